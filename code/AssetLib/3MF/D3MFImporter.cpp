@@ -45,7 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/StringComparison.h>
 #include <assimp/StringUtils.h>
-#include <assimp/XmlParser.h>
+#include <assimp/XmlStreamReader.h>
 #include <assimp/ZipArchiveIOSystem.h>
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
@@ -71,12 +71,12 @@ public:
     using MatArray = std::vector<aiMaterial *>;
     using MatId2MatArray = std::map<unsigned int, std::vector<unsigned int>>;
 
-    XmlSerializer(XmlParser *xmlParser) :
+    XmlSerializer(XmlStreamReader *reader) :
             mMeshes(),
             mMatArray(),
             mActiveMatGroup(99999999),
             mMatId2MatArray(),
-            mXmlParser(xmlParser) {
+            mReader(reader) {
         // empty
     }
 
@@ -92,22 +92,22 @@ public:
         scene->mRootNode = new aiNode();
         std::vector<aiNode *> children;
 
-        std::string nodeName;
-        XmlNode node = mXmlParser->getRootNode().child("model");
-        if (node.empty()) {
+        // The model is read as it streams in, only the meshes it describes are kept.
+        bool hasModel = false;
+        while (!hasModel && mReader->read()) {
+            hasModel = mReader->getEventType() == XmlStreamReader::Event_StartElement && mReader->getName() == D3MF::XmlTag::model;
+        }
+        if (!hasModel) {
             return;
         }
-        XmlNode resNode = node.child("resources");
-        for (XmlNode currentNode = resNode.first_child(); currentNode; currentNode = currentNode.next_sibling()) {
-            const std::string &currentNodeName = currentNode.name();
-            if (currentNodeName == D3MF::XmlTag::object) {
-                children.push_back(ReadObject(currentNode, scene));
-            } else if (currentNodeName == D3MF::XmlTag::build) {
-                //
-            } else if (currentNodeName == D3MF::XmlTag::basematerials) {
-                ReadBaseMaterials(currentNode);
-            } else if (currentNodeName == D3MF::XmlTag::meta) {
-                ReadMetadata(currentNode);
+
+        const size_t modelDepth = mReader->getDepth();
+        while (mReader->nextChild(modelDepth)) {
+            const std::string &currentName = mReader->getName();
+            if (currentName == D3MF::XmlTag::resources) {
+                ReadResources(scene, children);
+            } else if (currentName == D3MF::XmlTag::meta) {
+                ReadMetadata();
             }
         }
 
@@ -144,19 +144,33 @@ public:
     }
 
 private:
-    aiNode *ReadObject(XmlNode &node, aiScene *scene) {
+    void ReadResources(aiScene *scene, std::vector<aiNode *> &children) {
+        const size_t depth = mReader->getDepth();
+        while (mReader->nextChild(depth)) {
+            const std::string &currentName = mReader->getName();
+            if (currentName == D3MF::XmlTag::object) {
+                children.push_back(ReadObject(scene));
+            } else if (currentName == D3MF::XmlTag::basematerials) {
+                ReadBaseMaterials();
+            } else if (currentName == D3MF::XmlTag::meta) {
+                ReadMetadata();
+            }
+        }
+    }
+
+    aiNode *ReadObject(aiScene *scene) {
         std::unique_ptr<aiNode> nodePtr(new aiNode());
 
         std::vector<unsigned long> meshIds;
 
         std::string name, type;
-        pugi::xml_attribute attr = node.attribute(D3MF::XmlTag::id.c_str());
-        if (!attr.empty()) {
-            name = attr.as_string();
+        const char *attr = mReader->getAttribute(D3MF::XmlTag::id.c_str());
+        if (nullptr != attr) {
+            name = attr;
         }
-        attr = node.attribute(D3MF::XmlTag::type.c_str());
-        if (!attr.empty()) {
-            type = attr.as_string();
+        attr = mReader->getAttribute(D3MF::XmlTag::type.c_str());
+        if (nullptr != attr) {
+            type = attr;
         }
 
         nodePtr->mParent = scene->mRootNode;
@@ -164,10 +178,10 @@ private:
 
         size_t meshIdx = mMeshes.size();
 
-        for (XmlNode currentNode = node.first_child(); currentNode; currentNode = currentNode.next_sibling()) {
-            const std::string &currentName = currentNode.name();
-            if (currentName == D3MF::XmlTag::mesh) {
-                auto mesh = ReadMesh(currentNode);
+        const size_t depth = mReader->getDepth();
+        while (mReader->nextChild(depth)) {
+            if (mReader->getName() == D3MF::XmlTag::mesh) {
+                auto mesh = ReadMesh();
                 mesh->mName.Set(name);
                 mMeshes.push_back(mesh);
                 meshIds.push_back(static_cast<unsigned long>(meshIdx));
@@ -184,41 +198,41 @@ private:
         return nodePtr.release();
     }
 
-    aiMesh *ReadMesh(XmlNode &node) {
-        aiMesh *mesh = new aiMesh();
-        for (XmlNode currentNode = node.first_child(); currentNode; currentNode = currentNode.next_sibling()) {
-            const std::string &currentName = currentNode.name();
+    aiMesh *ReadMesh() {
+        std::unique_ptr<aiMesh> mesh(new aiMesh());
+        const size_t depth = mReader->getDepth();
+        while (mReader->nextChild(depth)) {
+            const std::string &currentName = mReader->getName();
             if (currentName == D3MF::XmlTag::vertices) {
-                ImportVertices(currentNode, mesh);
+                ImportVertices(mesh.get());
             } else if (currentName == D3MF::XmlTag::triangles) {
-                ImportTriangles(currentNode, mesh);
+                ImportTriangles(mesh.get());
             }
-
         }
 
-        return mesh;
+        return mesh.release();
     }
 
-    void ReadMetadata(XmlNode &node) {
-        pugi::xml_attribute attribute = node.attribute(D3MF::XmlTag::meta_name.c_str());
-        const std::string name = attribute.as_string();
-        const std::string value = node.value();
-        if (name.empty()) {
+    void ReadMetadata() {
+        const char *name = mReader->getAttribute(D3MF::XmlTag::meta_name.c_str());
+        if (nullptr == name || '\0' == *name) {
             return;
         }
 
         MetaEntry entry;
         entry.name = name;
-        entry.value = value;
+        mReader->readElementText(entry.value);
         mMetaData.push_back(entry);
     }
 
-    void ImportVertices(XmlNode &node, aiMesh *mesh) {
-        std::vector<aiVector3D> vertices;
-        for (XmlNode currentNode = node.first_child(); currentNode; currentNode = currentNode.next_sibling()) {
-            const std::string &currentName = currentNode.name();
-            if (currentName == D3MF::XmlTag::vertex) {
-                vertices.push_back(ReadVertex(currentNode));
+    // The vertices are appended straight into a growing buffer while the stream is read.
+    void ImportVertices(aiMesh *mesh) {
+        std::vector<aiVector3D> &vertices = mVertices;
+        vertices.clear();
+        const size_t depth = mReader->getDepth();
+        while (mReader->nextChild(depth)) {
+            if (mReader->getName() == D3MF::XmlTag::vertex) {
+                vertices.push_back(ReadVertex());
             }
         }
 
@@ -227,69 +241,62 @@ private:
         std::copy(vertices.begin(), vertices.end(), mesh->mVertices);
     }
 
-    aiVector3D ReadVertex(XmlNode &node) {
+    aiVector3D ReadVertex() {
         aiVector3D vertex;
-        vertex.x = ai_strtof(node.attribute(D3MF::XmlTag::x.c_str()).as_string(), nullptr);
-        vertex.y = ai_strtof(node.attribute(D3MF::XmlTag::y.c_str()).as_string(), nullptr);
-        vertex.z = ai_strtof(node.attribute(D3MF::XmlTag::z.c_str()).as_string(), nullptr);
+        vertex.x = ReadFloatAttribute(D3MF::XmlTag::x);
+        vertex.y = ReadFloatAttribute(D3MF::XmlTag::y);
+        vertex.z = ReadFloatAttribute(D3MF::XmlTag::z);
 
         return vertex;
     }
 
-    void ImportTriangles(XmlNode &node, aiMesh *mesh) {
-        std::vector<aiFace> faces;
-        for (XmlNode currentNode = node.first_child(); currentNode; currentNode = currentNode.next_sibling()) {
-            const std::string &currentName = currentNode.name();
-            if (currentName == D3MF::XmlTag::triangle) {
-                faces.push_back(ReadTriangle(currentNode));
-                const char *pidToken = currentNode.attribute(D3MF::XmlTag::p1.c_str()).as_string();
-                if (nullptr != pidToken) {
-                    int matIdx(std::atoi(pidToken));
-                    mesh->mMaterialIndex = matIdx;
-                }
+    ai_real ReadFloatAttribute(const std::string &name) const {
+        const char *value = mReader->getAttribute(name.c_str());
+        return nullptr != value ? ai_strtof(value, nullptr) : ai_real(0.0);
+    }
+
+    unsigned int ReadIndexAttribute(const std::string &name) const {
+        const char *value = mReader->getAttribute(name.c_str());
+        return nullptr != value ? static_cast<unsigned int>(std::atoi(value)) : 0u;
+    }
+
+    // The indices are collected in one flat array, the faces are created once their number is known.
+    void ImportTriangles(aiMesh *mesh) {
+        std::vector<unsigned int> &indices = mIndices;
+        indices.clear();
+        const size_t depth = mReader->getDepth();
+        while (mReader->nextChild(depth)) {
+            if (mReader->getName() == D3MF::XmlTag::triangle) {
+                indices.push_back(ReadIndexAttribute(D3MF::XmlTag::v1));
+                indices.push_back(ReadIndexAttribute(D3MF::XmlTag::v2));
+                indices.push_back(ReadIndexAttribute(D3MF::XmlTag::v3));
+                mesh->mMaterialIndex = ReadIndexAttribute(D3MF::XmlTag::p1);
             }
         }
 
-        mesh->mNumFaces = static_cast<unsigned int>(faces.size());
+        mesh->mNumFaces = static_cast<unsigned int>(indices.size() / 3);
         mesh->mFaces = new aiFace[mesh->mNumFaces];
         mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
-
-        std::copy(faces.begin(), faces.end(), mesh->mFaces);
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+            aiFace &face = mesh->mFaces[i];
+            face.mNumIndices = 3;
+            face.mIndices = new unsigned int[face.mNumIndices];
+            std::copy(indices.begin() + i * 3, indices.begin() + i * 3 + 3, face.mIndices);
+        }
     }
 
-    aiFace ReadTriangle(XmlNode &node) {
-        aiFace face;
-
-        face.mNumIndices = 3;
-        face.mIndices = new unsigned int[face.mNumIndices];
-        face.mIndices[0] = static_cast<unsigned int>(std::atoi(node.attribute(D3MF::XmlTag::v1.c_str()).as_string()));
-        face.mIndices[1] = static_cast<unsigned int>(std::atoi(node.attribute(D3MF::XmlTag::v2.c_str()).as_string()));
-        face.mIndices[2] = static_cast<unsigned int>(std::atoi(node.attribute(D3MF::XmlTag::v3.c_str()).as_string()));
-
-        return face;
-    }
+    void ReadBaseMaterials() {
+        const char *baseMaterialId = mReader->getAttribute(D3MF::XmlTag::basematerials_id.c_str());
+        mActiveMatGroup = nullptr != baseMaterialId ? static_cast<unsigned int>(std::atoi(baseMaterialId)) : 0u;
+        std::vector<unsigned int> &matIdArray = mMatId2MatArray[mActiveMatGroup];
 
-    void ReadBaseMaterials(XmlNode &node) {
-        std::vector<unsigned int> MatIdArray;
-        const char *baseMaterialId = node.attribute(D3MF::XmlTag::basematerials_id.c_str()).as_string();
-        if (nullptr != baseMaterialId) {
-            unsigned int id = std::atoi(baseMaterialId);
-            const size_t newMatIdx(mMatArray.size());
-            if (id != mActiveMatGroup) {
-                mActiveMatGroup = id;
-                MatId2MatArray::const_iterator it(mMatId2MatArray.find(id));
-                if (mMatId2MatArray.end() == it) {
-                    MatIdArray.clear();
-                    mMatId2MatArray[id] = MatIdArray;
-                } else {
-                    MatIdArray = it->second;
-                }
+        const size_t depth = mReader->getDepth();
+        while (mReader->nextChild(depth)) {
+            if (mReader->getName() == D3MF::XmlTag::basematerials_base) {
+                matIdArray.push_back(static_cast<unsigned int>(mMatArray.size()));
+                mMatArray.push_back(readMaterialDef());
             }
-            MatIdArray.push_back(static_cast<unsigned int>(newMatIdx));
-            mMatId2MatArray[mActiveMatGroup] = MatIdArray;
         }
-
-        mMatArray.push_back(readMaterialDef(node));
     }
 
     bool parseColor(const char *color, aiColor4D &diffuse) {
@@ -339,38 +346,33 @@ private:
         return true;
     }
 
-    void assignDiffuseColor(XmlNode &node, aiMaterial *mat) {
-        const char *color = node.attribute(D3MF::XmlTag::basematerials_displaycolor.c_str()).as_string();
+    void assignDiffuseColor(aiMaterial *mat) {
+        const char *color = mReader->getAttribute(D3MF::XmlTag::basematerials_displaycolor.c_str());
         aiColor4D diffuse;
         if (parseColor(color, diffuse)) {
             mat->AddProperty<aiColor4D>(&diffuse, 1, AI_MATKEY_COLOR_DIFFUSE);
         }
     }
 
-    aiMaterial *readMaterialDef(XmlNode &node) {
-        aiMaterial *mat(nullptr);
-        const char *name(nullptr);
-        const std::string nodeName = node.name();
-        if (nodeName == D3MF::XmlTag::basematerials_base) {
-            name = node.attribute(D3MF::XmlTag::basematerials_name.c_str()).as_string();
-            std::string stdMatName;
-            aiString matName;
-            std::string strId(to_string(mActiveMatGroup));
-            stdMatName += "id";
-            stdMatName += strId;
-            stdMatName += "_";
-            if (nullptr != name) {
-                stdMatName += std::string(name);
-            } else {
-                stdMatName += "basemat";
-            }
-            matName.Set(stdMatName);
+    aiMaterial *readMaterialDef() {
+        const char *name = mReader->getAttribute(D3MF::XmlTag::basematerials_name.c_str());
+        std::string stdMatName;
+        aiString matName;
+        std::string strId(to_string(mActiveMatGroup));
+        stdMatName += "id";
+        stdMatName += strId;
+        stdMatName += "_";
+        if (nullptr != name) {
+            stdMatName += std::string(name);
+        } else {
+            stdMatName += "basemat";
+        }
+        matName.Set(stdMatName);
 
-            mat = new aiMaterial;
-            mat->AddProperty(&matName, AI_MATKEY_NAME);
+        aiMaterial *mat = new aiMaterial;
+        mat->AddProperty(&matName, AI_MATKEY_NAME);
 
-            assignDiffuseColor(node, mat);
-        }
+        assignDiffuseColor(mat);
 
         return mat;
     }
@@ -385,7 +387,9 @@ private:
     MatArray mMatArray;
     unsigned int mActiveMatGroup;
     MatId2MatArray mMatId2MatArray;
-    XmlParser *mXmlParser;
+    std::vector<aiVector3D> mVertices;
+    std::vector<unsigned int> mIndices;
+    XmlStreamReader *mReader;
 };
 
 } //namespace D3MF
@@ -441,11 +445,9 @@ const aiImporterDesc *D3MFImporter::GetInfo() const {
 void D3MFImporter::InternReadFile(const std::string &filename, aiScene *pScene, IOSystem *pIOHandler) {
     D3MF::D3MFOpcPackage opcPackage(pIOHandler, filename);
 
-    XmlParser xmlParser;
-    if (xmlParser.parse(opcPackage.RootStream())) {
-        D3MF::XmlSerializer xmlSerializer(&xmlParser);
-        xmlSerializer.ImportXml(pScene);
-    }
+    XmlStreamReader reader(opcPackage.RootStream());
+    D3MF::XmlSerializer xmlSerializer(&reader);
+    xmlSerializer.ImportXml(pScene);
 }
 
 } // Namespace Assimp
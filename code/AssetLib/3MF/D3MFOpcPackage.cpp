@@ -187,7 +187,7 @@ bool D3MFOpcPackage::validate() {
 
 std::string D3MFOpcPackage::ReadPackageRootRelationship(IOStream *stream) {
     XmlParser xmlParser;
-    if (!xmlParser.parse(stream)) {
+    if (!xmlParser.parse(stream, pugi::parse_default)) {
         return "";
     }
 
@@ -135,6 +135,7 @@ AC3DImporter::AC3DImporter() :
         buffer(),
         configSplitBFCull(),
         configEvalSubdivision(),
+        configNumThreads(-1),
         mNumMeshes(),
         mLights(),
         mLightsCounter(0),
@@ -689,7 +690,7 @@ aiNode *AC3DImporter::ConvertObjectSection(Object &object,
             // collect all meshes using the same material group.
             if (object.subDiv) {
                 if (configEvalSubdivision) {
-                    std::unique_ptr<Subdivider> div(Subdivider::Create(Subdivider::CATMULL_CLARKE));
+                    std::unique_ptr<Subdivider> div(Subdivider::Create(Subdivider::CATMULL_CLARKE, configNumThreads));
                     ASSIMP_LOG_INFO("AC3D: Evaluating subdivision surface: " + object.name);
 
                     std::vector<aiMesh *> cpy(meshes.size() - oldm, nullptr);
@@ -752,6 +753,7 @@ aiNode *AC3DImporter::ConvertObjectSection(Object &object,
 void AC3DImporter::SetupProperties(const Importer *pImp) {
     configSplitBFCull = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_AC_SEPARATE_BFCULL, 1) ? true : false;
     configEvalSubdivision = pImp->GetPropertyInteger(AI_CONFIG_IMPORT_AC_EVAL_SUBDIVISION, 1) ? true : false;
+    configNumThreads = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -254,6 +254,10 @@ private:
     // evaluated if the value is true.
     bool configEvalSubdivision;
 
+    // Configuration option: AI_CONFIG_GLOB_MULTITHREADING,
+    // used for the subdivision surfaces.
+    int configNumThreads;
+
     // counts how many objects we have in the tree.
     // basing on this information we can find a
     // good estimate how many meshes we'll have in the final scene.
@@ -51,6 +51,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AMFImporter_Macro.hpp"
 
 #include <assimp/DefaultIOSystem.h>
+#include <assimp/ParsingUtils.h>
 #include <assimp/fast_atof.h>
 
 // Header files, stdlib.
@@ -73,6 +74,7 @@ const aiImporterDesc AMFImporter::Description = {
 
 void AMFImporter::Clear() {
     mNodeElement_Cur = nullptr;
+    mReader = nullptr;
     mUnit.clear();
     mMaterial_Converted.clear();
     mTexture_Converted.clear();
@@ -88,7 +90,8 @@ void AMFImporter::Clear() {
 
 AMFImporter::AMFImporter() AI_NO_EXCEPT :
         mNodeElement_Cur(nullptr),
-        mXmlParser(nullptr),
+        mReader(nullptr),
+        mText(),
         mUnit(),
         mVersion(),
         mMaterial_Converted(),
@@ -97,7 +100,6 @@ AMFImporter::AMFImporter() AI_NO_EXCEPT :
 }
 
 AMFImporter::~AMFImporter() {
-    delete mXmlParser;
     // Clear() is accounting if data already is deleted. So, just check again if all data is deleted.
     Clear();
 }
@@ -177,14 +179,27 @@ void AMFImporter::Throw_ID_NotFound(const std::string &pID) const {
 /************************************************************* Functions: XML set ************************************************************/
 /*********************************************************************************************************************************************/
 
-void AMFImporter::XML_CheckNode_MustHaveChildren(pugi::xml_node &node) {
-    if (node.children().begin() == node.children().end()) {
-        throw DeadlyImportError(std::string("Node <") + node.name() + "> must have children.");
+std::string AMFImporter::XML_ReadAttribute(const char *pName) const {
+    const char *value = mReader->getAttribute(pName);
+    return nullptr != value ? std::string(value) : std::string();
+}
+
+ai_real AMFImporter::XML_ReadNode_GetVal_AsFloat() {
+    mReader->readElementText(mText);
+    const char *text = mText.c_str();
+    SkipSpacesAndLineEnd(&text);
+    if ('\0' == *text) {
+        return ai_real(0.0);
     }
+
+    ai_real value;
+    fast_atoreal_move<ai_real>(text, value);
+    return value;
 }
 
-bool AMFImporter::XML_SearchNode(const std::string &nodeName) {
-    return nullptr != mXmlParser->findNode(nodeName);
+int AMFImporter::XML_ReadNode_GetVal_AsInt() {
+    mReader->readElementText(mText);
+    return std::atoi(mText.c_str());
 }
 
 void AMFImporter::ParseHelper_FixTruncatedFloatString(const char *pInStr, std::string &pOutString) {
@@ -270,18 +285,20 @@ void AMFImporter::ParseFile(const std::string &pFile, IOSystem *pIOHandler) {
         throw DeadlyImportError("Failed to open AMF file ", pFile, ".");
     }
 
-    mXmlParser = new XmlParser();
-    if (!mXmlParser->parse(file.get())) {
-        delete mXmlParser;
-        throw DeadlyImportError("Failed to create XML reader for file" + pFile + ".");
+    // The file is streamed, the node element graph is built while reading.
+    XmlStreamReader reader(file.get());
+    bool found = false;
+    while (!found && reader.read()) {
+        found = reader.getEventType() == XmlStreamReader::Event_StartElement && reader.getName() == "amf";
     }
-
-    // Start reading, search for root tag <amf>
-    if (!mXmlParser->hasNode("amf")) {
+    if (!found) {
         throw DeadlyImportError("Root node \"amf\" not found.");
     }
+
+    mReader = &reader;
     ParseNode_Root();
-} // namespace Assimp
+    mReader = nullptr;
+}
 
 void AMFImporter::ParseHelper_Node_Enter(AMFNodeElementBase *node) {
     mNodeElement_Cur->Child.push_back(node); // add new element to current element child list.
@@ -301,13 +318,8 @@ void AMFImporter::ParseHelper_Node_Exit() {
 // Multi elements - No.
 void AMFImporter::ParseNode_Root() {
     AMFNodeElementBase *ne = nullptr;
-    XmlNode *root = mXmlParser->findNode("amf");
-    if (nullptr == root) {
-        throw DeadlyImportError("Root node \"amf\" not found.");
-    }
-    XmlNode node = *root;
-    mUnit = node.attribute("unit").as_string();
-    mVersion = node.attribute("version").as_string();
+    mUnit = XML_ReadAttribute("unit");
+    mVersion = XML_ReadAttribute("version");
 
     // Read attributes for node <amf>.
     // Check attributes
@@ -319,6 +331,7 @@ void AMFImporter::ParseNode_Root() {
 
     // create root node element.
     ne = new AMFRoot(nullptr);
+    mNodeElement_List.push_back(ne); // add to node element list because its a new object in graph.
 
     mNodeElement_Cur = ne; // set first "current" element
     // and assign attribute's values
@@ -326,23 +339,23 @@ void AMFImporter::ParseNode_Root() {
     ((AMFRoot *)ne)->Version = mVersion;
 
     // Check for child nodes
-    for (XmlNode &currentNode : node.children() ) {
-        const std::string currentName = currentNode.name();
+    const size_t depth = mReader->getDepth();
+    while (mReader->nextChild(depth)) {
+        const std::string &currentName = mReader->getName();
         if (currentName == "object") {
-            ParseNode_Object(currentNode);
+            ParseNode_Object();
         } else if (currentName == "material") {
-            ParseNode_Material(currentNode);
+            ParseNode_Material();
         } else if (currentName == "texture") {
-            ParseNode_Texture(currentNode);
+            ParseNode_Texture();
         } else if (currentName == "constellation") {
-            ParseNode_Constellation(currentNode);
+            ParseNode_Constellation();
         } else if (currentName == "metadata") {
-            ParseNode_Metadata(currentNode);
+            ParseNode_Metadata();
         }
         mNodeElement_Cur = ne;
     }
     mNodeElement_Cur = ne; // force restore "current" element
-    mNodeElement_List.push_back(ne); // add to node element list because its a new object in graph.
 }
 
 // <constellation
@@ -352,35 +365,26 @@ void AMFImporter::ParseNode_Root() {
 // A collection of objects or constellations with specific relative locations.
 // Multi elements - Yes.
 // Parent element - <amf>.
-void AMFImporter::ParseNode_Constellation(XmlNode &node) {
-    std::string id;
-    id = node.attribute("id").as_string();
-
+void AMFImporter::ParseNode_Constellation() {
     // create and if needed - define new grouping object.
     AMFNodeElementBase *ne = new AMFConstellation(mNodeElement_Cur);
+    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
 
     AMFConstellation &als = *((AMFConstellation *)ne); // alias for convenience
-
-    if (!id.empty()) {
-        als.ID = id;
-    }
+    als.ID = XML_ReadAttribute("id");
 
     // Check for child nodes
-    if (!node.empty()) {
-        ParseHelper_Node_Enter(ne);
-        for (XmlNode currentNode = node.first_child(); currentNode; currentNode = currentNode.next_sibling()) {
-            std::string name = currentNode.name();
-            if (name == "instance") {
-                ParseNode_Instance(currentNode);
-            } else if (name == "metadata") {
-                ParseNode_Metadata(currentNode);
-            }
+    ParseHelper_Node_Enter(ne);
+    const size_t depth = mReader->getDepth();
+    while (mReader->nextChild(depth)) {
+        const std::string &currentName = mReader->getName();
+        if (currentName == "instance") {
+            ParseNode_Instance();
+        } else if (currentName == "metadata") {
+            ParseNode_Metadata();
         }
-        ParseHelper_Node_Exit();
-    } else {
-        mNodeElement_Cur->Child.push_back(ne);
     }
-    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
+    ParseHelper_Node_Exit();
 }
 
 // <instance
@@ -390,45 +394,39 @@ void AMFImporter::ParseNode_Constellation(XmlNode &node) {
 // A collection of objects or constellations with specific relative locations.
 // Multi elements - Yes.
 // Parent element - <amf>.
-void AMFImporter::ParseNode_Instance(XmlNode &node) {
-    AMFNodeElementBase *ne(nullptr);
-
+void AMFImporter::ParseNode_Instance() {
     // Read attributes for node <constellation>.
-    std::string objectid = node.attribute("objectid").as_string();
+    std::string objectid = XML_ReadAttribute("objectid");
 
     // used object id must be defined, check that.
     if (objectid.empty()) {
         throw DeadlyImportError("\"objectid\" in <instance> must be defined.");
     }
     // create and define new grouping object.
-    ne = new AMFInstance(mNodeElement_Cur);
+    AMFNodeElementBase *ne = new AMFInstance(mNodeElement_Cur);
+    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
     AMFInstance &als = *((AMFInstance *)ne);
     als.ObjectID = objectid;
 
-    if (!node.empty()) {
-        ParseHelper_Node_Enter(ne);
-        for (XmlNode currentNode = node.first_child(); currentNode; currentNode = currentNode.next_sibling()) {
-            const std::string &currentName = currentNode.name();
-            if (currentName == "deltax") {
-                als.Delta.x = (ai_real)std::atof(currentNode.value());
-            } else if (currentName == "deltay") {
-                als.Delta.y = (ai_real)std::atof(currentNode.value());
-            } else if (currentName == "deltaz") {
-                als.Delta.z = (ai_real)std::atof(currentNode.value());
-            } else if (currentName == "rx") {
-                als.Delta.x = (ai_real)std::atof(currentNode.value());
-            } else if (currentName == "ry") {
-                als.Delta.y = (ai_real)std::atof(currentNode.value());
-            } else if (currentName == "rz") {
-                als.Delta.z = (ai_real)std::atof(currentNode.value());
-            }
+    ParseHelper_Node_Enter(ne);
+    const size_t depth = mReader->getDepth();
+    while (mReader->nextChild(depth)) {
+        const std::string &currentName = mReader->getName();
+        if (currentName == "deltax") {
+            als.Delta.x = XML_ReadNode_GetVal_AsFloat();
+        } else if (currentName == "deltay") {
+            als.Delta.y = XML_ReadNode_GetVal_AsFloat();
+        } else if (currentName == "deltaz") {
+            als.Delta.z = XML_ReadNode_GetVal_AsFloat();
+        } else if (currentName == "rx") {
+            als.Rotation.x = XML_ReadNode_GetVal_AsFloat();
+        } else if (currentName == "ry") {
+            als.Rotation.y = XML_ReadNode_GetVal_AsFloat();
+        } else if (currentName == "rz") {
+            als.Rotation.z = XML_ReadNode_GetVal_AsFloat();
         }
-        ParseHelper_Node_Exit();
-    } else {
-        mNodeElement_Cur->Child.push_back(ne);
     }
-
-    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
+    ParseHelper_Node_Exit();
 }
 
 // <object
@@ -438,40 +436,28 @@ void AMFImporter::ParseNode_Instance(XmlNode &node) {
 // An object definition.
 // Multi elements - Yes.
 // Parent element - <amf>.
-void AMFImporter::ParseNode_Object(XmlNode &node) {
-    AMFNodeElementBase *ne = nullptr;
-
-    // Read attributes for node <object>.
-    std::string id = node.attribute("id").as_string();
-
+void AMFImporter::ParseNode_Object() {
     // create and if needed - define new geometry object.
-    ne = new AMFObject(mNodeElement_Cur);
+    AMFNodeElementBase *ne = new AMFObject(mNodeElement_Cur);
+    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
 
     AMFObject &als = *((AMFObject *)ne); // alias for convenience
-
-    if (!id.empty()) {
-        als.ID = id;
-    }
+    als.ID = XML_ReadAttribute("id");
 
     // Check for child nodes
-    if (!node.empty()) {
-        ParseHelper_Node_Enter(ne);
-        for (XmlNode currentNode = node.first_child(); currentNode; currentNode = currentNode.next_sibling()) {
-            const std::string &currentName = currentNode.name();
-            if (currentName == "color") {
-                ParseNode_Color(currentNode);
-            } else if (currentName == "mesh") {
-                ParseNode_Mesh(currentNode);
-            } else if (currentName == "metadata") {
-                ParseNode_Metadata(currentNode);
-            }
+    ParseHelper_Node_Enter(ne);
+    const size_t depth = mReader->getDepth();
+    while (mReader->nextChild(depth)) {
+        const std::string &currentName = mReader->getName();
+        if (currentName == "color") {
+            ParseNode_Color();
+        } else if (currentName == "mesh") {
+            ParseNode_Mesh();
+        } else if (currentName == "metadata") {
+            ParseNode_Metadata();
         }
-        ParseHelper_Node_Exit();
-    } else {
-        mNodeElement_Cur->Child.push_back(ne); // Add element to child list of current element
     }
-
-    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
+    ParseHelper_Node_Exit();
 }
 
 // <metadata
@@ -492,16 +478,12 @@ void AMFImporter::ParseNode_Object(XmlNode &node) {
 // "Revision" - specifies the revision of the entity
 // "Tolerance" - specifies the desired manufacturing tolerance of the entity in entity's unit system
 // "Volume" - specifies the total volume of the entity, in the entity's unit system, to be used for verification (object and volume only)
-void AMFImporter::ParseNode_Metadata(XmlNode &node) {
-    AMFNodeElementBase *ne = nullptr;
-
-    std::string type = node.attribute("type").as_string(), value;
-    XmlParser::getValueAsString(node, value);
+void AMFImporter::ParseNode_Metadata() {
+    AMFNodeElementBase *ne = new AMFMetadata(mNodeElement_Cur);
 
     // read attribute
-    ne = new AMFMetadata(mNodeElement_Cur);
-    ((AMFMetadata *)ne)->Type = type;
-    ((AMFMetadata *)ne)->Value = value;
+    ((AMFMetadata *)ne)->Type = XML_ReadAttribute("type");
+    mReader->readElementText(((AMFMetadata *)ne)->Value);
     mNodeElement_Cur->Child.push_back(ne); // Add element to child list of current element
     mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
 }
@@ -54,7 +54,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Header files, Assimp.
 #include "assimp/types.h"
 #include <assimp/BaseImporter.h>
-#include <assimp/XmlParser.h>
+#include <assimp/XmlStreamReader.h>
 #include <assimp/importerdesc.h>
 #include <assimp/DefaultLogger.hpp>
 
@@ -213,54 +213,55 @@ private:
     /// \param [out] pOutputData - reference to output array for decoded data.
     void ParseHelper_Decode_Base64(const std::string &pInputBase64, std::vector<uint8_t> &pOutputData) const;
 
+    /// The ParseNode_* functions are called at the start of their element in the stream and return after its end.
     /// Parse <AMF> node of the file.
     void ParseNode_Root();
 
     /// Parse <constellation> node of the file.
-    void ParseNode_Constellation(XmlNode &node);
+    void ParseNode_Constellation();
 
     /// Parse <instance> node of the file.
-    void ParseNode_Instance(XmlNode &node);
+    void ParseNode_Instance();
 
     /// Parse <material> node of the file.
-    void ParseNode_Material(XmlNode &node);
+    void ParseNode_Material();
 
     /// Parse <metadata> node.
-    void ParseNode_Metadata(XmlNode &node);
+    void ParseNode_Metadata();
 
     /// Parse <object> node of the file.
-    void ParseNode_Object(XmlNode &node);
+    void ParseNode_Object();
 
     /// Parse <texture> node of the file.
-    void ParseNode_Texture(XmlNode &node);
+    void ParseNode_Texture();
 
     /// Parse <coordinates> node of the file.
-    void ParseNode_Coordinates(XmlNode &node);
+    void ParseNode_Coordinates();
 
     /// Parse <edge> node of the file.
-    void ParseNode_Edge(XmlNode &node);
+    void ParseNode_Edge();
 
     /// Parse <mesh> node of the file.
-    void ParseNode_Mesh(XmlNode &node);
+    void ParseNode_Mesh();
 
     /// Parse <triangle> node of the file.
-    void ParseNode_Triangle(XmlNode &node);
+    void ParseNode_Triangle();
 
     /// Parse <vertex> node of the file.
-    void ParseNode_Vertex(XmlNode &node);
+    void ParseNode_Vertex();
 
     /// Parse <vertices> node of the file.
-    void ParseNode_Vertices(XmlNode &node);
+    void ParseNode_Vertices();
 
     /// Parse <volume> node of the file.
-    void ParseNode_Volume(XmlNode &node);
+    void ParseNode_Volume();
 
     /// Parse <color> node of the file.
-    void ParseNode_Color(XmlNode &node);
+    void ParseNode_Color();
 
     /// Parse <texmap> of <map> node of the file.
     /// \param [in] pUseOldName - if true then use old name of node(and children) - <map>, instead of new name - <texmap>.
-    void ParseNode_TexMap(XmlNode &node, const bool pUseOldName = false);
+    void ParseNode_TexMap(const bool pUseOldName = false);
 
 public:
     /// Default constructor.
@@ -288,8 +289,9 @@ public:
     void Throw_IncorrectAttrValue(const std::string &nodeName, const std::string &pAttrName);
     void Throw_MoreThanOnceDefined(const std::string &nodeName, const std::string &pNodeType, const std::string &pDescription);
     void Throw_ID_NotFound(const std::string &pID) const;
-    void XML_CheckNode_MustHaveChildren(pugi::xml_node &node);
-    bool XML_SearchNode(const std::string &nodeName);
+    std::string XML_ReadAttribute(const char *pName) const;
+    ai_real XML_ReadNode_GetVal_AsFloat();
+    int XML_ReadNode_GetVal_AsInt();
     void ParseHelper_FixTruncatedFloatString(const char *pInStr, std::string &pOutString);
     AMFImporter(const AMFImporter &pScene) = delete;
     AMFImporter &operator=(const AMFImporter &pScene) = delete;
@@ -299,7 +301,8 @@ private:
 
     AMFNodeElementBase *mNodeElement_Cur; ///< Current element.
     std::list<AMFNodeElementBase *> mNodeElement_List; ///< All elements of scene graph.
-    XmlParser *mXmlParser;
+    XmlStreamReader *mReader; ///< Reader of the file being parsed.
+    std::string mText; ///< Scratch buffer for element texts.
     std::string mUnit;
     std::string mVersion;
     std::list<SPP_Material> mMaterial_Converted; ///< List of converted materials for postprocessing step.
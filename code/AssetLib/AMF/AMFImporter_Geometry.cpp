@@ -58,38 +58,23 @@ namespace Assimp {
 // A 3D mesh hull.
 // Multi elements - Yes.
 // Parent element - <object>.
-void AMFImporter::ParseNode_Mesh(XmlNode &node) {
-    AMFNodeElementBase *ne = nullptr;
-
+void AMFImporter::ParseNode_Mesh() {
     // create new mesh object.
-    ne = new AMFMesh(mNodeElement_Cur);
-    // Check for child nodes
-    if (0 != ASSIMP_stricmp(node.name(), "mesh")) {
-        return;
-    }
-    bool found_verts = false, found_volumes = false;
-    if (!node.empty()) {
-        ParseHelper_Node_Enter(ne);
-        pugi::xml_node vertNode = node.child("vertices");
-        if (!vertNode.empty()) {
-            ParseNode_Vertices(vertNode);
-            found_verts = true;
-        }
+    AMFNodeElementBase *ne = new AMFMesh(mNodeElement_Cur);
+    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
 
-        pugi::xml_node volumeNode = node.child("volume");
-        if (!volumeNode.empty()) {
-            ParseNode_Volume(volumeNode);
-            found_volumes = true;
+    // Check for child nodes
+    ParseHelper_Node_Enter(ne);
+    const size_t depth = mReader->getDepth();
+    while (mReader->nextChild(depth)) {
+        const std::string &currentName = mReader->getName();
+        if (currentName == "vertices") {
+            ParseNode_Vertices();
+        } else if (currentName == "volume") {
+            ParseNode_Volume();
         }
-        ParseHelper_Node_Exit();
-    } 
-
-    if (!found_verts && !found_volumes) {
-        mNodeElement_Cur->Child.push_back(ne);
-    } // if(!mReader->isEmptyElement()) else
-
-    // and to node element list because its a new object in graph.
-    mNodeElement_List.push_back(ne);
+    }
+    ParseHelper_Node_Exit();
 }
 
 // <vertices>
@@ -97,25 +82,20 @@ void AMFImporter::ParseNode_Mesh(XmlNode &node) {
 // The list of vertices to be used in defining triangles.
 // Multi elements - No.
 // Parent element - <mesh>.
-void AMFImporter::ParseNode_Vertices(XmlNode &node) {
-    AMFNodeElementBase *ne = nullptr;
-
+void AMFImporter::ParseNode_Vertices() {
     // create new mesh object.
-    ne = new AMFVertices(mNodeElement_Cur);
-    // Check for child nodes
-    pugi::xml_node vertexNode = node.child("vertex");
-    if (!vertexNode.empty()) {
-        ParseHelper_Node_Enter(ne);
-
-        ParseNode_Vertex(vertexNode);
-
-        ParseHelper_Node_Exit();
-
-    } else {
-        mNodeElement_Cur->Child.push_back(ne); // Add element to child list of current element
-    } // if(!mReader->isEmptyElement()) else
-
+    AMFNodeElementBase *ne = new AMFVertices(mNodeElement_Cur);
     mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
+
+    // Check for child nodes
+    ParseHelper_Node_Enter(ne);
+    const size_t depth = mReader->getDepth();
+    while (mReader->nextChild(depth)) {
+        if (mReader->getName() == "vertex") {
+            ParseNode_Vertex();
+        }
+    }
+    ParseHelper_Node_Exit();
 }
 
 // <vertex>
@@ -123,35 +103,31 @@ void AMFImporter::ParseNode_Vertices(XmlNode &node) {
 // A vertex to be referenced in triangles.
 // Multi elements - Yes.
 // Parent element - <vertices>.
-void AMFImporter::ParseNode_Vertex(XmlNode &node) {
-    AMFNodeElementBase *ne = nullptr;
-
+void AMFImporter::ParseNode_Vertex() {
     // create new mesh object.
-    ne = new AMFVertex(mNodeElement_Cur);
+    AMFNodeElementBase *ne = new AMFVertex(mNodeElement_Cur);
+    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
 
     // Check for child nodes
-    pugi::xml_node colorNode = node.child("color");
     bool col_read = false;
     bool coord_read = false;
-    if (!node.empty()) {
-        ParseHelper_Node_Enter(ne);
-        if (!colorNode.empty()) {
-            ParseNode_Color(colorNode);
+    ParseHelper_Node_Enter(ne);
+    const size_t depth = mReader->getDepth();
+    while (mReader->nextChild(depth)) {
+        const std::string &currentName = mReader->getName();
+        if (currentName == "color") {
+            if (col_read) Throw_MoreThanOnceDefined(currentName, "color", "Only one color can be defined for <vertex>.");
+            ParseNode_Color();
             col_read = true;
-        }
-        pugi::xml_node coordNode = node.child("coordinates");
-        if (!coordNode.empty()) {
-            ParseNode_Coordinates(coordNode);
+        } else if (currentName == "coordinates") {
+            if (coord_read) Throw_MoreThanOnceDefined(currentName, "coordinates", "Only one coordinates set can be defined for <vertex>.");
+            ParseNode_Coordinates();
             coord_read = true;
+        } else if (currentName == "metadata") {
+            ParseNode_Metadata();
         }
-        ParseHelper_Node_Exit();
     }
-
-    if (!coord_read && !col_read) {
-        mNodeElement_Cur->Child.push_back(ne); // Add element to child list of current element
-    }
-
-    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
+    ParseHelper_Node_Exit();
 }
 
 // <coordinates>
@@ -164,32 +140,25 @@ void AMFImporter::ParseNode_Vertex(XmlNode &node) {
 //   <x>, <y>, <z>
 //   Multi elements - No.
 //   X, Y, or Z coordinate, respectively, of a vertex position in space.
-void AMFImporter::ParseNode_Coordinates(XmlNode &node) {
-    AMFNodeElementBase *ne = nullptr;
-
+void AMFImporter::ParseNode_Coordinates() {
     // create new color object.
-    ne = new AMFCoordinates(mNodeElement_Cur);
+    AMFNodeElementBase *ne = new AMFCoordinates(mNodeElement_Cur);
+    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
 
     AMFCoordinates &als = *((AMFCoordinates *)ne); // alias for convenience
-    if (!node.empty()) {
-        ParseHelper_Node_Enter(ne);
-        for (XmlNode &currentNode : node.children()) {
-            const std::string &currentName = currentNode.name();
-            if (currentName == "X") {
-                XmlParser::getValueAsFloat(currentNode, als.Coordinate.x);
-            } else if (currentName == "Y") {
-                XmlParser::getValueAsFloat(currentNode, als.Coordinate.y);
-            } else if (currentName == "Z") {
-                XmlParser::getValueAsFloat(currentNode, als.Coordinate.z);
-            }
+    ParseHelper_Node_Enter(ne);
+    const size_t depth = mReader->getDepth();
+    while (mReader->nextChild(depth)) {
+        const char *currentName = mReader->getName().c_str();
+        if (0 == ASSIMP_stricmp(currentName, "x")) {
+            als.Coordinate.x = XML_ReadNode_GetVal_AsFloat();
+        } else if (0 == ASSIMP_stricmp(currentName, "y")) {
+            als.Coordinate.y = XML_ReadNode_GetVal_AsFloat();
+        } else if (0 == ASSIMP_stricmp(currentName, "z")) {
+            als.Coordinate.z = XML_ReadNode_GetVal_AsFloat();
         }
-
-        ParseHelper_Node_Exit();
-    } else {
-        mNodeElement_Cur->Child.push_back(ne);
     }
-
-    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
+    ParseHelper_Node_Exit();
 }
 
 // <volume
@@ -201,41 +170,32 @@ void AMFImporter::ParseNode_Coordinates(XmlNode &node) {
 // Defines a volume from the established vertex list.
 // Multi elements - Yes.
 // Parent element - <mesh>.
-void AMFImporter::ParseNode_Volume(XmlNode &node) {
-    std::string materialid;
-    std::string type;
+void AMFImporter::ParseNode_Volume() {
     AMFNodeElementBase *ne = new AMFVolume(mNodeElement_Cur);
+    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
 
-    // Read attributes for node <color>.
+    // Read attributes for node <volume>.
     // and assign read data
-   
-    ((AMFVolume *)ne)->MaterialID = node.attribute("materialid").as_string();
-     
-    ((AMFVolume *)ne)->Type = type;
+    ((AMFVolume *)ne)->MaterialID = XML_ReadAttribute("materialid");
+    ((AMFVolume *)ne)->Type = XML_ReadAttribute("type");
+
     // Check for child nodes
     bool col_read = false;
-    if (!node.empty()) {
-        ParseHelper_Node_Enter(ne);
-        for (XmlNode currentNode = node.first_child(); currentNode; currentNode = currentNode.next_sibling()) {
-            const std::string currentName = currentNode.name();
-            if (currentName == "color") {
-                if (col_read) Throw_MoreThanOnceDefined(currentName, "color", "Only one color can be defined for <volume>.");
-                ParseNode_Color(currentNode);
-                col_read = true;
-            } else if (currentName == "triangle") {
-                ParseNode_Triangle(currentNode);
-            } else if (currentName == "metadata") {
-                ParseNode_Metadata(currentNode);
-            } else if (currentName == "volume") {
-                ParseNode_Metadata(currentNode);
-            }
+    ParseHelper_Node_Enter(ne);
+    const size_t depth = mReader->getDepth();
+    while (mReader->nextChild(depth)) {
+        const std::string &currentName = mReader->getName();
+        if (currentName == "color") {
+            if (col_read) Throw_MoreThanOnceDefined(currentName, "color", "Only one color can be defined for <volume>.");
+            ParseNode_Color();
+            col_read = true;
+        } else if (currentName == "triangle") {
+            ParseNode_Triangle();
+        } else if (currentName == "metadata") {
+            ParseNode_Metadata();
         }
-        ParseHelper_Node_Exit();
-    } else {
-        mNodeElement_Cur->Child.push_back(ne); // Add element to child list of current element
     }
-
-    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
+    ParseHelper_Node_Exit();
 }
 
 // <triangle>
@@ -248,40 +208,35 @@ void AMFImporter::ParseNode_Volume(XmlNode &node) {
 //   <v1>, <v2>, <v3>
 //   Multi elements - No.
 //   Index of the desired vertices in a triangle or edge.
-void AMFImporter::ParseNode_Triangle(XmlNode &node) {
-    AMFNodeElementBase *ne = new AMFTriangle(mNodeElement_Cur);
-
+void AMFImporter::ParseNode_Triangle() {
     // create new triangle object.
+    AMFNodeElementBase *ne = new AMFTriangle(mNodeElement_Cur);
+    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
 
     AMFTriangle &als = *((AMFTriangle *)ne); // alias for convenience
 
     bool col_read = false;
-    if (!node.empty()) {
-        ParseHelper_Node_Enter(ne);
-        for (XmlNode currentNode = node.first_child(); currentNode; currentNode = currentNode.next_sibling()) {
-            const std::string currentName = currentNode.name();
-            if (currentName == "color") {
-                if (col_read) Throw_MoreThanOnceDefined(currentName, "color", "Only one color can be defined for <triangle>.");
-                ParseNode_Color(currentNode);
-                col_read = true;
-            } else if (currentName == "texmap") {
-                ParseNode_TexMap(currentNode);
-            } else if (currentName == "map") {
-                ParseNode_TexMap(currentNode, true);
-            } else if (currentName == "v1") {
-                als.V[0] = std::atoi(currentNode.value());
-            } else if (currentName == "v2") {
-                als.V[1] = std::atoi(currentNode.value());
-            } else if (currentName == "v3") {
-                als.V[2] = std::atoi(currentNode.value());
-            }
+    ParseHelper_Node_Enter(ne);
+    const size_t depth = mReader->getDepth();
+    while (mReader->nextChild(depth)) {
+        const std::string &currentName = mReader->getName();
+        if (currentName == "color") {
+            if (col_read) Throw_MoreThanOnceDefined(currentName, "color", "Only one color can be defined for <triangle>.");
+            ParseNode_Color();
+            col_read = true;
+        } else if (currentName == "texmap") {
+            ParseNode_TexMap();
+        } else if (currentName == "map") {
+            ParseNode_TexMap(true);
+        } else if (currentName == "v1") {
+            als.V[0] = XML_ReadNode_GetVal_AsInt();
+        } else if (currentName == "v2") {
+            als.V[1] = XML_ReadNode_GetVal_AsInt();
+        } else if (currentName == "v3") {
+            als.V[2] = XML_ReadNode_GetVal_AsInt();
         }
-        ParseHelper_Node_Exit();
-    } else {
-        mNodeElement_Cur->Child.push_back(ne); // Add element to child list of current element
     }
-
-    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
+    ParseHelper_Node_Exit();
 }
 
 } // namespace Assimp
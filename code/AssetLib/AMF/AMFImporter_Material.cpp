@@ -64,49 +64,46 @@ namespace Assimp {
 //   Multi elements - No.
 //   Red, Greed, Blue and Alpha (transparency) component of a color in sRGB space, values ranging from 0 to 1. The
 //   values can be specified as constants, or as a formula depending on the coordinates.
-void AMFImporter::ParseNode_Color(XmlNode &node) {
-    std::string profile = node.attribute("profile").as_string();
-    
-	// create new color object.
-	AMFNodeElementBase *ne = new AMFColor(mNodeElement_Cur);
-	AMFColor& als = *((AMFColor*)ne);// alias for convenience
-
-	als.Profile = profile;
-	if (!node.empty()) {
-        ParseHelper_Node_Enter(ne);
-		bool read_flag[4] = { false, false, false, false };
-		for (pugi::xml_node &child : node.children()) {
-            std::string name = child.name();
-            if ( name == "r") {
-				read_flag[0] = true;
-                XmlParser::getValueAsFloat(child, als.Color.r);
-            } else if (name == "g") {
-				read_flag[1] = true;
-                XmlParser::getValueAsFloat(child, als.Color.g);
-            } else if (name == "b") {
-				read_flag[2] = true;
-                XmlParser::getValueAsFloat(child, als.Color.b);
-            } else if (name == "a") {
-			    read_flag[3] = true;
-                XmlParser::getValueAsFloat(child, als.Color.a);
-            }
-            ParseHelper_Node_Exit();
+void AMFImporter::ParseNode_Color() {
+    // create new color object.
+    AMFNodeElementBase *ne = new AMFColor(mNodeElement_Cur);
+    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
+    AMFColor &als = *((AMFColor *)ne); // alias for convenience
+
+    als.Profile = XML_ReadAttribute("profile");
+
+    ParseHelper_Node_Enter(ne);
+    bool read_flag[4] = { false, false, false, false };
+    const size_t depth = mReader->getDepth();
+    while (mReader->nextChild(depth)) {
+        const std::string &name = mReader->getName();
+        if (name == "r") {
+            read_flag[0] = true;
+            als.Color.r = XML_ReadNode_GetVal_AsFloat();
+        } else if (name == "g") {
+            read_flag[1] = true;
+            als.Color.g = XML_ReadNode_GetVal_AsFloat();
+        } else if (name == "b") {
+            read_flag[2] = true;
+            als.Color.b = XML_ReadNode_GetVal_AsFloat();
+        } else if (name == "a") {
+            read_flag[3] = true;
+            als.Color.a = XML_ReadNode_GetVal_AsFloat();
         }
-		// check that all components was defined
-		if (!(read_flag[0] && read_flag[1] && read_flag[2])) {
-			throw DeadlyImportError("Not all color components are defined.");
-		}
-
-		// check if <a> is absent. Then manually add "a == 1".
-		if (!read_flag[3]) {
-			als.Color.a = 1;
-		}
-	} else {
-		mNodeElement_Cur->Child.push_back(ne);// Add element to child list of current element
-	}
-
-	als.Composed = false;
-	mNodeElement_List.push_back(ne);// and to node element list because its a new object in graph.
+    }
+    ParseHelper_Node_Exit();
+
+    // check that all components was defined
+    if (!(read_flag[0] && read_flag[1] && read_flag[2])) {
+        throw DeadlyImportError("Not all color components are defined.");
+    }
+
+    // check if <a> is absent. Then manually add "a == 1".
+    if (!read_flag[3]) {
+        als.Color.a = 1;
+    }
+
+    als.Composed = false;
 }
 
 // <material
@@ -116,29 +113,24 @@ void AMFImporter::ParseNode_Color(XmlNode &node) {
 // An available material.
 // Multi elements - Yes.
 // Parent element - <amf>.
-void AMFImporter::ParseNode_Material(XmlNode &node) {
+void AMFImporter::ParseNode_Material() {
     // create new object and assign read data
-	std::string id = node.attribute("id").as_string();
-	AMFNodeElementBase *ne = new AMFMaterial(mNodeElement_Cur);
-	((AMFMaterial*)ne)->ID = id;
+    AMFNodeElementBase *ne = new AMFMaterial(mNodeElement_Cur);
+    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
+    ((AMFMaterial *)ne)->ID = XML_ReadAttribute("id");
 
     // Check for child nodes
-	if (!node.empty()) {
-        ParseHelper_Node_Enter(ne);
-        for (pugi::xml_node &child : node.children()) {
-            const std::string name = child.name();
-            if (name == "color") {
-				ParseNode_Color(child);
-            } else if (name == "metadata") {
-				ParseNode_Metadata(child);
-			}
-		}
-        ParseHelper_Node_Exit();
-	} else {
-		mNodeElement_Cur->Child.push_back(ne);// Add element to child list of current element
-	}
-
-	mNodeElement_List.push_back(ne);// and to node element list because its a new object in graph.
+    ParseHelper_Node_Enter(ne);
+    const size_t depth = mReader->getDepth();
+    while (mReader->nextChild(depth)) {
+        const std::string &name = mReader->getName();
+        if (name == "color") {
+            ParseNode_Color();
+        } else if (name == "metadata") {
+            ParseNode_Metadata();
+        }
+    }
+    ParseHelper_Node_Exit();
 }
 
 // <texture
@@ -157,60 +149,57 @@ void AMFImporter::ParseNode_Material(XmlNode &node) {
 // then layer by layer.
 // Multi elements - Yes.
 // Parent element - <amf>.
-void AMFImporter::ParseNode_Texture(XmlNode &node) {
-    std::string id = node.attribute("id").as_string();
-	uint32_t width = node.attribute("width").as_uint();
-	uint32_t height = node.attribute("height").as_uint();
-	uint32_t depth = node.attribute("depth").as_uint();
-	std::string type = node.attribute("type").as_string();
-	bool tiled = node.attribute("tiled").as_bool();
-
-	// create new texture object.
-    AMFNodeElementBase *ne = new AMFTexture(mNodeElement_Cur);
-
-	AMFTexture& als = *((AMFTexture*)ne);// alias for convenience
-
-    if (node.empty()) {
-		return;
-    }
-
-    std::string enc64_data = node.value();
-	// Check for child nodes
-
-	// check that all components was defined
+void AMFImporter::ParseNode_Texture() {
+    const std::string id = XML_ReadAttribute("id");
+    const uint32_t width = static_cast<uint32_t>(std::strtoul(XML_ReadAttribute("width").c_str(), nullptr, 10));
+    const uint32_t height = static_cast<uint32_t>(std::strtoul(XML_ReadAttribute("height").c_str(), nullptr, 10));
+    const uint32_t depth = static_cast<uint32_t>(std::strtoul(XML_ReadAttribute("depth").c_str(), nullptr, 10));
+    const std::string type = XML_ReadAttribute("type");
+    const std::string tiledValue = XML_ReadAttribute("tiled");
+    const bool tiled = !tiledValue.empty() && strchr("1tTyY", tiledValue[0]) != nullptr;
+
+    std::string enc64_data;
+    mReader->readElementText(enc64_data);
+
+    // check that all components was defined
     if (id.empty()) {
-		throw DeadlyImportError("ID for texture must be defined.");
+        throw DeadlyImportError("ID for texture must be defined.");
     }
     if (width < 1) {
-		throw DeadlyImportError("INvalid width for texture.");
+        throw DeadlyImportError("INvalid width for texture.");
     }
     if (height < 1) {
-		throw DeadlyImportError("Invalid height for texture.");
-	}
+        throw DeadlyImportError("Invalid height for texture.");
+    }
     if (depth < 1) {
-		throw DeadlyImportError("Invalid depth for texture.");
+        throw DeadlyImportError("Invalid depth for texture.");
     }
     if (type != "grayscale") {
-		throw DeadlyImportError("Invalid type for texture.");
+        throw DeadlyImportError("Invalid type for texture.");
     }
     if (enc64_data.empty()) {
         throw DeadlyImportError("Texture data not defined.");
     }
-	// copy data
-	als.ID = id;
-	als.Width = width;
-	als.Height = height;
-	als.Depth = depth;
-	als.Tiled = tiled;
-	ParseHelper_Decode_Base64(enc64_data, als.Data);
+
+    // create new texture object.
+    AMFNodeElementBase *ne = new AMFTexture(mNodeElement_Cur);
+    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
+    AMFTexture &als = *((AMFTexture *)ne); // alias for convenience
+
+    // copy data
+    als.ID = id;
+    als.Width = width;
+    als.Height = height;
+    als.Depth = depth;
+    als.Tiled = tiled;
+    ParseHelper_Decode_Base64(enc64_data, als.Data);
 
     // check data size
     if ((width * height * depth) != als.Data.size()) {
         throw DeadlyImportError("Texture has incorrect data size.");
     }
 
-	mNodeElement_Cur->Child.push_back(ne);// Add element to child list of current element
-	mNodeElement_List.push_back(ne);// and to node element list because its a new object in graph.
+    mNodeElement_Cur->Child.push_back(ne); // Add element to child list of current element
 }
 
 // <texmap
@@ -227,102 +216,54 @@ void AMFImporter::ParseNode_Texture(XmlNode &node) {
 //   <utex1>, <utex2>, <utex3>, <vtex1>, <vtex2>, <vtex3>. Old name: <u1>, <u2>, <u3>, <v1>, <v2>, <v3>.
 //   Multi elements - No.
 //   Texture coordinates for every vertex of triangle.
-void AMFImporter::ParseNode_TexMap(XmlNode &node, const bool pUseOldName) {
-	// Read attributes for node <color>.
+void AMFImporter::ParseNode_TexMap(const bool pUseOldName) {
+    // Read attributes for node <texmap>.
     AMFNodeElementBase *ne = new AMFTexMap(mNodeElement_Cur);
-    AMFTexMap &als = *((AMFTexMap *)ne); //
-    std::string rtexid, gtexid, btexid, atexid;
-    if (!node.empty()) {
-        ParseHelper_Node_Enter(ne);
-        for (XmlNode &currentNode : node.children()) {
-            const std::string &currentName = currentNode.name();
-            if (currentName == "rtexid") {
-                XmlParser::getValueAsString(node, rtexid);
-            } else if (currentName == "gtexid") {
-                XmlParser::getValueAsString(node, gtexid);
-            } else if (currentName == "btexid") {
-                XmlParser::getValueAsString(node, btexid);
-            } else if (currentName == "atexid") {
-                XmlParser::getValueAsString(node, atexid);
+    mNodeElement_List.push_back(ne); // and to node element list because its a new object in graph.
+    AMFTexMap &als = *((AMFTexMap *)ne); // alias for convenience
+    const std::string rtexid = XML_ReadAttribute("rtexid");
+    const std::string gtexid = XML_ReadAttribute("gtexid");
+    const std::string btexid = XML_ReadAttribute("btexid");
+    const std::string atexid = XML_ReadAttribute("atexid");
+
+    // check data
+    if (rtexid.empty() && gtexid.empty() && btexid.empty()) {
+        throw DeadlyImportError("ParseNode_TexMap. At least one texture ID must be defined.");
+    }
+
+    // read children nodes
+    static const char *const names[2][6] = {
+        { "utex1", "utex2", "utex3", "vtex1", "vtex2", "vtex3" },
+        { "u1", "u2", "u3", "v1", "v2", "v3" }
+    };
+    const char *const *coordNames = names[pUseOldName ? 1 : 0];
+    bool read_flag[6] = { false, false, false, false, false, false };
+
+    ParseHelper_Node_Enter(ne);
+    const size_t depth = mReader->getDepth();
+    while (mReader->nextChild(depth)) {
+        const std::string &name = mReader->getName();
+        for (size_t i = 0; i < 6; ++i) {
+            if (name == coordNames[i]) {
+                read_flag[i] = true;
+                ai_real &value = i < 3 ? als.TextureCoordinate[i].x : als.TextureCoordinate[i - 3].y;
+                value = XML_ReadNode_GetVal_AsFloat();
+                break;
             }
         }
-        ParseHelper_Node_Exit();
+    }
+    ParseHelper_Node_Exit();
+
+    // check that all components was defined
+    if (!(read_flag[0] && read_flag[1] && read_flag[2] && read_flag[3] && read_flag[4] && read_flag[5])) {
+        throw DeadlyImportError("Not all texture coordinates are defined.");
     }
 
-	// create new texture coordinates object, alias for convenience
-	// check data
-	if (rtexid.empty() && gtexid.empty() && btexid.empty()) {
-		throw DeadlyImportError("ParseNode_TexMap. At least one texture ID must be defined.");
-	}
-
-	// Check for children nodes
-	//XML_CheckNode_MustHaveChildren();
-	if (node.children().begin() == node.children().end()) {
-		throw DeadlyImportError("Invalid children definition.");
-	}
-	// read children nodes
-	bool read_flag[6] = { false, false, false, false, false, false };
-
-	if (!pUseOldName) {
-		for (pugi::xml_attribute &attr : node.attributes()) {
-            const std::string name = attr.name();
-            if (name == "utex1") {
-				read_flag[0] = true;
-				als.TextureCoordinate[0].x = attr.as_float();
-            } else if (name == "utex2") {
-				read_flag[1] = true;
-				als.TextureCoordinate[1].x = attr.as_float();
-            } else if (name == "utex3") {
-				read_flag[2] = true;
-				als.TextureCoordinate[2].x = attr.as_float();
-            } else if (name == "vtex1") {
-				read_flag[3] = true;
-				als.TextureCoordinate[0].y = attr.as_float();
-            } else if (name == "vtex2") {
-				read_flag[4] = true;
-				als.TextureCoordinate[1].y = attr.as_float();
-            } else if (name == "vtex3") {
-				read_flag[5] = true;
-				als.TextureCoordinate[0].y = attr.as_float();
-			}
-		}
-	} else {
-		for (pugi::xml_attribute &attr : node.attributes()) {
-            const std::string name = attr.name();
-            if (name == "u") {
-				read_flag[0] = true;
-				als.TextureCoordinate[0].x = attr.as_float();
-            } else if (name == "u2") {
-				read_flag[1] = true;
-				als.TextureCoordinate[1].x = attr.as_float();
-            } else if (name == "u3") {
-				read_flag[2] = true;
-				als.TextureCoordinate[2].x = attr.as_float();
-            } else if (name == "v1") {
-				read_flag[3] = true;
-				als.TextureCoordinate[0].y = attr.as_float();
-            } else if (name == "v2") {
-				read_flag[4] = true;
-				als.TextureCoordinate[1].y = attr.as_float();
-            } else if (name == "v3") {
-				read_flag[5] = true;
-				als.TextureCoordinate[0].y = attr.as_float();
-			}
-		}
-	}
-
-	// check that all components was defined
-	if (!(read_flag[0] && read_flag[1] && read_flag[2] && read_flag[3] && read_flag[4] && read_flag[5])) {
-		throw DeadlyImportError("Not all texture coordinates are defined.");
-	}
-
-	// copy attributes data
-	als.TextureID_R = rtexid;
-	als.TextureID_G = gtexid;
-	als.TextureID_B = btexid;
-	als.TextureID_A = atexid;
-
-	mNodeElement_List.push_back(ne);
+    // copy attributes data
+    als.TextureID_R = rtexid;
+    als.TextureID_G = gtexid;
+    als.TextureID_B = btexid;
+    als.TextureID_A = atexid;
 }
 
 }// namespace Assimp
@@ -142,6 +142,7 @@ namespace Blender {
         ConversionData(const FileDatabase& db)
             : sentinel_cnt()
             , next_texture()
+            , numThreads(-1)
             , db(db)
         {}
 
@@ -170,6 +171,9 @@ namespace Blender {
         // next texture ID for each texture type, respectively
         unsigned int next_texture[aiTextureType_UNKNOWN+1];
 
+        // AI_CONFIG_GLOB_MULTITHREADING, for modifiers that evaluate in parallel
+        int numThreads;
+
         // original file data
         const FileDatabase& db;
     };
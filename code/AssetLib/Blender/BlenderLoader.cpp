@@ -55,12 +55,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "BlenderIntermediate.h"
 #include "BlenderModifier.h"
 #include <assimp/StringUtils.h>
+#include <assimp/config.h>
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
 
 #include <assimp/MemoryIOWrapper.h>
 #include <assimp/StreamReader.h>
 #include <assimp/StringComparison.h>
+#include <assimp/Importer.hpp>
 
 #include <cctype>
 
@@ -101,7 +103,8 @@ static const aiImporterDesc blenderDesc = {
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 BlenderImporter::BlenderImporter() :
-        modifier_cache(new BlenderModifierShowcase()) {
+        modifier_cache(new BlenderModifierShowcase()),
+        configNumThreads(-1) {
     // empty
 }
 
@@ -143,8 +146,8 @@ const aiImporterDesc *BlenderImporter::GetInfo() const {
 
 // ------------------------------------------------------------------------------------------------
 // Setup configuration properties for the loader
-void BlenderImporter::SetupProperties(const Importer * /*pImp*/) {
-    // nothing to be done for the moment
+void BlenderImporter::SetupProperties(const Importer *pImp) {
+    configNumThreads = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -324,6 +327,7 @@ void BlenderImporter::ExtractScene(Scene &out, const FileDatabase &file) {
 // ------------------------------------------------------------------------------------------------
 void BlenderImporter::ConvertBlendFile(aiScene *out, const Scene &in, const FileDatabase &file) {
     ConversionData conv(file);
+    conv.numThreads = configNumThreads;
 
     // FIXME it must be possible to take the hierarchy directly from
     // the file. This is terrible. Here, we're first looking for
@@ -201,6 +201,9 @@ private:
 
     Blender::BlenderModifierShowcase* modifier_cache;
 
+    // Configuration option: AI_CONFIG_GLOB_MULTITHREADING
+    int configNumThreads;
+
 }; // !class BlenderImporter
 
 } // end of namespace Assimp
@@ -281,7 +281,7 @@ void BlenderModifier_Subdivision ::DoIt(aiNode &out, ConversionData &conv_data,
         return;
     };
 
-    std::unique_ptr<Subdivider> subd(Subdivider::Create(algo));
+    std::unique_ptr<Subdivider> subd(Subdivider::Create(algo, conv_data.numThreads));
     ai_assert(subd);
     if (conv_data.meshes->empty()) {
         return;
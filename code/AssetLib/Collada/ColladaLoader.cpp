@@ -178,7 +178,7 @@ void ColladaLoader::InternReadFile(const std::string &pFile, aiScene *pScene, IO
     mAnims.clear();
 
     // parse the input file
-    ColladaParser parser(pIOHandler, pFile);
+    ColladaParser parser(pIOHandler, pFile, &m_checkpoint);
 
     if (!parser.mRootNode) {
         throw DeadlyImportError("Collada: File came out empty. Something is wrong here.");
@@ -468,6 +468,7 @@ void ColladaLoader::BuildMeshesForNode(const ColladaParser &pParser, const Colla
 
     // add a mesh for each subgroup in each collada mesh
     for (const Collada::MeshInstance &mid : pNode->mMeshes) {
+        m_checkpoint.Check();
         const Collada::Mesh *srcMesh = nullptr;
         const Collada::Controller *srcController = nullptr;
 
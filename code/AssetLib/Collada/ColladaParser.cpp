@@ -46,6 +46,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ASSIMP_BUILD_NO_COLLADA_IMPORTER
 
 #include "ColladaParser.h"
+#include <assimp/Cancellation.h>
 #include <assimp/ParsingUtils.h>
 #include <assimp/StringUtils.h>
 #include <assimp/ZipArchiveIOSystem.h>
@@ -85,6 +86,10 @@ static bool FindCommonKey(const std::string &collada_key, const MetaKeyPairVecto
     return false;
 }
 
+// Collada needs neither comments, processing instructions nor the doctype. Line ends are not
+// normalized, the number lists are read with helpers which accept any line end.
+static const unsigned int ColladaXmlParseOptions = pugi::parse_cdata | pugi::parse_escapes;
+
 static void readUrlAttribute(XmlNode &node, std::string &url) {
     url.clear();
     if (!XmlParser::getStdStrAttribute(node, "url", url)) {
@@ -98,7 +103,7 @@ static void readUrlAttribute(XmlNode &node, std::string &url) {
 
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
-ColladaParser::ColladaParser(IOSystem *pIOHandler, const std::string &pFile) :
+ColladaParser::ColladaParser(IOSystem *pIOHandler, const std::string &pFile, ImportCheckpoint *checkpoint) :
         mFileName(pFile),
         mXmlParser(),
         mDataLibrary(),
@@ -115,7 +120,8 @@ ColladaParser::ColladaParser(IOSystem *pIOHandler, const std::string &pFile) :
         mAnims(),
         mUnitSize(1.0f),
         mUpDirection(UP_Y),
-        mFormat(FV_1_5_n) {
+        mFormat(FV_1_5_n),
+        mCheckpoint(checkpoint) {
     if (nullptr == pIOHandler) {
         throw DeadlyImportError("IOSystem is nullptr.");
     }
@@ -149,7 +155,7 @@ ColladaParser::ColladaParser(IOSystem *pIOHandler, const std::string &pFile) :
     }
 
     // generate a XML reader for it
-    if (!mXmlParser.parse(daefile.get())) {
+    if (!mXmlParser.parse(daefile.get(), ColladaXmlParseOptions)) {
         throw DeadlyImportError("Unable to read file, malformed XML");
     }
     // start reading
@@ -194,7 +200,7 @@ std::string ColladaParser::ReadZaeManifest(ZipArchiveIOSystem &zip_archive) {
         return file_list.front();
     }
     XmlParser manifestParser;
-    if (!manifestParser.parse(manifestfile.get())) {
+    if (!manifestParser.parse(manifestfile.get(), ColladaXmlParseOptions)) {
         return std::string();
     }
 
@@ -639,9 +645,8 @@ void ColladaParser::ReadController(XmlNode &node, Collada::Controller &pControll
         } else if (currentName == "skin") {
             pController.mMeshId = currentNode.attribute("source").as_string();
         } else if (currentName == "bind_shape_matrix") {
-            std::string v;
-            XmlParser::getValueAsString(currentNode, v);
-            const char *content = v.c_str();
+            const char *content = nullptr;
+            XmlParser::getValueAsCString(currentNode, content);
             for (unsigned int a = 0; a < 16; a++) {
                 // read a number
                 content = fast_atoreal_move<ai_real>(content, pController.mBindShapeMatrix[a]);
@@ -741,9 +746,8 @@ void ColladaParser::ReadControllerWeights(XmlNode &node, Collada::Controller &pC
             pController.mWeights.resize(numWeights);
         } else if (currentName == "v" && vertexCount > 0) {
             // read JointIndex - WeightIndex pairs
-            std::string stdText;
-            XmlParser::getValueAsString(currentNode, stdText);
-            const char *text = stdText.c_str();
+            const char *text = nullptr;
+            XmlParser::getValueAsCString(currentNode, text);
             for (std::vector<std::pair<size_t, size_t>>::iterator it = pController.mWeights.begin(); it != pController.mWeights.end(); ++it) {
                 if (text == 0) {
                     throw DeadlyImportError("Out of data while reading <vertex_weights>");
@@ -948,9 +952,8 @@ void ColladaParser::ReadLight(XmlNode &node, Collada::Light &pLight) {
             pLight.mType = aiLightSource_POINT;
         } else if (currentName == "color") {
             // text content contains 3 floats
-            std::string v;
-            XmlParser::getValueAsString(currentNode, v);
-            const char *content = v.c_str();
+            const char *content = nullptr;
+            XmlParser::getValueAsCString(currentNode, content);
 
             content = fast_atoreal_move<ai_real>(content, (ai_real &)pLight.mColor.r);
             SkipSpacesAndLineEnd(&content);
@@ -1176,9 +1179,8 @@ void ColladaParser::ReadSamplerProperties(XmlNode &node, Sampler &out) {
         } else if (currentName == "rotateUV") {
             XmlParser::getFloatAttribute(currentNode, currentName.c_str(), out.mTransform.mRotation);
         } else if (currentName == "blend_mode") {
-            std::string v;
-            XmlParser::getValueAsString(currentNode, v);
-            const char *sz = v.c_str();
+            const char *sz = nullptr;
+            XmlParser::getValueAsCString(currentNode, sz);
             // http://www.feelingsoftware.com/content/view/55/72/lang,en/
             // NONE, OVER, IN, OUT, ADD, SUBTRACT, MULTIPLY, DIFFERENCE, LIGHTEN, DARKEN, SATURATE, DESATURATE and ILLUMINATE
             if (0 == ASSIMP_strincmp(sz, "ADD", 3))
@@ -1220,9 +1222,8 @@ void ColladaParser::ReadEffectColor(XmlNode &node, aiColor4D &pColor, Sampler &p
         const std::string &currentName = currentNode.name();
         if (currentName == "color") {
             // text content contains 4 floats
-            std::string v;
-            XmlParser::getValueAsString(currentNode, v);
-            const char *content = v.c_str();
+            const char *content = nullptr;
+            XmlParser::getValueAsCString(currentNode, content);
 
             content = fast_atoreal_move<ai_real>(content, (ai_real &)pColor.r);
             SkipSpacesAndLineEnd(&content);
@@ -1321,6 +1322,9 @@ void ColladaParser::ReadGeometryLibrary(XmlNode &node) {
         return;
     }
     for (XmlNode &currentNode : node.children()) {
+        if (mCheckpoint) {
+            mCheckpoint->Check();
+        }
         const std::string &currentName = currentNode.name();
         if (currentName == "geometry") {
             // read ID. Another entry which is "optional" by design but obligatory in reality
@@ -1417,10 +1421,9 @@ void ColladaParser::ReadDataArray(XmlNode &node) {
     XmlParser::getStdStrAttribute(node, "id", id);
     unsigned int count = 0;
     XmlParser::getUIntAttribute(node, "count", count);
-    std::string v;
-    XmlParser::getValueAsString(node, v);
-    trim(v);
-    const char *content = v.c_str();
+    const char *content = nullptr;
+    XmlParser::getValueAsCString(node, content);
+    SkipSpacesAndLineEnd(&content);
 
     // read values and store inside an array in the data library
     mDataLibrary[id] = Data();
@@ -1434,6 +1437,9 @@ void ColladaParser::ReadDataArray(XmlNode &node) {
             std::string s;
 
             for (unsigned int a = 0; a < count; a++) {
+                if (mCheckpoint) {
+                    mCheckpoint->Check();
+                }
                 if (*content == 0) {
                     throw DeadlyImportError("Expected more values while reading IDREF_array contents.");
                 }
@@ -1449,6 +1455,9 @@ void ColladaParser::ReadDataArray(XmlNode &node) {
             data.mValues.reserve(count);
 
             for (unsigned int a = 0; a < count; a++) {
+                if (mCheckpoint) {
+                    mCheckpoint->Check();
+                }
                 if (*content == 0) {
                     throw DeadlyImportError("Expected more values while reading float_array contents.");
                 }
@@ -1624,9 +1633,8 @@ void ColladaParser::ReadIndexData(XmlNode &node, Mesh &pMesh) {
                 if (numPrimitives) // It is possible to define a mesh without any primitives
                 {
                     // case <polylist> - specifies the number of indices for each polygon
-                    std::string v;
-                    XmlParser::getValueAsString(currentNode, v);
-                    const char *content = v.c_str();
+                    const char *content = nullptr;
+                    XmlParser::getValueAsCString(currentNode, content);
                     vcount.reserve(numPrimitives);
                     for (unsigned int a = 0; a < numPrimitives; a++) {
                         if (*content == 0) {
@@ -1743,10 +1751,12 @@ size_t ColladaParser::ReadPrimitives(XmlNode &node, Mesh &pMesh, std::vector<Inp
 
     if (pNumPrimitives > 0) // It is possible to not contain any indices
     {
-        std::string v;
-        XmlParser::getValueAsString(node, v);
-        const char *content = v.c_str();
+        const char *content = nullptr;
+        XmlParser::getValueAsCString(node, content);
         while (*content != 0) {
+            if (mCheckpoint) {
+                mCheckpoint->Check();
+            }
             // read a value.
             // Hack: (thom) Some exporters put negative indices sometimes. We just try to carry on anyways.
             int value = std::max(0, strtol10(content, &content));
@@ -2049,6 +2059,9 @@ void ColladaParser::ReadSceneNode(XmlNode &node, Node *pNode) {
     }
 
     for (XmlNode &currentNode : node.children()) {
+        if (mCheckpoint) {
+            mCheckpoint->Check();
+        }
         const std::string &currentName = currentNode.name();
         if (currentName == "node") {
             Node *child = new Node;
@@ -2164,9 +2177,8 @@ void ColladaParser::ReadNodeTransformation(XmlNode &node, Node *pNode, Transform
 
     // how many parameters to read per transformation type
     static const unsigned int sNumParameters[] = { 9, 4, 3, 3, 7, 16 };
-    std::string value;
-    XmlParser::getValueAsString(node, value);
-    const char *content = value.c_str();
+    const char *content = nullptr;
+    XmlParser::getValueAsCString(node, content);
 
     // read as many parameters and store in the transformation
     for (unsigned int a = 0; a < sNumParameters[pType]; a++) {
@@ -56,6 +56,7 @@
 namespace Assimp {
 
 class ZipArchiveIOSystem;
+class ImportCheckpoint;
 
 // ------------------------------------------------------------------------------------------
 /** Parser helper class for the Collada loader.
@@ -73,8 +74,9 @@ protected:
     /** Map for generic metadata as aiString */
     typedef std::map<std::string, aiString> StringMetaData;
 
-    /** Constructor from XML file */
-    ColladaParser(IOSystem *pIOHandler, const std::string &pFile);
+    /** Constructor from XML file. The checkpoint, if any, is checked in
+     *  the loops over data arrays, indices, geometries and nodes. */
+    ColladaParser(IOSystem *pIOHandler, const std::string &pFile, ImportCheckpoint *checkpoint = nullptr);
 
     /** Destructor */
     ~ColladaParser();
@@ -329,6 +331,9 @@ protected:
 
     /** Collada file format version */
     Collada::FormatVersion mFormat;
+
+    /** Honors a cancelled import, may be nullptr */
+    ImportCheckpoint *mCheckpoint;
 };
 
 // ------------------------------------------------------------------------------------------------
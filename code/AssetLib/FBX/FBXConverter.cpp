@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FBXParser.h"
 #include "FBXProperties.h"
 #include "FBXUtil.h"
+#include "Common/ParallelFor.h"
 
 #include <assimp/MathFunctions.h>
 #include <assimp/StringComparison.h>
@@ -66,6 +67,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cstdint>
 #include <iomanip>
 #include <iostream>
+#include <atomic>
 #include <iterator>
 #include <memory>
 #include <sstream>
@@ -81,7 +83,7 @@ using namespace Util;
 
 #define CONVERT_FBX_TIME(time) (static_cast<double>(time) * 1000.0 / 46186158000LL)
 
-FBXConverter::FBXConverter(aiScene *out, const Document &doc, bool removeEmptyBones) :
+FBXConverter::FBXConverter(aiScene *out, const Document &doc, bool removeEmptyBones, ImportCheckpoint *checkpoint) :
         defaultMaterialIndex(),
         mMeshes(),
         lights(),
@@ -90,12 +92,14 @@ FBXConverter::FBXConverter(aiScene *out, const Document &doc, bool removeEmptyBo
         materials_converted(),
         textures_converted(),
         meshes_converted(),
+        mMeshJobs(),
         node_anim_chain_bits(),
         mNodeNames(),
         anim_fps(),
         mSceneOut(out),
         doc(doc),
-        mRemoveEmptyBones(removeEmptyBones) {
+        mRemoveEmptyBones(removeEmptyBones),
+        mCheckpoint(checkpoint) {
     // animations need to be converted first since this will
     // populate the node_anim_chain_bits map, which is needed
     // to determine which nodes need to be generated.
@@ -108,10 +112,14 @@ FBXConverter::FBXConverter(aiScene *out, const Document &doc, bool removeEmptyBo
         ConvertOrphanedEmbeddedTextures();
     }
     ConvertRootNode();
+    ConvertMeshGeometries();
 
     if (doc.Settings().readAllMaterials) {
         // unfortunately this means we have to evaluate all objects
         for (const ObjectMap::value_type &v : doc.Objects()) {
+            if (mCheckpoint) {
+                mCheckpoint->Check();
+            }
 
             const Object *ob = v.second->Get();
             if (!ob) {
@@ -210,6 +218,10 @@ void FBXConverter::ConvertNodes(uint64_t id, aiNode *parent, aiNode *root_node)
     std::vector<PotentialNode> post_nodes_chain;
 
     for (const Connection *con : conns) {
+        if (mCheckpoint) {
+            mCheckpoint->Check();
+        }
+
         // ignore object-property links
         if (con->PropertyName().length()) {
             // really important we document why this is ignored.
@@ -1029,12 +1041,69 @@ aiMesh *FBXConverter::SetupEmptyMesh(const Geometry &mesh, aiNode *parent) {
     return out_mesh;
 }
 
+void FBXConverter::AddMeshGeometryJob(const MeshGeometry &mesh, const aiMatrix4x4 &absolute_transform, aiNode *parent,
+        aiMesh *out_mesh, bool splitByMaterial, MatIndexArray::value_type materialIndex) {
+    // all output meshes of a geometry are set up in a row, keep them in one job
+    if (mMeshJobs.empty() || mMeshJobs.back().geometry != &mesh) {
+        mMeshJobs.emplace_back();
+        MeshGeometryJob &job = mMeshJobs.back();
+        job.geometry = &mesh;
+        job.absolute_transform = absolute_transform;
+        job.parent = parent;
+        job.splitByMaterial = splitByMaterial;
+    }
+    mMeshJobs.back().outputs.emplace_back(out_mesh, materialIndex);
+}
+
+void FBXConverter::ConvertMeshGeometries() {
+    // Geometries differ a lot in size, so threads fetch jobs one at a time
+    // instead of getting a fixed share. Mesh indices and materials are already
+    // assigned, the output does not depend on the thread count.
+    const size_t numJobs = mMeshJobs.size();
+    const unsigned int numThreads = static_cast<unsigned int>(
+            std::min<size_t>(GetNumWorkerThreads(doc.Settings().numThreads), numJobs));
+    std::atomic<size_t> nextJob(0);
+    ParallelFor(numThreads, numThreads, 1, [this, &nextJob, numJobs](size_t, size_t) {
+        for (size_t i = nextJob++; i < numJobs; i = nextJob++) {
+            if (mCheckpoint) {
+                mCheckpoint->CheckCancelled();
+            }
+            ConvertMeshGeometry(mMeshJobs[i]);
+        }
+    });
+    mMeshJobs.clear();
+}
+
+void FBXConverter::ConvertMeshGeometry(const MeshGeometryJob &job) const {
+    for (const std::pair<aiMesh *, MatIndexArray::value_type> &output : job.outputs) {
+        if (job.splitByMaterial) {
+            FillMeshMultiMaterial(output.first, *job.geometry, output.second, job.parent, job.absolute_transform);
+        } else {
+            FillMeshSingleMaterial(output.first, *job.geometry, job.absolute_transform, job.parent);
+        }
+    }
+}
+
 unsigned int FBXConverter::ConvertMeshSingleMaterial(const MeshGeometry &mesh, const Model &model,
         const aiMatrix4x4 &absolute_transform, aiNode *parent,
         aiNode *) {
     const MatIndexArray &mindices = mesh.GetMaterialIndices();
     aiMesh *const out_mesh = SetupEmptyMesh(mesh, parent);
 
+    if (!doc.Settings().readMaterials || mindices.empty()) {
+        FBXImporter::LogError("no material assigned to mesh, setting default material");
+        out_mesh->mMaterialIndex = GetDefaultMaterial();
+    } else {
+        ConvertMaterialForMesh(out_mesh, model, mesh, mindices[0]);
+    }
+
+    // vertex data is copied later on, see ConvertMeshGeometries()
+    AddMeshGeometryJob(mesh, absolute_transform, parent, out_mesh, false, 0);
+    return static_cast<unsigned int>(mMeshes.size() - 1);
+}
+
+void FBXConverter::FillMeshSingleMaterial(aiMesh *out_mesh, const MeshGeometry &mesh,
+        const aiMatrix4x4 &absolute_transform, aiNode *parent) const {
     const std::vector<aiVector3D> &vertices = mesh.GetVertices();
     const std::vector<unsigned int> &faces = mesh.GetFaceIndexCounts();
 
@@ -1140,13 +1209,6 @@ unsigned int FBXConverter::ConvertMeshSingleMaterial(const MeshGeometry &mesh, c
         std::copy(colors.begin(), colors.end(), out_mesh->mColors[i]);
     }
 
-    if (!doc.Settings().readMaterials || mindices.empty()) {
-        FBXImporter::LogError("no material assigned to mesh, setting default material");
-        out_mesh->mMaterialIndex = GetDefaultMaterial();
-    } else {
-        ConvertMaterialForMesh(out_mesh, model, mesh, mindices[0]);
-    }
-
     if (doc.Settings().readWeights && mesh.DeformerSkin() != nullptr) {
         ConvertWeights(out_mesh, mesh, absolute_transform, parent, NO_MATERIAL_SEPARATION, nullptr);
     }
@@ -1191,7 +1253,6 @@ unsigned int FBXConverter::ConvertMeshSingleMaterial(const MeshGeometry &mesh, c
             out_mesh->mAnimMeshes[i] = animMeshes.at(i);
         }
     }
-    return static_cast<unsigned int>(mMeshes.size() - 1);
 }
 
 std::vector<unsigned int>
@@ -1220,7 +1281,15 @@ unsigned int FBXConverter::ConvertMeshMultiMaterial(const MeshGeometry &mesh, co
         aiNode *parent, aiNode *,
         const aiMatrix4x4 &absolute_transform) {
     aiMesh *const out_mesh = SetupEmptyMesh(mesh, parent);
+    ConvertMaterialForMesh(out_mesh, model, mesh, index);
 
+    // vertex data is copied later on, see ConvertMeshGeometries()
+    AddMeshGeometryJob(mesh, absolute_transform, parent, out_mesh, true, index);
+    return static_cast<unsigned int>(mMeshes.size() - 1);
+}
+
+void FBXConverter::FillMeshMultiMaterial(aiMesh *out_mesh, const MeshGeometry &mesh, MatIndexArray::value_type index,
+        aiNode *parent, const aiMatrix4x4 &absolute_transform) const {
     const MatIndexArray &mindices = mesh.GetMaterialIndices();
     const std::vector<aiVector3D> &vertices = mesh.GetVertices();
     const std::vector<unsigned int> &faces = mesh.GetFaceIndexCounts();
@@ -1378,8 +1447,6 @@ unsigned int FBXConverter::ConvertMeshMultiMaterial(const MeshGeometry &mesh, co
         }
     }
 
-    ConvertMaterialForMesh(out_mesh, model, mesh, index);
-
     if (process_weights) {
         ConvertWeights(out_mesh, mesh, absolute_transform, parent, index, &reverseMapping);
     }
@@ -1427,14 +1494,12 @@ unsigned int FBXConverter::ConvertMeshMultiMaterial(const MeshGeometry &mesh, co
             out_mesh->mAnimMeshes[i] = animMeshes.at(i);
         }
     }
-
-    return static_cast<unsigned int>(mMeshes.size() - 1);
 }
 
 void FBXConverter::ConvertWeights(aiMesh *out, const MeshGeometry &geo,
         const aiMatrix4x4 &absolute_transform,
         aiNode *parent, unsigned int materialIndex,
-        std::vector<unsigned int> *outputVertStartIndices) {
+        std::vector<unsigned int> *outputVertStartIndices) const {
     ai_assert(geo.DeformerSkin());
 
     std::vector<size_t> out_indices;
@@ -1445,6 +1510,10 @@ void FBXConverter::ConvertWeights(aiMesh *out, const MeshGeometry &geo,
 
     std::vector<aiBone *> bones;
 
+    // Deformer name is not the same as a bone name - it does contain the bone name though :)
+    // Deformer names in FBX are always unique in an FBX file.
+    std::map<const std::string, aiBone *> bone_map;
+
     const bool no_mat_check = materialIndex == NO_MATERIAL_SEPARATION;
     ai_assert(no_mat_check || outputVertStartIndices);
 
@@ -1503,11 +1572,9 @@ void FBXConverter::ConvertWeights(aiMesh *out, const MeshGeometry &geo,
             // if we found at least one, generate the output bones
             // XXX this could be heavily simplified by collecting the bone
             // data in a single step.
-            ConvertCluster(bones, cluster, out_indices, index_out_indices,
+            ConvertCluster(bones, bone_map, cluster, out_indices, index_out_indices,
                     count_out_indices, absolute_transform, parent);
         }
-
-        bone_map.clear();
     } catch (std::exception &) {
         std::for_each(bones.begin(), bones.end(), Util::delete_fun<aiBone>());
         throw;
@@ -1531,21 +1598,21 @@ const aiNode *GetNodeByName(aiNode *current_node) {
     return iter;
 }
 
-void FBXConverter::ConvertCluster(std::vector<aiBone *> &local_mesh_bones, const Cluster *cl,
+void FBXConverter::ConvertCluster(std::vector<aiBone *> &local_mesh_bones,
+        std::map<const std::string, aiBone *> &bone_map, const Cluster *cl,
         std::vector<size_t> &out_indices, std::vector<size_t> &index_out_indices,
         std::vector<size_t> &count_out_indices, const aiMatrix4x4 &absolute_transform,
-        aiNode *) {
+        aiNode *) const {
     ai_assert(cl); // make sure cluster valid
     std::string deformer_name = cl->TargetNode()->Name();
     aiString bone_name = aiString(FixNodeName(deformer_name));
 
     aiBone *bone = nullptr;
 
+    // no logging here, this runs on the mesh conversion threads
     if (bone_map.count(deformer_name)) {
-        ASSIMP_LOG_VERBOSE_DEBUG_F("retrieved bone from lookup ", bone_name.C_Str(), ". Deformer:", deformer_name);
         bone = bone_map[deformer_name];
     } else {
-        ASSIMP_LOG_VERBOSE_DEBUG_F("created new bone ", bone_name.C_Str(), ". Deformer: ", deformer_name);
         bone = new aiBone();
         bone->mName = bone_name;
 
@@ -1591,8 +1658,6 @@ void FBXConverter::ConvertCluster(std::vector<aiBone *> &local_mesh_bones, const
         bone_map.insert(std::pair<const std::string, aiBone *>(deformer_name, bone));
     }
 
-    ASSIMP_LOG_DEBUG_F("bone research: Indicies size: ", out_indices.size());
-
     // lookup must be populated in case something goes wrong
     // this also allocates bones to mesh instance outside
     local_mesh_bones.push_back(bone);
@@ -2422,11 +2487,14 @@ void FBXConverter::ConvertAnimations() {
 
     const std::vector<const AnimationStack *> &curAnimations = doc.AnimationStacks();
     for (const AnimationStack *stack : curAnimations) {
+        if (mCheckpoint) {
+            mCheckpoint->Check();
+        }
         ConvertAnimationStack(*stack);
     }
 }
 
-std::string FBXConverter::FixNodeName(const std::string &name) {
+std::string FBXConverter::FixNodeName(const std::string &name) const {
     // strip Model:: prefix, avoiding ambiguities (i.e. don't strip if
     // this causes ambiguities, well possible between empty identifiers,
     // such as "Model::" and ""). Make sure the behaviour is consistent
@@ -2439,7 +2507,7 @@ std::string FBXConverter::FixNodeName(const std::string &name) {
     return name;
 }
 
-std::string FBXConverter::FixAnimMeshName(const std::string &name) {
+std::string FBXConverter::FixAnimMeshName(const std::string &name) const {
     if (name.length()) {
         size_t indexOf = name.find_first_of("::");
         if (indexOf != std::string::npos && indexOf < name.size() - 2) {
@@ -3531,8 +3599,8 @@ void FBXConverter::ConvertOrphanedEmbeddedTextures() {
 }
 
 // ------------------------------------------------------------------------------------------------
-void ConvertToAssimpScene(aiScene *out, const Document &doc, bool removeEmptyBones) {
-    FBXConverter converter(out, doc, removeEmptyBones);
+void ConvertToAssimpScene(aiScene *out, const Document &doc, bool removeEmptyBones, ImportCheckpoint *checkpoint) {
+    FBXConverter converter(out, doc, removeEmptyBones, checkpoint);
 }
 
 } // namespace FBX
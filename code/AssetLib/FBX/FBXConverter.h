@@ -59,6 +59,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/texture.h>
 #include <assimp/camera.h>
 #include <assimp/StringComparison.h>
+#include <assimp/Cancellation.h>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -81,8 +82,10 @@ class Document;
  *  @param out Empty scene to be populated
  *  @param doc Parsed FBX document
  *  @param removeEmptyBones Will remove bones, which do not have any references to vertices.
+ *  @param checkpoint Cancellation point of the import, may be nullptr.
  */
-void ConvertToAssimpScene(aiScene* out, const Document& doc, bool removeEmptyBones);
+void ConvertToAssimpScene(aiScene* out, const Document& doc, bool removeEmptyBones,
+        ImportCheckpoint *checkpoint = nullptr);
 
 /** Dummy class to encapsulate the conversion process */
 class FBXConverter {
@@ -113,7 +116,7 @@ public:
     };
 
 public:
-    FBXConverter(aiScene* out, const Document& doc, bool removeEmptyBones);
+    FBXConverter(aiScene* out, const Document& doc, bool removeEmptyBones, ImportCheckpoint *checkpoint = nullptr);
     ~FBXConverter();
 
 private:
@@ -209,6 +212,37 @@ private:
     unsigned int ConvertMeshMultiMaterial(const MeshGeometry &mesh, const Model &model, MatIndexArray::value_type index,
                                           aiNode *parent, aiNode *root_node, const aiMatrix4x4 &absolute_transform);
 
+    // ------------------------------------------------------------------------------------------------
+    // Vertex data, weights and blend shapes of one MeshGeometry. Mesh indices and materials are
+    // assigned while walking the node graph, the remaining work is independent per geometry
+    // and deferred to ConvertMeshGeometries().
+    struct MeshGeometryJob {
+        const MeshGeometry *geometry;
+        aiMatrix4x4 absolute_transform;
+        aiNode *parent;
+        bool splitByMaterial;
+        std::vector<std::pair<aiMesh *, MatIndexArray::value_type>> outputs;
+    };
+
+    // ------------------------------------------------------------------------------------------------
+    void AddMeshGeometryJob(const MeshGeometry &mesh, const aiMatrix4x4 &absolute_transform, aiNode *parent,
+                            aiMesh *out_mesh, bool splitByMaterial, MatIndexArray::value_type materialIndex);
+
+    // ------------------------------------------------------------------------------------------------
+    // runs all pending MeshGeometryJobs, on several threads if AI_CONFIG_GLOB_MULTITHREADING allows
+    void ConvertMeshGeometries();
+
+    // ------------------------------------------------------------------------------------------------
+    void ConvertMeshGeometry(const MeshGeometryJob &job) const;
+
+    // ------------------------------------------------------------------------------------------------
+    void FillMeshSingleMaterial(aiMesh *out_mesh, const MeshGeometry &mesh,
+                                const aiMatrix4x4 &absolute_transform, aiNode *parent) const;
+
+    // ------------------------------------------------------------------------------------------------
+    void FillMeshMultiMaterial(aiMesh *out_mesh, const MeshGeometry &mesh, MatIndexArray::value_type index,
+                               aiNode *parent, const aiMatrix4x4 &absolute_transform) const;
+
     // ------------------------------------------------------------------------------------------------
     static const unsigned int NO_MATERIAL_SEPARATION = /* std::numeric_limits<unsigned int>::max() */
         static_cast<unsigned int>(-1);
@@ -222,13 +256,14 @@ private:
     */
     void ConvertWeights(aiMesh *out, const MeshGeometry &geo, const aiMatrix4x4 &absolute_transform,
             aiNode *parent = nullptr, unsigned int materialIndex = NO_MATERIAL_SEPARATION,
-            std::vector<unsigned int> *outputVertStartIndices = nullptr);
+            std::vector<unsigned int> *outputVertStartIndices = nullptr) const;
 
     // ------------------------------------------------------------------------------------------------
-    void ConvertCluster(std::vector<aiBone *> &local_mesh_bones, const Cluster *cl,
+    void ConvertCluster(std::vector<aiBone *> &local_mesh_bones,
+                        std::map<const std::string, aiBone *> &bone_map, const Cluster *cl,
                         std::vector<size_t> &out_indices, std::vector<size_t> &index_out_indices,
                         std::vector<size_t> &count_out_indices, const aiMatrix4x4 &absolute_transform,
-                        aiNode *parent );
+                        aiNode *parent ) const;
 
     // ------------------------------------------------------------------------------------------------
     void ConvertMaterialForMesh(aiMesh* out, const Model& model, const MeshGeometry& geo,
@@ -289,8 +324,8 @@ private:
     // takes a fbx node name and returns the identifier to be used in the assimp output scene.
     // the function is guaranteed to provide consistent results over multiple invocations
     // UNLESS RenameNode() is called for a particular node name.
-    std::string FixNodeName(const std::string& name);
-    std::string FixAnimMeshName(const std::string& name);
+    std::string FixNodeName(const std::string& name) const;
+    std::string FixAnimMeshName(const std::string& name) const;
 
     typedef std::map<const AnimationCurveNode*, const AnimationLayer*> LayerMap;
 
@@ -435,6 +470,9 @@ private:
     using MeshMap = std::fbx_unordered_map<const Geometry*, std::vector<unsigned int> >;
     MeshMap meshes_converted;
 
+    // geometry conversions collected while walking the node graph
+    std::vector<MeshGeometryJob> mMeshJobs;
+
     // fixed node name -> which trafo chain components have animations?
     using NodeAnimBitMap = std::fbx_unordered_map<std::string, unsigned int> ;
     NodeAnimBitMap node_anim_chain_bits;
@@ -443,15 +481,12 @@ private:
     using NodeNameCache = std::fbx_unordered_map<std::string, unsigned int>;
     NodeNameCache mNodeNames;
 
-    // Deformer name is not the same as a bone name - it does contain the bone name though :)
-    // Deformer names in FBX are always unique in an FBX file.
-    std::map<const std::string, aiBone *> bone_map;
-
     double anim_fps;
 
     aiScene* const mSceneOut;
     const FBX::Document& doc;
     bool mRemoveEmptyBones;
+    ImportCheckpoint *mCheckpoint;
     static void BuildBoneList(aiNode *current_node, const aiNode *root_node, const aiScene *scene,
                              std::vector<aiBone*>& bones);
 
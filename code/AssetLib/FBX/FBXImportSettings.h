@@ -64,7 +64,8 @@ struct ImportSettings {
             optimizeEmptyAnimationCurves(true),
             useLegacyEmbeddedTextureNaming(false),
             removeEmptyBones(true),
-            convertToMeters(false) {
+            convertToMeters(false),
+            numThreads(-1) {
         // empty
     }
 
@@ -150,6 +151,11 @@ struct ImportSettings {
     /** Set to true to perform a conversion from cm to meter after the import
     */
     bool convertToMeters;
+
+    /** Number of threads used to convert the mesh geometry, see
+     *  AI_CONFIG_GLOB_MULTITHREADING. The default value is -1.
+     */
+    int numThreads;
 };
 
 } // namespace FBX
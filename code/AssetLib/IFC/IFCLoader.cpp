@@ -267,13 +267,13 @@ void IFCImporter::InternReadFile(const std::string &pFile, aiScene *pScene, IOSy
     };
 
     // feed the IFC schema into the reader and pre-parse all lines
-    STEP::ReadFile(*db, schema, types_to_track, inverse_indices_to_track);
+    STEP::ReadFile(*db, schema, types_to_track, inverse_indices_to_track, &m_checkpoint);
     const STEP::LazyObject *proj = db->GetObject("ifcproject");
     if (!proj) {
         ThrowException("missing IfcProject entity");
     }
 
-    ConversionData conv(*db, proj->To<Schema_2x3::IfcProject>(), pScene, settings);
+    ConversionData conv(*db, proj->To<Schema_2x3::IfcProject>(), pScene, settings, &m_checkpoint);
     SetUnits(conv);
     SetCoordinateSpace(conv);
     ProcessSpatialStructures(conv);
@@ -635,6 +635,9 @@ void ProcessMetadata(uint64_t relDefinesByPropertiesID, ConversionData &conv, Me
 // ------------------------------------------------------------------------------------------------
 aiNode *ProcessSpatialStructure(aiNode *parent, const Schema_2x3::IfcProduct &el, ConversionData &conv,
         std::vector<TempOpening> *collect_openings = nullptr) {
+    if (conv.checkpoint) {
+        conv.checkpoint->Check();
+    }
     const STEP::DB::RefMap &refs = conv.db.GetRefs();
 
     // skip over space and annotation nodes - usually, these have no meaning in Assimp's context
@@ -172,13 +172,15 @@ struct TempOpening
 // ------------------------------------------------------------------------------------------------
 struct ConversionData
 {
-    ConversionData(const STEP::DB& db, const IFC::Schema_2x3::IfcProject& proj, aiScene* out,const IFCImporter::Settings& settings)
+    ConversionData(const STEP::DB& db, const IFC::Schema_2x3::IfcProject& proj, aiScene* out,const IFCImporter::Settings& settings,
+            ImportCheckpoint* checkpoint = nullptr)
         : len_scale(1.0)
         , angle_scale(-1.0)
         , db(db)
         , proj(proj)
         , out(out)
         , settings(settings)
+        , checkpoint(checkpoint)
         , apply_openings()
         , collect_openings()
     {}
@@ -214,6 +216,9 @@ struct ConversionData
 
     const IFCImporter::Settings& settings;
 
+    // Cancellation point of the import, checked once per product. May be nullptr.
+    ImportCheckpoint* checkpoint;
+
     // Intermediate arrays used to resolve openings in walls: only one of them
     // can be given at a time. apply_openings if present if the current element
     // is a wall and needs its openings to be poured into its geometry while
@@ -347,13 +347,17 @@ void ObjExporter::AddMesh(const aiString& name, const aiMesh* m, const aiMatrix4
     mesh.name = std::string( name.data, name.length );//mesh名
     mesh.matname = GetMaterialName(m->mMaterialIndex);//mesh的材质名称
 
-    mesh.faces.resize(m->mNumFaces);//设置mesh面数量
+    // point clouds have no faces, each vertex is written as a point of its own
+    const bool pointCloud = m->IsPointCloud();
+    const unsigned int numFaces = pointCloud ? m->mNumVertices : m->mNumFaces;
+    mesh.faces.resize(numFaces);//设置mesh面数量
 
-    for(unsigned int i = 0; i < m->mNumFaces; ++i) {//mesh中逐个面处理，赋值面到mesh中
-        const aiFace& f = m->mFaces[i];//assimp中定义的aiFace
+    for(unsigned int i = 0; i < numFaces; ++i) {//mesh中逐个面处理，赋值面到mesh中
+        const unsigned int numIndices = pointCloud ? 1u : m->mFaces[i].mNumIndices;
+        const unsigned int *indices = pointCloud ? &i : m->mFaces[i].mIndices;
 
         Face& face = mesh.faces[i];//objexporter中定义的face
-        switch (f.mNumIndices) {//复制face中类型
+        switch (numIndices) {//复制face中类型
             case 1:
                 face.kind = 'p';//点
                 break;
@@ -363,10 +367,10 @@ void ObjExporter::AddMesh(const aiString& name, const aiMesh* m, const aiMatrix4
             default:
                 face.kind = 'f';//面
         }
-        face.indices.resize(f.mNumIndices);//设置顶点数量
+        face.indices.resize(numIndices);//设置顶点数量
 
-        for(unsigned int a = 0; a < f.mNumIndices; ++a) {
-            const unsigned int idx = f.mIndices[a];//逐个顶点索引赋值
+        for(unsigned int a = 0; a < numIndices; ++a) {
+            const unsigned int idx = indices[a];//逐个顶点索引赋值
 
             aiVector3D vert = mat * m->mVertices[idx];//计算全局下顶点坐标
 
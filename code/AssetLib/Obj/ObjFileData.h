@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/mesh.h>
 #include <assimp/types.h>
+#include <algorithm>
 #include <map>
 #include <vector>
 
@@ -57,30 +58,22 @@ struct Material;
 
 // ------------------------------------------------------------------------------------------------
 //! \struct Face
-//! \brief  Data structure for a simple obj-face, describes discredit,l.ation and materials
+//! \brief  Data structure for a simple obj-face. The indices of a face are not stored in the face
+//!         itself but in the flat index streams of the owning mesh, see Mesh::m_VertexIndices.
 // ------------------------------------------------------------------------------------------------
 struct Face {
-    typedef std::vector<unsigned int> IndexArray;
-
     //! Primitive type
     aiPrimitiveType m_PrimitiveType;
-    //! Vertex indices
-    IndexArray m_vertices;
-    //! Normal indices
-    IndexArray m_normals;
-    //! Texture coordinates indices
-    IndexArray m_texturCoords;
-    //! Pointer to assigned material
-    Material *m_pMaterial;
+    //! Offset of the first index in the index streams of the mesh
+    unsigned int m_firstIndex;
+    //! Number of vertex indices
+    unsigned int m_numIndices;
+    //! True, if at least one normal index was given
+    bool m_hasNormals;
 
     //! \brief  Default constructor
     Face(aiPrimitiveType pt = aiPrimitiveType_POLYGON) :
-            m_PrimitiveType(pt), m_vertices(), m_normals(), m_texturCoords(), m_pMaterial(0L) {
-        // empty
-    }
-
-    //! \brief  Destructor
-    ~Face() {
+            m_PrimitiveType(pt), m_firstIndex(0), m_numIndices(0), m_hasNormals(false) {
         // empty
     }
 };
@@ -195,11 +188,21 @@ struct Material {
 //! \brief  Data structure to store a mesh
 // ------------------------------------------------------------------------------------------------
 struct Mesh {
+    typedef std::vector<unsigned int> IndexArray;
+
     static const unsigned int NoMaterial = ~0u;
+    /// Marks a missing normal or texture coordinate index
+    static const unsigned int NoIndex = ~0u;
     /// The name for the mesh
     std::string m_name;
-    /// Array with pointer to all stored faces
-    std::vector<Face *> m_Faces;
+    /// All stored faces
+    std::vector<Face> m_Faces;
+    /// Vertex indices of all faces, addressed by Face::m_firstIndex
+    IndexArray m_VertexIndices;
+    /// Normal indices, parallel to m_VertexIndices. Empty as long as no face has normals.
+    IndexArray m_NormalIndices;
+    /// Texture coordinate indices, parallel to m_VertexIndices. Empty as long as no face has any.
+    IndexArray m_TexCoordIndices;
     /// Assigned material
     Material *m_pMaterial;
     /// Number of stored indices.
@@ -224,11 +227,46 @@ struct Mesh {
     }
 
     /// Destructor
-    ~Mesh() {
-        for (std::vector<Face *>::iterator it = m_Faces.begin();
-                it != m_Faces.end(); ++it) {
-            delete *it;
+    ~Mesh() = default;
+
+    /// Appends a face. The normal and texture coordinate arrays may be shorter than the
+    /// vertex array, missing entries are stored as NoIndex.
+    void addFace(aiPrimitiveType type, const IndexArray &vertices, const IndexArray &normals, const IndexArray &texCoords) {
+        Face face(type);
+        face.m_firstIndex = static_cast<unsigned int>(m_VertexIndices.size());
+        face.m_numIndices = static_cast<unsigned int>(vertices.size());
+        face.m_hasNormals = !normals.empty();
+        m_Faces.push_back(face);
+
+        m_VertexIndices.insert(m_VertexIndices.end(), vertices.begin(), vertices.end());
+        appendIndices(m_NormalIndices, normals, face);
+        appendIndices(m_TexCoordIndices, texCoords, face);
+    }
+
+    /// Returns the normal index of the i-th corner of a face or NoIndex.
+    unsigned int getNormalIndex(const Face &face, size_t i) const {
+        const size_t idx = face.m_firstIndex + i;
+        return idx < m_NormalIndices.size() ? m_NormalIndices[idx] : NoIndex;
+    }
+
+    /// Returns the texture coordinate index of the i-th corner of a face or NoIndex.
+    unsigned int getTexCoordIndex(const Face &face, size_t i) const {
+        const size_t idx = face.m_firstIndex + i;
+        return idx < m_TexCoordIndices.size() ? m_TexCoordIndices[idx] : NoIndex;
+    }
+
+private:
+    // Keeps an optional stream parallel to the vertex stream. Streams that were never
+    // used stay empty, so position-only files pay for a single index per corner.
+    static void appendIndices(IndexArray &stream, const IndexArray &indices, const Face &face) {
+        if (indices.empty() && stream.empty()) {
+            return;
         }
+        const unsigned int missing = NoIndex;
+        stream.resize(face.m_firstIndex, missing);
+        const size_t n = std::min(indices.size(), static_cast<size_t>(face.m_numIndices));
+        stream.insert(stream.end(), indices.begin(), indices.begin() + n);
+        stream.resize(face.m_firstIndex + face.m_numIndices, missing);
     }
 };
 
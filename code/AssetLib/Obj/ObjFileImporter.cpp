@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ObjFileImporter.h"
 #include "ObjFileData.h"
 #include "ObjFileParser.h"
+#include "Common/ParallelFor.h"
 #include <assimp/DefaultIOSystem.h>
 #include <assimp/IOStreamBuffer.h>
 #include <assimp/ai_assert.h>
@@ -77,7 +78,8 @@ using namespace std;
 ObjFileImporter::ObjFileImporter() :
         m_Buffer(),
         m_pRootObject(nullptr),
-        m_strAbsPath(std::string(1, DefaultIOSystem().getOsSeparator())) {}
+        m_strAbsPath(std::string(1, DefaultIOSystem().getOsSeparator())),
+        m_numThreads(-1) {}
 
 // ------------------------------------------------------------------------------------------------
 //  Destructor.
@@ -99,6 +101,11 @@ bool ObjFileImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bo
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+void ObjFileImporter::SetupProperties(const Importer *pImp) {
+    m_numThreads = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1);
+}
+
 // ------------------------------------------------------------------------------------------------
 const aiImporterDesc *ObjFileImporter::GetInfo() const {
     return &desc;
@@ -123,12 +130,6 @@ void ObjFileImporter::InternReadFile(const std::string &file, aiScene *pScene, I
         throw DeadlyImportError("OBJ-file is too small.");
     }
 
-    IOStreamBuffer<char> streamedBuffer;
-    streamedBuffer.open(fileStream.get());
-
-    // Allocate buffer and read file into it
-    //TextFileToBuffer( fileStream.get(),m_Buffer);
-
     // Get the model name
     std::string modelName, folderName;
     std::string::size_type pos = file.find_last_of("\\/");
@@ -142,16 +143,29 @@ void ObjFileImporter::InternReadFile(const std::string &file, aiScene *pScene, I
         modelName = file;
     }
 
-    // parse the file into a temporary representation
-    ObjFileParser parser(streamedBuffer, modelName, pIOHandler, m_progress, file);
+    // parse the file into a temporary representation. Large files are read into memory
+    // and split into chunks for the worker threads, all others are streamed.
+    std::unique_ptr<ObjFileParser> parser;
+    const unsigned int numThreads = GetNumWorkerThreads(m_numThreads);
+    if (numThreads > 1 && fileSize >= 2 * ObjFileParser::MinChunkSize) {
+        m_Buffer.resize(fileSize);
+        if (fileStream->Read(m_Buffer.data(), 1, fileSize) != fileSize) {
+            throw DeadlyImportError("OBJ: Failed to read file ", file, ".");
+        }
+        parser.reset(new ObjFileParser(m_Buffer, modelName, pIOHandler, m_progress, file, numThreads, &m_checkpoint));
+    } else {
+        IOStreamBuffer<char> streamedBuffer;
+        streamedBuffer.open(fileStream.get());
+        parser.reset(new ObjFileParser(streamedBuffer, modelName, pIOHandler, m_progress, file, &m_checkpoint));
+        streamedBuffer.close();
+    }
 
     // And create the proper return structures out of it
-    CreateDataFromImport(parser.GetModel(), pScene);
-
-    streamedBuffer.close();
+    CreateDataFromImport(parser->GetModel(), pScene);
 
     // Clean up allocated storage for the next import
     m_Buffer.clear();
+    m_Buffer.shrink_to_fit();
 
     // Pop directory stack
     if (pIOHandler->StackSize() > 0) {
@@ -276,7 +290,7 @@ aiNode *ObjFileImporter::createNodes(const ObjFile::Model *pModel, const ObjFile
         unsigned int meshId = pObject->m_Meshes[i];
         aiMesh *pMesh = createTopology(pModel, pObject, meshId);
         if (pMesh) {
-            if (pMesh->mNumFaces > 0) {
+            if (pMesh->mNumFaces > 0 || pMesh->IsPointCloud()) {
                 MeshArray.push_back(pMesh);
             } else {
                 delete pMesh;
@@ -334,19 +348,16 @@ aiMesh *ObjFileImporter::createTopology(const ObjFile::Model *pModel, const ObjF
         pMesh->mName.Set(pObjMesh->m_name);
     }
 
-    for (size_t index = 0; index < pObjMesh->m_Faces.size(); index++) {
-        ObjFile::Face *const inp = pObjMesh->m_Faces[index];
-        ai_assert(nullptr != inp);
-
-        if (inp->m_PrimitiveType == aiPrimitiveType_LINE) {
-            pMesh->mNumFaces += static_cast<unsigned int>(inp->m_vertices.size() - 1);
+    for (const ObjFile::Face &inp : pObjMesh->m_Faces) {
+        if (inp.m_PrimitiveType == aiPrimitiveType_LINE) {
+            pMesh->mNumFaces += inp.m_numIndices - 1;
             pMesh->mPrimitiveTypes |= aiPrimitiveType_LINE;
-        } else if (inp->m_PrimitiveType == aiPrimitiveType_POINT) {
-            pMesh->mNumFaces += static_cast<unsigned int>(inp->m_vertices.size());
+        } else if (inp.m_PrimitiveType == aiPrimitiveType_POINT) {
+            pMesh->mNumFaces += inp.m_numIndices;
             pMesh->mPrimitiveTypes |= aiPrimitiveType_POINT;
         } else {
             ++pMesh->mNumFaces;
-            if (inp->m_vertices.size() > 3) {
+            if (inp.m_numIndices > 3) {
                 pMesh->mPrimitiveTypes |= aiPrimitiveType_POLYGON;
             } else {
                 pMesh->mPrimitiveTypes |= aiPrimitiveType_TRIANGLE;
@@ -355,7 +366,14 @@ aiMesh *ObjFileImporter::createTopology(const ObjFile::Model *pModel, const ObjF
     }
 
     unsigned int uiIdxCount(0u);
-    if (pMesh->mNumFaces > 0) {
+    if (pMesh->mPrimitiveTypes == aiPrimitiveType_POINT) {
+        // point cloud, each point gets its own vertex and needs no face
+        uiIdxCount = pMesh->mNumFaces;
+        pMesh->mNumFaces = 0;
+        if (pObjMesh->m_uiMaterialIndex != ObjFile::Mesh::NoMaterial) {
+            pMesh->mMaterialIndex = pObjMesh->m_uiMaterialIndex;
+        }
+    } else if (pMesh->mNumFaces > 0) {
         pMesh->mFaces = new aiFace[pMesh->mNumFaces];
         if (pObjMesh->m_uiMaterialIndex != ObjFile::Mesh::NoMaterial) {
             pMesh->mMaterialIndex = pObjMesh->m_uiMaterialIndex;
@@ -364,17 +382,16 @@ aiMesh *ObjFileImporter::createTopology(const ObjFile::Model *pModel, const ObjF
         unsigned int outIndex(0);
 
         // Copy all data from all stored meshes
-        for (auto &face : pObjMesh->m_Faces) {
-            ObjFile::Face *const inp = face;
-            if (inp->m_PrimitiveType == aiPrimitiveType_LINE) {
-                for (size_t i = 0; i < inp->m_vertices.size() - 1; ++i) {
+        for (const ObjFile::Face &inp : pObjMesh->m_Faces) {
+            if (inp.m_PrimitiveType == aiPrimitiveType_LINE) {
+                for (size_t i = 0; i < inp.m_numIndices - 1; ++i) {
                     aiFace &f = pMesh->mFaces[outIndex++];
                     uiIdxCount += f.mNumIndices = 2;
                     f.mIndices = new unsigned int[2];
                 }
                 continue;
-            } else if (inp->m_PrimitiveType == aiPrimitiveType_POINT) {
-                for (size_t i = 0; i < inp->m_vertices.size(); ++i) {
+            } else if (inp.m_PrimitiveType == aiPrimitiveType_POINT) {
+                for (size_t i = 0; i < inp.m_numIndices; ++i) {
                     aiFace &f = pMesh->mFaces[outIndex++];
                     uiIdxCount += f.mNumIndices = 1;
                     f.mIndices = new unsigned int[1];
@@ -383,7 +400,7 @@ aiMesh *ObjFileImporter::createTopology(const ObjFile::Model *pModel, const ObjF
             }
 
             aiFace *pFace = &pMesh->mFaces[outIndex++];
-            const unsigned int uiNumIndices = (unsigned int)face->m_vertices.size();
+            const unsigned int uiNumIndices = inp.m_numIndices;
             uiIdxCount += pFace->mNumIndices = (unsigned int)uiNumIndices;
             if (pFace->mNumIndices > 0) {
                 pFace->mIndices = new unsigned int[uiNumIndices];
@@ -443,10 +460,12 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model *pModel,
     // Copy vertices, normals and textures into aiMesh instance
     bool normalsok = true, uvok = true;
     unsigned int newIndex = 0, outIndex = 0;
-    for (auto sourceFace : pObjMesh->m_Faces) {
+    for (const ObjFile::Face &sourceFace : pObjMesh->m_Faces) {
+        const unsigned int *sourceVertices = pObjMesh->m_VertexIndices.data() + sourceFace.m_firstIndex;
+
         // Copy all index arrays
-        for (size_t vertexIndex = 0, outVertexIndex = 0; vertexIndex < sourceFace->m_vertices.size(); vertexIndex++) {
-            const unsigned int vertex = sourceFace->m_vertices.at(vertexIndex);
+        for (size_t vertexIndex = 0, outVertexIndex = 0; vertexIndex < sourceFace.m_numIndices; vertexIndex++) {
+            const unsigned int vertex = sourceVertices[vertexIndex];
             if (vertex >= pModel->m_Vertices.size()) {
                 throw DeadlyImportError("OBJ: vertex index out of range");
             }
@@ -458,8 +477,8 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model *pModel,
             pMesh->mVertices[newIndex] = pModel->m_Vertices[vertex];
 
             // Copy all normals
-            if (normalsok && !pModel->m_Normals.empty() && vertexIndex < sourceFace->m_normals.size()) {
-                const unsigned int normal = sourceFace->m_normals.at(vertexIndex);
+            const unsigned int normal = pObjMesh->getNormalIndex(sourceFace, vertexIndex);
+            if (normalsok && !pModel->m_Normals.empty() && normal != ObjFile::Mesh::NoIndex) {
                 if (normal >= pModel->m_Normals.size()) {
                     normalsok = false;
                 } else {
@@ -474,9 +493,8 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model *pModel,
             }
 
             // Copy all texture coordinates
-            if (uvok && !pModel->m_TextureCoord.empty() && vertexIndex < sourceFace->m_texturCoords.size()) {
-                const unsigned int tex = sourceFace->m_texturCoords.at(vertexIndex);
-
+            const unsigned int tex = pObjMesh->getTexCoordIndex(sourceFace, vertexIndex);
+            if (uvok && !pModel->m_TextureCoord.empty() && tex != ObjFile::Mesh::NoIndex) {
                 if (tex >= pModel->m_TextureCoord.size()) {
                     uvok = false;
                 } else {
@@ -485,19 +503,25 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model *pModel,
                 }
             }
 
+            // Point clouds have no faces
+            if (pMesh->IsPointCloud()) {
+                ++newIndex;
+                continue;
+            }
+
             // Get destination face
             aiFace *pDestFace = &pMesh->mFaces[outIndex];
 
-            const bool last = (vertexIndex == sourceFace->m_vertices.size() - 1);
-            if (sourceFace->m_PrimitiveType != aiPrimitiveType_LINE || !last) {
+            const bool last = (vertexIndex == sourceFace.m_numIndices - 1);
+            if (sourceFace.m_PrimitiveType != aiPrimitiveType_LINE || !last) {
                 pDestFace->mIndices[outVertexIndex] = newIndex;
                 outVertexIndex++;
             }
 
-            if (sourceFace->m_PrimitiveType == aiPrimitiveType_POINT) {
+            if (sourceFace.m_PrimitiveType == aiPrimitiveType_POINT) {
                 outIndex++;
                 outVertexIndex = 0;
-            } else if (sourceFace->m_PrimitiveType == aiPrimitiveType_LINE) {
+            } else if (sourceFace.m_PrimitiveType == aiPrimitiveType_LINE) {
                 outVertexIndex = 0;
 
                 if (!last)
@@ -506,7 +530,7 @@ void ObjFileImporter::createVertexArray(const ObjFile::Model *pModel,
                 if (vertexIndex) {
                     if (!last) {
                         pMesh->mVertices[newIndex + 1] = pMesh->mVertices[newIndex];
-                        if (!sourceFace->m_normals.empty() && !pModel->m_Normals.empty()) {
+                        if (sourceFace.m_hasNormals && !pModel->m_Normals.empty()) {
                             pMesh->mNormals[newIndex + 1] = pMesh->mNormals[newIndex];
                         }
                         if (!pModel->m_TextureCoord.empty()) {
@@ -72,6 +72,9 @@ public:
     /// \remark See BaseImporter::CanRead() for details.
     bool CanRead(const std::string &pFile, IOSystem *pIOHandler, bool checkSig) const;
 
+    /// \brief  Reads the #AI_CONFIG_GLOB_MULTITHREADING setting.
+    void SetupProperties(const Importer *pImp);
+
 private:
     //! \brief  Appends the supported extension.
     const aiImporterDesc *GetInfo() const;
@@ -113,6 +116,8 @@ private:
     ObjFile::Object *m_pRootObject;
     //! Absolute pathname of model in file system
     std::string m_strAbsPath;
+    //! Value of #AI_CONFIG_GLOB_MULTITHREADING
+    int m_numThreads;
 };
 
 // ------------------------------------------------------------------------------------------------
@@ -44,13 +44,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ObjFileData.h"
 #include "ObjFileMtlImporter.h"
 #include "ObjTools.h"
+#include "Common/ParallelFor.h"
 #include <assimp/BaseImporter.h>
 #include <assimp/DefaultIOSystem.h>
 #include <assimp/ParsingUtils.h>
 #include <assimp/material.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
+#include <assimp/MemoryIOWrapper.h>
 #include <cstdlib>
+#include <cstring>
 #include <memory>
 #include <utility>
 
@@ -66,13 +69,14 @@ ObjFileParser::ObjFileParser() :
         m_buffer(),
         m_pIO(nullptr),
         m_progress(nullptr),
+        m_checkpoint(nullptr),
         m_originalObjFileName() {
     std::fill_n(m_buffer, Buffersize, '\0');
 }
 
 ObjFileParser::ObjFileParser(IOStreamBuffer<char> &streamBuffer, const std::string &modelName,
         IOSystem *io, ProgressHandler *progress,
-        const std::string &originalObjFileName) :
+        const std::string &originalObjFileName, ImportCheckpoint *checkpoint) :
         m_DataIt(),
         m_DataItEnd(),
         m_pModel(nullptr),
@@ -80,35 +84,60 @@ ObjFileParser::ObjFileParser(IOStreamBuffer<char> &streamBuffer, const std::stri
         m_buffer(),
         m_pIO(io),
         m_progress(progress),
+        m_checkpoint(checkpoint),
         m_originalObjFileName(originalObjFileName) {
     std::fill_n(m_buffer, Buffersize, '\0');
 
-    // Create the model instance to store all the data
-    m_pModel.reset(new ObjFile::Model());
-    m_pModel->m_ModelName = modelName;
-
-    // create default material and store it
-    m_pModel->m_pDefaultMaterial = new ObjFile::Material;
-    m_pModel->m_pDefaultMaterial->MaterialName.Set(DEFAULT_MATERIAL);
-    m_pModel->m_MaterialLib.push_back(DEFAULT_MATERIAL);
-    m_pModel->m_MaterialMap[DEFAULT_MATERIAL] = m_pModel->m_pDefaultMaterial;
+    createModel(modelName);
 
     // Start parsing the file
     parseFile(streamBuffer);
 }
 
+ObjFileParser::ObjFileParser(const std::vector<char> &buffer, const std::string &modelName,
+        IOSystem *io, ProgressHandler *progress,
+        const std::string &originalObjFileName, unsigned int numThreads, ImportCheckpoint *checkpoint) :
+        m_DataIt(),
+        m_DataItEnd(),
+        m_pModel(nullptr),
+        m_uiLine(0),
+        m_buffer(),
+        m_pIO(io),
+        m_progress(progress),
+        m_checkpoint(checkpoint),
+        m_originalObjFileName(originalObjFileName) {
+    std::fill_n(m_buffer, Buffersize, '\0');
+
+    createModel(modelName);
+
+    // Start parsing the file
+    parseFileChunked(buffer, numThreads);
+}
+
 ObjFileParser::~ObjFileParser() {
 }
 
 void ObjFileParser::setBuffer(std::vector<char> &buffer) {
-    m_DataIt = buffer.begin();
-    m_DataItEnd = buffer.end();
+    m_DataIt = buffer.data();
+    m_DataItEnd = buffer.data() + buffer.size();
 }
 
 ObjFile::Model *ObjFileParser::GetModel() const {
     return m_pModel.get();
 }
 
+void ObjFileParser::createModel(const std::string &modelName) {
+    // Create the model instance to store all the data
+    m_pModel.reset(new ObjFile::Model());
+    m_pModel->m_ModelName = modelName;
+
+    // create default material and store it
+    m_pModel->m_pDefaultMaterial = new ObjFile::Material;
+    m_pModel->m_pDefaultMaterial->MaterialName.Set(DEFAULT_MATERIAL);
+    m_pModel->m_MaterialLib.push_back(DEFAULT_MATERIAL);
+    m_pModel->m_MaterialMap[DEFAULT_MATERIAL] = m_pModel->m_pDefaultMaterial;
+}
+
 void ObjFileParser::parseFile(IOStreamBuffer<char> &streamBuffer) {
     // only update every 100KB or it'll be too slow
     //const unsigned int updateProgressEveryBytes = 100 * 1024;
@@ -118,10 +147,12 @@ void ObjFileParser::parseFile(IOStreamBuffer<char> &streamBuffer) {
     unsigned int processed = 0;
     size_t lastFilePos(0);
 
-    std::vector<char> buffer;
-    while (streamBuffer.getNextDataLine(buffer, '\\')) {
-        m_DataIt = buffer.begin();
-        m_DataItEnd = buffer.end();
+    const char *line = nullptr;
+    size_t lineLength = 0;
+    while (streamBuffer.getNextDataLineView(line, lineLength, '\\')) {
+        // the line end belongs to the line, the parsing helpers stop at it
+        m_DataIt = line;
+        m_DataItEnd = line + lineLength + 1;
 
         // Handle progress reporting
         const size_t filePos(streamBuffer.getFilePos());
@@ -131,100 +162,330 @@ void ObjFileParser::parseFile(IOStreamBuffer<char> &streamBuffer) {
             progressCounter++;
             m_progress->UpdateFileRead(processed, progressTotal);
         }
+        if (m_checkpoint) {
+            m_checkpoint->Check(filePos, progressTotal);
+        }
+
+        parseLine();
+    }
+}
+
+// Splits the indices of a face statement into tokens. Returns the position after the
+// last token, the number of '/' separators is returned in numSeparators.
+static const char *tokenizeFace(const char *it, const char *end, std::vector<ObjFileParser::FaceToken> &tokens,
+        unsigned int &numSeparators) {
+    int iPos = 0;
+    while (it != end) {
+        int iStep = 1;
+
+        if (IsLineEnd(*it)) {
+            break;
+        }
+
+        if (*it == '/') {
+            ++numSeparators;
+            iPos++;
+        } else if (IsSpaceOrNewLine(*it)) {
+            iPos = 0;
+        } else {
+            //OBJ USES 1 Base ARRAYS!!!!
+            const int iVal(::atoi(it));
 
-        // parse line
-        switch (*m_DataIt) {
-        case 'v': // Parse a vertex texture coordinate
-        {
-            ++m_DataIt;
-            if (*m_DataIt == ' ' || *m_DataIt == '\t') {
-                size_t numComponents = getNumComponentsInDataDefinition();
-                if (numComponents == 3) {
-                    // read in vertex definition
-                    getVector3(m_pModel->m_Vertices);
-                } else if (numComponents == 4) {
-                    // read in vertex definition (homogeneous coords)
-                    getHomogeneousVector3(m_pModel->m_Vertices);
-                } else if (numComponents == 6) {
-                    // read vertex and vertex-color
-                    getTwoVectors3(m_pModel->m_Vertices, m_pModel->m_VertexColors);
-                }
-            } else if (*m_DataIt == 't') {
-                // read in texture coordinate ( 2D or 3D )
-                ++m_DataIt;
-                size_t dim = getTexCoordVector(m_pModel->m_TextureCoord);
-                m_pModel->m_TextureCoordDim = std::max(m_pModel->m_TextureCoordDim, (unsigned int)dim);
-            } else if (*m_DataIt == 'n') {
-                // Read in normal vector definition
-                ++m_DataIt;
-                getVector3(m_pModel->m_Normals);
+            // increment iStep position based off of the sign and # of digits
+            int tmp = iVal;
+            if (iVal < 0) {
+                ++iStep;
             }
-        } break;
+            while ((tmp = tmp / 10) != 0) {
+                ++iStep;
+            }
+
+            tokens.push_back({ iPos, iVal });
+        }
+        it += iStep;
+    }
+    return it;
+}
+
+// Statements of one chunk of the file. Vertex data and faces are parsed on a worker thread,
+// lines which depend on the parser state (usemtl, g, o, ...) are kept for the merge.
+struct ObjFileParser::Chunk {
+    // Kind of a statement which is replayed when merging
+    static const unsigned int DeferredLine = 0;
+
+    struct Statement {
+        // aiPrimitiveType of a face or DeferredLine
+        unsigned int type;
+        // First token of a face or index of a deferred line
+        unsigned int first;
+        unsigned int numTokens;
+        // Sizes of the chunk arrays when the statement was read
+        unsigned int numVertices;
+        unsigned int numTexCoords;
+        unsigned int numNormals;
+    };
+
+    std::vector<aiVector3D> vertices;
+    std::vector<aiVector3D> colors;
+    std::vector<aiVector3D> normals;
+    std::vector<aiVector3D> texCoords;
+    unsigned int texCoordDim = 0;
+    std::vector<FaceToken> tokens;
+    std::vector<Statement> statements;
+    std::vector<std::string> lines;
+};
+
+// Returns the start of the first line after pos. A line continued with a '\' is never split.
+static const char *findChunkBoundary(const char *pos, const char *begin, const char *end) {
+    while (pos < end) {
+        const char *lineEnd = static_cast<const char *>(::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+        if (nullptr == lineEnd) {
+            break;
+        }
+        const char *lineStart = lineEnd;
+        while (lineStart != begin && lineStart[-1] != '\n') {
+            --lineStart;
+        }
+        if (nullptr == ::memchr(lineStart, '\\', static_cast<size_t>(lineEnd - lineStart))) {
+            return lineEnd + 1;
+        }
+        pos = lineEnd + 1;
+    }
+    return end;
+}
 
-        case 'p': // Parse a face, line or point statement
-        case 'l':
-        case 'f': {
-            getFace(*m_DataIt == 'f' ? aiPrimitiveType_POLYGON : (*m_DataIt == 'l' ? aiPrimitiveType_LINE : aiPrimitiveType_POINT));
-        } break;
+void ObjFileParser::parseFileChunked(const std::vector<char> &buffer, unsigned int numThreads) {
+    const char *begin = buffer.data();
+    const char *end = begin + buffer.size();
+    const size_t numChunks = std::max<size_t>(1, std::min<size_t>(numThreads, buffer.size() / MinChunkSize));
 
-        case '#': // Parse a comment
-        {
-            getComment();
-        } break;
+    std::vector<const char *> bounds(1, begin);
+    for (size_t i = 1; i < numChunks; ++i) {
+        const char *pos = std::max(bounds.back(), begin + i * (buffer.size() / numChunks));
+        bounds.push_back(findChunkBoundary(pos, begin, end));
+    }
+    bounds.push_back(end);
+
+    std::vector<Chunk> chunks(numChunks);
+    ParallelFor(numChunks, numThreads, 1, [this, &bounds, &chunks](size_t first, size_t last) {
+        ObjFileParser worker;
+        worker.m_checkpoint = m_checkpoint;
+        for (size_t i = first; i < last; ++i) {
+            worker.parseChunk(bounds[i], bounds[i + 1], chunks[i]);
+        }
+    });
 
-        case 'u': // Parse a material desc. setter
-        {
-            std::string name;
+    // Resolve the parser state and the relative indices in file order
+    for (size_t i = 0; i < numChunks; ++i) {
+        if (m_checkpoint) {
+            m_checkpoint->CheckProgress(static_cast<size_t>(bounds[i] - begin), buffer.size());
+        }
+        mergeChunk(chunks[i]);
+        chunks[i] = Chunk();
+        m_progress->UpdateFileRead(static_cast<unsigned int>(bounds[i + 1] - begin), static_cast<unsigned int>(buffer.size()));
+    }
+}
 
-            getNameNoSpace(m_DataIt, m_DataItEnd, name);
+void ObjFileParser::parseChunk(const char *begin, const char *end, Chunk &chunk) {
+    if (begin == end) {
+        return;
+    }
 
-            size_t nextSpace = name.find(' ');
-            if (nextSpace != std::string::npos)
-                name = name.substr(0, nextSpace);
+    MemoryIOStream stream(reinterpret_cast<const uint8_t *>(begin), static_cast<size_t>(end - begin));
+    IOStreamBuffer<char> streamBuffer;
+    streamBuffer.open(&stream);
 
-            if (name == "usemtl") {
-                getMaterialDesc();
+    const char *line = nullptr;
+    size_t lineLength = 0;
+    while (streamBuffer.getNextDataLineView(line, lineLength, '\\')) {
+        // Workers must not call the progress handler
+        if (m_checkpoint) {
+            m_checkpoint->CheckCancelled();
+        }
+        m_DataIt = line;
+        m_DataItEnd = line + lineLength + 1;
+
+        const char c = *m_DataIt;
+        if ('v' == c) {
+            getVertexData(chunk.vertices, chunk.colors, chunk.normals, chunk.texCoords, chunk.texCoordDim);
+            continue;
+        }
+        if ('#' == c || IsLineEnd(c)) {
+            continue;
+        }
+
+        if ('f' == c || 'l' == c || 'p' == c) {
+            const aiPrimitiveType type = 'f' == c ? aiPrimitiveType_POLYGON : ('l' == c ? aiPrimitiveType_LINE : aiPrimitiveType_POINT);
+            const size_t first = chunk.tokens.size();
+            unsigned int numSeparators = 0;
+            m_DataIt = getNextToken<DataArrayIt>(m_DataIt, m_DataItEnd);
+            if (m_DataIt != m_DataItEnd && *m_DataIt != '\0') {
+                tokenizeFace(m_DataIt, m_DataItEnd, chunk.tokens, numSeparators);
             }
-        } break;
-
-        case 'm': // Parse a material library or merging group ('mg')
-        {
-            std::string name;
-
-            getNameNoSpace(m_DataIt, m_DataItEnd, name);
-
-            size_t nextSpace = name.find(' ');
-            if (nextSpace != std::string::npos)
-                name = name.substr(0, nextSpace);
-
-            if (name == "mg")
-                getGroupNumberAndResolution();
-            else if (name == "mtllib")
-                getMaterialLib();
-            else
-                goto pf_skip_line;
-        } break;
-
-        case 'g': // Parse group name
-        {
-            getGroupName();
-        } break;
-
-        case 's': // Parse group number
-        {
-            getGroupNumber();
-        } break;
-
-        case 'o': // Parse object name
-        {
-            getObjectName();
-        } break;
-
-        default: {
-        pf_skip_line:
-            m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
-        } break;
+
+            // Faces which would log or throw are deferred, so this happens in file order
+            bool valid = chunk.tokens.size() > first && (type != aiPrimitiveType_POINT || 0 == numSeparators);
+            for (size_t i = first; valid && i < chunk.tokens.size(); ++i) {
+                valid = 0 != chunk.tokens[i].value && chunk.tokens[i].pos <= 2;
+            }
+            if (valid) {
+                chunk.statements.push_back({ static_cast<unsigned int>(type),
+                        static_cast<unsigned int>(first),
+                        static_cast<unsigned int>(chunk.tokens.size() - first),
+                        static_cast<unsigned int>(chunk.vertices.size()),
+                        static_cast<unsigned int>(chunk.texCoords.size()),
+                        static_cast<unsigned int>(chunk.normals.size()) });
+                continue;
+            }
+            chunk.tokens.resize(first);
         }
+
+        chunk.lines.emplace_back(line, lineLength + 1);
+        chunk.statements.push_back({ Chunk::DeferredLine,
+                static_cast<unsigned int>(chunk.lines.size() - 1),
+                0,
+                static_cast<unsigned int>(chunk.vertices.size()),
+                static_cast<unsigned int>(chunk.texCoords.size()),
+                static_cast<unsigned int>(chunk.normals.size()) });
+    }
+    streamBuffer.close();
+}
+
+void ObjFileParser::mergeChunk(const Chunk &chunk) {
+    std::vector<aiVector3D> &vertices = m_pModel->m_Vertices;
+    std::vector<aiVector3D> &texCoords = m_pModel->m_TextureCoord;
+    std::vector<aiVector3D> &normals = m_pModel->m_Normals;
+    const size_t vBase = vertices.size();
+    const size_t vtBase = texCoords.size();
+    const size_t vnBase = normals.size();
+
+    // Appends the chunk data up to the given sizes to the model
+    auto flush = [&](size_t numVertices, size_t numTexCoords, size_t numNormals) {
+        vertices.insert(vertices.end(), chunk.vertices.begin() + (vertices.size() - vBase), chunk.vertices.begin() + numVertices);
+        texCoords.insert(texCoords.end(), chunk.texCoords.begin() + (texCoords.size() - vtBase), chunk.texCoords.begin() + numTexCoords);
+        normals.insert(normals.end(), chunk.normals.begin() + (normals.size() - vnBase), chunk.normals.begin() + numNormals);
+    };
+
+    for (const Chunk::Statement &statement : chunk.statements) {
+        if (Chunk::DeferredLine != statement.type) {
+            storeFace(static_cast<aiPrimitiveType>(statement.type), &chunk.tokens[statement.first], statement.numTokens,
+                    static_cast<int>(vBase + statement.numVertices),
+                    static_cast<int>(vtBase + statement.numTexCoords),
+                    static_cast<int>(vnBase + statement.numNormals));
+            continue;
+        }
+
+        // The line sees the model like the sequential parser would
+        flush(statement.numVertices, statement.numTexCoords, statement.numNormals);
+        const std::string &line = chunk.lines[statement.first];
+        m_DataIt = line.data();
+        m_DataItEnd = line.data() + line.size();
+        parseLine();
+    }
+
+    flush(chunk.vertices.size(), chunk.texCoords.size(), chunk.normals.size());
+    m_pModel->m_VertexColors.insert(m_pModel->m_VertexColors.end(), chunk.colors.begin(), chunk.colors.end());
+    m_pModel->m_TextureCoordDim = std::max(m_pModel->m_TextureCoordDim, chunk.texCoordDim);
+}
+
+void ObjFileParser::parseLine() {
+    switch (*m_DataIt) {
+    case 'v': // Parse a vertex texture coordinate
+    {
+        getVertexData(m_pModel->m_Vertices, m_pModel->m_VertexColors, m_pModel->m_Normals,
+                m_pModel->m_TextureCoord, m_pModel->m_TextureCoordDim);
+    } break;
+
+    case 'p': // Parse a face, line or point statement
+    case 'l':
+    case 'f': {
+        getFace(*m_DataIt == 'f' ? aiPrimitiveType_POLYGON : (*m_DataIt == 'l' ? aiPrimitiveType_LINE : aiPrimitiveType_POINT));
+    } break;
+
+    case '#': // Parse a comment
+    {
+        getComment();
+    } break;
+
+    case 'u': // Parse a material desc. setter
+    {
+        std::string name;
+
+        getNameNoSpace(m_DataIt, m_DataItEnd, name);
+
+        size_t nextSpace = name.find(' ');
+        if (nextSpace != std::string::npos)
+            name = name.substr(0, nextSpace);
+
+        if (name == "usemtl") {
+            getMaterialDesc();
+        }
+    } break;
+
+    case 'm': // Parse a material library or merging group ('mg')
+    {
+        std::string name;
+
+        getNameNoSpace(m_DataIt, m_DataItEnd, name);
+
+        size_t nextSpace = name.find(' ');
+        if (nextSpace != std::string::npos)
+            name = name.substr(0, nextSpace);
+
+        if (name == "mg")
+            getGroupNumberAndResolution();
+        else if (name == "mtllib")
+            getMaterialLib();
+        else
+            goto pf_skip_line;
+    } break;
+
+    case 'g': // Parse group name
+    {
+        getGroupName();
+    } break;
+
+    case 's': // Parse group number
+    {
+        getGroupNumber();
+    } break;
+
+    case 'o': // Parse object name
+    {
+        getObjectName();
+    } break;
+
+    default: {
+    pf_skip_line:
+        m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
+    } break;
+    }
+}
+
+void ObjFileParser::getVertexData(std::vector<aiVector3D> &vertices, std::vector<aiVector3D> &colors,
+        std::vector<aiVector3D> &normals, std::vector<aiVector3D> &texCoords, unsigned int &texCoordDim) {
+    ++m_DataIt;
+    if (*m_DataIt == ' ' || *m_DataIt == '\t') {
+        size_t numComponents = getNumComponentsInDataDefinition();
+        if (numComponents == 3) {
+            // read in vertex definition
+            getVector3(vertices);
+        } else if (numComponents == 4) {
+            // read in vertex definition (homogeneous coords)
+            getHomogeneousVector3(vertices);
+        } else if (numComponents == 6) {
+            // read vertex and vertex-color
+            getTwoVectors3(vertices, colors);
+        }
+    } else if (*m_DataIt == 't') {
+        // read in texture coordinate ( 2D or 3D )
+        ++m_DataIt;
+        size_t dim = getTexCoordVector(texCoords);
+        texCoordDim = std::max(texCoordDim, (unsigned int)dim);
+    } else if (*m_DataIt == 'n') {
+        // Read in normal vector definition
+        ++m_DataIt;
+        getVector3(normals);
     }
 }
 
@@ -412,94 +673,65 @@ void ObjFileParser::getFace(aiPrimitiveType type) {
         return;
     }
 
-    ObjFile::Face *face = new ObjFile::Face(type);
-    bool hasNormal = false;
+    m_faceTokens.clear();
+    unsigned int numSeparators = 0;
+    m_DataIt = tokenizeFace(m_DataIt, m_DataItEnd, m_faceTokens, numSeparators);
+    if (type == aiPrimitiveType_POINT && numSeparators > 0) {
+        ASSIMP_LOG_ERROR("Obj: Separator unexpected in point statement");
+    }
 
-    const int vSize = static_cast<unsigned int>(m_pModel->m_Vertices.size());
-    const int vtSize = static_cast<unsigned int>(m_pModel->m_TextureCoord.size());
-    const int vnSize = static_cast<unsigned int>(m_pModel->m_Normals.size());
+    storeFace(type, m_faceTokens.data(), m_faceTokens.size(),
+            static_cast<int>(m_pModel->m_Vertices.size()),
+            static_cast<int>(m_pModel->m_TextureCoord.size()),
+            static_cast<int>(m_pModel->m_Normals.size()));
 
-    const bool vt = (!m_pModel->m_TextureCoord.empty());
-    const bool vn = (!m_pModel->m_Normals.empty());
-    int iPos = 0;
-    while (m_DataIt != m_DataItEnd) {
-        int iStep = 1;
+    // Skip the rest of the line
+    m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
+}
 
-        if (IsLineEnd(*m_DataIt)) {
-            break;
+void ObjFileParser::storeFace(aiPrimitiveType type, const FaceToken *tokens, size_t numTokens, int vSize, int vtSize, int vnSize) {
+    m_faceVertices.clear();
+    m_faceNormals.clear();
+    m_faceTexCoords.clear();
+
+    const bool vt = vtSize > 0;
+    const bool vn = vnSize > 0;
+    int shift = 0;
+    for (size_t i = 0; i < numTokens; ++i) {
+        const int iVal = tokens[i].value;
+        if (0 == tokens[i].pos) {
+            shift = 0;
+        }
+        int iPos = tokens[i].pos + shift;
+        if (iPos == 1 && !vt && vn) {
+            // skip texture coords for normals if there are no tex coords
+            shift = 1;
+            iPos = 2;
         }
 
-        if (*m_DataIt == '/') {
-            if (type == aiPrimitiveType_POINT) {
-                ASSIMP_LOG_ERROR("Obj: Separator unexpected in point statement");
-            }
-            iPos++;
-        } else if (IsSpaceOrNewLine(*m_DataIt)) {
-            iPos = 0;
-        } else {
-            //OBJ USES 1 Base ARRAYS!!!!
-            const int iVal(::atoi(&(*m_DataIt)));
-
-            // increment iStep position based off of the sign and # of digits
-            int tmp = iVal;
-            if (iVal < 0) {
-                ++iStep;
-            }
-            while ((tmp = tmp / 10) != 0) {
-                ++iStep;
-            }
+        if (0 == iVal) {
+            //On error, std::atoi will return 0 which is not a valid value
+            throw DeadlyImportError("OBJ: Invalid face indice");
+        }
 
-            if (iPos == 1 && !vt && vn)
-                iPos = 2; // skip texture coords for normals if there are no tex coords
-
-            if (iVal > 0) {
-                // Store parsed index
-                if (0 == iPos) {
-                    face->m_vertices.push_back(iVal - 1);
-                } else if (1 == iPos) {
-                    face->m_texturCoords.push_back(iVal - 1);
-                } else if (2 == iPos) {
-                    face->m_normals.push_back(iVal - 1);
-                    hasNormal = true;
-                } else {
-                    reportErrorTokenInFace();
-                }
-            } else if (iVal < 0) {
-                // Store relatively index
-                if (0 == iPos) {
-                    face->m_vertices.push_back(vSize + iVal);
-                } else if (1 == iPos) {
-                    face->m_texturCoords.push_back(vtSize + iVal);
-                } else if (2 == iPos) {
-                    face->m_normals.push_back(vnSize + iVal);
-                    hasNormal = true;
-                } else {
-                    reportErrorTokenInFace();
-                }
-            } else {
-                //On error, std::atoi will return 0 which is not a valid value
-                delete face;
-                throw DeadlyImportError("OBJ: Invalid face indice");
-            }
+        // Store parsed or relative index
+        if (0 == iPos) {
+            m_faceVertices.push_back(iVal > 0 ? iVal - 1 : vSize + iVal);
+        } else if (1 == iPos) {
+            m_faceTexCoords.push_back(iVal > 0 ? iVal - 1 : vtSize + iVal);
+        } else if (2 == iPos) {
+            m_faceNormals.push_back(iVal > 0 ? iVal - 1 : vnSize + iVal);
+        } else {
+            reportErrorTokenInFace();
+            break;
         }
-        m_DataIt += iStep;
     }
 
-    if (face->m_vertices.empty()) {
+    if (m_faceVertices.empty()) {
         ASSIMP_LOG_ERROR("Obj: Ignoring empty face");
-        // skip line and clean up
-        m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
-        delete face;
         return;
     }
 
-    // Set active material, if one set
-    if (nullptr != m_pModel->m_pCurrentMaterial) {
-        face->m_pMaterial = m_pModel->m_pCurrentMaterial;
-    } else {
-        face->m_pMaterial = m_pModel->m_pDefaultMaterial;
-    }
-
     // Create a default object, if nothing is there
     if (nullptr == m_pModel->m_pCurrent) {
         createObject(DefaultObjName);
@@ -511,14 +743,12 @@ void ObjFileParser::getFace(aiPrimitiveType type) {
     }
 
     // Store the face
-    m_pModel->m_pCurrentMesh->m_Faces.push_back(face);
-    m_pModel->m_pCurrentMesh->m_uiNumIndices += (unsigned int)face->m_vertices.size();
-    m_pModel->m_pCurrentMesh->m_uiUVCoordinates[0] += (unsigned int)face->m_texturCoords.size();
-    if (!m_pModel->m_pCurrentMesh->m_hasNormals && hasNormal) {
+    m_pModel->m_pCurrentMesh->addFace(type, m_faceVertices, m_faceNormals, m_faceTexCoords);
+    m_pModel->m_pCurrentMesh->m_uiNumIndices += (unsigned int)m_faceVertices.size();
+    m_pModel->m_pCurrentMesh->m_uiUVCoordinates[0] += (unsigned int)m_faceTexCoords.size();
+    if (!m_pModel->m_pCurrentMesh->m_hasNormals && !m_faceNormals.empty()) {
         m_pModel->m_pCurrentMesh->m_hasNormals = true;
     }
-    // Skip the rest of the line
-    m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
 }
 
 void ObjFileParser::getMaterialDesc() {
@@ -528,7 +758,7 @@ void ObjFileParser::getMaterialDesc() {
         return;
     }
 
-    char *pStart = &(*m_DataIt);
+    const char *pStart = &(*m_DataIt);
     while (m_DataIt != m_DataItEnd && !IsLineEnd(*m_DataIt)) {
         ++m_DataIt;
     }
@@ -592,7 +822,7 @@ void ObjFileParser::getMaterialLib() {
         return;
     }
 
-    char *pStart = &(*m_DataIt);
+    const char *pStart = &(*m_DataIt);
     while (m_DataIt != m_DataItEnd && !IsLineEnd(*m_DataIt)) {
         ++m_DataIt;
     }
@@ -652,7 +882,7 @@ void ObjFileParser::getNewMaterial() {
         return;
     }
 
-    char *pStart = &(*m_DataIt);
+    const char *pStart = &(*m_DataIt);
     std::string strMat(pStart, *m_DataIt);
     while (m_DataIt != m_DataItEnd && IsSpaceOrNewLine(*m_DataIt)) {
         ++m_DataIt;
@@ -745,7 +975,7 @@ void ObjFileParser::getObjectName() {
     if (m_DataIt == m_DataItEnd) {
         return;
     }
-    char *pStart = &(*m_DataIt);
+    const char *pStart = &(*m_DataIt);
     while (m_DataIt != m_DataItEnd && !IsSpaceOrNewLine(*m_DataIt)) {
         ++m_DataIt;
     }
@@ -828,7 +1058,6 @@ bool ObjFileParser::needsNewMesh(const std::string &materialName) {
 // -------------------------------------------------------------------
 //  Shows an error in parsing process.
 void ObjFileParser::reportErrorTokenInFace() {
-    m_DataIt = skipLine<DataArrayIt>(m_DataIt, m_DataItEnd, m_uiLine);
     ASSIMP_LOG_ERROR("OBJ: Not supported token in face description detected");
 }
 
@@ -63,21 +63,35 @@ struct Point2;
 class ObjFileImporter;
 class IOSystem;
 class ProgressHandler;
+class ImportCheckpoint;
 
 /// \class  ObjFileParser
 /// \brief  Parser for a obj waveform file
 class ASSIMP_API ObjFileParser {
 public:
     static const size_t Buffersize = 4096;
+    /// Minimal number of bytes a worker thread gets in the chunked parser.
+    static const size_t MinChunkSize = 1024 * 1024;
     typedef std::vector<char> DataArray;
-    typedef std::vector<char>::iterator DataArrayIt;
-    typedef std::vector<char>::const_iterator ConstDataArrayIt;
+    typedef const char *DataArrayIt;
+    typedef const char *ConstDataArrayIt;
+    /// One index of a face statement: the slot within the corner (0 vertex, 1 texture
+    /// coordinate, 2 normal) and the raw, 1-based or relative, index.
+    struct FaceToken {
+        int pos;
+        int value;
+    };
 
 public:
     /// @brief  The default constructor.
     ObjFileParser();
     /// @brief  Constructor with data array.
-    ObjFileParser(IOStreamBuffer<char> &streamBuffer, const std::string &modelName, IOSystem *io, ProgressHandler *progress, const std::string &originalObjFileName);
+    ObjFileParser(IOStreamBuffer<char> &streamBuffer, const std::string &modelName, IOSystem *io, ProgressHandler *progress, const std::string &originalObjFileName,
+            ImportCheckpoint *checkpoint = nullptr);
+    /// @brief  Constructor with the whole file in memory, it is split into chunks which are
+    ///         tokenized on up to numThreads threads.
+    ObjFileParser(const std::vector<char> &buffer, const std::string &modelName, IOSystem *io, ProgressHandler *progress,
+            const std::string &originalObjFileName, unsigned int numThreads, ImportCheckpoint *checkpoint = nullptr);
     /// @brief  Destructor
     ~ObjFileParser();
     /// @brief  If you want to load in-core data.
@@ -89,8 +103,24 @@ public:
     ObjFileParser &operator=(const ObjFileParser& ) = delete;
 
 protected:
+    /// Statements of one chunk of the file, see parseChunk().
+    struct Chunk;
+
+    /// Creates the model and its default material.
+    void createModel(const std::string &modelName);
     /// Parse the loaded file
     void parseFile(IOStreamBuffer<char> &streamBuffer);
+    /// Parse the file from memory, split into chunks.
+    void parseFileChunked(const std::vector<char> &buffer, unsigned int numThreads);
+    /// Parses the statements of a chunk which do not depend on the parser state.
+    void parseChunk(const char *begin, const char *end, Chunk &chunk);
+    /// Adds the data of a parsed chunk to the model.
+    void mergeChunk(const Chunk &chunk);
+    /// Parses the line between m_DataIt and m_DataItEnd.
+    void parseLine();
+    /// Stores a v, vt or vn statement.
+    void getVertexData(std::vector<aiVector3D> &vertices, std::vector<aiVector3D> &colors,
+            std::vector<aiVector3D> &normals, std::vector<aiVector3D> &texCoords, unsigned int &texCoordDim);
     /// Method to copy the new delimited word in the current line.
     void copyNextWord(char *pBuffer, size_t length);
     /// Method to copy the new line.
@@ -109,6 +139,8 @@ protected:
     void getVector2(std::vector<aiVector2D> &point2d_array);
     /// Stores the following face.
     void getFace(aiPrimitiveType type);
+    /// Resolves the tokens of a face against the given array sizes and adds it to the current mesh.
+    void storeFace(aiPrimitiveType type, const FaceToken *tokens, size_t numTokens, int vSize, int vtSize, int vnSize);
     /// Reads the material description.
     void getMaterialDesc();
     /// Gets a comment.
@@ -156,8 +188,15 @@ private:
     IOSystem *m_pIO;
     //! Pointer to progress handler
     ProgressHandler *m_progress;
+    //! Cancellation point of the import, may be nullptr
+    ImportCheckpoint *m_checkpoint;
     /// Path to the current model, name of the obj file where the buffer comes from
     const std::string m_originalObjFileName;
+    //! Scratch arrays of the face being parsed, reused for all faces
+    std::vector<FaceToken> m_faceTokens;
+    std::vector<unsigned int> m_faceVertices;
+    std::vector<unsigned int> m_faceNormals;
+    std::vector<unsigned int> m_faceTexCoords;
 };
 
 } // Namespace Assimp
@@ -136,7 +136,7 @@ inline char_t getName(char_t it, char_t end, std::string &name) {
         return end;
     }
 
-    char *pStart = &(*it);
+    const char *pStart = &(*it);
     while (!isEndOfBuffer(it, end) && !IsLineEnd(*it)) {
         ++it;
     }
@@ -149,7 +149,7 @@ inline char_t getName(char_t it, char_t end, std::string &name) {
     while (&(*it) < pStart) {
         ++it;
     }
-    std::string strName(pStart, &(*it));
+    std::string strName(pStart, static_cast<const char *>(&(*it)));
     if (strName.empty())
         return it;
     else
@@ -172,7 +172,7 @@ inline char_t getNameNoSpace(char_t it, char_t end, std::string &name) {
         return end;
     }
 
-    char *pStart = &(*it);
+    const char *pStart = &(*it);
     while (!isEndOfBuffer(it, end) && !IsLineEnd(*it) && !IsSpaceOrNewLine(*it)) {
         ++it;
     }
@@ -187,7 +187,7 @@ inline char_t getNameNoSpace(char_t it, char_t end, std::string &name) {
     while (&(*it) < pStart) {
         ++it;
     }
-    std::string strName(pStart, &(*it));
+    std::string strName(pStart, static_cast<const char *>(&(*it)));
     if (strName.empty())
         return it;
     else
@@ -114,10 +114,12 @@ PlyExporter::PlyExporter(const char* _filename, const aiScene* pScene, bool bina
     mOutput.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
 
     unsigned int faces = 0u, vertices = 0u, components = 0u;
+    bool pointsOnly = true;
     for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
         const aiMesh& m = *pScene->mMeshes[i];
         faces += m.mNumFaces;
         vertices += m.mNumVertices;
+        pointsOnly = pointsOnly && m.IsPointCloud();
 
         if (m.HasNormals()) {
             components |= PLY_EXPORT_HAS_NORMALS;
@@ -216,12 +218,15 @@ PlyExporter::PlyExporter(const char* _filename, const aiScene* pScene, bool bina
         mOutput << "property " << typeName << " bz" << endl;
     }
 
-    mOutput << "element face " << faces << endl;
+    // point clouds are written as vertices only
+    if (!pointsOnly) {
+        mOutput << "element face " << faces << endl;
 
-    // uchar seems to be the most common type for the number of indices per polygon and int seems to be most common for the vertex indices.
-    // For instance, MeshLab fails to load meshes in which both types are uint. Houdini seems to have problems as well.
-    // Obviously, using uchar will not work for meshes with polygons with more than 255 indices, but how realistic is this case?
-    mOutput << "property list uchar int vertex_index" << endl;
+        // uchar seems to be the most common type for the number of indices per polygon and int seems to be most common for the vertex indices.
+        // For instance, MeshLab fails to load meshes in which both types are uint. Houdini seems to have problems as well.
+        // Obviously, using uchar will not work for meshes with polygons with more than 255 indices, but how realistic is this case?
+        mOutput << "property list uchar int vertex_index" << endl;
+    }
 
     mOutput << "end_header" << endl;
 
@@ -47,10 +47,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers
 #include "PlyLoader.h"
+#include "Common/ParallelFor.h"
 #include <assimp/IOStreamBuffer.h>
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
 #include <assimp/IOSystem.hpp>
+#include <assimp/Importer.hpp>
 #include <memory>
 
 using namespace ::Assimp;
@@ -81,6 +83,9 @@ inline const T &GetProperty(const std::vector<T> &props, int idx) {
 
     return props[idx];
 }
+
+// Minimal number of vertex records decoded by a worker thread
+static const size_t MinVerticesPerThread = 16384;
 } // namespace
 
 // ------------------------------------------------------------------------------------------------
@@ -88,7 +93,8 @@ inline const T &GetProperty(const std::vector<T> &props, int idx) {
 PLYImporter::PLYImporter() :
         mBuffer(nullptr),
         pcDOM(nullptr),
-        mGeneratedMesh(nullptr) {
+        mGeneratedMesh(nullptr),
+        mNumThreads(-1) {
     // empty
 }
 
@@ -120,6 +126,11 @@ bool PLYImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool c
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+void PLYImporter::SetupProperties(const Importer *pImp) {
+    mNumThreads = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1);
+}
+
 // ------------------------------------------------------------------------------------------------
 const aiImporterDesc *PLYImporter::GetInfo() const {
     return &desc;
@@ -483,6 +494,102 @@ void PLYImporter::LoadVertex(const PLY::Element *pcElement, const PLY::ElementIn
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+// Decode binary vertex records straight into the mesh. Produces the same vertices as LoadVertex.
+void PLYImporter::LoadVertices(const PLY::Element *pcElement, const PLY::BinaryLayout &layout,
+        const char *pCur, unsigned int first, unsigned int count, bool p_bBE) {
+    ai_assert(nullptr != pcElement);
+    ai_assert(nullptr != pCur);
+
+    // vertex channels in ESemantic order: position, normal, texture coordinates, color
+    static const unsigned int NumChannels = PLY::EST_Alpha + 1;
+    struct Channel {
+        unsigned int iOffset;
+        PLY::EDataType eType;
+        unsigned int iSemantic;
+    };
+    Channel aChannels[NumChannels];
+    bool bHasChannel[NumChannels] = {};
+    for (size_t a = 0; a < pcElement->alProperties.size(); ++a) {
+        const PLY::Property &prop = pcElement->alProperties[a];
+        if (prop.Semantic < NumChannels) {
+            aChannels[prop.Semantic].iOffset = layout.aiOffsets[a];
+            aChannels[prop.Semantic].eType = prop.eType;
+            aChannels[prop.Semantic].iSemantic = prop.Semantic;
+            bHasChannel[prop.Semantic] = true;
+        }
+    }
+
+    unsigned int cnt = 0;
+    for (unsigned int a = 0; a < NumChannels; ++a) {
+        if (bHasChannel[a]) {
+            aChannels[cnt++] = aChannels[a];
+        }
+    }
+    // check whether we have a valid source for the vertex data
+    if (0 == cnt) {
+        return;
+    }
+    const bool haveNormal = bHasChannel[PLY::EST_XNormal] || bHasChannel[PLY::EST_YNormal] || bHasChannel[PLY::EST_ZNormal];
+    const bool haveTextureCoords = bHasChannel[PLY::EST_UTextureCoord] || bHasChannel[PLY::EST_VTextureCoord];
+    const bool haveColor = bHasChannel[PLY::EST_Red] || bHasChannel[PLY::EST_Green] || bHasChannel[PLY::EST_Blue] || bHasChannel[PLY::EST_Alpha];
+
+    //create aiMesh if needed
+    if (nullptr == mGeneratedMesh) {
+        mGeneratedMesh = new aiMesh();
+        mGeneratedMesh->mMaterialIndex = 0;
+    }
+    aiMesh *mesh = mGeneratedMesh;
+    if (nullptr == mesh->mVertices) {
+        mesh->mNumVertices = pcElement->NumOccur;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    }
+    if (haveNormal && nullptr == mesh->mNormals) {
+        mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+    }
+    if (haveColor && nullptr == mesh->mColors[0]) {
+        mesh->mColors[0] = new aiColor4D[mesh->mNumVertices];
+    }
+    if (haveTextureCoords && nullptr == mesh->mTextureCoords[0]) {
+        mesh->mNumUVComponents[0] = 2;
+        mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+    }
+
+    m_checkpoint.Check(first, pcElement->NumOccur);
+
+    const unsigned int recordSize = layout.RecordSize;
+    ParallelFor(count, GetNumWorkerThreads(mNumThreads), MinVerticesPerThread,
+            [&aChannels, cnt, haveNormal, haveColor, haveTextureCoords, mesh, pCur, first, recordSize, p_bBE](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    const char *record = pCur + i * recordSize;
+
+                    // missing channels are 0, except for alpha
+                    ai_real values[NumChannels] = {};
+                    values[PLY::EST_Alpha] = 1.0;
+                    for (unsigned int a = 0; a < cnt; ++a) {
+                        const Channel &channel = aChannels[a];
+                        const PLY::PropertyInstance::ValueUnion v =
+                                PLY::PropertyInstance::ReadValueBinary(record + channel.iOffset, channel.eType, p_bBE);
+                        values[channel.iSemantic] = channel.iSemantic >= PLY::EST_Red ?
+                                                            NormalizeColorValue(v, channel.eType) :
+                                                            PLY::PropertyInstance::ConvertTo<ai_real>(v, channel.eType);
+                    }
+
+                    const size_t pos = first + i;
+                    mesh->mVertices[pos] = aiVector3D(values[PLY::EST_XCoord], values[PLY::EST_YCoord], values[PLY::EST_ZCoord]);
+                    if (haveNormal) {
+                        mesh->mNormals[pos] = aiVector3D(values[PLY::EST_XNormal], values[PLY::EST_YNormal], values[PLY::EST_ZNormal]);
+                    }
+                    if (haveColor) {
+                        mesh->mColors[0][pos] = aiColor4D(values[PLY::EST_Red], values[PLY::EST_Green], values[PLY::EST_Blue], values[PLY::EST_Alpha]);
+                    }
+                    if (haveTextureCoords) {
+                        mesh->mTextureCoords[0][pos] = aiVector3D(values[PLY::EST_UTextureCoord], values[PLY::EST_VTextureCoord], 0);
+                    }
+                }
+            });
+}
+
 // ------------------------------------------------------------------------------------------------
 // Convert a color component to [0...1]
 ai_real PLYImporter::NormalizeColorValue(PLY::PropertyInstance::ValueUnion val, PLY::EDataType eType) {
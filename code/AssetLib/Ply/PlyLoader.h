@@ -73,11 +73,24 @@ public:
     bool CanRead(const std::string &pFile, IOSystem *pIOHandler,
             bool checkSig) const;
 
+    // -------------------------------------------------------------------
+    /** Called prior to ReadFile().
+     * The function is a request to the importer to update its configuration
+     * basing on the Importer's configuration property list.
+     */
+    void SetupProperties(const Importer *pImp);
+
     // -------------------------------------------------------------------
     /** Extract a vertex from the DOM
     */
     void LoadVertex(const PLY::Element *pcElement, const PLY::ElementInstance *instElement, unsigned int pos);
 
+    // -------------------------------------------------------------------
+    /** Extract vertices first ... first+count-1 from binary records
+    */
+    void LoadVertices(const PLY::Element *pcElement, const PLY::BinaryLayout &layout,
+            const char *pCur, unsigned int first, unsigned int count, bool p_bBE);
+
     // -------------------------------------------------------------------
     /** Extract a face from the DOM
     */
@@ -127,6 +140,9 @@ protected:
 
     /** Mesh generated by loader */
     aiMesh *mGeneratedMesh;
+
+    /** Configuration option: number of threads, see AI_CONFIG_GLOB_MULTITHREADING */
+    int mNumThreads;
 };
 
 } // end of namespace Assimp
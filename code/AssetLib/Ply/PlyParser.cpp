@@ -48,9 +48,27 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/ByteSwapper.h>
 #include <assimp/fast_atof.h>
 #include <assimp/DefaultLogger.hpp>
+#include <algorithm>
 
 using namespace Assimp;
 
+// ------------------------------------------------------------------------------------------------
+// Appends the next file block to the unread rest of the buffer
+static void ReadNextBlock(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
+        const char *&pCur, unsigned int &bufferSize) {
+    std::vector<char> nbuffer;
+    if (streamBuffer.getNextBlock(nbuffer)) {
+        //concat buffer contents
+        buffer = std::vector<char>(buffer.end() - bufferSize, buffer.end());
+        buffer.insert(buffer.end(), nbuffer.begin(), nbuffer.end());
+        nbuffer.clear();
+        bufferSize = static_cast<unsigned int>(buffer.size());
+        pCur = (char *)&buffer[0];
+    } else {
+        throw DeadlyImportError("Invalid .ply file: File corrupted");
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 PLY::EDataType PLY::Property::ParseDataType(std::vector<char> &buffer) {
     ai_assert(!buffer.empty());
@@ -472,7 +490,10 @@ bool PLY::DOM::ParseElementInstanceListsBinary(IOStreamBuffer<char> &streamBuffe
 
     // parse all element instances
     for (; i != alElements.end(); ++i, ++a) {
-        if ((*i).eSemantic == EEST_Vertex || (*i).eSemantic == EEST_Face || (*i).eSemantic == EEST_TriStrip) {
+        PLY::BinaryLayout layout;
+        if ((*i).eSemantic == EEST_Vertex && PLY::BinaryLayout::Compile(&(*i), &layout)) {
+            PLY::ElementInstanceList::ParseRecordListBinary(streamBuffer, buffer, pCur, bufferSize, &(*i), layout, loader, p_bBE);
+        } else if ((*i).eSemantic == EEST_Vertex || (*i).eSemantic == EEST_Face || (*i).eSemantic == EEST_TriStrip) {
             PLY::ElementInstanceList::ParseInstanceListBinary(streamBuffer, buffer, pCur, bufferSize, &(*i), nullptr, loader, p_bBE);
         } else {
             (*a).alInstances.resize((*i).NumOccur);
@@ -576,8 +597,13 @@ bool PLY::ElementInstanceList::ParseInstanceList(
                 }
             }
 
-            streamBuffer.getNextLine(buffer);
-            pCur = (buffer.empty()) ? nullptr : (const char *)&buffer[0];
+            // the line after the list is handed on to the next element in buffer,
+            // all others are read in place
+            size_t length = 0;
+            if (i + 1 == pcElement->NumOccur || !streamBuffer.getNextLineView(pCur, length)) {
+                streamBuffer.getNextLine(buffer);
+                pCur = (buffer.empty()) ? nullptr : (const char *)&buffer[0];
+            }
         }
     }
     return true;
@@ -622,6 +648,57 @@ bool PLY::ElementInstanceList::ParseInstanceListBinary(
     return true;
 }
 
+// ------------------------------------------------------------------------------------------------
+bool PLY::ElementInstanceList::ParseRecordListBinary(
+        IOStreamBuffer<char> &streamBuffer,
+        std::vector<char> &buffer,
+        const char *&pCur,
+        unsigned int &bufferSize,
+        const PLY::Element *pcElement,
+        const PLY::BinaryLayout &layout,
+        PLYImporter *loader,
+        bool p_bBE) {
+    ai_assert(nullptr != pcElement);
+    ai_assert(nullptr != loader);
+    ai_assert(0 != layout.RecordSize);
+
+    unsigned int i = 0;
+    while (i < pcElement->NumOccur) {
+        //read the next file block if not even one record is left
+        if (bufferSize < layout.RecordSize) {
+            ReadNextBlock(streamBuffer, buffer, pCur, bufferSize);
+            continue;
+        }
+
+        const unsigned int count = std::min(bufferSize / layout.RecordSize, pcElement->NumOccur - i);
+        loader->LoadVertices(pcElement, layout, pCur, i, count, p_bBE);
+
+        pCur += count * layout.RecordSize;
+        bufferSize -= count * layout.RecordSize;
+        i += count;
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+bool PLY::BinaryLayout::Compile(const PLY::Element *pcElement, PLY::BinaryLayout *pOut) {
+    ai_assert(nullptr != pcElement);
+    ai_assert(nullptr != pOut);
+
+    pOut->aiOffsets.resize(pcElement->alProperties.size());
+    pOut->RecordSize = 0;
+    for (size_t i = 0; i < pcElement->alProperties.size(); ++i) {
+        const PLY::Property &prop = pcElement->alProperties[i];
+        const unsigned int size = PLY::PropertyInstance::SizeOf(prop.eType);
+        if (prop.bIsList || 0 == size) {
+            return false;
+        }
+        pOut->aiOffsets[i] = pOut->RecordSize;
+        pOut->RecordSize += size;
+    }
+    return 0 != pOut->RecordSize;
+}
+
 // ------------------------------------------------------------------------------------------------
 bool PLY::ElementInstance::ParseInstance(const char *&pCur,
         const PLY::Element *pcElement,
@@ -822,137 +899,136 @@ bool PLY::PropertyInstance::ParseValueBinary(IOStreamBuffer<char> &streamBuffer,
     ai_assert(nullptr != out);
 
     //calc element size
-    unsigned int lsize = 0;
+    const unsigned int lsize = SizeOf(eType);
+
+    //read the next file block if needed
+    if (bufferSize < lsize) {
+        ReadNextBlock(streamBuffer, buffer, pCur, bufferSize);
+    }
+
+    bool ret = true;
+    if (0 != lsize) {
+        *out = ReadValueBinary(pCur, eType, p_bBE);
+        pCur += lsize;
+    } else {
+        ret = false;
+    }
+
+    bufferSize -= lsize;
+
+    return ret;
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int PLY::PropertyInstance::SizeOf(PLY::EDataType eType) {
     switch (eType) {
     case EDT_Char:
     case EDT_UChar:
-        lsize = 1;
-        break;
+        return 1;
 
     case EDT_UShort:
     case EDT_Short:
-        lsize = 2;
-        break;
+        return 2;
 
     case EDT_UInt:
     case EDT_Int:
     case EDT_Float:
-        lsize = 4;
-        break;
+        return 4;
 
     case EDT_Double:
-        lsize = 8;
-        break;
+        return 8;
 
     case EDT_INVALID:
     default:
         break;
     }
+    return 0;
+}
 
-    //read the next file block if needed
-    if (bufferSize < lsize) {
-        std::vector<char> nbuffer;
-        if (streamBuffer.getNextBlock(nbuffer)) {
-            //concat buffer contents
-            buffer = std::vector<char>(buffer.end() - bufferSize, buffer.end());
-            buffer.insert(buffer.end(), nbuffer.begin(), nbuffer.end());
-            nbuffer.clear();
-            bufferSize = static_cast<unsigned int>(buffer.size());
-            pCur = (char *)&buffer[0];
-        } else {
-            throw DeadlyImportError("Invalid .ply file: File corrupted");
-        }
-    }
+// ------------------------------------------------------------------------------------------------
+PLY::PropertyInstance::ValueUnion PLY::PropertyInstance::ReadValueBinary(const char *pCur,
+        PLY::EDataType eType,
+        bool p_bBE) {
+    ai_assert(nullptr != pCur);
 
-    bool ret = true;
+    PLY::PropertyInstance::ValueUnion out;
     switch (eType) {
     case EDT_UInt: {
         uint32_t t;
         memcpy(&t, pCur, sizeof(uint32_t));
-        pCur += sizeof(uint32_t);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
-        out->iUInt = t;
+        out.iUInt = t;
         break;
     }
 
     case EDT_UShort: {
         uint16_t t;
         memcpy(&t, pCur, sizeof(uint16_t));
-        pCur += sizeof(uint16_t);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
-        out->iUInt = t;
+        out.iUInt = t;
         break;
     }
 
     case EDT_UChar: {
         uint8_t t;
         memcpy(&t, pCur, sizeof(uint8_t));
-        pCur += sizeof(uint8_t);
-        out->iUInt = t;
+        out.iUInt = t;
         break;
     }
 
     case EDT_Int: {
         int32_t t;
         memcpy(&t, pCur, sizeof(int32_t));
-        pCur += sizeof(int32_t);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
-        out->iInt = t;
+        out.iInt = t;
         break;
     }
 
     case EDT_Short: {
         int16_t t;
         memcpy(&t, pCur, sizeof(int16_t));
-        pCur += sizeof(int16_t);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
-        out->iInt = t;
+        out.iInt = t;
         break;
     }
 
     case EDT_Char: {
         int8_t t;
         memcpy(&t, pCur, sizeof(int8_t));
-        pCur += sizeof(int8_t);
-        out->iInt = t;
+        out.iInt = t;
         break;
     }
 
     case EDT_Float: {
         float t;
         memcpy(&t, pCur, sizeof(float));
-        pCur += sizeof(float);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
-        out->fFloat = t;
+        out.fFloat = t;
         break;
     }
     case EDT_Double: {
         double t;
         memcpy(&t, pCur, sizeof(double));
-        pCur += sizeof(double);
 
         // Swap endianness
         if (p_bBE) ByteSwap::Swap(&t);
-        out->fDouble = t;
+        out.fDouble = t;
         break;
     }
     default:
-        ret = false;
+        out.iUInt = 0;
     }
-
-    bufferSize -= lsize;
-
-    return ret;
+    return out;
 }
 
 #endif // !! ASSIMP_BUILD_NO_PLY_IMPORTER
@@ -348,12 +348,47 @@ public:
     static bool ParseValueBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
         const char* &pCur, unsigned int &bufferSize, EDataType eType, ValueUnion* out, bool p_bBE);
 
+    // -------------------------------------------------------------------
+    //! Read a binary value from memory, pCur must hold SizeOf(eType) bytes
+    static ValueUnion ReadValueBinary(const char* pCur, EDataType eType, bool p_bBE);
+
+    // -------------------------------------------------------------------
+    //! Get the size of a binary value of a given type, 0 for invalid types
+    static unsigned int SizeOf(EDataType eType);
+
     // -------------------------------------------------------------------
     //! Convert a property value to a given type TYPE
     template <typename TYPE>
     static TYPE ConvertTo(ValueUnion v, EDataType eType);
 };
 
+// ---------------------------------------------------------------------------------
+/** \brief Record layout of a binary element without list properties
+ *
+ * All instances of such an element have the same size, so they can be
+ * decoded straight from the file data without building element instances.
+ */
+class BinaryLayout {
+public:
+    //! Default constructor
+    BinaryLayout() AI_NO_EXCEPT
+    : aiOffsets()
+    , RecordSize(0) {
+        // empty
+    }
+
+    //! Byte offset of each property within a record
+    std::vector<unsigned int> aiOffsets;
+
+    //! Size of a record in bytes
+    unsigned int RecordSize;
+
+    // -------------------------------------------------------------------
+    //! Compute the layout of an element. Returns false if the element
+    //! has no properties, list properties or properties of unknown type.
+    static bool Compile(const Element* pcElement, BinaryLayout* pOut);
+};
+
 // ---------------------------------------------------------------------------------
 /** \brief Class for an element instance in a PLY file
  */
@@ -404,6 +439,12 @@ public:
     //! Parse a binary element instance list
     static bool ParseInstanceListBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
         const char* &pCur, unsigned int &bufferSize, const Element* pcElement, ElementInstanceList* p_pcOut, PLYImporter* loader, bool p_bBE);
+
+    // -------------------------------------------------------------------
+    //! Hand a binary element list with a fixed record layout to the loader,
+    //! as many records at once as the current file block holds
+    static bool ParseRecordListBinary(IOStreamBuffer<char> &streamBuffer, std::vector<char> &buffer,
+        const char* &pCur, unsigned int &bufferSize, const Element* pcElement, const BinaryLayout &layout, PLYImporter* loader, bool p_bBE);
 };
 // ---------------------------------------------------------------------------------
 /** \brief Class to represent the document object model of an ASCII or binary
@@ -49,6 +49,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "STEPFileEncoding.h"
 #include <assimp/TinyFormatter.h>
 #include <assimp/fast_atof.h>
+#include <assimp/Cancellation.h>
 #include <memory>
 #include <functional>
 
@@ -168,7 +169,8 @@ bool IsEntityDef(const std::string& snext)
 // ------------------------------------------------------------------------------------------------
 void STEP::ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme,
     const char* const* types_to_track, size_t len,
-    const char* const* inverse_indices_to_track, size_t len2)
+    const char* const* inverse_indices_to_track, size_t len2,
+    ImportCheckpoint *checkpoint)
 {
     db.SetSchema(scheme);
     db.SetTypesToTrack(types_to_track,len);
@@ -178,6 +180,9 @@ void STEP::ReadFile(DB& db,const EXPRESS::ConversionSchema& scheme,
     LineSplitter& splitter = db.GetSplitter();
 
     while (splitter) {
+        if (checkpoint) {
+            checkpoint->Check();
+        }
         bool has_next = false;
         std::string s = *splitter;
         if (s == "ENDSEC;") {
@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #if !defined(ASSIMP_BUILD_NO_EXPORT) && !defined(ASSIMP_BUILD_NO_STL_EXPORTER)
 
 #include "STLExporter.h"
+#include "Common/ParallelFor.h"
 #include <assimp/version.h>
 #include <assimp/IOSystem.hpp>
 #include <assimp/scene.h>
@@ -53,8 +54,106 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Exceptional.h>
 #include <assimp/ByteSwapper.h>
 
+#include <cstring>
+#include <vector>
+
 using namespace Assimp;
 
+namespace {
+
+// Size of a facet in a binary STL file: normal, three corners and a 16 bit attribute
+static const size_t BinaryFacetSize = 50;
+
+// Facets assembled per chunk before it is handed to the output, about 3 MB
+static const size_t FacetsPerChunk = 65536;
+
+// Facets per thread at least, smaller chunks are encoded on the calling thread
+static const size_t MinFacetsPerThread = 8192;
+
+inline void PutFloat(unsigned char *out, ai_real value) {
+    // STL binary files use 4-byte floats. This may possibly cause loss of precision
+    // for clients using 8-byte doubles
+    float f = static_cast<float>(value);
+    AI_SWAP4(f);
+    ::memcpy(out, &f, sizeof(float));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Encodes the faces [begin, end) of a mesh as binary facets. STL only knows
+// triangles: larger faces are cut to their first three corners, points and
+// lines repeat their last corner.
+void EncodeFacets(const aiMesh *m, size_t begin, size_t end, unsigned char *out) {
+    for (size_t i = begin; i < end; ++i, out += BinaryFacetSize) {
+        const aiFace &f = m->mFaces[i];
+
+        // we need per-face normals. We specified aiProcess_GenNormals as pre-requisite for this exporter,
+        // but nonetheless we have to expect per-vertex normals.
+        aiVector3D nor;
+        if (m->mNormals) {
+            for (unsigned int a = 0; a < f.mNumIndices; ++a) {
+                nor += m->mNormals[f.mIndices[a]];
+            }
+            nor.NormalizeSafe();
+        }
+        PutFloat(out, nor.x);
+        PutFloat(out + 4, nor.y);
+        PutFloat(out + 8, nor.z);
+
+        for (unsigned int a = 0; a < 3; ++a) {
+            aiVector3D v;
+            if (f.mNumIndices) {
+                v = m->mVertices[f.mIndices[std::min(a, f.mNumIndices - 1)]];
+            }
+            PutFloat(out + 12 + a * 12, v.x);
+            PutFloat(out + 16 + a * 12, v.y);
+            PutFloat(out + 20 + a * 12, v.z);
+        }
+        out[48] = out[49] = 0;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Writes the binary header and all facets of a scene. The facets are encoded
+// in parallel into a chunk buffer which is passed to write(data, size) once full.
+template <typename WriteFunc>
+void WriteBinarySTL(const aiScene *pScene, unsigned int numThreads, WriteFunc write) {
+    char buf[80] = {0} ;
+    buf[0] = 'A'; buf[1] = 's'; buf[2] = 's'; buf[3] = 'i'; buf[4] = 'm'; buf[5] = 'p';
+    buf[6] = 'S'; buf[7] = 'c'; buf[8] = 'e'; buf[9] = 'n'; buf[10] = 'e';
+    write(buf, 80);
+
+    uint32_t meshnum = 0;
+    for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+        meshnum += pScene->mMeshes[i]->mNumFaces;
+    }
+    AI_SWAP4(meshnum);
+    write(reinterpret_cast<const char *>(&meshnum), 4);
+
+    std::vector<unsigned char> chunk(FacetsPerChunk * BinaryFacetSize);
+    size_t used = 0;
+    for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
+        const aiMesh *m = pScene->mMeshes[i];
+        for (size_t first = 0; first < m->mNumFaces;) {
+            const size_t count = std::min<size_t>(m->mNumFaces - first, FacetsPerChunk - used);
+            unsigned char *out = chunk.data() + used * BinaryFacetSize;
+            ParallelFor(count, numThreads, MinFacetsPerThread, [m, first, out](size_t begin, size_t end) {
+                EncodeFacets(m, first + begin, first + end, out + begin * BinaryFacetSize);
+            });
+            first += count;
+            used += count;
+            if (FacetsPerChunk == used) {
+                write(reinterpret_cast<const char *>(chunk.data()), used * BinaryFacetSize);
+                used = 0;
+            }
+        }
+    }
+    if (used) {
+        write(reinterpret_cast<const char *>(chunk.data()), used * BinaryFacetSize);
+    }
+}
+
+} // namespace
+
 namespace Assimp    {
 
 // ------------------------------------------------------------------------------------------------
@@ -81,21 +180,22 @@ void ExportSceneSTL(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene
 void ExportSceneSTLBinary(const char* pFile,IOSystem* pIOSystem, const aiScene* pScene, const ExportProperties* pProperties )
 {
     bool exportPointClouds = pProperties->GetPropertyBool(AI_CONFIG_EXPORT_POINT_CLOUDS);
-
-    // invoke the exporter
-    STLExporter exporter(pFile, pScene, exportPointClouds, true);
-
-    if (exporter.mOutput.fail()) {
-        throw DeadlyExportError("output data creation failed. Most likely the file became too large: " + std::string(pFile));
+    if (exportPointClouds) {
+        throw DeadlyExportError("This functionality is not yet implemented for binary output.");
     }
-    
-    // we're still here - export successfully completed. Write the file.
+
     std::unique_ptr<IOStream> outfile (pIOSystem->Open(pFile,"wb"));
     if (outfile == nullptr) {
         throw DeadlyExportError("could not open output .stl file: " + std::string(pFile));
     }
 
-    outfile->Write( exporter.mOutput.str().c_str(), static_cast<size_t>(exporter.mOutput.tellp()),1);
+    // stream the facets chunk by chunk, no copy of the whole file is kept in memory
+    const unsigned int numThreads = GetNumWorkerThreads(pProperties->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1));
+    WriteBinarySTL(pScene, numThreads, [&outfile, pFile](const char *data, size_t size) {
+        if (outfile->Write(data, size, 1) != 1) {
+            throw DeadlyExportError("could not write output .stl file: " + std::string(pFile));
+        }
+    });
 }
 
 } // end of namespace Assimp
@@ -113,26 +213,13 @@ STLExporter::STLExporter(const char* _filename, const aiScene* pScene, bool expo
     mOutput.imbue(l);
     mOutput.precision(ASSIMP_AI_REAL_TEXT_PRECISION);
     if (binary) {
-        char buf[80] = {0} ;
-        buf[0] = 'A'; buf[1] = 's'; buf[2] = 's'; buf[3] = 'i'; buf[4] = 'm'; buf[5] = 'p';
-        buf[6] = 'S'; buf[7] = 'c'; buf[8] = 'e'; buf[9] = 'n'; buf[10] = 'e';
-        mOutput.write(buf, 80);
-        unsigned int meshnum = 0;
-        for(unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
-            for (unsigned int j = 0; j < pScene->mMeshes[i]->mNumFaces; ++j) {
-                meshnum++;
-            }
-        }
-        AI_SWAP4(meshnum);
-        mOutput.write((char *)&meshnum, 4);
-
         if (exportPointClouds) {
             throw DeadlyExportError("This functionality is not yet implemented for binary output.");
         }
 
-        for(unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
-            WriteMeshBinary(pScene->mMeshes[i]);
-        }
+        WriteBinarySTL(pScene, GetNumWorkerThreads(-1), [this](const char *data, size_t size) {
+            mOutput.write(data, size);
+        });
     } else {
 
         // Exporting only point clouds
@@ -199,35 +286,4 @@ void STLExporter::WriteMesh(const aiMesh* m)
     }
 }
 
-void STLExporter::WriteMeshBinary(const aiMesh* m)
-{
-    for (unsigned int i = 0; i < m->mNumFaces; ++i) {
-        const aiFace& f = m->mFaces[i];
-        // we need per-face normals. We specified aiProcess_GenNormals as pre-requisite for this exporter,
-        // but nonetheless we have to expect per-vertex normals.
-        aiVector3D nor;
-        if (m->mNormals) {
-            for(unsigned int a = 0; a < f.mNumIndices; ++a) {
-                nor += m->mNormals[f.mIndices[a]];
-            }
-            nor.Normalize();
-        }
-        // STL binary files use 4-byte floats. This may possibly cause loss of precision
-        // for clients using 8-byte doubles
-        float nx = (float) nor.x;
-        float ny = (float) nor.y;
-        float nz = (float) nor.z;
-        AI_SWAP4(nx); AI_SWAP4(ny); AI_SWAP4(nz);
-        mOutput.write((char *)&nx, 4); mOutput.write((char *)&ny, 4); mOutput.write((char *)&nz, 4);
-        for(unsigned int a = 0; a < f.mNumIndices; ++a) {
-            const aiVector3D& v  = m->mVertices[f.mIndices[a]];
-            float vx = (float) v.x, vy = (float) v.y, vz = (float) v.z;
-            AI_SWAP4(vx); AI_SWAP4(vy); AI_SWAP4(vz);
-            mOutput.write((char *)&vx, 4); mOutput.write((char *)&vy, 4); mOutput.write((char *)&vz, 4);
-        }
-        char dummy[2] = {0};
-        mOutput.write(dummy, 2);
-    }
-}
-
 #endif
@@ -69,7 +69,6 @@ public:
 private:
     void WritePointCloud(const std::string &name, const aiScene* pScene);
     void WriteMesh(const aiMesh* m);
-    void WriteMeshBinary(const aiMesh* m);
 
 private:
 
@@ -45,12 +45,17 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers
 #include "STLLoader.h"
+#include "Common/ParallelFor.h"
+#include "Common/VertexTriangleAdjacency.h"
 #include <assimp/ParsingUtils.h>
 #include <assimp/fast_atof.h>
 #include <assimp/importerdesc.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/IOSystem.hpp>
+#include <assimp/Importer.hpp>
+#include <atomic>
+#include <climits>
 #include <memory>
 
 using namespace Assimp;
@@ -87,6 +92,30 @@ static bool IsBinarySTL(const char *buffer, unsigned int fileSize) {
     return expectedBinaryFileSize == fileSize;
 }
 
+// Size of a facet in a binary STL file: normal, three corners and a 16 bit attribute
+static const size_t BinaryFacetSize = 50;
+
+// Facets per thread at least, smaller files are decoded on the calling thread
+static const size_t MinFacetsPerThread = 16384;
+
+inline uint16_t GetFacetAttribute(const unsigned char *facet) {
+    uint16_t attribute;
+    ::memcpy(&attribute, facet + 48, sizeof(uint16_t));
+    return attribute;
+}
+
+// FNV-1a over the position, -0 and +0 hash to the same value as they compare equal
+inline uint32_t HashPosition(const aiVector3D &v) {
+    const ai_real c[3] = { v.x + ai_real(0.0), v.y + ai_real(0.0), v.z + ai_real(0.0) };
+    unsigned char bytes[sizeof(c)];
+    ::memcpy(bytes, c, sizeof(c));
+    uint32_t hash = 2166136261u;
+    for (unsigned char b : bytes) {
+        hash = (hash ^ b) * 16777619u;
+    }
+    return hash;
+}
+
 static const size_t BufferSize = 500;
 static const char UnicodeBoundary = 127;
 
@@ -129,7 +158,10 @@ static bool IsAsciiSTL(const char *buffer, unsigned int fileSize) {
 STLImporter::STLImporter() :
         mBuffer(),
         mFileSize(0),
-        mScene() {
+        mScene(),
+        mWeldVertices(false),
+        mRecomputeNormals(false),
+        mNumThreads(-1) {
    // empty
 }
 
@@ -157,6 +189,13 @@ bool STLImporter::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool c
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+void STLImporter::SetupProperties(const Importer *pImp) {
+    mWeldVertices = pImp->GetPropertyBool(AI_CONFIG_IMPORT_STL_WELD_VERTICES, false);
+    mRecomputeNormals = pImp->GetPropertyBool(AI_CONFIG_IMPORT_STL_RECOMPUTE_NORMALS, false);
+    mNumThreads = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1);
+}
+
 // ------------------------------------------------------------------------------------------------
 const aiImporterDesc *STLImporter::GetInfo() const {
     return &desc;
@@ -464,88 +503,83 @@ bool STLImporter::LoadBinaryFile() {
     aiVector3D *vp = pMesh->mVertices = new aiVector3D[pMesh->mNumVertices];
     aiVector3D *vn = pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
 
-    typedef aiVector3t<float> aiVector3F;
-    aiVector3F *theVec;
-    aiVector3F theVec3F;
-
-    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
-        // NOTE: Blender sometimes writes empty normals ... this is not
-        // our fault ... the RemoveInvalidData helper step should fix that
-
-        // There's one normal for the face in the STL; use it three times
-        // for vertex normals
-        theVec = (aiVector3F *)sz;
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vn->x = theVec3F.x;
-        vn->y = theVec3F.y;
-        vn->z = theVec3F.z;
-        *(vn + 1) = *vn;
-        *(vn + 2) = *vn;
-        ++theVec;
-        vn += 3;
-
-        // vertex 1
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        // vertex 2
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        // vertex 3
-        ::memcpy(&theVec3F, theVec, sizeof(aiVector3F));
-        vp->x = theVec3F.x;
-        vp->y = theVec3F.y;
-        vp->z = theVec3F.z;
-        ++theVec;
-        ++vp;
-
-        sz = (const unsigned char *)theVec;
-
-        uint16_t color = *((uint16_t *)sz);
-        sz += 2;
-
-        if (color & (1 << 15)) {
-            // seems we need to take the color
-            if (!pMesh->mColors[0]) {
-                pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
-                for (unsigned int j = 0; j < pMesh->mNumVertices; ++j) {
-                    *pMesh->mColors[0]++ = mClrColorDefault;
-                }
-                pMesh->mColors[0] -= pMesh->mNumVertices;
-
-                ASSIMP_LOG_INFO("STL: Mesh has vertex colors");
-            }
-            aiColor4D *clr = &pMesh->mColors[0][i * 3];
-            clr->a = 1.0;
-            const ai_real invVal((ai_real)1.0 / (ai_real)31.0);
-            if (bIsMaterialise) // this is reversed
-            {
-                clr->r = (color & 0x31u) * invVal;
-                clr->g = ((color & (0x31u << 5)) >> 5u) * invVal;
-                clr->b = ((color & (0x31u << 10)) >> 10u) * invVal;
+    // Decode blocks of facets in parallel. The 50 byte stride leaves the floats
+    // unaligned, so each facet is fetched with a single 48 byte copy.
+    const unsigned int numThreads = GetNumWorkerThreads(mNumThreads);
+    const bool recomputeNormals = mRecomputeNormals;
+    std::atomic<bool> hasColors(false);
+    ParallelFor(pMesh->mNumFaces, numThreads, MinFacetsPerThread, [sz, vp, vn, recomputeNormals, &hasColors](size_t begin, size_t end) {
+        bool colors = false;
+        for (size_t i = begin; i < end; ++i) {
+            const unsigned char *facet = sz + i * BinaryFacetSize;
+            float data[12];
+            ::memcpy(data, facet, sizeof(data));
+
+            aiVector3D *v = vp + i * 3;
+            v[0].Set(data[3], data[4], data[5]);
+            v[1].Set(data[6], data[7], data[8]);
+            v[2].Set(data[9], data[10], data[11]);
+
+            // NOTE: Blender sometimes writes empty normals ... this is not
+            // our fault ... the RemoveInvalidData helper step should fix that
+
+            // There's one normal for the face in the STL; use it three times
+            // for vertex normals
+            aiVector3D *n = vn + i * 3;
+            if (recomputeNormals) {
+                n[0] = ((v[1] - v[0]) ^ (v[2] - v[0])).NormalizeSafe();
             } else {
-                clr->b = (color & 0x31u) * invVal;
-                clr->g = ((color & (0x31u << 5)) >> 5u) * invVal;
-                clr->r = ((color & (0x31u << 10)) >> 10u) * invVal;
+                n[0].Set(data[0], data[1], data[2]);
             }
-            // assign the color to all vertices of the face
-            *(clr + 1) = *clr;
-            *(clr + 2) = *clr;
+            n[1] = n[2] = n[0];
+
+            colors |= (GetFacetAttribute(facet) & (1 << 15)) != 0;
         }
+        if (colors) {
+            hasColors = true;
+        }
+    });
+
+    if (hasColors) {
+        // seems we need to take the color
+        ASSIMP_LOG_INFO("STL: Mesh has vertex colors");
+        aiColor4D *clr = pMesh->mColors[0] = new aiColor4D[pMesh->mNumVertices];
+        const aiColor4D clrDefault = mClrColorDefault;
+        ParallelFor(pMesh->mNumFaces, numThreads, MinFacetsPerThread, [sz, clr, clrDefault, bIsMaterialise](size_t begin, size_t end) {
+            const ai_real invVal((ai_real)1.0 / (ai_real)31.0);
+            for (size_t i = begin; i < end; ++i) {
+                const uint16_t color = GetFacetAttribute(sz + i * BinaryFacetSize);
+                aiColor4D c = clrDefault;
+                if (color & (1 << 15)) {
+                    c.a = 1.0;
+                    if (bIsMaterialise) // this is reversed
+                    {
+                        c.r = (color & 0x31u) * invVal;
+                        c.g = ((color & (0x31u << 5)) >> 5u) * invVal;
+                        c.b = ((color & (0x31u << 10)) >> 10u) * invVal;
+                    } else {
+                        c.b = (color & 0x31u) * invVal;
+                        c.g = ((color & (0x31u << 5)) >> 5u) * invVal;
+                        c.r = ((color & (0x31u << 10)) >> 10u) * invVal;
+                    }
+                }
+                // assign the color to all vertices of the face
+                clr[i * 3] = clr[i * 3 + 1] = clr[i * 3 + 2] = c;
+            }
+        });
     }
 
     // now copy faces
     addFacesToMesh(pMesh);
 
+    if (mWeldVertices) {
+        if (pMesh->mColors[0]) {
+            ASSIMP_LOG_INFO("STL: Facet colors present, vertices are not welded");
+        } else {
+            WeldVertices(pMesh, numThreads);
+        }
+    }
+
     aiNode *root = mScene->mRootNode;
 
     // allocate one node
@@ -570,6 +604,83 @@ bool STLImporter::LoadBinaryFile() {
     return false;
 }
 
+// ------------------------------------------------------------------------------------------------
+void STLImporter::WeldVertices(aiMesh *pMesh, unsigned int numThreads) {
+    const unsigned int numCorners = pMesh->mNumVertices;
+    aiVector3D *positions = pMesh->mVertices;
+
+    std::vector<uint32_t> hashes(numCorners);
+    ParallelFor(numCorners, numThreads, MinFacetsPerThread, [positions, &hashes](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            hashes[i] = HashPosition(positions[i]);
+        }
+    });
+
+    // Look up each corner in an open addressing table holding the index of the
+    // first vertex at each position. Unique positions are compacted in place,
+    // the write position never passes the corner being read.
+    size_t tableSize = 1;
+    while (tableSize < size_t(numCorners) * 2) {
+        tableSize <<= 1;
+    }
+    const size_t mask = tableSize - 1;
+    std::vector<unsigned int> table(tableSize, UINT_MAX);
+    std::vector<unsigned int> remap(numCorners);
+    unsigned int numUnique = 0;
+    for (unsigned int i = 0; i < numCorners; ++i) {
+        for (size_t slot = hashes[i] & mask;; slot = (slot + 1) & mask) {
+            const unsigned int index = table[slot];
+            if (UINT_MAX == index) {
+                table[slot] = remap[i] = numUnique;
+                positions[numUnique++] = positions[i];
+                break;
+            }
+            if (positions[index] == positions[i]) {
+                remap[i] = index;
+                break;
+            }
+        }
+    }
+    ASSIMP_LOG_DEBUG_F("STL: Welded ", numCorners, " corners into ", numUnique, " vertices");
+
+    aiVector3D *vertices = new aiVector3D[numUnique];
+    std::copy(positions, positions + numUnique, vertices);
+    delete[] pMesh->mVertices;
+    pMesh->mVertices = vertices;
+    pMesh->mNumVertices = numUnique;
+
+    aiFace *faces = pMesh->mFaces;
+    std::vector<aiVector3D> faceNormals(pMesh->mNumFaces);
+    ParallelFor(pMesh->mNumFaces, numThreads, MinFacetsPerThread, [faces, vertices, &remap, &faceNormals](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            unsigned int *idx = faces[i].mIndices;
+            for (unsigned int o = 0; o < 3; ++o) {
+                idx[o] = remap[idx[o]];
+            }
+            // not normalized, larger facets get more weight
+            faceNormals[i] = (vertices[idx[1]] - vertices[idx[0]]) ^ (vertices[idx[2]] - vertices[idx[0]]);
+        }
+    });
+
+    // STL has no smoothing information, the vertex normals are the mean of all
+    // adjacent facets.
+    VertexTriangleAdjacency adjacency(faces, pMesh->mNumFaces, numUnique, true);
+    delete[] pMesh->mNormals;
+    aiVector3D *normals = pMesh->mNormals = new aiVector3D[numUnique];
+    ParallelFor(numUnique, numThreads, MinFacetsPerThread, [&adjacency, &faceNormals, normals](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const unsigned int vertex = static_cast<unsigned int>(i);
+            const unsigned int *adjacent = adjacency.GetAdjacentTriangles(vertex);
+            aiVector3D sum;
+            for (unsigned int f = 0; f < adjacency.mLiveTriangles[vertex]; ++f) {
+                sum += faceNormals[adjacent[f]];
+            }
+            normals[i] = sum.NormalizeSafe();
+        }
+    });
+}
+
+// ------------------------------------------------------------------------------------------------
 void STLImporter::pushMeshesToNode(std::vector<unsigned int> &meshIndices, aiNode *node) {
     ai_assert(nullptr != node);
     if (meshIndices.empty()) {
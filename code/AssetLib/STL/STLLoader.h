@@ -50,6 +50,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Forward declarations
 struct aiNode;
+struct aiMesh;
 
 namespace Assimp {
 
@@ -76,6 +77,11 @@ public:
      */
     bool CanRead( const std::string& pFile, IOSystem* pIOHandler, bool checkSig) const;
 
+    /**
+     * @brief   Called prior to ReadFile() to read the import configuration.
+     */
+    void SetupProperties(const Importer* pImp);
+
 protected:
 
     /**
@@ -102,6 +108,12 @@ protected:
      */
     void LoadASCIIFile( aiNode *root );
 
+    /**
+     * @brief   Merges the bitwise identical vertices of a binary mesh and
+     *          replaces the facet normals by smooth vertex normals.
+     */
+    void WeldVertices( aiMesh *pMesh, unsigned int numThreads );
+
     void pushMeshesToNode( std::vector<unsigned int> &meshIndices, aiNode *node );
 
 protected:
@@ -117,6 +129,15 @@ protected:
 
     /** Default vertex color */
     aiColor4D mClrColorDefault;
+
+    /** Configuration option: merge identical vertices of binary files */
+    bool mWeldVertices;
+
+    /** Configuration option: compute facet normals from the geometry */
+    bool mRecomputeNormals;
+
+    /** Configuration option: number of threads, see AI_CONFIG_GLOB_MULTITHREADING */
+    int mNumThreads;
 };
 
 } // end of namespace Assimp
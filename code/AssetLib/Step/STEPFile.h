@@ -88,6 +88,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 namespace Assimp {
 
+class ImportCheckpoint;
+
 // ********************************************************************************
 // before things get complicated, this is the basic outline:
 
@@ -792,7 +794,8 @@ class DB {
     friend DB *ReadFileHeader(std::shared_ptr<IOStream> stream);
     friend void ReadFile(DB &db, const EXPRESS::ConversionSchema &scheme,
             const char *const *types_to_track, size_t len,
-            const char *const *inverse_indices_to_track, size_t len2);
+            const char *const *inverse_indices_to_track, size_t len2,
+            ImportCheckpoint *checkpoint);
 
     friend class LazyObject;
 
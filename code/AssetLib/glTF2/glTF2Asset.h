@@ -46,6 +46,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *   KHR_materials_pbrSpecularGlossiness full
  *   KHR_materials_unlit full
  *   KHR_lights_punctual full
+ *   KHR_mesh_quantization full
+ *   EXT_meshopt_compression ATTRIBUTES and INDICES modes without filters
  */
 #ifndef GLTF2ASSET_H_INC
 #define GLTF2ASSET_H_INC
@@ -384,6 +386,7 @@ struct Accessor : public Object {
     ComponentType componentType; //!< The datatype of components in the attribute. (required)
     size_t count; //!< The number of attributes referenced by this accessor. (required)
     AttribType::Value type; //!< Specifies if the attribute is a scalar, vector, or matrix. (required)
+    bool normalized = false; //!< Specifies whether integer data values are normalized before usage. (default: false)
     std::vector<double> max; //!< Maximum value of each component in this attribute.
     std::vector<double> min; //!< Minimum value of each component in this attribute.
     std::unique_ptr<Sparse> sparse;
@@ -397,6 +400,11 @@ struct Accessor : public Object {
     template <class T>
     void ExtractData(T *&outData);
 
+    //! Extracts the data as ai_real components, converting (normalized) integer
+    //! component types as used by KHR_mesh_quantization.
+    template <class T>
+    void ExtractFloatData(T *&outData);
+
     void WriteData(size_t count, const void *src_buffer, size_t src_stride);
     void WriteSparseValues(size_t count, const void *src_data, size_t src_dataStride);
     void WriteSparseIndices(size_t count, const void *src_idx, size_t src_idxStride);
@@ -525,6 +533,7 @@ public:
 private:
     shared_ptr<uint8_t> mData; //!< Pointer to the data
     bool mIsSpecial; //!< Set to true for special cases (e.g. the body buffer)
+    bool mIsMeshoptFallback; //!< Set to true for EXT_meshopt_compression fallback buffers
 
     /// \var EncodedRegion_List
     /// List of encoded regions.
@@ -573,6 +582,11 @@ public:
 
     bool IsSpecial() const { return mIsSpecial; }
 
+    //! A fallback buffer of EXT_meshopt_compression has no data and no uri
+    void MarkAsMeshoptFallback() { mIsMeshoptFallback = true; }
+
+    bool IsMeshoptFallback() const { return mIsMeshoptFallback; }
+
     std::string GetURI() { return std::string(this->id) + ".bin"; }
 
     static const char *TranslateId(Asset &r, const char *id);
@@ -587,8 +601,31 @@ struct BufferView : public Object {
 
     BufferViewTarget target; //! The target that the WebGL buffer should be bound to.
 
+    //! The EXT_meshopt_compression extension of a buffer view
+    struct MeshoptCompression {
+        enum Mode {
+            Mode_Attributes,
+            Mode_Triangles,
+            Mode_Indices
+        };
+
+        Ref<Buffer> buffer; //!< The buffer holding the compressed data. (required)
+        size_t byteOffset = 0; //!< The offset into the buffer in bytes. (default: 0)
+        size_t byteLength = 0; //!< The length of the compressed data in bytes. (required)
+        unsigned int byteStride = 0; //!< The stride, in bytes, of the decompressed elements. (required)
+        size_t count = 0; //!< The number of elements. (required)
+        Mode mode = Mode_Attributes; //!< The compression mode. (required)
+        std::string filter = "NONE"; //!< The post-decompression filter. (default: "NONE")
+    };
+
+    std::unique_ptr<MeshoptCompression> meshopt; //!< Set if the view is compressed with EXT_meshopt_compression
+    std::vector<uint8_t> decodedData; //!< The decompressed data of a meshopt compressed view
+
     void Read(Value &obj, Asset &r);
     uint8_t *GetPointer(size_t accOffset);
+
+private:
+    void ReadMeshoptCompression(Value &obj, Asset &r);
 };
 
 struct Camera : public Object {
@@ -1040,6 +1077,7 @@ private:
     std::vector<LazyDictBase *> mDicts;
 
     IdMap mUsedIds;
+    IdMap mIdCounters; //!< Next numeric suffix to try for each id prefix, see FindUniqueID()
 
     Ref<Buffer> mBodyBuffer;
 
@@ -1053,11 +1091,15 @@ public:
         bool KHR_materials_unlit;
         bool KHR_lights_punctual;
         bool KHR_texture_transform;
+        bool KHR_mesh_quantization;
+        bool EXT_meshopt_compression;
     } extensionsUsed;
 
     //! Keeps info about the required extensions
     struct RequiredExtensions {
         bool KHR_draco_mesh_compression;
+        bool KHR_mesh_quantization;
+        bool EXT_meshopt_compression;
     } extensionsRequired;
 
     AssetMetadata asset;
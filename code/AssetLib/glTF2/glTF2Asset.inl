@@ -41,6 +41,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "AssetLib/glTF/glTFCommon.h"
+#include "AssetLib/glTF2/glTF2MeshoptCodec.h"
 
 #include <assimp/StringUtils.h>
 #include <assimp/DefaultLogger.hpp>
@@ -353,7 +354,8 @@ inline Buffer::Buffer() :
         byteLength(0),
         type(Type_arraybuffer),
         EncodedRegion_Current(nullptr),
-        mIsSpecial(false) {}
+        mIsSpecial(false),
+        mIsMeshoptFallback(false) {}
 
 inline Buffer::~Buffer() {
     for (SEncodedRegion *reg : EncodedRegion_List)
@@ -370,6 +372,15 @@ inline void Buffer::Read(Value &obj, Asset &r) {
 
     Value *it = FindString(obj, "uri");
     if (!it) {
+        // The data of a meshopt fallback buffer is only referenced by compressed buffer views
+        if (Value *extensions = FindObject(obj, "extensions")) {
+            if (Value *meshoptExt = FindObject(*extensions, "EXT_meshopt_compression")) {
+                if (MemberOrDefault(*meshoptExt, "fallback", false)) {
+                    MarkAsMeshoptFallback();
+                    return;
+                }
+            }
+        }
         if (statedLength > 0) {
             throw DeadlyImportError("GLTF: buffer with non-zero length missing the \"uri\" attribute");
         }
@@ -535,8 +546,9 @@ inline void Buffer::Grow(size_t amount) {
         return;
     }
 
-    // Just allocate data which we need
-    capacity = byteLength + amount;
+    // Grow geometrically, so appending many small accessors does not copy the
+    // whole buffer each time
+    capacity = std::max(byteLength + amount, capacity + capacity / 2);
 
     uint8_t *b = new uint8_t[capacity];
     if (nullptr != mData) {
@@ -569,9 +581,67 @@ inline void BufferView::Read(Value &obj, Asset &r) {
         ai_snprintf(val, val_size, "%llu, %llu", (unsigned long long)byteOffset, (unsigned long long)byteLength);
         throw DeadlyImportError("GLTF: Buffer view with offset/length (", val, ") is out of range.");
     }
+
+    if (Value *extensions = FindObject(obj, "extensions")) {
+        if (Value *meshoptExt = FindObject(*extensions, "EXT_meshopt_compression")) {
+            ReadMeshoptCompression(*meshoptExt, r);
+        }
+    }
+}
+
+inline void BufferView::ReadMeshoptCompression(Value &obj, Asset &r) {
+    meshopt.reset(new MeshoptCompression);
+
+    Value *bufferVal = FindUInt(obj, "buffer");
+    if (!bufferVal) {
+        throw DeadlyImportError("GLTF: EXT_meshopt_compression of buffer view ", getContextForErrorMessages(id, name), " has no buffer");
+    }
+    meshopt->buffer = r.buffers.Retrieve(bufferVal->GetUint());
+    meshopt->byteOffset = MemberOrDefault(obj, "byteOffset", size_t(0));
+    meshopt->byteLength = MemberOrDefault(obj, "byteLength", size_t(0));
+    meshopt->byteStride = MemberOrDefault(obj, "byteStride", 0u);
+    meshopt->count = MemberOrDefault(obj, "count", size_t(0));
+    meshopt->filter = MemberOrDefault<const char *>(obj, "filter", "NONE");
+
+    const char *mode = MemberOrDefault<const char *>(obj, "mode", "");
+    if (strcmp(mode, "ATTRIBUTES") == 0) {
+        meshopt->mode = MeshoptCompression::Mode_Attributes;
+    } else if (strcmp(mode, "TRIANGLES") == 0) {
+        meshopt->mode = MeshoptCompression::Mode_Triangles;
+    } else if (strcmp(mode, "INDICES") == 0) {
+        meshopt->mode = MeshoptCompression::Mode_Indices;
+    } else {
+        throw DeadlyImportError("GLTF: unknown EXT_meshopt_compression mode \"", mode, "\" in ", getContextForErrorMessages(id, name));
+    }
+
+    // Only the modes and filters the exporter writes are decoded
+    if (meshopt->mode == MeshoptCompression::Mode_Triangles || meshopt->filter != "NONE") {
+        throw DeadlyImportError("GLTF: EXT_meshopt_compression with mode \"", mode, "\" and filter \"", meshopt->filter,
+                "\" is not supported in ", getContextForErrorMessages(id, name));
+    }
+
+    const uint8_t *data = meshopt->buffer->GetPointer();
+    const size_t decodedLength = meshopt->count * meshopt->byteStride;
+    if (!data || meshopt->byteOffset + meshopt->byteLength > meshopt->buffer->byteLength || decodedLength > byteLength) {
+        throw DeadlyImportError("GLTF: EXT_meshopt_compression data of ", getContextForErrorMessages(id, name), " is out of range.");
+    }
+
+    decodedData.resize(byteLength, 0);
+    bool ok = false;
+    if (meshopt->mode == MeshoptCompression::Mode_Attributes) {
+        ok = meshopt->byteStride % 4 == 0 && meshopt->byteStride <= 256 &&
+             Meshopt::DecodeVertexBuffer(decodedData.data(), meshopt->count, meshopt->byteStride, data + meshopt->byteOffset, meshopt->byteLength);
+    } else {
+        ok = (meshopt->byteStride == 2 || meshopt->byteStride == 4) &&
+             Meshopt::DecodeIndexSequence(decodedData.data(), meshopt->count, meshopt->byteStride, data + meshopt->byteOffset, meshopt->byteLength);
+    }
+    if (!ok) {
+        throw DeadlyImportError("GLTF: failed to decode EXT_meshopt_compression data of ", getContextForErrorMessages(id, name));
+    }
 }
 
 inline uint8_t *BufferView::GetPointer(size_t accOffset) {
+    if (meshopt) return decodedData.data() + accOffset;
     if (!buffer) return 0;
     uint8_t *basePtr = buffer->GetPointer();
     if (!basePtr) return 0;
@@ -639,6 +709,8 @@ inline void Accessor::Read(Value &obj, Asset &r) {
     componentType = MemberOrDefault(obj, "componentType", ComponentType_BYTE);
     count = MemberOrDefault(obj, "count", size_t(0));
 
+    normalized = MemberOrDefault(obj, "normalized", false);
+
     const char *typestr;
     type = ReadMember(obj, "type", typestr) ? AttribType::FromString(typestr) : AttribType::SCALAR;
 
@@ -708,6 +780,9 @@ inline uint8_t *Accessor::GetPointer() {
     if (sparse)
         return sparse->data.data();
 
+    if (bufferView && bufferView->meshopt)
+        return bufferView->decodedData.data() + byteOffset;
+
     if (!bufferView || !bufferView->buffer) return 0;
     uint8_t *basePtr = bufferView->buffer->GetPointer();
     if (!basePtr) return 0;
@@ -780,6 +855,75 @@ void Accessor::ExtractData(T *&outData) {
     }
 }
 
+template <class T>
+void Accessor::ExtractFloatData(T *&outData) {
+    if (componentType == ComponentType_FLOAT) {
+        ExtractData(outData);
+        return;
+    }
+
+    uint8_t *data = GetPointer();
+    if (!data) {
+        throw DeadlyImportError("GLTF2: data is null when extracting data from ", getContextForErrorMessages(id, name));
+    }
+
+    const unsigned int numComponents = GetNumComponents();
+    const size_t componentSize = GetBytesPerComponent();
+    const size_t elemSize = GetElementSize();
+    const size_t stride = bufferView && bufferView->byteStride ? bufferView->byteStride : elemSize;
+
+    if (numComponents * sizeof(ai_real) > sizeof(T)) {
+        throw DeadlyImportError("GLTF: ", numComponents, " components do not fit into targetElemSize ", sizeof(T), " in ", getContextForErrorMessages(id, name));
+    }
+
+    const size_t maxSize = (bufferView ? bufferView->byteLength : sparse->data.size());
+    if (count * stride > maxSize) {
+        throw DeadlyImportError("GLTF: count*stride ", (count * stride), " > maxSize ", maxSize, " in ", getContextForErrorMessages(id, name));
+    }
+
+    outData = new T[count];
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t *element = data + i * stride;
+        ai_real *out = reinterpret_cast<ai_real *>(outData + i);
+        for (unsigned int c = 0; c < numComponents; ++c) {
+            const uint8_t *src = element + c * componentSize;
+            double value = 0.0;
+            switch (componentType) {
+            case ComponentType_BYTE: {
+                int8_t v;
+                memcpy(&v, src, sizeof(v));
+                value = normalized ? std::max(v / 127.0, -1.0) : v;
+                break;
+            }
+            case ComponentType_UNSIGNED_BYTE:
+                value = normalized ? *src / 255.0 : *src;
+                break;
+            case ComponentType_SHORT: {
+                int16_t v;
+                memcpy(&v, src, sizeof(v));
+                value = normalized ? std::max(v / 32767.0, -1.0) : v;
+                break;
+            }
+            case ComponentType_UNSIGNED_SHORT: {
+                uint16_t v;
+                memcpy(&v, src, sizeof(v));
+                value = normalized ? v / 65535.0 : v;
+                break;
+            }
+            case ComponentType_UNSIGNED_INT: {
+                uint32_t v;
+                memcpy(&v, src, sizeof(v));
+                value = v;
+                break;
+            }
+            default:
+                throw DeadlyImportError("GLTF: unsupported component type in ", getContextForErrorMessages(id, name));
+            }
+            out[c] = static_cast<ai_real>(value);
+        }
+    }
+}
+
 inline void Accessor::WriteData(size_t _count, const void *src_buffer, size_t src_stride) {
     uint8_t *buffer_ptr = bufferView->buffer->GetPointer();
     size_t offset = byteOffset + bufferView->byteOffset;
@@ -1711,6 +1855,8 @@ inline void Asset::ReadExtensionsRequired(Document &doc) {
     }
 
     CHECK_REQUIRED_EXT(KHR_draco_mesh_compression);
+    CHECK_REQUIRED_EXT(KHR_mesh_quantization);
+    CHECK_REQUIRED_EXT(EXT_meshopt_compression);
 
 #undef CHECK_REQUIRED_EXT
 }
@@ -1731,6 +1877,8 @@ inline void Asset::ReadExtensionsUsed(Document &doc) {
     CHECK_EXT(KHR_materials_unlit);
     CHECK_EXT(KHR_lights_punctual);
     CHECK_EXT(KHR_texture_transform);
+    CHECK_EXT(KHR_mesh_quantization);
+    CHECK_EXT(EXT_meshopt_compression);
 
 #undef CHECK_EXT
 }
@@ -1768,11 +1916,14 @@ inline std::string Asset::FindUniqueID(const std::string &str, const char *suffi
     std::vector<char> buffer;
     buffer.resize(id.size() + 16);
     int offset = ai_snprintf(buffer.data(), buffer.size(), "%s_", id.c_str());
-    for (int i = 0; it != mUsedIds.end(); ++i) {
-        ai_snprintf(buffer.data() + offset, buffer.size() - offset, "%d", i);
+
+    // Continue where the last search for this prefix stopped, the ids below
+    // the counter are all taken already
+    int &counter = mIdCounters[id];
+    do {
+        ai_snprintf(buffer.data() + offset, buffer.size() - offset, "%d", counter++);
         id = buffer.data();
-        it = mUsedIds.find(id);
-    }
+    } while (mUsedIds.find(id) != mUsedIds.end());
 
     return id;
 }
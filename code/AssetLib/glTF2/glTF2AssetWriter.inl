@@ -121,6 +121,9 @@ namespace glTF2 {
         }
 
         obj.AddMember("componentType", int(a.componentType), w.mAl);
+        if (a.normalized) {
+            obj.AddMember("normalized", true, w.mAl);
+        }
         obj.AddMember("count", (unsigned int)a.count, w.mAl);
         obj.AddMember("type", StringRef(AttribType::ToString(a.type)), w.mAl);
 
@@ -221,6 +224,18 @@ namespace glTF2 {
     {
         obj.AddMember("byteLength", static_cast<uint64_t>(b.byteLength), w.mAl);
 
+        if (b.IsMeshoptFallback()) {
+            Value meshoptExt;
+            meshoptExt.SetObject();
+            meshoptExt.AddMember("fallback", true, w.mAl);
+
+            Value exts;
+            exts.SetObject();
+            exts.AddMember("EXT_meshopt_compression", meshoptExt, w.mAl);
+            obj.AddMember("extensions", exts, w.mAl);
+            return;
+        }
+
         const auto uri = b.GetURI();
         const auto relativeUri = uri.substr(uri.find_last_of("/\\") + 1u);
         obj.AddMember("uri", Value(relativeUri, w.mAl).Move(), w.mAl);
@@ -237,6 +252,27 @@ namespace glTF2 {
         if (bv.target != BufferViewTarget_NONE) {
             obj.AddMember("target", int(bv.target), w.mAl);
         }
+
+        if (bv.meshopt) {
+            BufferView::MeshoptCompression &mc = *bv.meshopt;
+            Value meshoptExt;
+            meshoptExt.SetObject();
+            meshoptExt.AddMember("buffer", mc.buffer->index, w.mAl);
+            meshoptExt.AddMember("byteOffset", static_cast<uint64_t>(mc.byteOffset), w.mAl);
+            meshoptExt.AddMember("byteLength", static_cast<uint64_t>(mc.byteLength), w.mAl);
+            meshoptExt.AddMember("byteStride", mc.byteStride, w.mAl);
+            meshoptExt.AddMember("count", static_cast<uint64_t>(mc.count), w.mAl);
+            meshoptExt.AddMember("mode", StringRef(mc.mode == BufferView::MeshoptCompression::Mode_Indices ? "INDICES" :
+                                                   mc.mode == BufferView::MeshoptCompression::Mode_Triangles ? "TRIANGLES" : "ATTRIBUTES"), w.mAl);
+            if (mc.filter != "NONE") {
+                meshoptExt.AddMember("filter", Value(mc.filter, w.mAl).Move(), w.mAl);
+            }
+
+            Value exts;
+            exts.SetObject();
+            exts.AddMember("EXT_meshopt_compression", meshoptExt, w.mAl);
+            obj.AddMember("extensions", exts, w.mAl);
+        }
     }
 
     inline void Write(Value& /*obj*/, Camera& /*c*/, AssetWriter& /*w*/)
@@ -670,6 +706,9 @@ namespace glTF2 {
         // Write buffer data to separate .bin files
         for (unsigned int i = 0; i < mAsset.buffers.Size(); ++i) {
             Ref<Buffer> b = mAsset.buffers.Get(i);
+            if (b->IsMeshoptFallback()) {
+                continue;
+            }
 
             std::string binPath = b->GetURI();
 
@@ -695,36 +734,72 @@ namespace glTF2 {
             throw DeadlyExportError("Could not open output file: " + std::string(path));
         }
 
+        // The body buffer is the first buffer of the asset, so it goes in front
+        // of any other buffer (e.g. a meshopt fallback) to keep the indices valid
         Ref<Buffer> bodyBuffer = mAsset.GetBodyBuffer();
-        if (bodyBuffer->byteLength > 0) {
-            rapidjson::Value glbBodyBuffer;
+        Value &buffers = mDoc["buffers"];
+        if (bodyBuffer->byteLength > 0 || !buffers.Empty()) {
+            Value glbBuffers;
+            glbBuffers.SetArray();
+            glbBuffers.Reserve(buffers.Size() + 1, mAl);
+
+            Value glbBodyBuffer;
             glbBodyBuffer.SetObject();
             glbBodyBuffer.AddMember("byteLength", static_cast<uint64_t>(bodyBuffer->byteLength), mAl);
-            mDoc["buffers"].PushBack(glbBodyBuffer, mAl);
+            glbBuffers.PushBack(glbBodyBuffer, mAl);
+            for (Value &b : buffers.GetArray()) {
+                glbBuffers.PushBack(b, mAl);
+            }
+            buffers = glbBuffers;
         }
 
         // Padding with spaces as required by the spec
         uint32_t padding = 0x20202020;
 
-        //
-        // JSON chunk
-        //
-
         StringBuffer docBuffer;
         Writer<StringBuffer> writer(docBuffer);
         if (!mDoc.Accept(writer)) {
             throw DeadlyExportError("Failed to write scene data!");
         }
 
+        // All chunk sizes are known up front, so the file is written front to
+        // back and the body goes straight from the buffer to the stream
         uint32_t jsonChunkLength = (docBuffer.GetSize() + 3) & ~3; // Round up to next multiple of 4
         auto paddingLength = jsonChunkLength - docBuffer.GetSize();
 
+        int GLB_Chunk_count = 1;
+        uint32_t binaryChunkLength = 0;
+        if (bodyBuffer->byteLength > 0) {
+            binaryChunkLength = (bodyBuffer->byteLength + 3) & ~3; // Round up to next multiple of 4
+            ++GLB_Chunk_count;
+        }
+
+        //
+        // Header
+        //
+
+        GLB_Header header;
+        memcpy(header.magic, AI_GLB_MAGIC_NUMBER, sizeof(header.magic));
+
+        header.version = 2;
+        AI_SWAP4(header.version);
+
+        header.length = uint32_t(sizeof(GLB_Header) + GLB_Chunk_count * sizeof(GLB_Chunk) + jsonChunkLength + binaryChunkLength);
+        AI_SWAP4(header.length);
+
+        if (outfile->Write(&header, 1, sizeof(GLB_Header)) != sizeof(GLB_Header)) {
+            throw DeadlyExportError("Failed to write the header!");
+        }
+
+        //
+        // JSON chunk
+        //
+
         GLB_Chunk jsonChunk;
         jsonChunk.chunkLength = jsonChunkLength;
         jsonChunk.chunkType = ChunkType_JSON;
         AI_SWAP4(jsonChunk.chunkLength);
 
-        outfile->Seek(sizeof(GLB_Header), aiOrigin_SET);
         if (outfile->Write(&jsonChunk, 1, sizeof(GLB_Chunk)) != sizeof(GLB_Chunk)) {
             throw DeadlyExportError("Failed to write scene data header!");
         }
@@ -739,49 +814,24 @@ namespace glTF2 {
         // Binary chunk
         //
 
-        int GLB_Chunk_count = 1;
-        uint32_t binaryChunkLength = 0;
         if (bodyBuffer->byteLength > 0) {
-            binaryChunkLength = (bodyBuffer->byteLength + 3) & ~3; // Round up to next multiple of 4
-            
             auto curPaddingLength = binaryChunkLength - bodyBuffer->byteLength;
-            ++GLB_Chunk_count;
 
             GLB_Chunk binaryChunk;
             binaryChunk.chunkLength = binaryChunkLength;
             binaryChunk.chunkType = ChunkType_BIN;
             AI_SWAP4(binaryChunk.chunkLength);
 
-            size_t bodyOffset = sizeof(GLB_Header) + sizeof(GLB_Chunk) + jsonChunk.chunkLength;
-            outfile->Seek(bodyOffset, aiOrigin_SET);
             if (outfile->Write(&binaryChunk, 1, sizeof(GLB_Chunk)) != sizeof(GLB_Chunk)) {
                 throw DeadlyExportError("Failed to write body data header!");
             }
             if (outfile->Write(bodyBuffer->GetPointer(), 1, bodyBuffer->byteLength) != bodyBuffer->byteLength) {
                 throw DeadlyExportError("Failed to write body data!");
             }
-            if (curPaddingLength && outfile->Write(&padding, 1, paddingLength) != paddingLength) {
+            if (curPaddingLength && outfile->Write(&padding, 1, curPaddingLength) != curPaddingLength) {
                 throw DeadlyExportError("Failed to write body data padding!");
             }
         }
-
-        //
-        // Header
-        //
-
-        GLB_Header header;
-        memcpy(header.magic, AI_GLB_MAGIC_NUMBER, sizeof(header.magic));
-
-        header.version = 2;
-        AI_SWAP4(header.version);
-
-        header.length = uint32_t(sizeof(GLB_Header) + GLB_Chunk_count * sizeof(GLB_Chunk) + jsonChunkLength + binaryChunkLength);
-        AI_SWAP4(header.length);
-
-        outfile->Seek(0, aiOrigin_SET);
-        if (outfile->Write(&header, 1, sizeof(GLB_Header)) != sizeof(GLB_Header)) {
-            throw DeadlyExportError("Failed to write the header!");
-        }
     }
 
     inline void AssetWriter::WriteMetadata()
@@ -808,10 +858,30 @@ namespace glTF2 {
             if (this->mAsset.extensionsUsed.KHR_materials_unlit) {
               exts.PushBack(StringRef("KHR_materials_unlit"), mAl);
             }
+
+            if (this->mAsset.extensionsUsed.KHR_mesh_quantization) {
+                exts.PushBack(StringRef("KHR_mesh_quantization"), mAl);
+            }
+
+            if (this->mAsset.extensionsUsed.EXT_meshopt_compression) {
+                exts.PushBack(StringRef("EXT_meshopt_compression"), mAl);
+            }
         }
 
         if (!exts.Empty())
             mDoc.AddMember("extensionsUsed", exts, mAl);
+
+        Value required;
+        required.SetArray();
+        if (this->mAsset.extensionsRequired.KHR_mesh_quantization) {
+            required.PushBack(StringRef("KHR_mesh_quantization"), mAl);
+        }
+        if (this->mAsset.extensionsRequired.EXT_meshopt_compression) {
+            required.PushBack(StringRef("EXT_meshopt_compression"), mAl);
+        }
+
+        if (!required.Empty())
+            mDoc.AddMember("extensionsRequired", required, mAl);
     }
 
     template<class T>
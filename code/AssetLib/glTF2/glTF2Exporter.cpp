@@ -44,6 +44,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AssetLib/glTF2/glTF2Exporter.h"
 #include "AssetLib/glTF2/glTF2AssetWriter.h"
+#include "AssetLib/glTF2/glTF2MeshoptCodec.h"
+#include "Common/ParallelFor.h"
 #include "PostProcessing/SplitLargeMeshes.h"
 
 #include <assimp/commonMetaData.h>
@@ -56,10 +58,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Exporter.hpp>
 #include <assimp/material.h>
 #include <assimp/scene.h>
+#include <assimp/SceneAnalysis.h>
 
 // Header files, standard library.
 #include <memory>
 #include <limits>
+#include <numeric>
 #include <inttypes.h>
 
 using namespace rapidjson;
@@ -111,6 +115,7 @@ glTF2Exporter::glTF2Exporter(const char* filename, IOSystem* pIOSystem, const ai
 
     ExportMeshes();
     MergeMeshes();
+    ExportDequantizationTransforms();
 
     ExportScene();
 
@@ -151,6 +156,13 @@ static void CopyValue(const aiMatrix4x4& v, aiMatrix4x4& o) {
     memcpy(&o, &v, sizeof(aiMatrix4x4));
 }
 
+static void CopyValue(const mat4& v, aiMatrix4x4& o) {
+    o.a1 = v[ 0]; o.b1 = v[ 1]; o.c1 = v[ 2]; o.d1 = v[ 3];
+    o.a2 = v[ 4]; o.b2 = v[ 5]; o.c2 = v[ 6]; o.d2 = v[ 7];
+    o.a3 = v[ 8]; o.b3 = v[ 9]; o.c3 = v[10]; o.d3 = v[11];
+    o.a4 = v[12]; o.b4 = v[13]; o.c4 = v[14]; o.d4 = v[15];
+}
+
 static void IdentityMatrix4(mat4& o) {
     o[ 0] = 1; o[ 1] = 0; o[ 2] = 0; o[ 3] = 0;
     o[ 4] = 0; o[ 5] = 1; o[ 6] = 0; o[ 7] = 0;
@@ -416,6 +428,403 @@ inline Ref<Accessor> ExportData(Asset& a, std::string& meshName, Ref<Buffer>& bu
     return acc;
 }
 
+namespace {
+
+// A vertex attribute or index stream of one mesh, quantized and optionally
+// compressed before it is added to the asset
+struct EncodedStream {
+    std::vector<uint8_t> data; //!< count elements of stride bytes each
+    std::vector<uint8_t> compressed; //!< EXT_meshopt_compression stream, empty if stored plain
+    size_t count = 0;
+    unsigned int stride = 0;
+    ComponentType componentType = ComponentType_FLOAT;
+    AttribType::Value type = AttribType::SCALAR;
+    bool normalized = false;
+    std::vector<double> min, max;
+};
+
+struct EncodedMesh {
+    EncodedStream position;
+    EncodedStream normal;
+    EncodedStream texcoord[AI_MAX_NUMBER_OF_TEXTURECOORDS];
+    EncodedStream color[AI_MAX_NUMBER_OF_COLOR_SETS];
+    EncodedStream indices;
+};
+
+// Integer grid for the positions of a mesh, position = offset + scale * q
+struct QuantizationGrid {
+    aiVector3D offset;
+    ai_real scale = 1;
+    bool enabled = false;
+};
+
+// Number of meshes encoded in parallel before they are added to the asset
+static const unsigned int EncodeBatchSize = 64;
+
+// Fills a stream with count elements; element(i, values) writes the components of element i
+template <typename T, typename Func>
+void PackStream(EncodedStream &s, size_t count, AttribType::Value type, ComponentType componentType,
+        bool normalized, unsigned int stride, Func element) {
+    const unsigned int numComps = AttribType::GetNumComponents(type);
+    s.count = count;
+    s.type = type;
+    s.componentType = componentType;
+    s.normalized = normalized;
+    s.stride = stride;
+    s.data.assign(count * stride, 0);
+    s.min.assign(numComps, std::numeric_limits<double>::max());
+    s.max.assign(numComps, -std::numeric_limits<double>::max());
+
+    T values[4];
+    for (size_t i = 0; i < count; ++i) {
+        element(i, values);
+        memcpy(s.data.data() + i * stride, values, numComps * sizeof(T));
+        for (unsigned int c = 0; c < numComps; ++c) {
+            const double value = values[c];
+            // Same as SetAccessorRange, NaNs and Infs must not end up in the bounds
+            if (!std::isfinite(value)) {
+                continue;
+            }
+            s.min[c] = std::min(s.min[c], value);
+            s.max[c] = std::max(s.max[c], value);
+        }
+    }
+}
+
+inline uint8_t QuantizeUnorm8(ai_real v) {
+    return static_cast<uint8_t>(std::lround(std::min(std::max(v, ai_real(0.0)), ai_real(1.0)) * 255));
+}
+
+inline uint16_t QuantizeUnorm16(ai_real v) {
+    return static_cast<uint16_t>(std::lround(std::min(std::max(v, ai_real(0.0)), ai_real(1.0)) * 65535));
+}
+
+inline int8_t QuantizeSnorm8(ai_real v) {
+    return static_cast<int8_t>(std::lround(std::min(std::max(v, ai_real(-1.0)), ai_real(1.0)) * 127));
+}
+
+template <typename V>
+bool IsInUnitRange(const V *values, unsigned int count, unsigned int numComps) {
+    for (unsigned int i = 0; i < count; ++i) {
+        for (unsigned int c = 0; c < numComps; ++c) {
+            if (!(values[i][c] >= 0 && values[i][c] <= 1)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Point meshes whose face i is just vertex i are written without indices,
+// the vertices are drawn in order then
+bool HasImplicitPointIndices(const aiMesh *aim) {
+    if (aim->mPrimitiveTypes != aiPrimitiveType_POINT || aim->mNumFaces != aim->mNumVertices) {
+        return false;
+    }
+    for (unsigned int i = 0; i < aim->mNumFaces; ++i) {
+        if (aim->mFaces[i].mNumIndices != 1 || aim->mFaces[i].mIndices[0] != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Assigns a position grid to each mesh. Meshes attached to the same node are
+// merged into one glTF mesh later on, so they share the grid (and thereby the
+// dequantization transform) of their combined bounding box. Skinned and morphed
+// meshes keep float positions as the transform would not apply to them.
+void ComputeQuantizationGrids(const aiScene *scene, int numThreads, std::vector<QuantizationGrid> &grids) {
+    const unsigned int numMeshes = scene->mNumMeshes;
+    grids.assign(numMeshes, QuantizationGrid());
+
+    std::vector<unsigned int> group(numMeshes);
+    std::iota(group.begin(), group.end(), 0u);
+    auto findGroup = [&group](unsigned int m) {
+        while (group[m] != m) {
+            m = group[m] = group[group[m]];
+        }
+        return m;
+    };
+
+    std::vector<const aiNode *> stack;
+    if (scene->mRootNode) {
+        stack.push_back(scene->mRootNode);
+    }
+    while (!stack.empty()) {
+        const aiNode *node = stack.back();
+        stack.pop_back();
+        for (unsigned int i = 1; i < node->mNumMeshes; ++i) {
+            if (node->mMeshes[0] < numMeshes && node->mMeshes[i] < numMeshes) {
+                group[findGroup(node->mMeshes[i])] = findGroup(node->mMeshes[0]);
+            }
+        }
+        stack.insert(stack.end(), node->mChildren, node->mChildren + node->mNumChildren);
+    }
+
+    SceneStatistics stats;
+    AnalyzeScene(scene, stats, numThreads, false);
+
+    std::vector<aiAABB> bounds(numMeshes);
+    std::vector<bool> hasBounds(numMeshes, false);
+    std::vector<bool> quantizable(numMeshes, true);
+    for (unsigned int m = 0; m < numMeshes; ++m) {
+        const aiMesh *mesh = scene->mMeshes[m];
+        const unsigned int root = findGroup(m);
+        if (mesh->HasBones() || mesh->mNumAnimMeshes > 0) {
+            quantizable[root] = false;
+        }
+        if (0 == mesh->mNumVertices) {
+            continue;
+        }
+        const aiAABB &aabb = stats.mMeshes[m].mAABB;
+        if (!hasBounds[root]) {
+            bounds[root] = aabb;
+            hasBounds[root] = true;
+        } else {
+            bounds[root].mMin.x = std::min(bounds[root].mMin.x, aabb.mMin.x);
+            bounds[root].mMin.y = std::min(bounds[root].mMin.y, aabb.mMin.y);
+            bounds[root].mMin.z = std::min(bounds[root].mMin.z, aabb.mMin.z);
+            bounds[root].mMax.x = std::max(bounds[root].mMax.x, aabb.mMax.x);
+            bounds[root].mMax.y = std::max(bounds[root].mMax.y, aabb.mMax.y);
+            bounds[root].mMax.z = std::max(bounds[root].mMax.z, aabb.mMax.z);
+        }
+    }
+
+    for (unsigned int m = 0; m < numMeshes; ++m) {
+        const unsigned int root = findGroup(m);
+        if (!quantizable[root] || !hasBounds[root]) {
+            continue;
+        }
+        const aiVector3D extent = bounds[root].mMax - bounds[root].mMin;
+        const ai_real maxExtent = std::max(extent.x, std::max(extent.y, extent.z));
+        if (!std::isfinite(maxExtent)) {
+            continue;
+        }
+        grids[m].offset = bounds[root].mMin;
+        grids[m].scale = maxExtent > 0 ? maxExtent / 65535 : ai_real(1.0);
+        grids[m].enabled = true;
+    }
+}
+
+// Converts the vertex data and indices of a mesh to their glTF layout. This does
+// not touch the asset, so meshes can be encoded concurrently.
+void EncodeMesh(const aiMesh *aim, const QuantizationGrid &grid, bool quantize, bool compress, EncodedMesh &out) {
+    const size_t numVertices = aim->mNumVertices;
+
+    /******************* Vertices ********************/
+    if (numVertices > 0) {
+        if (grid.enabled) {
+            const ai_real invScale = 1 / grid.scale;
+            PackStream<uint16_t>(out.position, numVertices, AttribType::VEC3, ComponentType_UNSIGNED_SHORT, false, 8,
+                    [aim, &grid, invScale](size_t i, uint16_t *values) {
+                        const aiVector3D q = (aim->mVertices[i] - grid.offset) * invScale;
+                        values[0] = static_cast<uint16_t>(std::min(std::max(std::lround(q.x), 0L), 65535L));
+                        values[1] = static_cast<uint16_t>(std::min(std::max(std::lround(q.y), 0L), 65535L));
+                        values[2] = static_cast<uint16_t>(std::min(std::max(std::lround(q.z), 0L), 65535L));
+                    });
+        } else {
+            PackStream<float>(out.position, numVertices, AttribType::VEC3, ComponentType_FLOAT, false, 12,
+                    [aim](size_t i, float *values) {
+                        values[0] = static_cast<float>(aim->mVertices[i].x);
+                        values[1] = static_cast<float>(aim->mVertices[i].y);
+                        values[2] = static_cast<float>(aim->mVertices[i].z);
+                    });
+        }
+    }
+
+    /******************** Normals ********************/
+    // Normalize all normals as the validator can emit a warning otherwise
+    if (numVertices > 0 && nullptr != aim->mNormals) {
+        if (quantize) {
+            PackStream<int8_t>(out.normal, numVertices, AttribType::VEC3, ComponentType_BYTE, true, 4,
+                    [aim](size_t i, int8_t *values) {
+                        aiVector3D normal = aim->mNormals[i];
+                        normal.NormalizeSafe();
+                        values[0] = QuantizeSnorm8(normal.x);
+                        values[1] = QuantizeSnorm8(normal.y);
+                        values[2] = QuantizeSnorm8(normal.z);
+                    });
+        } else {
+            PackStream<float>(out.normal, numVertices, AttribType::VEC3, ComponentType_FLOAT, false, 12,
+                    [aim](size_t i, float *values) {
+                        aiVector3D normal = aim->mNormals[i];
+                        normal.NormalizeSafe();
+                        values[0] = static_cast<float>(normal.x);
+                        values[1] = static_cast<float>(normal.y);
+                        values[2] = static_cast<float>(normal.z);
+                    });
+        }
+    }
+
+    /************** Texture coordinates **************/
+    // The y coords are flipped, this keeps [0,1] intact
+    for (unsigned int t = 0; t < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++t) {
+        if (numVertices == 0 || !aim->HasTextureCoords(t) || aim->mNumUVComponents[t] == 0) {
+            continue;
+        }
+        const aiVector3D *uvs = aim->mTextureCoords[t];
+        if (aim->mNumUVComponents[t] == 2) {
+            if (quantize && IsInUnitRange(uvs, aim->mNumVertices, 2)) {
+                PackStream<uint16_t>(out.texcoord[t], numVertices, AttribType::VEC2, ComponentType_UNSIGNED_SHORT, true, 4,
+                        [uvs](size_t i, uint16_t *values) {
+                            values[0] = QuantizeUnorm16(uvs[i].x);
+                            values[1] = QuantizeUnorm16(1 - uvs[i].y);
+                        });
+            } else {
+                PackStream<float>(out.texcoord[t], numVertices, AttribType::VEC2, ComponentType_FLOAT, false, 8,
+                        [uvs](size_t i, float *values) {
+                            values[0] = static_cast<float>(uvs[i].x);
+                            values[1] = static_cast<float>(1 - uvs[i].y);
+                        });
+            }
+        } else {
+            const bool flip = aim->mNumUVComponents[t] > 1;
+            PackStream<float>(out.texcoord[t], numVertices, AttribType::VEC3, ComponentType_FLOAT, false, 12,
+                    [uvs, flip](size_t i, float *values) {
+                        values[0] = static_cast<float>(uvs[i].x);
+                        values[1] = static_cast<float>(flip ? 1 - uvs[i].y : uvs[i].y);
+                        values[2] = static_cast<float>(uvs[i].z);
+                    });
+        }
+    }
+
+    /*************** Vertex colors ****************/
+    for (unsigned int c = 0; c < aim->GetNumColorChannels(); ++c) {
+        const aiColor4D *colors = aim->mColors[c];
+        if (numVertices == 0) {
+            break;
+        }
+        if (quantize && IsInUnitRange(colors, aim->mNumVertices, 4)) {
+            PackStream<uint8_t>(out.color[c], numVertices, AttribType::VEC4, ComponentType_UNSIGNED_BYTE, true, 4,
+                    [colors](size_t i, uint8_t *values) {
+                        for (unsigned int k = 0; k < 4; ++k) {
+                            values[k] = QuantizeUnorm8(colors[i][k]);
+                        }
+                    });
+        } else {
+            PackStream<float>(out.color[c], numVertices, AttribType::VEC4, ComponentType_FLOAT, false, 16,
+                    [colors](size_t i, float *values) {
+                        for (unsigned int k = 0; k < 4; ++k) {
+                            values[k] = static_cast<float>(colors[i][k]);
+                        }
+                    });
+        }
+    }
+
+    /*************** Vertices indices ****************/
+    std::vector<uint32_t> indices;
+    if (aim->mNumFaces > 0 && !HasImplicitPointIndices(aim)) {
+        const unsigned int nIndicesPerFace = aim->mFaces[0].mNumIndices;
+        indices.resize(aim->mNumFaces * nIndicesPerFace);
+        for (size_t i = 0; i < aim->mNumFaces; ++i) {
+            for (size_t j = 0; j < nIndicesPerFace; ++j) {
+                indices[i * nIndicesPerFace + j] = aim->mFaces[i].mIndices[j];
+            }
+        }
+
+        if (quantize && numVertices <= std::numeric_limits<uint16_t>::max()) {
+            PackStream<uint16_t>(out.indices, indices.size(), AttribType::SCALAR, ComponentType_UNSIGNED_SHORT, false, 2,
+                    [&indices](size_t i, uint16_t *values) { values[0] = static_cast<uint16_t>(indices[i]); });
+        } else {
+            PackStream<uint32_t>(out.indices, indices.size(), AttribType::SCALAR, ComponentType_UNSIGNED_INT, false, 4,
+                    [&indices](size_t i, uint32_t *values) { values[0] = indices[i]; });
+        }
+    }
+
+    if (!compress) {
+        return;
+    }
+
+    // Keep the plain layout of streams which do not get smaller
+    auto compressVertices = [](EncodedStream &s) {
+        if (s.count > 0) {
+            Meshopt::EncodeVertexBuffer(s.compressed, s.data.data(), s.count, s.stride);
+            if (s.compressed.size() >= s.data.size()) {
+                s.compressed.clear();
+            }
+        }
+    };
+    compressVertices(out.position);
+    compressVertices(out.normal);
+    for (EncodedStream &s : out.texcoord) {
+        compressVertices(s);
+    }
+    for (EncodedStream &s : out.color) {
+        compressVertices(s);
+    }
+    if (!indices.empty()) {
+        Meshopt::EncodeIndexSequence(out.indices.compressed, indices.data(), indices.size());
+        if (out.indices.compressed.size() >= out.indices.data.size()) {
+            out.indices.compressed.clear();
+        }
+    }
+}
+
+// Appends data to the buffer at a 4 byte aligned offset, returns the offset
+size_t AppendAligned(Buffer &buffer, const std::vector<uint8_t> &data) {
+    const size_t padding = (4 - buffer.byteLength % 4) % 4;
+    const size_t offset = buffer.byteLength + padding;
+    buffer.Grow(padding + data.size());
+    memset(buffer.GetPointer() + offset - padding, 0, padding);
+    memcpy(buffer.GetPointer() + offset, data.data(), data.size());
+    return offset;
+}
+
+// Adds an encoded stream to the asset. Compressed streams are stored in the body
+// buffer, their buffer view describes the decoded layout in the fallback buffer.
+Ref<Accessor> ExportEncodedStream(Asset &a, std::string &meshName, Ref<Buffer> &buffer, Ref<Buffer> &fallback,
+        const EncodedStream &s, BufferViewTarget target) {
+    if (!s.count) {
+        return Ref<Accessor>();
+    }
+
+    const bool isVertexAttribute = target == BufferViewTarget_ARRAY_BUFFER;
+
+    // bufferView
+    Ref<BufferView> bv = a.bufferViews.Create(a.FindUniqueID(meshName, "view"));
+    bv->byteLength = s.data.size();
+    bv->byteStride = isVertexAttribute ? s.stride : 0;
+    bv->target = target;
+    if (s.compressed.empty()) {
+        bv->buffer = buffer;
+        bv->byteOffset = AppendAligned(*buffer, s.data);
+    } else {
+        if (!fallback) {
+            fallback = a.buffers.Create(a.FindUniqueID("", "fallback"));
+            fallback->MarkAsMeshoptFallback();
+            a.extensionsUsed.EXT_meshopt_compression = true;
+            a.extensionsRequired.EXT_meshopt_compression = true;
+        }
+        bv->buffer = fallback;
+        bv->byteOffset = (fallback->byteLength + 3) & ~size_t(3);
+        fallback->byteLength = bv->byteOffset + s.data.size();
+
+        bv->meshopt.reset(new BufferView::MeshoptCompression);
+        bv->meshopt->buffer = buffer;
+        bv->meshopt->byteOffset = AppendAligned(*buffer, s.compressed);
+        bv->meshopt->byteLength = s.compressed.size();
+        bv->meshopt->byteStride = s.stride;
+        bv->meshopt->count = s.count;
+        bv->meshopt->mode = isVertexAttribute ? BufferView::MeshoptCompression::Mode_Attributes :
+                                                BufferView::MeshoptCompression::Mode_Indices;
+    }
+
+    // accessor
+    Ref<Accessor> acc = a.accessors.Create(a.FindUniqueID(meshName, "accessor"));
+    acc->bufferView = bv;
+    acc->byteOffset = 0;
+    acc->componentType = s.componentType;
+    acc->normalized = s.normalized;
+    acc->count = s.count;
+    acc->type = s.type;
+    acc->min = s.min;
+    acc->max = s.max;
+
+    return acc;
+}
+
+} // namespace
+
 inline void SetSamplerWrap(SamplerWrap& wrap, aiTextureMapMode map)
 {
     switch (map) {
@@ -875,6 +1284,21 @@ void glTF2Exporter::ExportMeshes()
        b = mAsset->buffers.Create(bufferId);
     }
 
+    //----------------------------------------
+    // Quantization and compression of the mesh data
+    const bool quantize = mProperties->GetPropertyBool(AI_CONFIG_EXPORT_GLTF_QUANTIZE, false);
+    const bool compress = mProperties->GetPropertyBool(AI_CONFIG_EXPORT_GLTF_MESHOPT_COMPRESSION, false);
+    const bool encode = quantize || compress;
+    const int threadConfig = mProperties->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1);
+
+    std::vector<QuantizationGrid> grids(mScene->mNumMeshes);
+    if (quantize) {
+        ComputeQuantizationGrids(mScene, threadConfig, grids);
+    }
+    std::vector<EncodedMesh> encoded;
+    Ref<Buffer> fallback;
+    bool usesQuantization = false;
+
     //----------------------------------------
     // Initialize variables for the skin
     bool createSkin = false;
@@ -898,6 +1322,21 @@ void glTF2Exporter::ExportMeshes()
 	for (unsigned int idx_mesh = 0; idx_mesh < mScene->mNumMeshes; ++idx_mesh) {
 		const aiMesh* aim = mScene->mMeshes[idx_mesh];
 
+        // Encode the next batch of meshes in parallel, the asset itself is built serially
+        if (encode && idx_mesh % EncodeBatchSize == 0) {
+            const unsigned int batchBegin = idx_mesh;
+            const unsigned int batchEnd = std::min(batchBegin + EncodeBatchSize, mScene->mNumMeshes);
+            encoded.clear();
+            encoded.resize(batchEnd - batchBegin);
+            ParallelFor(encoded.size(), GetNumWorkerThreads(threadConfig), 1,
+                    [this, &encoded, &grids, batchBegin, quantize, compress](size_t begin, size_t end) {
+                        for (size_t i = begin; i < end; ++i) {
+                            EncodeMesh(mScene->mMeshes[batchBegin + i], grids[batchBegin + i], quantize, compress, encoded[i]);
+                        }
+                    });
+        }
+        EncodedMesh *em = encode ? &encoded[idx_mesh % EncodeBatchSize] : nullptr;
+
         std::string name = aim->mName.C_Str();
 
         std::string meshId = mAsset->FindUniqueID(name, "mesh");
@@ -910,49 +1349,75 @@ void glTF2Exporter::ExportMeshes()
         p.material = mAsset->materials.Get(aim->mMaterialIndex);
 
 		/******************* Vertices ********************/
-		Ref<Accessor> v = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mVertices, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
+		Ref<Accessor> v = encode ?
+            ExportEncodedStream(*mAsset, meshId, b, fallback, em->position, BufferViewTarget_ARRAY_BUFFER) :
+            ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mVertices, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
 		if (v) p.attributes.position.push_back(v);
+        if (encode && grids[idx_mesh].enabled) {
+            aiMatrix4x4 translation, scaling;
+            aiMatrix4x4::Translation(grids[idx_mesh].offset, translation);
+            aiMatrix4x4::Scaling(aiVector3D(grids[idx_mesh].scale), scaling);
+            mDequantizationTransforms[meshId] = translation * scaling;
+        }
 
 		/******************** Normals ********************/
-        // Normalize all normals as the validator can emit a warning otherwise
-        if ( nullptr != aim->mNormals) {
-            for ( auto i = 0u; i < aim->mNumVertices; ++i ) {
-                aim->mNormals[ i ].NormalizeSafe();
+        // Normalize all normals as the validator can emit a warning otherwise.
+        // The scene may be shared with the caller, so this works on a copy.
+        std::vector<aiVector3D> normals;
+        if (!encode && nullptr != aim->mNormals) {
+            normals.assign(aim->mNormals, aim->mNormals + aim->mNumVertices);
+            for (aiVector3D &normal : normals) {
+                normal.NormalizeSafe();
             }
         }
 
-		Ref<Accessor> n = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mNormals, AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
+		Ref<Accessor> n = encode ?
+            ExportEncodedStream(*mAsset, meshId, b, fallback, em->normal, BufferViewTarget_ARRAY_BUFFER) :
+            ExportData(*mAsset, meshId, b, aim->mNumVertices, normals.empty() ? nullptr : normals.data(), AttribType::VEC3, AttribType::VEC3, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
         if (n) p.attributes.normal.push_back(n);
 
+        // Integer positions and normals are only valid with KHR_mesh_quantization
+        if ((v && v->componentType != ComponentType_FLOAT) || (n && n->componentType != ComponentType_FLOAT)) {
+            usesQuantization = true;
+        }
+
 		/************** Texture coordinates **************/
         for (int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
 			if (!aim->HasTextureCoords(i))
 				continue;
 
-            // Flip UV y coords
-            if (aim -> mNumUVComponents[i] > 1) {
-                for (unsigned int j = 0; j < aim->mNumVertices; ++j) {
-                    aim->mTextureCoords[i][j].y = 1 - aim->mTextureCoords[i][j].y;
+            // Flip UV y coords, on a copy as the scene may be shared with the caller
+            std::vector<aiVector3D> uvs;
+            if (!encode && aim -> mNumUVComponents[i] > 1) {
+                uvs.assign(aim->mTextureCoords[i], aim->mTextureCoords[i] + aim->mNumVertices);
+                for (aiVector3D &uv : uvs) {
+                    uv.y = 1 - uv.y;
                 }
             }
 
             if (aim->mNumUVComponents[i] > 0) {
                 AttribType::Value type = (aim->mNumUVComponents[i] == 2) ? AttribType::VEC2 : AttribType::VEC3;
 
-				Ref<Accessor> tc = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mTextureCoords[i], AttribType::VEC3, type, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
+				Ref<Accessor> tc = encode ?
+                    ExportEncodedStream(*mAsset, meshId, b, fallback, em->texcoord[i], BufferViewTarget_ARRAY_BUFFER) :
+                    ExportData(*mAsset, meshId, b, aim->mNumVertices, uvs.empty() ? aim->mTextureCoords[i] : uvs.data(), AttribType::VEC3, type, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
 				if (tc) p.attributes.texcoord.push_back(tc);
 			}
 		}
 
 		/*************** Vertex colors ****************/
 		for (unsigned int indexColorChannel = 0; indexColorChannel < aim->GetNumColorChannels(); ++indexColorChannel) {
-			Ref<Accessor> c = ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mColors[indexColorChannel], AttribType::VEC4, AttribType::VEC4, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
+			Ref<Accessor> c = encode ?
+                ExportEncodedStream(*mAsset, meshId, b, fallback, em->color[indexColorChannel], BufferViewTarget_ARRAY_BUFFER) :
+                ExportData(*mAsset, meshId, b, aim->mNumVertices, aim->mColors[indexColorChannel], AttribType::VEC4, AttribType::VEC4, ComponentType_FLOAT, BufferViewTarget_ARRAY_BUFFER);
 			if (c)
 				p.attributes.color.push_back(c);
 		}
 
 		/*************** Vertices indices ****************/
-		if (aim->mNumFaces > 0) {
+		if (encode) {
+			p.indices = ExportEncodedStream(*mAsset, meshId, b, fallback, em->indices, BufferViewTarget_ELEMENT_ARRAY_BUFFER);
+		} else if (aim->mNumFaces > 0 && !HasImplicitPointIndices(aim)) {
 			std::vector<IndicesType> indices;
 			unsigned int nIndicesPerFace = aim->mFaces[0].mNumIndices;
             indices.resize(aim->mNumFaces * nIndicesPerFace);
@@ -1022,7 +1487,8 @@ void glTF2Exporter::ExportMeshes()
                 if (pAnimMesh->HasNormals() && bIncludeNormal) {
                     aiVector3D *pNormalDiff = new aiVector3D[pAnimMesh->mNumVertices];
                     for (unsigned int vt = 0; vt < pAnimMesh->mNumVertices; ++vt) {
-                        pNormalDiff[vt] = pAnimMesh->mNormals[vt] - aim->mNormals[vt];
+                        aiVector3D normal = aim->mNormals[vt];
+                        pNormalDiff[vt] = pAnimMesh->mNormals[vt] - normal.NormalizeSafe();
                     }
                     Ref<Accessor> vec;
                     if (bUseSparse) {
@@ -1045,6 +1511,11 @@ void glTF2Exporter::ExportMeshes()
         }
     }
 
+    if (usesQuantization) {
+        mAsset->extensionsUsed.KHR_mesh_quantization = true;
+        mAsset->extensionsRequired.KHR_mesh_quantization = true;
+    }
+
     //----------------------------------------
     // Finish the skin
     // Create the Accessor for skinRef->inverseBindMatrices
@@ -1142,6 +1613,50 @@ void glTF2Exporter::MergeMeshes()
     }
 }
 
+/*
+ * Moves quantized positions back into their original space. The dequantization
+ * transform is folded into the node matrix if nothing else depends on it, else
+ * the meshes move to a new child node carrying the transform.
+ */
+void glTF2Exporter::ExportDequantizationTransforms()
+{
+    if (mDequantizationTransforms.empty()) {
+        return;
+    }
+
+    const unsigned int numNodes = mAsset->nodes.Size();
+    for (unsigned int n = 0; n < numNodes; ++n) {
+        Ref<Node> node = mAsset->nodes.Get(n);
+        if (node->meshes.empty()) {
+            continue;
+        }
+
+        // After MergeMeshes all meshes of a node are in the first one
+        auto it = mDequantizationTransforms.find(node->meshes[0]->id);
+        if (it == mDequantizationTransforms.end()) {
+            continue;
+        }
+
+        if (node->children.empty() && !node->camera && !node->light && !node->skin && mScene->mNumAnimations == 0) {
+            aiMatrix4x4 matrix;
+            if (node->matrix.isPresent) {
+                CopyValue(node->matrix.value, matrix);
+            }
+            node->matrix.isPresent = true;
+            CopyValue(matrix * it->second, node->matrix.value);
+        } else {
+            const std::string id = mAsset->FindUniqueID(node->name + "_dequantized", "node");
+            Ref<Node> child = mAsset->nodes.Create(id);
+            child->name = id;
+            child->parent = node;
+            child->matrix.isPresent = true;
+            CopyValue(it->second, child->matrix.value);
+            child->meshes.swap(node->meshes);
+            node->children.push_back(child);
+        }
+    }
+}
+
 /*
  * Export the root node of the node hierarchy.
  * Calls ExportNode for all children.
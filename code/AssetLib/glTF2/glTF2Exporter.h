@@ -110,6 +110,7 @@ namespace Assimp
         void ExportMaterials();
         void ExportMeshes();
         void MergeMeshes();
+        void ExportDequantizationTransforms();
         unsigned int ExportNodeHierarchy(const aiNode* n);
         unsigned int ExportNode(const aiNode* node, glTF2::Ref<glTF2::Node>& parent);
         void ExportScene();
@@ -123,6 +124,7 @@ namespace Assimp
         std::map<std::string, unsigned int> mTexturesByPath;
         std::shared_ptr<glTF2::Asset> mAsset;
         std::vector<unsigned char> mBodyData;
+        std::map<std::string, aiMatrix4x4> mDequantizationTransforms; //!< Per glTF mesh id, for quantized positions
     };
 
 }
@@ -47,6 +47,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AssetLib/glTF2/glTF2AssetWriter.h"
 
 #include <assimp/CreateAnimMesh.h>
+#include <assimp/Hash.h>
+#include <assimp/SceneCombiner.h>
 #include <assimp/StringComparison.h>
 #include <assimp/StringUtils.h>
 #include <assimp/ai_assert.h>
@@ -55,7 +57,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/commonMetaData.h>
+#include <assimp/config.h>
 
+#include <algorithm>
 #include <memory>
 #include <unordered_map>
 
@@ -72,6 +76,113 @@ struct Tangent {
     aiVector3D xyz;
     ai_real w;
 };
+
+// Hashes the source data a primitive is converted from, used to detect
+// unchanged primitives on incremental re-imports.
+class SourceHasher {
+public:
+    explicit SourceHasher(uint64_t seed) :
+            mLow(static_cast<uint32_t>(seed) ^ 0x811c9dc5u), mHigh(static_cast<uint32_t>(seed >> 32) ^ 0x9e3779b9u) {
+        // empty
+    }
+
+    void Add(const void *data, size_t size) {
+        // SuperFastHash takes a 32-bit length and interprets 0 as 'strlen'
+        const char *bytes = static_cast<const char *>(data);
+        while (size > 0) {
+            const uint32_t len = static_cast<uint32_t>(std::min(size, static_cast<size_t>(1u << 30)));
+            mLow = SuperFastHash(bytes, len, mLow);
+            mHigh = SuperFastHash(bytes, len, mHigh ^ mLow);
+            bytes += len;
+            size -= len;
+        }
+    }
+
+    void Add(uint64_t value) {
+        Add(&value, sizeof(value));
+    }
+
+    void Add(const std::string &str) {
+        Add(static_cast<uint64_t>(str.size()));
+        Add(str.data(), str.size());
+    }
+
+    void Add(Ref<Accessor> &accessor) {
+        Add(static_cast<uint64_t>(accessor ? 1 : 0));
+        if (!accessor) {
+            return;
+        }
+
+        const size_t elemSize = accessor->GetElementSize();
+        const size_t stride = accessor->bufferView && accessor->bufferView->byteStride ? accessor->bufferView->byteStride : elemSize;
+        Add(static_cast<uint64_t>(accessor->count));
+        Add(static_cast<uint64_t>(accessor->componentType));
+        Add(static_cast<uint64_t>(accessor->type));
+        Add(static_cast<uint64_t>(accessor->normalized ? 1 : 0));
+        Add(static_cast<uint64_t>(stride));
+
+        // never read beyond the data, the conversion reports broken accessors
+        const uint8_t *data = accessor->GetPointer();
+        size_t available = 0;
+        if (accessor->sparse) {
+            available = accessor->sparse->data.size();
+        } else if (accessor->bufferView && accessor->bufferView->byteLength > accessor->byteOffset) {
+            available = accessor->bufferView->byteLength - accessor->byteOffset;
+        }
+        if (data) {
+            Add(data, std::min(accessor->count * stride, available));
+        }
+    }
+
+    void Add(Mesh::AccessorList &accessors) {
+        Add(static_cast<uint64_t>(accessors.size()));
+        for (Ref<Accessor> &accessor : accessors) {
+            Add(accessor);
+        }
+    }
+
+    uint64_t Get() const {
+        return (static_cast<uint64_t>(mHigh) << 32) | mLow;
+    }
+
+private:
+    uint32_t mLow, mHigh;
+};
+
+// Computes the fingerprint of a primitive, never 0 as that marks unknown mesh keys
+uint64_t HashPrimitive(Mesh &mesh, uint64_t id, unsigned int materialIndex) {
+    Mesh::Primitive &prim = mesh.primitives[static_cast<uint32_t>(id)];
+
+    SourceHasher hasher(id);
+    hasher.Add(mesh.id);
+    hasher.Add(mesh.name);
+    hasher.Add(static_cast<uint64_t>(mesh.primitives.size()));
+    hasher.Add(static_cast<uint64_t>(prim.mode));
+    hasher.Add(static_cast<uint64_t>(materialIndex));
+
+    Mesh::Primitive::Attributes &attr = prim.attributes;
+    hasher.Add(attr.position);
+    hasher.Add(attr.normal);
+    hasher.Add(attr.tangent);
+    hasher.Add(attr.color);
+    hasher.Add(attr.texcoord);
+    hasher.Add(prim.indices);
+
+    hasher.Add(static_cast<uint64_t>(prim.targets.size()));
+    for (Mesh::Primitive::Target &target : prim.targets) {
+        hasher.Add(target.position);
+        hasher.Add(target.normal);
+        hasher.Add(target.tangent);
+    }
+    hasher.Add(mesh.weights.data(), mesh.weights.size() * sizeof(float));
+    hasher.Add(static_cast<uint64_t>(mesh.targetNames.size()));
+    for (const std::string &name : mesh.targetNames) {
+        hasher.Add(name);
+    }
+
+    const uint64_t hash = hasher.Get();
+    return 0 != hash ? hash : 1;
+}
 } // namespace
 
 //
@@ -95,7 +206,9 @@ glTF2Importer::glTF2Importer() :
         BaseImporter(),
         meshOffsets(),
         embeddedTexIdxs(),
-        mScene(nullptr) {
+        mScene(nullptr),
+        incremental(false),
+        meshCache() {
     // empty
 }
 
@@ -107,6 +220,10 @@ const aiImporterDesc *glTF2Importer::GetInfo() const {
     return &desc;
 }
 
+void glTF2Importer::SetupProperties(const Importer *pImp) {
+    incremental = pImp->GetPropertyBool(AI_CONFIG_IMPORT_INCREMENTAL, false);
+}
+
 bool glTF2Importer::CanRead(const std::string &pFile, IOSystem *pIOHandler, bool /* checkSig */) const {
     const std::string &extension = GetExtension(pFile);//ȡ׺
 
@@ -355,6 +472,11 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
     ASSIMP_LOG_DEBUG_F("Importing ", r.meshes.Size(), " meshes");
     std::vector<std::unique_ptr<aiMesh>> meshes;
 
+    // On incremental imports primitives are identified by mesh index and
+    // primitive number, unchanged ones are copied from the last import.
+    std::unordered_map<uint64_t, CachedMesh> cache;
+    unsigned int numReused = 0;
+
     unsigned int k = 0;
     meshOffsets.clear();
 
@@ -367,6 +489,24 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
         for (unsigned int p = 0; p < mesh.primitives.size(); ++p) {
             Mesh::Primitive &prim = mesh.primitives[p];
 
+            const unsigned int materialIndex = prim.material ? prim.material.GetIndex() : mScene->mNumMaterials - 1;
+            const uint64_t id = (static_cast<uint64_t>(m) << 32) | p;
+            uint64_t fingerprint = 0;
+            if (incremental) {
+                fingerprint = HashPrimitive(mesh, id, materialIndex);
+                m_meshKeys.push_back(fingerprint);
+
+                auto it = meshCache.find(id);
+                if (it != meshCache.end() && it->second.fingerprint == fingerprint) {
+                    aiMesh *copy = nullptr;
+                    SceneCombiner::Copy(&copy, it->second.mesh.get());
+                    meshes.push_back(std::unique_ptr<aiMesh>(copy));
+                    cache[id] = std::move(it->second);
+                    ++numReused;
+                    continue;
+                }
+            }
+
             aiMesh *aim = new aiMesh();
             meshes.push_back(std::unique_ptr<aiMesh>(aim));
 
@@ -400,18 +540,18 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
 
             if (attr.position.size() > 0 && attr.position[0]) {
                 aim->mNumVertices = static_cast<unsigned int>(attr.position[0]->count);
-                attr.position[0]->ExtractData(aim->mVertices);
+                attr.position[0]->ExtractFloatData(aim->mVertices);
             }
 
             if (attr.normal.size() > 0 && attr.normal[0]) {
-                attr.normal[0]->ExtractData(aim->mNormals);
+                attr.normal[0]->ExtractFloatData(aim->mNormals);
 
                 // only extract tangents if normals are present
                 if (attr.tangent.size() > 0 && attr.tangent[0]) {
                     // generate bitangents from normals and tangents according to spec
                     Tangent *tangents = nullptr;
 
-                    attr.tangent[0]->ExtractData(tangents);
+                    attr.tangent[0]->ExtractFloatData(tangents);
 
                     aim->mTangents = new aiVector3D[aim->mNumVertices];
                     aim->mBitangents = new aiVector3D[aim->mNumVertices];
@@ -431,7 +571,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                                                "\" does not match the vertex count");
                     continue;
                 }
-                attr.color[c]->ExtractData(aim->mColors[c]);
+                attr.color[c]->ExtractFloatData(aim->mColors[c]);
             }
             for (size_t tc = 0; tc < attr.texcoord.size() && tc < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++tc) {
                 if (!attr.texcoord[tc]) {
@@ -445,7 +585,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                     continue;
                 }
 
-                attr.texcoord[tc]->ExtractData(aim->mTextureCoords[tc]);
+                attr.texcoord[tc]->ExtractFloatData(aim->mTextureCoords[tc]);
                 aim->mNumUVComponents[tc] = attr.texcoord[tc]->GetNumComponents();
 
                 aiVector3D *values = aim->mTextureCoords[tc];
@@ -471,7 +611,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
 
                     if (needPositions) {
                         aiVector3D *positionDiff = nullptr;
-                        target.position[0]->ExtractData(positionDiff);
+                        target.position[0]->ExtractFloatData(positionDiff);
                         for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; vertexId++) {
                             aiAnimMesh.mVertices[vertexId] += positionDiff[vertexId];
                         }
@@ -479,7 +619,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                     }
                     if (needNormals) {
                         aiVector3D *normalDiff = nullptr;
-                        target.normal[0]->ExtractData(normalDiff);
+                        target.normal[0]->ExtractFloatData(normalDiff);
                         for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; vertexId++) {
                             aiAnimMesh.mNormals[vertexId] += normalDiff[vertexId];
                         }
@@ -487,10 +627,10 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                     }
                     if (needTangents) {
                         Tangent *tangent = nullptr;
-                        attr.tangent[0]->ExtractData(tangent);
+                        attr.tangent[0]->ExtractFloatData(tangent);
 
                         aiVector3D *tangentDiff = nullptr;
-                        target.tangent[0]->ExtractData(tangentDiff);
+                        target.tangent[0]->ExtractFloatData(tangentDiff);
 
                         for (unsigned int vertexId = 0; vertexId < aim->mNumVertices; ++vertexId) {
                             tangent[vertexId].xyz += tangentDiff[vertexId];
@@ -601,11 +741,7 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
 
                 switch (prim.mode) {
                     case PrimitiveMode_POINTS: {
-                        nFaces = count;
-                        facePtr = faces = new aiFace[nFaces];
-                        for (unsigned int i = 0; i < count; ++i) {
-                            SetFaceAndAdvance1(facePtr, aim->mNumVertices, i);
-                        }
+                        // a point cloud, each vertex is one point and needs no face
                         break;
                     }
 
@@ -688,16 +824,24 @@ void glTF2Importer::ImportMeshes(glTF2::Asset &r) {
                 ai_assert(CheckValidFacesIndices(faces, actualNumFaces, aim->mNumVertices));
             }
 
-            if (prim.material) {
-                aim->mMaterialIndex = prim.material.GetIndex();
-            } else {
-                aim->mMaterialIndex = mScene->mNumMaterials - 1;
+            aim->mMaterialIndex = materialIndex;
+
+            if (incremental) {
+                aiMesh *copy = nullptr;
+                SceneCombiner::Copy(&copy, aim);
+                cache[id] = CachedMesh{ fingerprint, std::unique_ptr<aiMesh>(copy) };
             }
         }
     }
 
     meshOffsets.push_back(k);
 
+    // keep exactly the primitives of this import
+    meshCache.swap(cache);
+    if (incremental) {
+        ASSIMP_LOG_DEBUG_F("Reused ", numReused, " of ", meshes.size(), " converted meshes");
+    }
+
     CopyVector(meshes, mScene->mMeshes, mScene->mNumMeshes);
 }
 
@@ -1459,6 +1603,13 @@ void glTF2Importer::InternReadFile(const std::string &pFile, aiScene *pScene, IO
 
     ImportNodes(asset);
 
+    // Bones depend on the skinned node, not on the primitive alone
+    for (size_t i = 0; i < m_meshKeys.size(); ++i) {
+        if (pScene->mMeshes[i]->HasBones()) {
+            m_meshKeys[i] = 0;
+        }
+    }
+
     ImportAnimations(asset);
 
     ImportCommonMetadata(asset);
@@ -45,7 +45,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/BaseImporter.h>
 #include <assimp/DefaultIOSystem.h>
 
+#include <memory>
+#include <unordered_map>
+
 struct aiNode;
+struct aiMesh;
 
 
 namespace glTF2
@@ -67,9 +71,15 @@ public:
 
 protected:
     virtual const aiImporterDesc* GetInfo() const;
+    virtual void SetupProperties( const Importer* pImp );
     virtual void InternReadFile( const std::string& pFile, aiScene* pScene, IOSystem* pIOHandler );
 
 private:
+    /** Converted mesh of a glTF primitive, kept for incremental re-imports */
+    struct CachedMesh {
+        uint64_t fingerprint;
+        std::unique_ptr<aiMesh> mesh;
+    };
 
     std::vector<unsigned int> meshOffsets;//
 
@@ -77,6 +87,12 @@ private:
 
     aiScene* mScene;
 
+    /** AI_CONFIG_IMPORT_INCREMENTAL */
+    bool incremental;
+
+    /** Meshes of the last import by mesh index (high word) and primitive */
+    std::unordered_map<uint64_t, CachedMesh> meshCache;
+
     void ImportEmbeddedTextures(glTF2::Asset& a);
     void ImportMaterials(glTF2::Asset& a);
     void ImportMeshes(glTF2::Asset& a);
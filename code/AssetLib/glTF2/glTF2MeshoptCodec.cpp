@@ -0,0 +1,352 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+#if !defined(ASSIMP_BUILD_NO_GLTF_IMPORTER) && !defined(ASSIMP_BUILD_NO_GLTF2_IMPORTER)
+
+#include "AssetLib/glTF2/glTF2MeshoptCodec.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace glTF2 {
+namespace Meshopt {
+
+namespace {
+
+const uint8_t VertexHeader = 0xa0;
+const uint8_t SequenceHeader = 0xd0;
+const int SequenceVersion = 1;
+
+const size_t VertexBlockSizeBytes = 8192;
+const size_t VertexBlockMaxSize = 256;
+const size_t ByteGroupSize = 16;
+const size_t ByteGroupDecodeLimit = 24;
+const size_t TailMaxSize = 32;
+
+// Number of vertices per block, so one block of a byte stream fits into the scratch buffer
+size_t GetVertexBlockSize(size_t stride) {
+    size_t result = VertexBlockSizeBytes / stride;
+    result &= ~(ByteGroupSize - 1);
+    return std::min(result, VertexBlockMaxSize);
+}
+
+inline uint8_t ZigZag8(uint8_t v) {
+    return static_cast<uint8_t>((static_cast<int8_t>(v) >> 7) ^ (v << 1));
+}
+
+inline uint8_t UnZigZag8(uint8_t v) {
+    return static_cast<uint8_t>(-(v & 1) ^ (v >> 1));
+}
+
+// Encoded size of a group of 16 bytes with the given number of bits, values
+// which do not fit are stored as extra bytes behind the group
+size_t MeasureGroup(const uint8_t *group, int bits) {
+    if (0 == bits) {
+        for (size_t i = 0; i < ByteGroupSize; ++i) {
+            if (group[i]) {
+                return size_t(-1);
+            }
+        }
+        return 0;
+    }
+    if (8 == bits) {
+        return ByteGroupSize;
+    }
+    size_t result = ByteGroupSize * bits / 8;
+    const uint8_t sentinel = static_cast<uint8_t>((1 << bits) - 1);
+    for (size_t i = 0; i < ByteGroupSize; ++i) {
+        result += group[i] >= sentinel;
+    }
+    return result;
+}
+
+void EncodeGroup(std::vector<uint8_t> &out, const uint8_t *group, int bits) {
+    if (0 == bits) {
+        return;
+    }
+    if (8 == bits) {
+        out.insert(out.end(), group, group + ByteGroupSize);
+        return;
+    }
+    const size_t perByte = 8 / bits;
+    const uint8_t sentinel = static_cast<uint8_t>((1 << bits) - 1);
+    for (size_t i = 0; i < ByteGroupSize; i += perByte) {
+        uint8_t byte = 0;
+        for (size_t k = 0; k < perByte; ++k) {
+            byte = static_cast<uint8_t>(byte << bits);
+            byte |= std::min(group[i + k], sentinel);
+        }
+        out.push_back(byte);
+    }
+    for (size_t i = 0; i < ByteGroupSize; ++i) {
+        if (group[i] >= sentinel) {
+            out.push_back(group[i]);
+        }
+    }
+}
+
+// Encodes a stream of size bytes, a multiple of the group size
+void EncodeBytes(std::vector<uint8_t> &out, const uint8_t *buffer, size_t size) {
+    // two header bits per group select 0, 2, 4 or 8 bits per value
+    const size_t headerOffset = out.size();
+    out.resize(out.size() + (size / ByteGroupSize + 3) / 4, 0);
+
+    static const int Bits[4] = { 0, 2, 4, 8 };
+    for (size_t i = 0; i < size; i += ByteGroupSize) {
+        int best = 3;
+        size_t bestSize = MeasureGroup(buffer + i, 8);
+        for (int b = 0; b < 3; ++b) {
+            const size_t groupSize = MeasureGroup(buffer + i, Bits[b]);
+            if (groupSize < bestSize) {
+                best = b;
+                bestSize = groupSize;
+            }
+        }
+        const size_t group = i / ByteGroupSize;
+        out[headerOffset + group / 4] |= static_cast<uint8_t>(best << ((group % 4) * 2));
+        EncodeGroup(out, buffer + i, Bits[best]);
+    }
+}
+
+const uint8_t *DecodeGroup(const uint8_t *data, uint8_t *group, int bitsLog2) {
+    switch (bitsLog2) {
+    case 0:
+        memset(group, 0, ByteGroupSize);
+        return data;
+    case 3:
+        memcpy(group, data, ByteGroupSize);
+        return data + ByteGroupSize;
+    default:
+        break;
+    }
+
+    const int bits = 1 << bitsLog2;
+    const size_t perByte = 8 / bits;
+    const uint8_t sentinel = static_cast<uint8_t>((1 << bits) - 1);
+    const uint8_t *extra = data + ByteGroupSize / perByte;
+    for (size_t i = 0; i < ByteGroupSize; i += perByte) {
+        uint8_t byte = *data++;
+        for (size_t k = 0; k < perByte; ++k) {
+            const uint8_t value = static_cast<uint8_t>(byte >> (8 - bits));
+            byte = static_cast<uint8_t>(byte << bits);
+            group[i + k] = (value == sentinel) ? *extra++ : value;
+        }
+    }
+    return extra;
+}
+
+const uint8_t *DecodeBytes(const uint8_t *data, const uint8_t *end, uint8_t *buffer, size_t size) {
+    const size_t headerSize = (size / ByteGroupSize + 3) / 4;
+    if (size_t(end - data) < headerSize) {
+        return nullptr;
+    }
+    const uint8_t *header = data;
+    data += headerSize;
+
+    for (size_t i = 0; i < size; i += ByteGroupSize) {
+        // a group takes at most 24 bytes, the tail keeps this from reading past the end
+        if (size_t(end - data) < ByteGroupDecodeLimit) {
+            return nullptr;
+        }
+        const size_t group = i / ByteGroupSize;
+        data = DecodeGroup(data, buffer + i, (header[group / 4] >> ((group % 4) * 2)) & 3);
+    }
+    return data;
+}
+
+void EncodeVByte(std::vector<uint8_t> &out, uint32_t v) {
+    do {
+        out.push_back(static_cast<uint8_t>((v & 127) | (v > 127 ? 128 : 0)));
+        v >>= 7;
+    } while (v);
+}
+
+bool DecodeVByte(const uint8_t *&data, const uint8_t *end, uint32_t &v) {
+    v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        if (data == end) {
+            return false;
+        }
+        const uint8_t byte = *data++;
+        v |= uint32_t(byte & 127) << shift;
+        if (!(byte & 128)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+void EncodeVertexBuffer(std::vector<uint8_t> &out, const uint8_t *vertices, size_t count, size_t stride) {
+    out.push_back(VertexHeader);
+
+    uint8_t first[VertexBlockMaxSize] = {};
+    if (count > 0) {
+        memcpy(first, vertices, stride);
+    }
+    uint8_t last[VertexBlockMaxSize];
+    memcpy(last, first, stride);
+
+    const size_t blockSize = GetVertexBlockSize(stride);
+    uint8_t buffer[VertexBlockMaxSize];
+    for (size_t offset = 0; offset < count; offset += blockSize) {
+        const size_t blockCount = std::min(blockSize, count - offset);
+        const uint8_t *block = vertices + offset * stride;
+
+        // the bytes past the last vertex of a partial group stay zero
+        memset(buffer, 0, sizeof(buffer));
+        for (size_t k = 0; k < stride; ++k) {
+            uint8_t previous = last[k];
+            for (size_t i = 0; i < blockCount; ++i) {
+                const uint8_t value = block[i * stride + k];
+                buffer[i] = ZigZag8(static_cast<uint8_t>(value - previous));
+                previous = value;
+            }
+            EncodeBytes(out, buffer, (blockCount + ByteGroupSize - 1) & ~(ByteGroupSize - 1));
+        }
+        memcpy(last, block + (blockCount - 1) * stride, stride);
+    }
+
+    // the first vertex goes into a tail of at least 32 bytes
+    if (stride < TailMaxSize) {
+        out.resize(out.size() + TailMaxSize - stride, 0);
+    }
+    out.insert(out.end(), first, first + stride);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool DecodeVertexBuffer(uint8_t *out, size_t count, size_t stride, const uint8_t *data, size_t size) {
+    if (0 == stride || stride > VertexBlockMaxSize || stride % 4 != 0) {
+        return false;
+    }
+    const size_t tailSize = std::max(stride, TailMaxSize);
+    if (size < 1 + tailSize || data[0] != VertexHeader) {
+        return false;
+    }
+    const uint8_t *end = data + size;
+    ++data;
+
+    uint8_t last[VertexBlockMaxSize];
+    memcpy(last, end - stride, stride);
+
+    const size_t blockSize = GetVertexBlockSize(stride);
+    uint8_t buffer[VertexBlockMaxSize];
+    for (size_t offset = 0; offset < count; offset += blockSize) {
+        const size_t blockCount = std::min(blockSize, count - offset);
+        uint8_t *block = out + offset * stride;
+
+        for (size_t k = 0; k < stride; ++k) {
+            data = DecodeBytes(data, end, buffer, (blockCount + ByteGroupSize - 1) & ~(ByteGroupSize - 1));
+            if (nullptr == data) {
+                return false;
+            }
+            uint8_t previous = last[k];
+            for (size_t i = 0; i < blockCount; ++i) {
+                previous = static_cast<uint8_t>(previous + UnZigZag8(buffer[i]));
+                block[i * stride + k] = previous;
+            }
+        }
+        memcpy(last, block + (blockCount - 1) * stride, stride);
+    }
+    return data == end - tailSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+void EncodeIndexSequence(std::vector<uint8_t> &out, const uint32_t *indices, size_t count) {
+    out.push_back(static_cast<uint8_t>(SequenceHeader | SequenceVersion));
+
+    // deltas go against one of two baselines, switching when the delta grows large
+    uint32_t last[2] = { 0, 0 };
+    unsigned int current = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t index = indices[i];
+        const int cd = int(index - last[current]);
+        current ^= ((cd < 0 ? -cd : cd) >= 30);
+
+        const uint32_t d = index - last[current];
+        const uint32_t v = (d << 1) ^ uint32_t(int32_t(d) >> 31);
+        EncodeVByte(out, (v << 1) | current);
+        last[current] = index;
+    }
+    out.resize(out.size() + 4, 0);
+}
+
+// ------------------------------------------------------------------------------------------------
+bool DecodeIndexSequence(uint8_t *out, size_t count, size_t indexSize, const uint8_t *data, size_t size) {
+    if ((indexSize != 2 && indexSize != 4) || size < 1 + 4) {
+        return false;
+    }
+    if ((data[0] & 0xf0) != SequenceHeader || (data[0] & 0x0f) > SequenceVersion) {
+        return false;
+    }
+    const uint8_t *end = data + size - 4;
+    ++data;
+
+    uint32_t last[2] = { 0, 0 };
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t v;
+        if (!DecodeVByte(data, end, v)) {
+            return false;
+        }
+        const unsigned int current = v & 1;
+        v >>= 1;
+        const uint32_t d = (v >> 1) ^ uint32_t(-int32_t(v & 1));
+        const uint32_t index = last[current] + d;
+        last[current] = index;
+
+        if (2 == indexSize) {
+            const uint16_t index16 = static_cast<uint16_t>(index);
+            memcpy(out + i * 2, &index16, 2);
+        } else {
+            memcpy(out + i * 4, &index, 4);
+        }
+    }
+    return data == end;
+}
+
+} // namespace Meshopt
+} // namespace glTF2
+
+#endif // ASSIMP_BUILD_NO_GLTF_IMPORTER
@@ -0,0 +1,82 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file glTF2MeshoptCodec.h
+ *  Vertex and index codecs of the EXT_meshopt_compression extension.
+ *
+ *  The vertex codec stores each byte of a vertex as a separate stream of
+ *  zigzag encoded deltas to the previous vertex, packed in groups of 16 with
+ *  0, 2, 4 or 8 bits per value. The index sequence codec stores varint deltas
+ *  to one of two previous indices.
+ */
+#ifndef GLTF2MESHOPTCODEC_H_INC
+#define GLTF2MESHOPTCODEC_H_INC
+
+#include <assimp/defs.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace glTF2 {
+namespace Meshopt {
+
+//! Appends count vertices of stride bytes each, encoded with the vertex codec.
+//! The stride must be a multiple of 4 and at most 256.
+ASSIMP_API void EncodeVertexBuffer(std::vector<uint8_t> &out, const uint8_t *vertices, size_t count, size_t stride);
+
+//! Decodes a vertex codec stream into count * stride bytes.
+//! \return false if the stream is malformed or of an unknown version
+ASSIMP_API bool DecodeVertexBuffer(uint8_t *out, size_t count, size_t stride, const uint8_t *data, size_t size);
+
+//! Appends count indices, encoded with the index sequence codec.
+ASSIMP_API void EncodeIndexSequence(std::vector<uint8_t> &out, const uint32_t *indices, size_t count);
+
+//! Decodes an index sequence stream into count indices of indexSize (2 or 4) bytes.
+//! \return false if the stream is malformed or of an unknown version
+ASSIMP_API bool DecodeIndexSequence(uint8_t *out, size_t count, size_t indexSize, const uint8_t *data, size_t size);
+
+} // namespace Meshopt
+} // namespace glTF2
+
+#endif // GLTF2MESHOPTCODEC_H_INC
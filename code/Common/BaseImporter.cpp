@@ -64,7 +64,9 @@ using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 BaseImporter::BaseImporter() AI_NO_EXCEPT
-        : m_progress() {
+        : m_progress(),
+          m_checkpoint(),
+          m_meshKeys() {
     /**
     * Assimp Importer
     * unit conversions available
@@ -110,6 +112,9 @@ aiScene *BaseImporter::ReadFile(Importer *pImp, const std::string &pFile, IOSyst
     }
 
     ai_assert(m_progress);
+    m_checkpoint = ImportCheckpoint(m_progress, pImp->GetCancellationToken().get());
+
+    m_meshKeys.clear();
 
     // Gather configuration properties for this run
     SetupProperties(pImp);
@@ -122,11 +127,14 @@ aiScene *BaseImporter::ReadFile(Importer *pImp, const std::string &pFile, IOSyst
 
     // dispatch importing
     try {
+        // loaders without own checkpoints at least honor a cancelled token here
+        m_checkpoint.CheckCancelled();
         InternReadFile(pFile, sc.get(), &filter);	//˴gltf2importer.cppеĺ
 
         // Calculate import scale hook - required because pImp not available anywhere else
         // passes scale into ScaleProcess
         UpdateImporterScale(pImp);
+        m_checkpoint.CheckCancelled();
 
     } catch( const std::exception &err ) {
         // extract error description
@@ -44,6 +44,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "BaseProcess.h"
 #include "Importer.h"
 #include <assimp/BaseImporter.h>
+#include <assimp/SceneCombiner.h>
 #include <assimp/scene.h>
 #include <assimp/DefaultLogger.hpp>
 
@@ -53,7 +54,8 @@ using namespace Assimp;
 // Constructor to be privately used by Importer
 BaseProcess::BaseProcess() AI_NO_EXCEPT
         : shared(),
-          progress() {
+          progress(),
+          checkpoint() {
     // empty
 }
 
@@ -70,6 +72,7 @@ void BaseProcess::ExecuteOnScene(Importer *pImp) {
 
     progress = pImp->GetProgressHandler();
     ai_assert(nullptr != progress);
+    checkpoint = ImportCheckpoint(progress, pImp->GetCancellationToken().get());
 
     SetupProperties(pImp);
 
@@ -98,3 +101,9 @@ void BaseProcess::SetupProperties(const Importer * /*pImp*/) {
 bool BaseProcess::RequireVerboseFormat() const {
     return true;
 }
+
+// ------------------------------------------------------------------------------------------------
+unsigned int BaseProcess::GetModifiedSceneComponents() const {
+    // be conservative, steps which know better override this
+    return SceneComponent_All;
+}
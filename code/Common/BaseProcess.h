@@ -43,7 +43,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef INCLUDED_AI_BASEPROCESS_H
 #define INCLUDED_AI_BASEPROCESS_H
 
+#include <assimp/Cancellation.h>
 #include <assimp/GenericProperty.h>
+#include <assimp/SceneCombiner.h>
 
 #include <map>
 
@@ -199,6 +201,13 @@ public:
      *  in verbose format. */
     virtual bool RequireVerboseFormat() const;
 
+    // -------------------------------------------------------------------
+    /** Returns the scene components the step may modify, as a bitwise
+     *  combination of #SceneComponent flags. The node graph is always
+     *  assumed to be modified. Used by the Exporter to unshare only
+     *  what a step touches. */
+    virtual unsigned int GetModifiedSceneComponents() const;
+
     // -------------------------------------------------------------------
     /** Executes the post processing step on the given imported data.
     * The function deletes the scene if the postprocess step fails (
@@ -244,6 +253,10 @@ protected:
 
     /** Currently active progress handler */
     ProgressHandler *progress;
+
+    /** Cancellation point for per-mesh loops, inactive unless the
+     *  step runs through ExecuteOnScene() */
+    ImportCheckpoint checkpoint;
 };
 
 } // end of namespace Assimp
@@ -0,0 +1,564 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  BatchMath.cpp
+ *  @brief Scalar, SSE2 and AVX2 implementations of the batch math functions.
+ */
+#include "Common/BatchMath.h"
+#include "Common/simd.h"
+
+#include <atomic>
+#include <cmath>
+
+// The SIMD paths work on single precision only. SSE2 is part of the x86_64
+// baseline, the AVX2 functions are compiled for that target separately and
+// only called if the CPU supports it.
+#if !defined(ASSIMP_DOUBLE_PRECISION) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#   define AI_BATCHMATH_SSE2
+#   include <emmintrin.h>
+#   include <immintrin.h>
+#   if defined(__GNUC__) || defined(__clang__)
+#       define AI_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#   else
+#       define AI_TARGET_AVX2
+#   endif
+#endif
+
+namespace Assimp {
+namespace BatchMath {
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Scalar implementations, these define the results the SIMD paths have to match
+
+void MultiplyScalar(aiMatrix4x4 *out, const aiMatrix4x4 *lhs, size_t lhsStride, const aiMatrix4x4 *rhs, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = lhs[i * lhsStride] * rhs[i];
+    }
+}
+
+void InvertScalar(aiMatrix4x4 *out, const aiMatrix4x4 *in, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = in[i];
+        out[i].Inverse();
+    }
+}
+
+void TransformPositionsScalar(aiVector3D *out, const aiVector3D *in, size_t count, const aiMatrix4x4 &m) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = m * in[i];
+    }
+}
+
+void TransformDirectionsScalar(aiVector3D *out, const aiVector3D *in, size_t count, const aiMatrix3x3 &m, bool normalize) {
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = m * in[i];
+        if (normalize) {
+            out[i].Normalize();
+        }
+    }
+}
+
+void BoundingBoxScalar(const aiVector3D *in, size_t count, aiVector3D &min, aiVector3D &max) {
+    for (size_t i = 0; i < count; ++i) {
+        const aiVector3D &pos = in[i];
+        if (pos.x < min.x) min.x = pos.x;
+        if (pos.y < min.y) min.y = pos.y;
+        if (pos.z < min.z) min.z = pos.z;
+        if (pos.x > max.x) max.x = pos.x;
+        if (pos.y > max.y) max.y = pos.y;
+        if (pos.z > max.z) max.z = pos.z;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Folds interleaved xyz accumulators back into a box, float k holds component k % 3
+void FoldBoundingBox(const float *mins, const float *maxs, size_t numFloats, aiVector3D &min, aiVector3D &max) {
+    for (size_t k = 0; k < numFloats; ++k) {
+        const unsigned int c = static_cast<unsigned int>(k % 3);
+        if (mins[k] < min[c]) min[c] = mins[k];
+        if (maxs[k] > max[c]) max[c] = maxs[k];
+    }
+}
+
+#ifdef AI_BATCHMATH_SSE2
+
+// ------------------------------------------------------------------------------------------------
+// SSE2 implementations. The operations are ordered like in the scalar code,
+// so results match bit for bit.
+
+inline __m128 Splat(__m128 v, int i) {
+    switch (i) {
+    case 0: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+    case 1: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+    case 2: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+    default: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+}
+
+inline void StoreVector(aiVector3D &out, __m128 v) {
+    _mm_storel_pi(reinterpret_cast<__m64 *>(&out.x), v);
+    _mm_store_ss(&out.z, _mm_movehl_ps(v, v));
+}
+
+// Loads x, y, z of in[i], the last element must not be read as four floats
+inline __m128 LoadVector(const aiVector3D *in, size_t i, size_t count) {
+    return i + 1 < count ? _mm_loadu_ps(&in[i].x) : _mm_setr_ps(in[i].x, in[i].y, in[i].z, 0.f);
+}
+
+void MultiplySSE2(aiMatrix4x4 *out, const aiMatrix4x4 *lhs, size_t lhsStride, const aiMatrix4x4 *rhs, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const float *a = &lhs[i * lhsStride].a1, *b = &rhs[i].a1;
+        const __m128 b0 = _mm_loadu_ps(b), b1 = _mm_loadu_ps(b + 4), b2 = _mm_loadu_ps(b + 8), b3 = _mm_loadu_ps(b + 12);
+        __m128 rows[4];
+        for (int r = 0; r < 4; ++r) {
+            const __m128 ar = _mm_loadu_ps(a + 4 * r);
+            rows[r] = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                                                    _mm_mul_ps(b0, Splat(ar, 0)),
+                                                    _mm_mul_ps(b1, Splat(ar, 1))),
+                                         _mm_mul_ps(b2, Splat(ar, 2))),
+                    _mm_mul_ps(b3, Splat(ar, 3)));
+        }
+        float *o = &out[i].a1;
+        _mm_storeu_ps(o, rows[0]);
+        _mm_storeu_ps(o + 4, rows[1]);
+        _mm_storeu_ps(o + 8, rows[2]);
+        _mm_storeu_ps(o + 12, rows[3]);
+    }
+}
+
+// 2x2 minor r_i * s_j - r_j * s_i of two matrix rows, one matrix per lane
+inline __m128 Minor(const __m128 *r, const __m128 *s, int i, int j) {
+    return _mm_sub_ps(_mm_mul_ps(r[i], s[j]), _mm_mul_ps(r[j], s[i]));
+}
+
+// x * p + y * q + z * r
+inline __m128 Dot3(__m128 x, __m128 p, __m128 y, __m128 q, __m128 z, __m128 r) {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, p), _mm_mul_ps(y, q)), _mm_mul_ps(z, r));
+}
+
+// Inverts four matrices at once, each lane of e[] holds one element of one matrix.
+// Follows aiMatrix4x4::Inverse() term by term.
+void InvertLanes(const __m128 *e, __m128 *res) {
+    const __m128 *a = e, *b = e + 4, *c = e + 8, *d = e + 12;
+
+    const __m128 cd34 = Minor(c, d, 2, 3), cd42 = Minor(c, d, 3, 1), cd23 = Minor(c, d, 1, 2), cd41 = Minor(c, d, 3, 0);
+    const __m128 cd13 = Minor(c, d, 0, 2), cd24 = Minor(c, d, 1, 3), cd12 = Minor(c, d, 0, 1), cd31 = Minor(c, d, 2, 0);
+    const __m128 bd34 = Minor(b, d, 2, 3), bd42 = Minor(b, d, 3, 1), bd23 = Minor(b, d, 1, 2), bd41 = Minor(b, d, 3, 0);
+    const __m128 bd13 = Minor(b, d, 0, 2), bd24 = Minor(b, d, 1, 3), bd12 = Minor(b, d, 0, 1), bd31 = Minor(b, d, 2, 0);
+    const __m128 bc34 = Minor(b, c, 2, 3), bc42 = Minor(b, c, 3, 1), bc23 = Minor(b, c, 1, 2), bc41 = Minor(b, c, 3, 0);
+    const __m128 bc13 = Minor(b, c, 0, 2), bc24 = Minor(b, c, 1, 3), bc12 = Minor(b, c, 0, 1), bc31 = Minor(b, c, 2, 0);
+
+    // Cofactors, the odd ones still have to be negated
+    res[0] = Dot3(b[1], cd34, b[2], cd42, b[3], cd23);
+    res[1] = Dot3(a[1], cd34, a[2], cd42, a[3], cd23);
+    res[2] = Dot3(a[1], bd34, a[2], bd42, a[3], bd23);
+    res[3] = Dot3(a[1], bc34, a[2], bc42, a[3], bc23);
+    res[4] = Dot3(b[0], cd34, b[2], cd41, b[3], cd13);
+    res[5] = Dot3(a[0], cd34, a[2], cd41, a[3], cd13);
+    res[6] = Dot3(a[0], bd34, a[2], bd41, a[3], bd13);
+    res[7] = Dot3(a[0], bc34, a[2], bc41, a[3], bc13);
+    res[8] = Dot3(b[0], cd24, b[1], cd41, b[3], cd12);
+    res[9] = Dot3(a[0], cd24, a[1], cd41, a[3], cd12);
+    res[10] = Dot3(a[0], bd24, a[1], bd41, a[3], bd12);
+    res[11] = Dot3(a[0], bc24, a[1], bc41, a[3], bc12);
+    res[12] = Dot3(b[0], cd23, b[1], cd31, b[2], cd12);
+    res[13] = Dot3(a[0], cd23, a[1], cd31, a[2], cd12);
+    res[14] = Dot3(a[0], bd23, a[1], bd31, a[2], bd12);
+    res[15] = Dot3(a[0], bc23, a[1], bc31, a[2], bc12);
+
+    // Laplace expansion along the first row
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 det = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(a[0], res[0]), _mm_mul_ps(a[1], res[4])), _mm_mul_ps(a[2], res[8])), _mm_mul_ps(a[3], res[12]));
+    const __m128 invdet = _mm_div_ps(_mm_set1_ps(1.f), det);
+    const __m128 neginvdet = _mm_sub_ps(zero, invdet);
+
+    // Singular matrices become all NaN, all bits set is a quiet NaN
+    const __m128 singular = _mm_cmpeq_ps(det, zero);
+    for (int k = 0; k < 16; ++k) {
+        const bool odd = ((k >> 2) + (k & 3)) & 1;
+        res[k] = _mm_or_ps(_mm_mul_ps(odd ? neginvdet : invdet, res[k]), singular);
+    }
+}
+
+void InvertSSE2(aiMatrix4x4 *out, const aiMatrix4x4 *in, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 e[16], res[16];
+        for (int r = 0; r < 4; ++r) {
+            __m128 m0 = _mm_loadu_ps(&in[i].a1 + 4 * r), m1 = _mm_loadu_ps(&in[i + 1].a1 + 4 * r);
+            __m128 m2 = _mm_loadu_ps(&in[i + 2].a1 + 4 * r), m3 = _mm_loadu_ps(&in[i + 3].a1 + 4 * r);
+            _MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+            e[4 * r] = m0;
+            e[4 * r + 1] = m1;
+            e[4 * r + 2] = m2;
+            e[4 * r + 3] = m3;
+        }
+        InvertLanes(e, res);
+        for (int r = 0; r < 4; ++r) {
+            __m128 m0 = res[4 * r], m1 = res[4 * r + 1], m2 = res[4 * r + 2], m3 = res[4 * r + 3];
+            _MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+            _mm_storeu_ps(&out[i].a1 + 4 * r, m0);
+            _mm_storeu_ps(&out[i + 1].a1 + 4 * r, m1);
+            _mm_storeu_ps(&out[i + 2].a1 + 4 * r, m2);
+            _mm_storeu_ps(&out[i + 3].a1 + 4 * r, m3);
+        }
+    }
+    InvertScalar(out + i, in + i, count - i);
+}
+
+void TransformPositionsSSE2(aiVector3D *out, const aiVector3D *in, size_t count, const aiMatrix4x4 &m) {
+    const __m128 c0 = _mm_setr_ps(m.a1, m.b1, m.c1, 0.f), c1 = _mm_setr_ps(m.a2, m.b2, m.c2, 0.f);
+    const __m128 c2 = _mm_setr_ps(m.a3, m.b3, m.c3, 0.f), c3 = _mm_setr_ps(m.a4, m.b4, m.c4, 0.f);
+    for (size_t i = 0; i < count; ++i) {
+        const __m128 v = LoadVector(in, i, count);
+        StoreVector(out[i], _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                                                          _mm_mul_ps(c0, Splat(v, 0)),
+                                                          _mm_mul_ps(c1, Splat(v, 1))),
+                                               _mm_mul_ps(c2, Splat(v, 2))),
+                                    c3));
+    }
+}
+
+void TransformDirectionsSSE2(aiVector3D *out, const aiVector3D *in, size_t count, const aiMatrix3x3 &m, bool normalize) {
+    const __m128 c0 = _mm_setr_ps(m.a1, m.b1, m.c1, 0.f), c1 = _mm_setr_ps(m.a2, m.b2, m.c2, 0.f);
+    const __m128 c2 = _mm_setr_ps(m.a3, m.b3, m.c3, 0.f), one = _mm_set1_ps(1.f);
+    for (size_t i = 0; i < count; ++i) {
+        const __m128 v = LoadVector(in, i, count);
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, Splat(v, 0)), _mm_mul_ps(c1, Splat(v, 1))), _mm_mul_ps(c2, Splat(v, 2)));
+        if (normalize) {
+            // aiVector3D::Normalize() multiplies with the reciprocal length
+            const __m128 sq = _mm_mul_ps(r, r);
+            const __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(Splat(sq, 0), Splat(sq, 1)), Splat(sq, 2)));
+            r = _mm_mul_ps(r, _mm_div_ps(one, len));
+        }
+        StoreVector(out[i], r);
+    }
+}
+
+void BoundingBoxSSE2(const aiVector3D *in, size_t count, aiVector3D &min, aiVector3D &max) {
+    // Four points are three registers, each register lane sees one fixed component.
+    // The point is the first operand of min/max so NaN coordinates are skipped.
+    float mins[12], maxs[12];
+    for (size_t k = 0; k < 12; ++k) {
+        mins[k] = min[static_cast<unsigned int>(k % 3)];
+        maxs[k] = max[static_cast<unsigned int>(k % 3)];
+    }
+    __m128 mn0 = _mm_loadu_ps(mins), mn1 = _mm_loadu_ps(mins + 4), mn2 = _mm_loadu_ps(mins + 8);
+    __m128 mx0 = _mm_loadu_ps(maxs), mx1 = _mm_loadu_ps(maxs + 4), mx2 = _mm_loadu_ps(maxs + 8);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const float *p = &in[i].x;
+        const __m128 v0 = _mm_loadu_ps(p), v1 = _mm_loadu_ps(p + 4), v2 = _mm_loadu_ps(p + 8);
+        mn0 = _mm_min_ps(v0, mn0);
+        mn1 = _mm_min_ps(v1, mn1);
+        mn2 = _mm_min_ps(v2, mn2);
+        mx0 = _mm_max_ps(v0, mx0);
+        mx1 = _mm_max_ps(v1, mx1);
+        mx2 = _mm_max_ps(v2, mx2);
+    }
+    _mm_storeu_ps(mins, mn0);
+    _mm_storeu_ps(mins + 4, mn1);
+    _mm_storeu_ps(mins + 8, mn2);
+    _mm_storeu_ps(maxs, mx0);
+    _mm_storeu_ps(maxs + 4, mx1);
+    _mm_storeu_ps(maxs + 8, mx2);
+    FoldBoundingBox(mins, maxs, 12, min, max);
+    BoundingBoxScalar(in + i, count - i, min, max);
+}
+
+// ------------------------------------------------------------------------------------------------
+// AVX2 implementations. They use FMA, results may differ from the scalar code
+// in the last bit.
+
+AI_TARGET_AVX2 void MultiplyAVX2(aiMatrix4x4 *out, const aiMatrix4x4 *lhs, size_t lhsStride, const aiMatrix4x4 *rhs, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const float *a = &lhs[i * lhsStride].a1, *b = &rhs[i].a1;
+        // Each rhs row in both halves, two result rows per register
+        const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b));
+        const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 4));
+        const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 8));
+        const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(b + 12));
+        const __m256 a01 = _mm256_loadu_ps(a), a23 = _mm256_loadu_ps(a + 8);
+
+        __m256 r01 = _mm256_mul_ps(b0, _mm256_permute_ps(a01, _MM_SHUFFLE(0, 0, 0, 0)));
+        r01 = _mm256_fmadd_ps(b1, _mm256_permute_ps(a01, _MM_SHUFFLE(1, 1, 1, 1)), r01);
+        r01 = _mm256_fmadd_ps(b2, _mm256_permute_ps(a01, _MM_SHUFFLE(2, 2, 2, 2)), r01);
+        r01 = _mm256_fmadd_ps(b3, _mm256_permute_ps(a01, _MM_SHUFFLE(3, 3, 3, 3)), r01);
+        __m256 r23 = _mm256_mul_ps(b0, _mm256_permute_ps(a23, _MM_SHUFFLE(0, 0, 0, 0)));
+        r23 = _mm256_fmadd_ps(b1, _mm256_permute_ps(a23, _MM_SHUFFLE(1, 1, 1, 1)), r23);
+        r23 = _mm256_fmadd_ps(b2, _mm256_permute_ps(a23, _MM_SHUFFLE(2, 2, 2, 2)), r23);
+        r23 = _mm256_fmadd_ps(b3, _mm256_permute_ps(a23, _MM_SHUFFLE(3, 3, 3, 3)), r23);
+
+        _mm256_storeu_ps(&out[i].a1, r01);
+        _mm256_storeu_ps(&out[i].a1 + 8, r23);
+    }
+}
+
+// Two points per register, one in each half
+AI_TARGET_AVX2 void TransformPositionsAVX2(aiVector3D *out, const aiVector3D *in, size_t count, const aiMatrix4x4 &m) {
+    const __m256 c0 = _mm256_setr_ps(m.a1, m.b1, m.c1, 0.f, m.a1, m.b1, m.c1, 0.f);
+    const __m256 c1 = _mm256_setr_ps(m.a2, m.b2, m.c2, 0.f, m.a2, m.b2, m.c2, 0.f);
+    const __m256 c2 = _mm256_setr_ps(m.a3, m.b3, m.c3, 0.f, m.a3, m.b3, m.c3, 0.f);
+    const __m256 c3 = _mm256_setr_ps(m.a4, m.b4, m.c4, 0.f, m.a4, m.b4, m.c4, 0.f);
+    size_t i = 0;
+    for (; i + 2 < count; i += 2) {
+        const __m256 v = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(&in[i].x)), _mm_loadu_ps(&in[i + 1].x), 1);
+        __m256 r = _mm256_fmadd_ps(c0, _mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0)), c3);
+        r = _mm256_fmadd_ps(c1, _mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1)), r);
+        r = _mm256_fmadd_ps(c2, _mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2)), r);
+        const __m128 lo = _mm256_castps256_ps128(r), hi = _mm256_extractf128_ps(r, 1);
+        _mm_storel_pi(reinterpret_cast<__m64 *>(&out[i].x), lo);
+        _mm_store_ss(&out[i].z, _mm_movehl_ps(lo, lo));
+        _mm_storel_pi(reinterpret_cast<__m64 *>(&out[i + 1].x), hi);
+        _mm_store_ss(&out[i + 1].z, _mm_movehl_ps(hi, hi));
+    }
+    TransformPositionsSSE2(out + i, in + i, count - i, m);
+}
+
+AI_TARGET_AVX2 void TransformDirectionsAVX2(aiVector3D *out, const aiVector3D *in, size_t count, const aiMatrix3x3 &m, bool normalize) {
+    const __m256 c0 = _mm256_setr_ps(m.a1, m.b1, m.c1, 0.f, m.a1, m.b1, m.c1, 0.f);
+    const __m256 c1 = _mm256_setr_ps(m.a2, m.b2, m.c2, 0.f, m.a2, m.b2, m.c2, 0.f);
+    const __m256 c2 = _mm256_setr_ps(m.a3, m.b3, m.c3, 0.f, m.a3, m.b3, m.c3, 0.f);
+    const __m256 one = _mm256_set1_ps(1.f);
+    size_t i = 0;
+    for (; i + 2 < count; i += 2) {
+        const __m256 v = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(&in[i].x)), _mm_loadu_ps(&in[i + 1].x), 1);
+        __m256 r = _mm256_mul_ps(c0, _mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0)));
+        r = _mm256_fmadd_ps(c1, _mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1)), r);
+        r = _mm256_fmadd_ps(c2, _mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2)), r);
+        if (normalize) {
+            const __m256 sq = _mm256_mul_ps(r, r);
+            const __m256 len = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(
+                                                                     _mm256_permute_ps(sq, _MM_SHUFFLE(0, 0, 0, 0)),
+                                                                     _mm256_permute_ps(sq, _MM_SHUFFLE(1, 1, 1, 1))),
+                    _mm256_permute_ps(sq, _MM_SHUFFLE(2, 2, 2, 2))));
+            r = _mm256_mul_ps(r, _mm256_div_ps(one, len));
+        }
+        const __m128 lo = _mm256_castps256_ps128(r), hi = _mm256_extractf128_ps(r, 1);
+        _mm_storel_pi(reinterpret_cast<__m64 *>(&out[i].x), lo);
+        _mm_store_ss(&out[i].z, _mm_movehl_ps(lo, lo));
+        _mm_storel_pi(reinterpret_cast<__m64 *>(&out[i + 1].x), hi);
+        _mm_store_ss(&out[i + 1].z, _mm_movehl_ps(hi, hi));
+    }
+    TransformDirectionsSSE2(out + i, in + i, count - i, m, normalize);
+}
+
+// Eight points are three registers, see BoundingBoxSSE2()
+AI_TARGET_AVX2 void BoundingBoxAVX2(const aiVector3D *in, size_t count, aiVector3D &min, aiVector3D &max) {
+    float mins[24], maxs[24];
+    for (size_t k = 0; k < 24; ++k) {
+        mins[k] = min[static_cast<unsigned int>(k % 3)];
+        maxs[k] = max[static_cast<unsigned int>(k % 3)];
+    }
+    __m256 mn0 = _mm256_loadu_ps(mins), mn1 = _mm256_loadu_ps(mins + 8), mn2 = _mm256_loadu_ps(mins + 16);
+    __m256 mx0 = _mm256_loadu_ps(maxs), mx1 = _mm256_loadu_ps(maxs + 8), mx2 = _mm256_loadu_ps(maxs + 16);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const float *p = &in[i].x;
+        const __m256 v0 = _mm256_loadu_ps(p), v1 = _mm256_loadu_ps(p + 8), v2 = _mm256_loadu_ps(p + 16);
+        mn0 = _mm256_min_ps(v0, mn0);
+        mn1 = _mm256_min_ps(v1, mn1);
+        mn2 = _mm256_min_ps(v2, mn2);
+        mx0 = _mm256_max_ps(v0, mx0);
+        mx1 = _mm256_max_ps(v1, mx1);
+        mx2 = _mm256_max_ps(v2, mx2);
+    }
+    _mm256_storeu_ps(mins, mn0);
+    _mm256_storeu_ps(mins + 8, mn1);
+    _mm256_storeu_ps(mins + 16, mn2);
+    _mm256_storeu_ps(maxs, mx0);
+    _mm256_storeu_ps(maxs + 8, mx1);
+    _mm256_storeu_ps(maxs + 16, mx2);
+    FoldBoundingBox(mins, maxs, 24, min, max);
+    BoundingBoxSSE2(in + i, count - i, min, max);
+}
+
+#endif // AI_BATCHMATH_SSE2
+
+// ------------------------------------------------------------------------------------------------
+Level DetectLevel() {
+#ifdef AI_BATCHMATH_SSE2
+    if (CPUSupportsAVX2()) {
+        return Level_AVX2;
+    }
+    if (CPUSupportsSSE2()) {
+        return Level_SSE2;
+    }
+#endif
+    return Level_Scalar;
+}
+
+Level BestLevel() {
+    static const Level best = DetectLevel();
+    return best;
+}
+
+std::atomic<int> gLevel(-1);
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+Level GetLevel() {
+    int level = gLevel.load(std::memory_order_relaxed);
+    if (level < 0) {
+        level = BestLevel();
+        gLevel.store(level, std::memory_order_relaxed);
+    }
+    return static_cast<Level>(level);
+}
+
+// ------------------------------------------------------------------------------------------------
+Level SetLevel(Level level) {
+    const Level used = level < BestLevel() ? level : BestLevel();
+    gLevel.store(used, std::memory_order_relaxed);
+    return used;
+}
+
+// ------------------------------------------------------------------------------------------------
+void MultiplyMatrices(aiMatrix4x4 *out, const aiMatrix4x4 *lhs, const aiMatrix4x4 *rhs, size_t count) {
+    switch (GetLevel()) {
+#ifdef AI_BATCHMATH_SSE2
+    case Level_AVX2:
+        MultiplyAVX2(out, lhs, 1, rhs, count);
+        return;
+    case Level_SSE2:
+        MultiplySSE2(out, lhs, 1, rhs, count);
+        return;
+#endif
+    default:
+        MultiplyScalar(out, lhs, 1, rhs, count);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void MultiplyMatrices(aiMatrix4x4 *out, const aiMatrix4x4 &lhs, const aiMatrix4x4 *rhs, size_t count) {
+    // lhs may be one of the outputs
+    const aiMatrix4x4 left = lhs;
+    switch (GetLevel()) {
+#ifdef AI_BATCHMATH_SSE2
+    case Level_AVX2:
+        MultiplyAVX2(out, &left, 0, rhs, count);
+        return;
+    case Level_SSE2:
+        MultiplySSE2(out, &left, 0, rhs, count);
+        return;
+#endif
+    default:
+        MultiplyScalar(out, &left, 0, rhs, count);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void InvertMatrices(aiMatrix4x4 *out, const aiMatrix4x4 *in, size_t count) {
+    // Four matrices per register already, AVX2 has nothing to add here
+    switch (GetLevel()) {
+#ifdef AI_BATCHMATH_SSE2
+    case Level_AVX2:
+    case Level_SSE2:
+        InvertSSE2(out, in, count);
+        return;
+#endif
+    default:
+        InvertScalar(out, in, count);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void TransformPositions(aiVector3D *out, const aiVector3D *in, size_t count, const aiMatrix4x4 &m) {
+    switch (GetLevel()) {
+#ifdef AI_BATCHMATH_SSE2
+    case Level_AVX2:
+        TransformPositionsAVX2(out, in, count, m);
+        return;
+    case Level_SSE2:
+        TransformPositionsSSE2(out, in, count, m);
+        return;
+#endif
+    default:
+        TransformPositionsScalar(out, in, count, m);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void TransformDirections(aiVector3D *out, const aiVector3D *in, size_t count, const aiMatrix3x3 &m, bool normalize) {
+    switch (GetLevel()) {
+#ifdef AI_BATCHMATH_SSE2
+    case Level_AVX2:
+        TransformDirectionsAVX2(out, in, count, m, normalize);
+        return;
+    case Level_SSE2:
+        TransformDirectionsSSE2(out, in, count, m, normalize);
+        return;
+#endif
+    default:
+        TransformDirectionsScalar(out, in, count, m, normalize);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void SlerpQuaternions(aiQuaternion *out, const aiQuaternion *a, const aiQuaternion *b, ai_real factor, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        aiQuaternion::Interpolate(out[i], a[i], b[i], factor);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void ComputeBoundingBox(const aiVector3D *in, size_t count, aiVector3D &min, aiVector3D &max) {
+    switch (GetLevel()) {
+#ifdef AI_BATCHMATH_SSE2
+    case Level_AVX2:
+        BoundingBoxAVX2(in, count, min, max);
+        return;
+    case Level_SSE2:
+        BoundingBoxSSE2(in, count, min, max);
+        return;
+#endif
+    default:
+        BoundingBoxScalar(in, count, min, max);
+    }
+}
+
+} // namespace BatchMath
+} // namespace Assimp
@@ -0,0 +1,114 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  BatchMath.h
+ *  @brief Math on arrays of matrices, vectors and quaternions.
+ *
+ *  The functions dispatch at runtime to SSE2 or AVX2 implementations if the
+ *  CPU supports them and ai_real is float, else the scalar math of the
+ *  aiMatrix4x4/aiVector3D/aiQuaternion templates is used. Unless stated
+ *  otherwise out may point to the same array as the input.
+ */
+#pragma once
+#ifndef AI_BATCHMATH_H_INC
+#define AI_BATCHMATH_H_INC
+
+#include <assimp/types.h>
+
+#include <cstddef>
+
+namespace Assimp {
+namespace BatchMath {
+
+/// Instruction sets the batch functions can use
+enum Level {
+    Level_Scalar = 0,
+    Level_SSE2,
+    Level_AVX2
+};
+
+// --------------------------------------------------------------------------------------------
+/** @brief Returns the instruction set the batch functions currently use. */
+Level ASSIMP_API GetLevel();
+
+// --------------------------------------------------------------------------------------------
+/** @brief Restricts the batch functions to an instruction set.
+ *  @param level Requested level, it is lowered to the best level the CPU supports.
+ *  @return The level in use from now on. */
+Level ASSIMP_API SetLevel(Level level);
+
+// --------------------------------------------------------------------------------------------
+/** @brief out[i] = lhs[i] * rhs[i] */
+void ASSIMP_API MultiplyMatrices(aiMatrix4x4 *out, const aiMatrix4x4 *lhs, const aiMatrix4x4 *rhs, size_t count);
+
+// --------------------------------------------------------------------------------------------
+/** @brief out[i] = lhs * rhs[i] */
+void ASSIMP_API MultiplyMatrices(aiMatrix4x4 *out, const aiMatrix4x4 &lhs, const aiMatrix4x4 *rhs, size_t count);
+
+// --------------------------------------------------------------------------------------------
+/** @brief out[i] = inverse of in[i], singular matrices become all NaN like aiMatrix4x4::Inverse() */
+void ASSIMP_API InvertMatrices(aiMatrix4x4 *out, const aiMatrix4x4 *in, size_t count);
+
+// --------------------------------------------------------------------------------------------
+/** @brief out[i] = m * in[i], the translation of m is applied. */
+void ASSIMP_API TransformPositions(aiVector3D *out, const aiVector3D *in, size_t count, const aiMatrix4x4 &m);
+
+// --------------------------------------------------------------------------------------------
+/** @brief out[i] = m * in[i], optionally normalized afterwards (normals, tangents). */
+void ASSIMP_API TransformDirections(aiVector3D *out, const aiVector3D *in, size_t count, const aiMatrix3x3 &m, bool normalize);
+
+// --------------------------------------------------------------------------------------------
+/** @brief Spherical linear interpolation out[i] = slerp(a[i], b[i], factor).
+ *
+ *  The trigonometry dominates here, all levels share the scalar code of
+ *  aiQuaternion::Interpolate(). */
+void ASSIMP_API SlerpQuaternions(aiQuaternion *out, const aiQuaternion *a, const aiQuaternion *b, ai_real factor, size_t count);
+
+// --------------------------------------------------------------------------------------------
+/** @brief Grows the box [min, max] to enclose all points, NaN coordinates are ignored. */
+void ASSIMP_API ComputeBoundingBox(const aiVector3D *in, size_t count, aiVector3D &min, aiVector3D &max);
+
+} // namespace BatchMath
+} // namespace Assimp
+
+#endif // AI_BATCHMATH_H_INC
@@ -0,0 +1,310 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  ConcurrentLogger.cpp
+ *  @brief Implementation of ConcurrentLogger
+ */
+
+#include <assimp/ConcurrentLogger.hpp>
+#include <assimp/StringUtils.h>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+
+namespace Assimp {
+
+namespace {
+
+// ----------------------------------------------------------------------------------
+// Owner of the innermost ScopedContext of this thread
+thread_local const void *tContext = nullptr;
+
+// ----------------------------------------------------------------------------------
+// Returns a small, stable id for the calling thread. std::thread::id is not
+// printable in a portable way, so we simply number the threads which log.
+unsigned int GetThreadLogID() {
+    static std::atomic<unsigned int> sNextID(1);
+    thread_local const unsigned int tID = sNextID++;
+    return tID;
+}
+
+static const unsigned int SeverityAll = Logger::Info | Logger::Err | Logger::Warn | Logger::Debugging;
+
+} // namespace
+
+// ----------------------------------------------------------------------------------
+// A formatted message waiting in the queue
+struct ConcurrentLogger::Message {
+    Message *mNext;
+    ErrorSeverity mSeverity;
+    std::string mText;
+};
+
+// ----------------------------------------------------------------------------------
+ConcurrentLogger::ScopedContext::ScopedContext(const void *owner) :
+        mPrevious(tContext) {
+    tContext = owner;
+}
+
+// ----------------------------------------------------------------------------------
+ConcurrentLogger::ScopedContext::~ScopedContext() {
+    tContext = mPrevious;
+}
+
+// ----------------------------------------------------------------------------------
+const void *ConcurrentLogger::getContext() {
+    return tContext;
+}
+
+// ----------------------------------------------------------------------------------
+Logger *ConcurrentLogger::create(const char *name, LogSeverity severity, unsigned int defStreams, IOSystem *io) {
+    ConcurrentLogger *logger = new ConcurrentLogger(severity);
+    if (defStreams & aiDefaultLogStream_DEBUGGER) {
+        logger->attachStream(LogStream::createDefaultStream(aiDefaultLogStream_DEBUGGER), SeverityAll);
+    }
+    if (defStreams & aiDefaultLogStream_STDOUT) {
+        logger->attachStream(LogStream::createDefaultStream(aiDefaultLogStream_STDOUT), SeverityAll);
+    }
+    if (defStreams & aiDefaultLogStream_STDERR) {
+        logger->attachStream(LogStream::createDefaultStream(aiDefaultLogStream_STDERR), SeverityAll);
+    }
+    if (defStreams & aiDefaultLogStream_FILE && name && *name) {
+        logger->attachStream(LogStream::createDefaultStream(aiDefaultLogStream_FILE, name, io), SeverityAll);
+    }
+
+    DefaultLogger::set(logger);
+    return logger;
+}
+
+// ----------------------------------------------------------------------------------
+ConcurrentLogger::ConcurrentLogger(LogSeverity severity) :
+        Logger(severity), mHead(nullptr), mDraining(false), mStreams() {
+    // empty
+}
+
+// ----------------------------------------------------------------------------------
+ConcurrentLogger::~ConcurrentLogger() {
+    flush();
+    for (StreamInfo &info : mStreams) {
+        // we are the owner of the attached streams
+        delete info.mStream;
+    }
+}
+
+// ----------------------------------------------------------------------------------
+void ConcurrentLogger::OnDebug(const char *message) {
+    if (m_Severity < Logger::DEBUGGING) {
+        return;
+    }
+    Enqueue("Debug", message, Logger::Debugging);
+}
+
+// ----------------------------------------------------------------------------------
+void ConcurrentLogger::OnVerboseDebug(const char *message) {
+    if (m_Severity < Logger::VERBOSE) {
+        return;
+    }
+    Enqueue("Debug", message, Logger::Debugging);
+}
+
+// ----------------------------------------------------------------------------------
+void ConcurrentLogger::OnInfo(const char *message) {
+    Enqueue("Info, ", message, Logger::Info);
+}
+
+// ----------------------------------------------------------------------------------
+void ConcurrentLogger::OnWarn(const char *message) {
+    Enqueue("Warn, ", message, Logger::Warn);
+}
+
+// ----------------------------------------------------------------------------------
+void ConcurrentLogger::OnError(const char *message) {
+    Enqueue("Error,", message, Logger::Err);
+}
+
+// ----------------------------------------------------------------------------------
+void ConcurrentLogger::Enqueue(const char *prefix, const char *message, ErrorSeverity severity) {
+    ai_assert(nullptr != message);
+
+    // Format into a per-thread buffer, nothing shared is touched here
+    static const size_t Size = MAX_LOG_MESSAGE_LENGTH + 64;
+    thread_local char tBuffer[Size];
+    int len;
+    if (nullptr != tContext) {
+        len = ai_snprintf(tBuffer, Size, "%s T%u, %p: %s\n", prefix, GetThreadLogID(), tContext, message);
+    } else {
+        len = ai_snprintf(tBuffer, Size, "%s T%u: %s\n", prefix, GetThreadLogID(), message);
+    }
+    if (len < 0) {
+        return;
+    }
+
+    Message *msg = new Message;
+    msg->mSeverity = severity;
+    msg->mText.assign(tBuffer, std::min(static_cast<size_t>(len), Size - 1));
+
+    // Lock-free push onto the queue head
+    msg->mNext = mHead.load(std::memory_order_relaxed);
+    while (!mHead.compare_exchange_weak(msg->mNext, msg)) {
+        // msg->mNext has been updated to the current head, retry
+    }
+
+    TryDrain();
+}
+
+// ----------------------------------------------------------------------------------
+// Drains the queue unless another thread is already doing so. The draining
+// thread checks the queue again after it is done, so no message gets stuck.
+void ConcurrentLogger::TryDrain() {
+    while (nullptr != mHead.load()) {
+        if (mDraining.exchange(true)) {
+            return;
+        }
+        WriteQueued();
+        mDraining.store(false);
+    }
+}
+
+// ----------------------------------------------------------------------------------
+// Must only be called while holding the drain flag
+void ConcurrentLogger::WriteQueued() {
+    Message *list = mHead.exchange(nullptr);
+
+    // The queue is LIFO, reverse it to restore the order of the messages
+    Message *ordered = nullptr;
+    while (nullptr != list) {
+        Message *next = list->mNext;
+        list->mNext = ordered;
+        ordered = list;
+        list = next;
+    }
+
+    while (nullptr != ordered) {
+        for (const StreamInfo &info : mStreams) {
+            if (ordered->mSeverity & info.mSeverity) {
+                info.mStream->write(ordered->mText.c_str());
+            }
+        }
+        Message *next = ordered->mNext;
+        delete ordered;
+        ordered = next;
+    }
+}
+
+// ----------------------------------------------------------------------------------
+void ConcurrentLogger::LockStreams() {
+    while (mDraining.exchange(true)) {
+        std::this_thread::yield();
+    }
+}
+
+// ----------------------------------------------------------------------------------
+void ConcurrentLogger::UnlockStreams() {
+    mDraining.store(false);
+}
+
+// ----------------------------------------------------------------------------------
+void ConcurrentLogger::flush() {
+    LockStreams();
+    WriteQueued();
+    UnlockStreams();
+}
+
+// ----------------------------------------------------------------------------------
+bool ConcurrentLogger::attachStream(LogStream *pStream, unsigned int severity) {
+    if (nullptr == pStream) {
+        return false;
+    }
+
+    if (0 == severity) {
+        severity = SeverityAll;
+    }
+
+    LockStreams();
+    bool found = false;
+    for (StreamInfo &info : mStreams) {
+        if (info.mStream == pStream) {
+            info.mSeverity |= severity;
+            found = true;
+            break;
+        }
+    }
+    if (!found) {
+        mStreams.push_back({ severity, pStream });
+    }
+    UnlockStreams();
+    return true;
+}
+
+// ----------------------------------------------------------------------------------
+bool ConcurrentLogger::detachStream(LogStream *pStream, unsigned int severity) {
+    if (nullptr == pStream) {
+        return false;
+    }
+
+    if (0 == severity) {
+        severity = SeverityAll;
+    }
+
+    // Pending messages still belong to the stream
+    LockStreams();
+    WriteQueued();
+    bool res = false;
+    for (std::vector<StreamInfo>::iterator it = mStreams.begin(); it != mStreams.end(); ++it) {
+        if (it->mStream == pStream) {
+            it->mSeverity &= ~severity;
+            if (0 == it->mSeverity) {
+                // don't delete the underlying stream 'cause the caller gains ownership again
+                mStreams.erase(it);
+            }
+            res = true;
+            break;
+        }
+    }
+    UnlockStreams();
+    return res;
+}
+
+} // namespace Assimp
@@ -55,7 +55,8 @@ namespace Assimp    {
 class DefaultProgressHandler : public ProgressHandler    {
 
     virtual bool Update(float /*percentage*/) {
-        return false;
+        // never abort, returning false would cancel every import
+        return true;
     }
 
 
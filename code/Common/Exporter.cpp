@@ -232,6 +232,8 @@ class ExporterPimpl {
 public:
     ExporterPimpl()
     : blob()
+    , mBlobAllocator( nullptr )
+    , mBlobSizeHint( 0 )
     , mIOSystem(new Assimp::DefaultIOSystem())
     , mIsDefaultIOHandler(true)
     , mProgressHandler( nullptr )
@@ -258,6 +260,11 @@ public:
 
 public:
     aiExportDataBlob* blob; //ݵݿ
+
+    /** Memory source and expected size for #blob */
+    const aiExportBlobAllocator* mBlobAllocator;
+    size_t mBlobSizeHint;
+
     std::shared_ptr< Assimp::IOSystem > mIOSystem;//ָmIOSystemָ
     bool mIsDefaultIOHandler;
 
@@ -342,7 +349,7 @@ const aiExportDataBlob* Exporter::ExportToBlob( const aiScene* pScene, const cha
     }
 
     std::shared_ptr<IOSystem> old = pimpl->mIOSystem;
-    BlobIOSystem* blobio = new BlobIOSystem();
+    BlobIOSystem* blobio = new BlobIOSystem(pimpl->mBlobAllocator, pimpl->mBlobSizeHint);
     pimpl->mIOSystem = std::shared_ptr<IOSystem>( blobio );
 
     if (AI_SUCCESS != Export(pScene,pFormatId,blobio->GetMagicFileName(), pPreprocessing, pProperties)) {
@@ -382,9 +389,10 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
         const Exporter::ExportFormatEntry& exp = pimpl->mExporters[i]; //exp
         if (!strcmp(exp.mDescription.id,pFormatId)) { //pFormatId==exp.mDescription.idҵĿʽ
             try {
-                // Always create a full copy of the scene. 
-                aiScene* scenecopy_tmp = nullptr;//pscene
-                SceneCombiner::CopyScene(&scenecopy_tmp,pScene);
+                // Share the scene data copy-on-write. Only the node graph is copied
+                // up front, every step unshares the components it modifies.
+                aiScene* scenecopy_tmp = nullptr;
+                SceneCombiner::ShareScene(&scenecopy_tmp,pScene);
 
                 pimpl->mProgressHandler->UpdateFileWrite(1, 4);//1ȡ
 
@@ -438,6 +446,7 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
                         ASSIMP_LOG_DEBUG("export: Scene data not in verbose format, applying MakeVerboseFormat step first");
 
                         MakeVerboseFormatProcess proc;
+                        SceneCombiner::MakeUnique(scenecopy.get(), proc.GetModifiedSceneComponents());
                         proc.Execute(scenecopy.get());
 
                         if(!(exp.mEnforcePP & aiProcess_JoinIdenticalVertices)) {//ΪmEnforcePPaiProcess_JoinIdenticalVertices
@@ -454,6 +463,7 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
                     {
                         FlipWindingOrderProcess step;//
                         if (step.IsActive(pp)) {
+                            SceneCombiner::MakeUnique(scenecopy.get(), step.GetModifiedSceneComponents());
                             step.Execute(scenecopy.get());
                         }
                     }
@@ -461,6 +471,7 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
                     {
                         FlipUVsProcess step;//uvͼ
                         if (step.IsActive(pp)) {
+                            SceneCombiner::MakeUnique(scenecopy.get(), step.GetModifiedSceneComponents());
                             step.Execute(scenecopy.get());
                         }
                     }
@@ -468,6 +479,7 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
                     {
                         MakeLeftHandedProcess step;//ϵ
                         if (step.IsActive(pp)) {
+                            SceneCombiner::MakeUnique(scenecopy.get(), step.GetModifiedSceneComponents());
                             step.Execute(scenecopy.get());
                         }
                     }
@@ -487,6 +499,7 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
                             if (dynamic_cast<PretransformVertices*>(p) && exportPointCloud) {
                                 continue;
                             }
+                            SceneCombiner::MakeUnique(scenecopy.get(), p->GetModifiedSceneComponents());
                             p->Execute(scenecopy.get());
                         }
                     }
@@ -500,6 +513,7 @@ aiReturn Exporter::Export( const aiScene* pScene, const char* pFormatId, const c
 
                 if(must_join_again) {
                     JoinVerticesProcess proc;
+                    SceneCombiner::MakeUnique(scenecopy.get(), proc.GetModifiedSceneComponents());
                     proc.Execute(scenecopy.get());
                 }
 
@@ -530,6 +544,18 @@ const char* Exporter::GetErrorString() const {
     return pimpl->mError.c_str();
 }
 
+// ------------------------------------------------------------------------------------------------
+void Exporter::SetBlobAllocator(const aiExportBlobAllocator* allocator) {
+    ai_assert(nullptr != pimpl);
+    pimpl->mBlobAllocator = allocator;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Exporter::SetBlobSizeHint(size_t size) {
+    ai_assert(nullptr != pimpl);
+    pimpl->mBlobSizeHint = size;
+}
+
 // ------------------------------------------------------------------------------------------------
 void Exporter::FreeBlob() {
 	ai_assert(nullptr != pimpl);
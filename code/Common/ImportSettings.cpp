@@ -0,0 +1,130 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  ImportSettings.cpp
+ *  @brief Implementation of the shared configuration snapshot #ImportSettings
+ */
+
+#include "Common/Importer.h"
+
+#include <assimp/GenericProperty.h>
+#include <assimp/ImportSettings.h>
+#include <assimp/Importer.hpp>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Adds the properties of a snapshot which are not overridden by the importer itself.
+template <class T>
+void MergeProperties(std::map<unsigned int, T> &merged, const std::unordered_map<unsigned int, T> *shared) {
+    if (nullptr == shared) {
+        return;
+    }
+    for (const auto &prop : *shared) {
+        merged.insert(prop);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+template <class T>
+inline const T &GetSharedProperty(const std::unordered_map<unsigned int, T> &list,
+        const char *szName, const T &errorReturn) {
+    ai_assert(nullptr != szName);
+    const uint32_t hash = SuperFastHash(szName);
+
+    typename std::unordered_map<unsigned int, T>::const_iterator it = list.find(hash);
+    if (it == list.end()) {
+        return errorReturn;
+    }
+    return (*it).second;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+ImportSettings::ImportSettings(const Importer &importer) :
+        pimpl(new ImportSettingsPimpl()) {
+    const ImporterPimpl *source = importer.Pimpl();
+    const ImportSettingsPimpl *base = source->mSettings ? source->mSettings->Pimpl() : nullptr;
+
+    // ordered copies first, the hash must not depend on the insertion order
+    ImporterPimpl::IntPropertyMap ints(source->mIntProperties);
+    ImporterPimpl::FloatPropertyMap floats(source->mFloatProperties);
+    ImporterPimpl::StringPropertyMap strings(source->mStringProperties);
+    ImporterPimpl::MatrixPropertyMap matrices(source->mMatrixProperties);
+    MergeProperties(ints, base ? &base->mIntProperties : nullptr);
+    MergeProperties(floats, base ? &base->mFloatProperties : nullptr);
+    MergeProperties(strings, base ? &base->mStringProperties : nullptr);
+    MergeProperties(matrices, base ? &base->mMatrixProperties : nullptr);
+
+    pimpl->mHash = HashPropertyMaps(ints, floats, strings, matrices);
+    pimpl->mIntProperties.insert(ints.begin(), ints.end());
+    pimpl->mFloatProperties.insert(floats.begin(), floats.end());
+    pimpl->mStringProperties.insert(strings.begin(), strings.end());
+    pimpl->mMatrixProperties.insert(matrices.begin(), matrices.end());
+}
+
+// ------------------------------------------------------------------------------------------------
+ImportSettings::~ImportSettings() {
+    delete pimpl;
+}
+
+// ------------------------------------------------------------------------------------------------
+int ImportSettings::GetPropertyInteger(const char *szName, int iErrorReturn /*= 0xffffffff*/) const {
+    return GetSharedProperty<int>(pimpl->mIntProperties, szName, iErrorReturn);
+}
+
+// ------------------------------------------------------------------------------------------------
+ai_real ImportSettings::GetPropertyFloat(const char *szName, ai_real iErrorReturn /*= 10e10*/) const {
+    return GetSharedProperty<ai_real>(pimpl->mFloatProperties, szName, iErrorReturn);
+}
+
+// ------------------------------------------------------------------------------------------------
+std::string ImportSettings::GetPropertyString(const char *szName, const std::string &iErrorReturn /*= ""*/) const {
+    return GetSharedProperty<std::string>(pimpl->mStringProperties, szName, iErrorReturn);
+}
+
+// ------------------------------------------------------------------------------------------------
+aiMatrix4x4 ImportSettings::GetPropertyMatrix(const char *szName, const aiMatrix4x4 &iErrorReturn /*= aiMatrix4x4()*/) const {
+    return GetSharedProperty<aiMatrix4x4>(pimpl->mMatrixProperties, szName, iErrorReturn);
+}
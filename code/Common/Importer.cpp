@@ -70,7 +70,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Common/ScenePrivate.h"
 
 #include <assimp/BaseImporter.h>
+#include <assimp/Cancellation.h>
+#include <assimp/ConcurrentLogger.hpp>
 #include <assimp/GenericProperty.h>
+#include <assimp/ImportSettings.h>
+#include <assimp/Hash.h>
 #include <assimp/MemoryIOWrapper.h>
 #include <assimp/Profiler.h>
 #include <assimp/TinyFormatter.h>
@@ -88,6 +92,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef ASSIMP_BUILD_NO_VALIDATEDS_PROCESS
 #   include "PostProcessing/ValidateDataStructure.h"
 #endif
+#ifndef ASSIMP_BUILD_NO_COMPRESSANIMATIONS_PROCESS
+#   include "PostProcessing/CompressAnimationsProcess.h"
+#endif
 
 using namespace Assimp::Profiling;
 using namespace Assimp::Formatter;
@@ -143,6 +150,72 @@ void AllocateFromAssimpHeap::operator delete[] ( void* data)    {
     return ::operator delete[](data);
 }
 
+// ------------------------------------------------------------------------------------------------
+uint64_t Assimp::HashPropertyMaps(const ImporterPimpl::IntPropertyMap &ints,
+        const ImporterPimpl::FloatPropertyMap &floats,
+        const ImporterPimpl::StringPropertyMap &strings,
+        const ImporterPimpl::MatrixPropertyMap &matrices) {
+    uint32_t low = 0, high = 1;
+    auto add = [&low, &high](const void *data, size_t size) {
+        if (size > 0) {
+            low = SuperFastHash(static_cast<const char *>(data), static_cast<uint32_t>(size), low);
+            high = SuperFastHash(static_cast<const char *>(data), static_cast<uint32_t>(size), high ^ low);
+        }
+    };
+    for (const auto &prop : ints) {
+        add(&prop.first, sizeof(prop.first));
+        add(&prop.second, sizeof(prop.second));
+    }
+    for (const auto &prop : floats) {
+        add(&prop.first, sizeof(prop.first));
+        add(&prop.second, sizeof(prop.second));
+    }
+    for (const auto &prop : strings) {
+        const uint32_t length = static_cast<uint32_t>(prop.second.length());
+        add(&prop.first, sizeof(prop.first));
+        add(&length, sizeof(length));
+        add(prop.second.data(), length);
+    }
+    for (const auto &prop : matrices) {
+        add(&prop.first, sizeof(prop.first));
+        add(&prop.second, sizeof(prop.second));
+    }
+    return (static_cast<uint64_t>(high) << 32) | low;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Looks up a property of an importer. Its own properties take precedence over
+// the ones of the shared settings.
+template <class T>
+inline const T &GetLayeredProperty(const std::map<unsigned int, T> &local,
+        const std::unordered_map<unsigned int, T> *shared, const char *szName, const T &errorReturn) {
+    ai_assert(nullptr != szName);
+    const uint32_t hash = SuperFastHash(szName);
+
+    typename std::map<unsigned int, T>::const_iterator it = local.find(hash);
+    if (it != local.end()) {
+        return (*it).second;
+    }
+    if (shared) {
+        typename std::unordered_map<unsigned int, T>::const_iterator sit = shared->find(hash);
+        if (sit != shared->end()) {
+            return (*sit).second;
+        }
+    }
+    return errorReturn;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Hashes all properties of an importer, including the ones of its shared settings.
+static uint64_t HashProperties(const ImporterPimpl *pimpl) {
+    uint64_t hash = HashPropertyMaps(pimpl->mIntProperties, pimpl->mFloatProperties,
+            pimpl->mStringProperties, pimpl->mMatrixProperties);
+    if (pimpl->mSettings) {
+        hash = (hash * 0x9e3779b97f4a7c15ull) ^ pimpl->mSettings->Pimpl()->mHash;
+    }
+    return hash;
+}
+
 // ------------------------------------------------------------------------------------------------
 // Importer constructor.
 Importer::Importer()
@@ -579,6 +652,9 @@ void WriteLogOpening(const std::string& file) {
 // Reads the given file and returns its contents if successful.
 const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
     ai_assert(nullptr != pimpl);
+
+    // Attribute all messages logged while reading to this instance
+    ConcurrentLogger::ScopedContext logContext(this);
     
     ASSIMP_BEGIN_EXCEPTION_REGION();
     const std::string pFile(_pFile);
@@ -723,7 +799,26 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
             }
 
             // Ensure that the validation process won't be called twice
-            ApplyPostProcessing(pFlags & (~aiProcess_ValidateDataStructure));
+            const unsigned int ppFlags = pFlags & (~aiProcess_ValidateDataStructure);
+            if (GetPropertyBool(AI_CONFIG_IMPORT_INCREMENTAL, false) && !pimpl->bExtraVerbose &&
+                    IncrementalMeshCache::IsSupported(ppFlags)) {
+                // Only meshes which changed since the last import are post-processed
+                IncrementalMeshCache::Session session;
+                const unsigned int numMeshes = pimpl->mScene->mNumMeshes;
+                const unsigned int numReused = pimpl->mMeshCache.Detach(pimpl->mScene, ppFlags, HashProperties(pimpl), session,
+                        &imp->GetMeshKeys());
+                const bool success = nullptr != ApplyPostProcessing(ppFlags);
+                if (pimpl->mScene) {
+                    pimpl->mMeshCache.Attach(pimpl->mScene, session);
+                    if (!success) {
+                        pimpl->mMeshCache.Clear();
+                    }
+                }
+                ASSIMP_LOG_INFO_F("Incremental import: reused ", numReused, " of ", numMeshes, " meshes");
+            } else {
+                pimpl->mMeshCache.Clear();
+                ApplyPostProcessing(ppFlags);
+            }
         }
         // if failed, extract the error string
         else if( !pimpl->mScene) {
@@ -763,6 +858,8 @@ const aiScene* Importer::ReadFile( const char* _pFile, unsigned int pFlags) {
 // Apply post-processing to the currently bound scene
 const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
     ai_assert(nullptr != pimpl);
+
+    ConcurrentLogger::ScopedContext logContext(this);
     
     ASSIMP_BEGIN_EXCEPTION_REGION();
     // Return immediately if no scene is active
@@ -770,8 +867,14 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
         return nullptr;
     }
 
+#ifndef ASSIMP_BUILD_NO_COMPRESSANIMATIONS_PROCESS
+    const bool compressAnimations = GetPropertyBool(AI_CONFIG_PP_CA_ENABLE, false);
+#else
+    const bool compressAnimations = false;
+#endif // no animation compression
+
     // If no flags are given, return the current scene with no further action
-    if (!pFlags) {
+    if (!pFlags && !compressAnimations) {
         return pimpl->mScene;
     }
 
@@ -808,6 +911,13 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
     for( unsigned int a = 0; a < pimpl->mPostProcessingSteps.size(); a++)   {
         BaseProcess* process = pimpl->mPostProcessingSteps[a];
         pimpl->mProgressHandler->UpdatePostProcess(static_cast<int>(a), static_cast<int>(pimpl->mPostProcessingSteps.size()) );
+        if (pimpl->mCancellation && pimpl->mCancellation->IsCancelled()) {
+            pimpl->mErrorString = "Import cancelled";
+            ASSIMP_LOG_ERROR(pimpl->mErrorString);
+            delete pimpl->mScene;
+            pimpl->mScene = nullptr;
+            break;
+        }
         if( process->IsActive( pFlags)) {
             if (profiler) {
                 profiler->BeginRegion("postprocess");
@@ -841,6 +951,15 @@ const aiScene* Importer::ApplyPostProcessing(unsigned int pFlags) {
         }
 #endif // ! DEBUG
     }
+
+#ifndef ASSIMP_BUILD_NO_COMPRESSANIMATIONS_PROCESS
+    // The animation compression step has no flag of its own, it is enabled by
+    // a property and executed after all other steps.
+    if (compressAnimations && pimpl->mScene) {
+        CompressAnimationsProcess ca;
+        ca.ExecuteOnScene(this);
+    }
+#endif // no animation compression
     pimpl->mProgressHandler->UpdatePostProcess( static_cast<int>(pimpl->mPostProcessingSteps.size()), 
         static_cast<int>(pimpl->mPostProcessingSteps.size()) );
 
@@ -1087,7 +1206,8 @@ bool Importer::SetPropertyMatrix(const char* szName, const aiMatrix4x4& value) {
 int Importer::GetPropertyInteger(const char* szName, int iErrorReturn /*= 0xffffffff*/) const {
     ai_assert(nullptr != pimpl);
     
-    return GetGenericProperty<int>(pimpl->mIntProperties,szName,iErrorReturn);
+    const ImportSettingsPimpl *settings = pimpl->mSettings ? pimpl->mSettings->Pimpl() : nullptr;
+    return GetLayeredProperty<int>(pimpl->mIntProperties, settings ? &settings->mIntProperties : nullptr, szName, iErrorReturn);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1095,7 +1215,8 @@ int Importer::GetPropertyInteger(const char* szName, int iErrorReturn /*= 0xffff
 ai_real Importer::GetPropertyFloat(const char* szName, ai_real iErrorReturn /*= 10e10*/) const {
     ai_assert(nullptr != pimpl);
     
-    return GetGenericProperty<ai_real>(pimpl->mFloatProperties,szName,iErrorReturn);
+    const ImportSettingsPimpl *settings = pimpl->mSettings ? pimpl->mSettings->Pimpl() : nullptr;
+    return GetLayeredProperty<ai_real>(pimpl->mFloatProperties, settings ? &settings->mFloatProperties : nullptr, szName, iErrorReturn);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1103,7 +1224,8 @@ ai_real Importer::GetPropertyFloat(const char* szName, ai_real iErrorReturn /*=
 std::string Importer::GetPropertyString(const char* szName, const std::string& iErrorReturn /*= ""*/) const {
     ai_assert(nullptr != pimpl);
     
-    return GetGenericProperty<std::string>(pimpl->mStringProperties,szName,iErrorReturn);
+    const ImportSettingsPimpl *settings = pimpl->mSettings ? pimpl->mSettings->Pimpl() : nullptr;
+    return GetLayeredProperty<std::string>(pimpl->mStringProperties, settings ? &settings->mStringProperties : nullptr, szName, iErrorReturn);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1111,7 +1233,37 @@ std::string Importer::GetPropertyString(const char* szName, const std::string& i
 aiMatrix4x4 Importer::GetPropertyMatrix(const char* szName, const aiMatrix4x4& iErrorReturn /*= aiMatrix4x4()*/) const {
     ai_assert(nullptr != pimpl);
     
-    return GetGenericProperty<aiMatrix4x4>(pimpl->mMatrixProperties,szName,iErrorReturn);
+    const ImportSettingsPimpl *settings = pimpl->mSettings ? pimpl->mSettings->Pimpl() : nullptr;
+    return GetLayeredProperty<aiMatrix4x4>(pimpl->mMatrixProperties, settings ? &settings->mMatrixProperties : nullptr, szName, iErrorReturn);
+}
+
+// ------------------------------------------------------------------------------------------------
+void Importer::SetSettings(const std::shared_ptr<const ImportSettings> &settings) {
+    ai_assert(nullptr != pimpl);
+
+    pimpl->mSettings = settings;
+    pimpl->mIntProperties.clear();
+    pimpl->mFloatProperties.clear();
+    pimpl->mStringProperties.clear();
+    pimpl->mMatrixProperties.clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+const std::shared_ptr<const ImportSettings> &Importer::GetSettings() const {
+    ai_assert(nullptr != pimpl);
+    return pimpl->mSettings;
+}
+
+// ------------------------------------------------------------------------------------------------
+void Importer::SetCancellationToken(const std::shared_ptr<CancellationToken> &token) {
+    ai_assert(nullptr != pimpl);
+    pimpl->mCancellation = token;
+}
+
+// ------------------------------------------------------------------------------------------------
+const std::shared_ptr<CancellationToken> &Importer::GetCancellationToken() const {
+    ai_assert(nullptr != pimpl);
+    return pimpl->mCancellation;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -45,10 +45,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define INCLUDED_AI_IMPORTER_H
 
 #include <map>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 #include <string>
 #include <assimp/matrix4x4.h>
 
+#include "Common/IncrementalMeshCache.h"
+
 struct aiScene;
 
 namespace Assimp    {
@@ -57,6 +61,8 @@ namespace Assimp    {
     class BaseImporter;
     class BaseProcess;
     class SharedPostProcessInfo;
+    class ImportSettings;
+    class CancellationToken;
 
 
 //! @cond never
@@ -116,6 +122,12 @@ public:
     /** List of Matrix properties */
     MatrixPropertyMap mMatrixProperties;
 
+    /** Shared read-only properties, the lists above take precedence */
+    std::shared_ptr<const ImportSettings> mSettings;
+
+    /** Cancels the running import, may be nullptr */
+    std::shared_ptr<CancellationToken> mCancellation;
+
     /** Used for testing - extra verbose mode causes the ValidateDataStructure-Step
      *  to be executed before and after every single post-process step */
     bool bExtraVerbose;
@@ -123,6 +135,9 @@ public:
     /** Used by post-process steps to share data */
     SharedPostProcessInfo* mPPShared;
 
+    /** Post-processed meshes of the last import, see AI_CONFIG_IMPORT_INCREMENTAL */
+    IncrementalMeshCache mMeshCache;
+
     /// The default class constructor.
     ImporterPimpl() AI_NO_EXCEPT;
 };
@@ -142,10 +157,41 @@ ImporterPimpl::ImporterPimpl() AI_NO_EXCEPT :
         mFloatProperties(),
         mStringProperties(),
         mMatrixProperties(),
+        mSettings(),
+        mCancellation(),
         bExtraVerbose( false ),
-        mPPShared( nullptr ) {
+        mPPShared( nullptr ),
+        mMeshCache() {
     // empty
 }
+
+// ---------------------------------------------------------------------------
+/** @brief Internal storage of Assimp::ImportSettings, never modified once
+ *  the snapshot has been taken. */
+class ImportSettingsPimpl {
+public:
+    typedef std::unordered_map<ImporterPimpl::KeyType, int> IntPropertyMap;
+    typedef std::unordered_map<ImporterPimpl::KeyType, ai_real> FloatPropertyMap;
+    typedef std::unordered_map<ImporterPimpl::KeyType, std::string> StringPropertyMap;
+    typedef std::unordered_map<ImporterPimpl::KeyType, aiMatrix4x4> MatrixPropertyMap;
+
+    IntPropertyMap mIntProperties;
+    FloatPropertyMap mFloatProperties;
+    StringPropertyMap mStringProperties;
+    MatrixPropertyMap mMatrixProperties;
+
+    /** Hash of all properties, see HashPropertyMaps() */
+    uint64_t mHash;
+};
+
+// ---------------------------------------------------------------------------
+/** Hashes a full set of configuration properties. Used as part of the key of
+ *  the incremental import cache, which is only valid as long as they don't
+ *  change. */
+uint64_t HashPropertyMaps(const ImporterPimpl::IntPropertyMap &ints,
+        const ImporterPimpl::FloatPropertyMap &floats,
+        const ImporterPimpl::StringPropertyMap &strings,
+        const ImporterPimpl::MatrixPropertyMap &matrices);
 //! @endcond
 
 struct BatchData;
@@ -0,0 +1,318 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file IncrementalMeshCache.cpp
+ *  @brief Implementation of the cache of post-processed meshes.
+ */
+
+#include "IncrementalMeshCache.h"
+
+#include <assimp/DefaultLogger.hpp>
+#include <assimp/Exceptional.h>
+#include <assimp/Hash.h>
+#include <assimp/SceneCombiner.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+
+using namespace Assimp;
+
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// Builds a 64-bit hash from two differently seeded 32-bit hashes.
+class MeshHasher {
+public:
+    MeshHasher() :
+            mLow(0x811c9dc5u), mHigh(0x9e3779b9u) {
+        // empty
+    }
+
+    void Add(const void *data, size_t size) {
+        // SuperFastHash takes a 32-bit length and interprets 0 as 'strlen'
+        const char *bytes = static_cast<const char *>(data);
+        while (size > 0) {
+            const uint32_t len = static_cast<uint32_t>(std::min(size, static_cast<size_t>(1u << 30)));
+            mLow = SuperFastHash(bytes, len, mLow);
+            mHigh = SuperFastHash(bytes, len, mHigh ^ mLow);
+            bytes += len;
+            size -= len;
+        }
+    }
+
+    void Add(unsigned int value) {
+        Add(&value, sizeof(value));
+    }
+
+    void Add(const aiString &str) {
+        Add(str.length);
+        Add(str.data, str.length);
+    }
+
+    template <typename T>
+    void AddArray(const T *data, unsigned int num) {
+        Add(nullptr != data ? 1u : 0u);
+        if (nullptr != data) {
+            Add(data, sizeof(T) * num);
+        }
+    }
+
+    uint64_t Get() const {
+        return (static_cast<uint64_t>(mHigh) << 32) | mLow;
+    }
+
+private:
+    uint32_t mLow, mHigh;
+};
+
+// ------------------------------------------------------------------------------------------------
+IncrementalMeshCache::Shape GetShape(const aiMesh *pMesh) {
+    IncrementalMeshCache::Shape shape;
+    shape.mNumVertices = pMesh->mNumVertices;
+    shape.mNumFaces = pMesh->mNumFaces;
+    shape.mPrimitiveTypes = pMesh->mPrimitiveTypes;
+    shape.mMaterialIndex = pMesh->mMaterialIndex;
+    return shape;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+IncrementalMeshCache::Session::Session() :
+        mHashes(), mShapes(), mReused() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+IncrementalMeshCache::Session::~Session() {
+    // only non-empty if Attach() was never reached
+    for (aiMesh *mesh : mReused) {
+        delete mesh;
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+IncrementalMeshCache::IncrementalMeshCache() :
+        mFlags(0), mConfigHash(0), mMeshes() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+IncrementalMeshCache::~IncrementalMeshCache() {
+    Clear();
+}
+
+// ------------------------------------------------------------------------------------------------
+bool IncrementalMeshCache::IsSupported(unsigned int pFlags) {
+    const unsigned int supported = aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices |
+                                   aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_GenSmoothNormals |
+                                   aiProcess_LimitBoneWeights | aiProcess_ValidateDataStructure |
+                                   aiProcess_ImproveCacheLocality | aiProcess_FixInfacingNormals |
+                                   aiProcess_FlipUVs | aiProcess_FlipWindingOrder | aiProcess_ForceGenNormals |
+                                   aiProcess_DropNormals | aiProcess_GenBoundingBoxes;
+    return (pFlags & ~supported) == 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+uint64_t IncrementalMeshCache::HashMesh(const aiMesh *pMesh) {
+    ai_assert(nullptr != pMesh);
+
+    MeshHasher hasher;
+    hasher.Add(pMesh->mName);
+    hasher.Add(pMesh->mPrimitiveTypes);
+    hasher.Add(pMesh->mMaterialIndex);
+    hasher.Add(pMesh->mMethod);
+    hasher.Add(pMesh->mNumVertices);
+    hasher.AddArray(pMesh->mVertices, pMesh->mNumVertices);
+    hasher.AddArray(pMesh->mNormals, pMesh->mNumVertices);
+    hasher.AddArray(pMesh->mTangents, pMesh->mNumVertices);
+    hasher.AddArray(pMesh->mBitangents, pMesh->mNumVertices);
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_COLOR_SETS; ++i) {
+        hasher.AddArray(pMesh->mColors[i], pMesh->mNumVertices);
+    }
+    for (unsigned int i = 0; i < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++i) {
+        hasher.Add(pMesh->mNumUVComponents[i]);
+        hasher.AddArray(pMesh->mTextureCoords[i], pMesh->mNumVertices);
+    }
+
+    hasher.Add(pMesh->mNumFaces);
+    for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
+        const aiFace &face = pMesh->mFaces[i];
+        hasher.Add(face.mNumIndices);
+        hasher.AddArray(face.mIndices, face.mNumIndices);
+    }
+
+    hasher.Add(pMesh->mNumBones);
+    for (unsigned int i = 0; i < pMesh->mNumBones; ++i) {
+        const aiBone *bone = pMesh->mBones[i];
+        hasher.Add(bone->mName);
+        hasher.Add(&bone->mOffsetMatrix, sizeof(bone->mOffsetMatrix));
+        hasher.Add(bone->mNumWeights);
+        hasher.AddArray(bone->mWeights, bone->mNumWeights);
+    }
+
+    hasher.Add(pMesh->mNumAnimMeshes);
+    for (unsigned int i = 0; i < pMesh->mNumAnimMeshes; ++i) {
+        const aiAnimMesh *anim = pMesh->mAnimMeshes[i];
+        hasher.Add(anim->mName);
+        hasher.Add(&anim->mWeight, sizeof(anim->mWeight));
+        hasher.Add(anim->mNumVertices);
+        hasher.AddArray(anim->mVertices, anim->mNumVertices);
+        hasher.AddArray(anim->mNormals, anim->mNumVertices);
+        hasher.AddArray(anim->mTangents, anim->mNumVertices);
+        hasher.AddArray(anim->mBitangents, anim->mNumVertices);
+        for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+            hasher.AddArray(anim->mColors[c], anim->mNumVertices);
+        }
+        for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+            hasher.AddArray(anim->mTextureCoords[c], anim->mNumVertices);
+        }
+    }
+    return hasher.Get();
+}
+
+// ------------------------------------------------------------------------------------------------
+unsigned int IncrementalMeshCache::Detach(aiScene *pScene, unsigned int pFlags, uint64_t pConfigHash, Session &session,
+        const std::vector<uint64_t> *pKeys) {
+    ai_assert(nullptr != pScene);
+    ai_assert(IsSupported(pFlags));
+
+    if (pFlags != mFlags || pConfigHash != mConfigHash) {
+        Clear();
+        mFlags = pFlags;
+        mConfigHash = pConfigHash;
+    }
+
+    const unsigned int numMeshes = pScene->mNumMeshes;
+    if (nullptr != pKeys && pKeys->size() != numMeshes) {
+        pKeys = nullptr;
+    }
+    session.mHashes.resize(numMeshes);
+    session.mShapes.resize(numMeshes);
+    session.mReused.assign(numMeshes, nullptr);
+
+    // Move all meshes which need processing to the front of the array,
+    // the relative order is kept so Attach() can undo it.
+    unsigned int numReused = 0, numFresh = 0;
+    for (unsigned int i = 0; i < numMeshes; ++i) {
+        aiMesh *mesh = pScene->mMeshes[i];
+        // source keys spare hashing the mesh, they are derived from the
+        // input data the mesh was converted from
+        const uint64_t key = nullptr != pKeys ? (*pKeys)[i] : 0;
+        const uint64_t hash = 0 != key ? key : HashMesh(mesh);
+        session.mHashes[i] = hash;
+        session.mShapes[i] = GetShape(mesh);
+
+        auto it = mMeshes.find(hash);
+        if (it != mMeshes.end() && !(it->second.mShape == session.mShapes[i])) {
+            ASSIMP_LOG_WARN_F("Incremental import: cache key collision for mesh \"", mesh->mName.C_Str(), "\", processing it again");
+            it = mMeshes.end();
+        }
+        if (it != mMeshes.end()) {
+            SceneCombiner::Copy(&session.mReused[i], it->second.mMesh);
+            delete mesh;
+            ++numReused;
+        } else {
+            pScene->mMeshes[numFresh++] = mesh;
+        }
+    }
+    pScene->mNumMeshes = numFresh;
+    return numReused;
+}
+
+// ------------------------------------------------------------------------------------------------
+void IncrementalMeshCache::Attach(aiScene *pScene, Session &session) {
+    ai_assert(nullptr != pScene);
+
+    const unsigned int numMeshes = static_cast<unsigned int>(session.mReused.size());
+    const unsigned int numReused = static_cast<unsigned int>(
+            numMeshes - std::count(session.mReused.begin(), session.mReused.end(), nullptr));
+    if (pScene->mNumMeshes + numReused != numMeshes) {
+        Clear();
+        throw DeadlyImportError("Incremental import: post-processing changed the number of meshes");
+    }
+
+    // Walk backwards so no fresh mesh is overwritten before it has been moved,
+    // the array still has room for all meshes.
+    unsigned int fresh = pScene->mNumMeshes;
+    for (unsigned int i = numMeshes; i-- > 0;) {
+        if (nullptr != session.mReused[i]) {
+            pScene->mMeshes[i] = session.mReused[i];
+            session.mReused[i] = nullptr;
+        } else {
+            pScene->mMeshes[i] = pScene->mMeshes[--fresh];
+        }
+    }
+    pScene->mNumMeshes = numMeshes;
+
+    // Keep exactly the meshes of this import, stale entries are evicted.
+    std::unordered_map<uint64_t, Entry> meshes;
+    meshes.reserve(numMeshes);
+    for (unsigned int i = 0; i < numMeshes; ++i) {
+        const uint64_t hash = session.mHashes[i];
+        if (meshes.count(hash)) {
+            continue;
+        }
+
+        auto it = mMeshes.find(hash);
+        if (it != mMeshes.end() && it->second.mShape == session.mShapes[i]) {
+            meshes[hash] = it->second;
+            mMeshes.erase(it);
+        } else {
+            Entry &entry = meshes[hash];
+            entry.mShape = session.mShapes[i];
+            SceneCombiner::Copy(&entry.mMesh, pScene->mMeshes[i]);
+        }
+    }
+    Clear();
+    mMeshes.swap(meshes);
+}
+
+// ------------------------------------------------------------------------------------------------
+void IncrementalMeshCache::Clear() {
+    for (auto &entry : mMeshes) {
+        delete entry.second.mMesh;
+    }
+    mMeshes.clear();
+}
@@ -0,0 +1,176 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file IncrementalMeshCache.h
+ *  @brief Cache of post-processed meshes used for incremental re-imports.
+ */
+#pragma once
+#ifndef AI_INCREMENTALMESHCACHE_H_INC
+#define AI_INCREMENTALMESHCACHE_H_INC
+
+#include <assimp/defs.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct aiMesh;
+struct aiScene;
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** @brief Keeps the post-processed meshes of the last import of an Importer.
+ *
+ *  Meshes are identified by the source key reported by the importer
+ *  (see BaseImporter::GetMeshKeys) or, if there is none, by a 64-bit
+ *  hash of their raw (not yet post-processed) content. Before post-processing, #Detach takes every
+ *  mesh with a known hash out of the scene, so the post processing steps
+ *  only see new or changed meshes. #Attach puts the cached results back
+ *  at their original positions and remembers the fresh ones for the next
+ *  import. The cache is dropped whenever the post processing flags or the
+ *  importer properties change. Only flags accepted by #IsSupported may be
+ *  used since the mesh list must keep its layout during post-processing.
+ *
+ *  Keys are 64-bit hashes, so each entry also records the vertex count,
+ *  face count, primitive types and material of the raw mesh. A hit whose
+ *  raw mesh differs in any of these is treated as a miss.
+ *
+ *  The cache owns a private copy of every post-processed mesh of the last
+ *  import since the returned scene belongs to the caller. Enabling it thus
+ *  roughly doubles the memory held for meshes, and each import copies
+ *  every mesh once: reused meshes out of the cache, fresh ones into it.
+ */
+class ASSIMP_API IncrementalMeshCache {
+public:
+    /** Properties of a raw mesh which must match on a cache hit */
+    struct Shape {
+        unsigned int mNumVertices;
+        unsigned int mNumFaces;
+        unsigned int mPrimitiveTypes;
+        unsigned int mMaterialIndex;
+
+        bool operator==(const Shape &other) const {
+            return mNumVertices == other.mNumVertices && mNumFaces == other.mNumFaces &&
+                   mPrimitiveTypes == other.mPrimitiveTypes && mMaterialIndex == other.mMaterialIndex;
+        }
+    };
+
+    /** State of a single import between #Detach and #Attach. */
+    struct Session {
+        /** Source key or raw content hash for each mesh of the imported scene */
+        std::vector<uint64_t> mHashes;
+
+        /** Raw shape of each mesh of the imported scene */
+        std::vector<Shape> mShapes;
+
+        /** Cached copy for each mesh, nullptr if the mesh is processed */
+        std::vector<aiMesh *> mReused;
+
+        Session();
+        ~Session();
+    };
+
+    IncrementalMeshCache();
+    ~IncrementalMeshCache();
+
+    // -------------------------------------------------------------------
+    /** Returns whether all steps in a post processing flag field operate
+     *  on each mesh in isolation and can thus be cached. */
+    static bool IsSupported(unsigned int pFlags);
+
+    // -------------------------------------------------------------------
+    /** Computes the content hash of a raw mesh. Names, vertex
+     *  components, faces, bones and animation meshes are included. */
+    static uint64_t HashMesh(const aiMesh *pMesh);
+
+    // -------------------------------------------------------------------
+    /** Removes all meshes with a cached result from the scene.
+     *  @param pScene Freshly imported scene, not yet post-processed
+     *  @param pFlags Post processing flags which will be applied
+     *  @param pConfigHash Hash of all importer properties
+     *  @param session Receives the state needed by #Attach
+     *  @param pKeys Optional source key for each mesh, 0 if unknown
+     *  @return Number of meshes which will be reused */
+    unsigned int Detach(aiScene *pScene, unsigned int pFlags, uint64_t pConfigHash, Session &session,
+            const std::vector<uint64_t> *pKeys = nullptr);
+
+    // -------------------------------------------------------------------
+    /** Restores the original mesh list of a post-processed scene and
+     *  updates the cache with the newly processed meshes. */
+    void Attach(aiScene *pScene, Session &session);
+
+    // -------------------------------------------------------------------
+    /** Drops all cached meshes. */
+    void Clear();
+
+    // -------------------------------------------------------------------
+    /** Returns the number of cached meshes. */
+    size_t GetNumCachedMeshes() const {
+        return mMeshes.size();
+    }
+
+private:
+    IncrementalMeshCache(const IncrementalMeshCache &) = delete;
+    IncrementalMeshCache &operator=(const IncrementalMeshCache &) = delete;
+
+    /** Post processing flags the cached meshes were produced with */
+    unsigned int mFlags;
+
+    /** Property hash the cached meshes were produced with */
+    uint64_t mConfigHash;
+
+    /** A post-processed mesh and the shape of its raw mesh */
+    struct Entry {
+        Shape mShape;
+        aiMesh *mMesh;
+    };
+
+    /** Post-processed meshes by source key or raw content hash */
+    std::unordered_map<uint64_t, Entry> mMeshes;
+};
+
+} // namespace Assimp
+
+#endif // AI_INCREMENTALMESHCACHE_H_INC
@@ -0,0 +1,132 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  ParallelFor.h
+ *  @brief Minimal helper to split a loop across worker threads.
+ */
+#pragma once
+#ifndef AI_PARALLELFOR_H_INC
+#define AI_PARALLELFOR_H_INC
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace Assimp {
+
+// --------------------------------------------------------------------------------------------
+/** @brief Resolves a #AI_CONFIG_GLOB_MULTITHREADING value to a number of threads.
+ *  @param config -1 to use all cores, 0 to disable threading, else a thread count.
+ *  @return Number of threads to use, at least one. */
+inline unsigned int GetNumWorkerThreads(int config) {
+    if (config > 0) {
+        return static_cast<unsigned int>(config);
+    }
+    if (0 == config) {
+        return 1;
+    }
+    const unsigned int hw = std::thread::hardware_concurrency();
+    return hw > 0 ? hw : 1;
+}
+
+// --------------------------------------------------------------------------------------------
+/** @brief Calls func(begin, end) for consecutive sub-ranges of [0, numItems).
+ *
+ *  The ranges are distributed across at most numThreads threads, the calling
+ *  thread handles the first range itself. If there is not enough work to give
+ *  each thread at least minItemsPerThread items fewer threads are used, so
+ *  small inputs never pay for a thread start. Exceptions thrown by func are
+ *  rethrown on the calling thread after all workers have finished.
+ *  @param numItems          Number of items to process
+ *  @param numThreads        Maximum number of threads, see #GetNumWorkerThreads()
+ *  @param minItemsPerThread Minimum number of items per thread
+ *  @param func              Callable taking (size_t begin, size_t end) */
+template <typename Func>
+void ParallelFor(size_t numItems, unsigned int numThreads, size_t minItemsPerThread, Func func) {
+    if (0 == numItems) {
+        return;
+    }
+    minItemsPerThread = std::max<size_t>(minItemsPerThread, 1);
+    const size_t maxThreads = std::max<size_t>(numItems / minItemsPerThread, 1);
+    const size_t threads = std::min<size_t>(std::max(numThreads, 1u), maxThreads);
+    if (threads <= 1) {
+        func(size_t(0), numItems);
+        return;
+    }
+
+    const size_t chunk = (numItems + threads - 1) / threads;
+    std::vector<std::exception_ptr> errors(threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t t = 1; t < threads; ++t) {
+        const size_t begin = std::min(t * chunk, numItems);
+        const size_t end = std::min(begin + chunk, numItems);
+        workers.emplace_back([&func, &errors, t, begin, end]() {
+            try {
+                func(begin, end);
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+
+    try {
+        func(size_t(0), std::min(chunk, numItems));
+    } catch (...) {
+        errors[0] = std::current_exception();
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+    for (const std::exception_ptr &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+} // namespace Assimp
+
+#endif // AI_PARALLELFOR_H_INC
@@ -0,0 +1,312 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  SceneAnalysis.cpp
+ *  @brief Implementation of AnalyzeScene()
+ */
+#include <assimp/SceneAnalysis.h>
+#include <assimp/scene.h>
+
+#include "Common/BatchMath.h"
+#include "Common/ParallelFor.h"
+
+#include <climits>
+#include <limits>
+
+namespace Assimp {
+
+namespace {
+
+// Maximum number of vertices reduced by one work item
+const unsigned int ChunkSize = 64 * 1024;
+
+// Minimum number of meshes to count per thread
+const size_t MinMeshesPerThread = 64;
+
+// ------------------------------------------------------------------------------------------------
+aiAABB EmptyBox() {
+    const ai_real big = std::numeric_limits<ai_real>::max();
+    return aiAABB(aiVector3D(big, big, big), aiVector3D(-big, -big, -big));
+}
+
+// ------------------------------------------------------------------------------------------------
+void MergeBox(aiAABB &box, const aiAABB &other) {
+    box.mMin.x = std::min(box.mMin.x, other.mMin.x);
+    box.mMin.y = std::min(box.mMin.y, other.mMin.y);
+    box.mMin.z = std::min(box.mMin.z, other.mMin.z);
+    box.mMax.x = std::max(box.mMax.x, other.mMax.x);
+    box.mMax.y = std::max(box.mMax.y, other.mMax.y);
+    box.mMax.z = std::max(box.mMax.z, other.mMax.z);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Same accounting as Importer::GetMemoryRequirements(), but with the real index count
+size_t ComputeMeshMemory(const aiMesh *mesh, unsigned int numIndices) {
+    size_t bytes = sizeof(aiMesh);
+    const size_t numVertices = mesh->mNumVertices;
+    if (mesh->HasPositions()) {
+        bytes += sizeof(aiVector3D) * numVertices;
+    }
+    if (mesh->HasNormals()) {
+        bytes += sizeof(aiVector3D) * numVertices;
+    }
+    if (mesh->HasTangentsAndBitangents()) {
+        bytes += sizeof(aiVector3D) * numVertices * 2;
+    }
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS && mesh->HasVertexColors(a); ++a) {
+        bytes += sizeof(aiColor4D) * numVertices;
+    }
+    for (unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS && mesh->HasTextureCoords(a); ++a) {
+        bytes += sizeof(aiVector3D) * numVertices;
+    }
+    if (mesh->HasBones()) {
+        bytes += sizeof(void *) * mesh->mNumBones;
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            bytes += sizeof(aiBone) + sizeof(aiVertexWeight) * mesh->mBones[b]->mNumWeights;
+        }
+    }
+    bytes += sizeof(aiFace) * mesh->mNumFaces + sizeof(unsigned int) * numIndices;
+    return bytes;
+}
+
+// ------------------------------------------------------------------------------------------------
+// A range of vertices of one mesh, either in mesh space or transformed to world space
+struct BoundsItem {
+    const aiMesh *mMesh;
+    const aiMatrix4x4 *mTransform;
+    unsigned int mTarget; // mesh index if mTransform is nullptr, else node index
+    unsigned int mBegin;
+    unsigned int mEnd;
+    aiAABB mBox;
+};
+
+// ------------------------------------------------------------------------------------------------
+void AddBoundsItems(std::vector<BoundsItem> &items, const aiMesh *mesh, const aiMatrix4x4 *transform, unsigned int target) {
+    if (nullptr == mesh || !mesh->HasPositions()) {
+        return;
+    }
+    for (unsigned int begin = 0; begin < mesh->mNumVertices; begin += ChunkSize) {
+        BoundsItem item;
+        item.mMesh = mesh;
+        item.mTransform = transform;
+        item.mTarget = target;
+        item.mBegin = begin;
+        item.mEnd = std::min(mesh->mNumVertices, begin + ChunkSize);
+        item.mBox = EmptyBox();
+        items.push_back(item);
+    }
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+MeshStatistics::MeshStatistics() :
+        mAABB(EmptyBox()),
+        mNumVertices(0),
+        mNumFaces(0),
+        mNumIndices(0),
+        mNumBones(0),
+        mNumBoneWeights(0),
+        mPrimitiveTypes(0),
+        mMemory(0) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+NodeStatistics::NodeStatistics() :
+        mNode(nullptr),
+        mParent(UINT_MAX),
+        mDepth(0),
+        mWorldTransform(),
+        mAABB(EmptyBox()) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+SceneStatistics::SceneStatistics() :
+        mMeshes(),
+        mNodes(),
+        mAABB(EmptyBox()),
+        mMaxDepth(0),
+        mNumVertices(0),
+        mNumFaces(0),
+        mNumBones(0),
+        mNumAnimChannels(0),
+        mPrimitiveTypes(0),
+        mMeshMemory(0) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+void AnalyzeScene(const aiScene *scene, SceneStatistics &stats, int numThreads, bool nodeBounds) {
+    stats = SceneStatistics();
+    if (nullptr == scene) {
+        return;
+    }
+    const unsigned int threads = GetNumWorkerThreads(numThreads);
+
+    // Element counts and memory of all meshes
+    stats.mMeshes.resize(scene->mNumMeshes);
+    ParallelFor(scene->mNumMeshes, threads, MinMeshesPerThread, [scene, &stats](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const aiMesh *mesh = scene->mMeshes[i];
+            if (nullptr == mesh) {
+                continue;
+            }
+            MeshStatistics &ms = stats.mMeshes[i];
+            ms.mNumVertices = mesh->mNumVertices;
+            ms.mNumFaces = mesh->mNumFaces;
+            ms.mNumBones = mesh->mNumBones;
+            ms.mPrimitiveTypes = mesh->mPrimitiveTypes;
+            for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+                ms.mNumIndices += mesh->mFaces[f].mNumIndices;
+            }
+            for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+                ms.mNumBoneWeights += mesh->mBones[b]->mNumWeights;
+            }
+            ms.mMemory = ComputeMeshMemory(mesh, ms.mNumIndices);
+        }
+    });
+    for (const MeshStatistics &ms : stats.mMeshes) {
+        stats.mNumVertices += ms.mNumVertices;
+        stats.mNumFaces += ms.mNumFaces;
+        stats.mNumBones += ms.mNumBones;
+        stats.mPrimitiveTypes |= ms.mPrimitiveTypes;
+        stats.mMeshMemory += ms.mMemory;
+    }
+    for (unsigned int i = 0; i < scene->mNumAnimations; ++i) {
+        stats.mNumAnimChannels += scene->mAnimations[i]->mNumChannels;
+    }
+
+    // Walk the node graph depth-first without recursion, deep hierarchies are common in CAD data
+    if (scene->mRootNode) {
+        std::vector<std::pair<const aiNode *, unsigned int>> stack(1, std::make_pair(scene->mRootNode, UINT_MAX));
+        while (!stack.empty()) {
+            const aiNode *node = stack.back().first;
+            const unsigned int parent = stack.back().second;
+            stack.pop_back();
+
+            NodeStatistics ns;
+            ns.mNode = node;
+            ns.mParent = parent;
+            if (UINT_MAX == parent) {
+                ns.mDepth = 1;
+                ns.mWorldTransform = node->mTransformation;
+            } else {
+                ns.mDepth = stats.mNodes[parent].mDepth + 1;
+                ns.mWorldTransform = stats.mNodes[parent].mWorldTransform * node->mTransformation;
+            }
+            stats.mMaxDepth = std::max(stats.mMaxDepth, ns.mDepth);
+
+            const unsigned int index = static_cast<unsigned int>(stats.mNodes.size());
+            stats.mNodes.push_back(ns);
+            for (unsigned int c = node->mNumChildren; c > 0; --c) {
+                stack.push_back(std::make_pair(node->mChildren[c - 1], index));
+            }
+        }
+    }
+
+    // Split the vertex work into chunks: mesh space boxes first, then all mesh
+    // instances which need a transformation to world space
+    std::vector<BoundsItem> items;
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        AddBoundsItems(items, scene->mMeshes[i], nullptr, i);
+    }
+    const aiMatrix4x4 identity;
+    if (nodeBounds) {
+        for (unsigned int n = 0; n < stats.mNodes.size(); ++n) {
+            const NodeStatistics &ns = stats.mNodes[n];
+            if (ns.mWorldTransform == identity) {
+                continue;
+            }
+            for (unsigned int m = 0; m < ns.mNode->mNumMeshes; ++m) {
+                if (ns.mNode->mMeshes[m] < scene->mNumMeshes) {
+                    AddBoundsItems(items, scene->mMeshes[ns.mNode->mMeshes[m]], &ns.mWorldTransform, n);
+                }
+            }
+        }
+    }
+
+    ParallelFor(items.size(), threads, 1, [&items](size_t begin, size_t end) {
+        std::vector<aiVector3D> scratch;
+        for (size_t i = begin; i < end; ++i) {
+            BoundsItem &item = items[i];
+            const aiVector3D *vertices = item.mMesh->mVertices + item.mBegin;
+            const unsigned int count = item.mEnd - item.mBegin;
+            if (item.mTransform) {
+                scratch.resize(count);
+                BatchMath::TransformPositions(scratch.data(), vertices, count, *item.mTransform);
+                vertices = scratch.data();
+            }
+            BatchMath::ComputeBoundingBox(vertices, count, item.mBox.mMin, item.mBox.mMax);
+        }
+    });
+
+    for (const BoundsItem &item : items) {
+        MergeBox(item.mTransform ? stats.mNodes[item.mTarget].mAABB : stats.mMeshes[item.mTarget].mAABB, item.mBox);
+    }
+    if (!nodeBounds) {
+        return;
+    }
+
+    // Untransformed instances reuse the mesh boxes, then the boxes are
+    // propagated to the parents. Children always come after their parent.
+    for (NodeStatistics &ns : stats.mNodes) {
+        if (ns.mWorldTransform == identity) {
+            for (unsigned int m = 0; m < ns.mNode->mNumMeshes; ++m) {
+                if (ns.mNode->mMeshes[m] < stats.mMeshes.size()) {
+                    MergeBox(ns.mAABB, stats.mMeshes[ns.mNode->mMeshes[m]].mAABB);
+                }
+            }
+        }
+    }
+    for (size_t n = stats.mNodes.size(); n > 1; --n) {
+        const NodeStatistics &ns = stats.mNodes[n - 1];
+        MergeBox(stats.mNodes[ns.mParent].mAABB, ns.mAABB);
+    }
+    if (!stats.mNodes.empty()) {
+        stats.mAABB = stats.mNodes[0].mAABB;
+    }
+}
+
+} // namespace Assimp
@@ -1046,6 +1046,106 @@ void SceneCombiner::CopyScene(aiScene **_dest, const aiScene *src, bool allocate
     }
 }
 
+// ------------------------------------------------------------------------------------------------
+template <typename Type>
+inline void SharePtrArray(Type **&dest, Type *const *src, ai_uint num) {
+    if (!num || nullptr == src) {
+        dest = nullptr;
+        return;
+    }
+    dest = new Type *[num];
+    ::memcpy(dest, src, sizeof(Type *) * num);
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename Type>
+inline void UnsharePtrArray(Type **dest, ai_uint num) {
+    if (nullptr == dest) {
+        return;
+    }
+    for (ai_uint i = 0; i < num; ++i) {
+        const Type *shared = dest[i];
+        dest[i] = nullptr;
+        SceneCombiner::Copy(&dest[i], shared);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::ShareScene(aiScene **_dest, const aiScene *src) {
+    if (nullptr == _dest || nullptr == src) {
+        return;
+    }
+
+    aiScene *dest = *_dest = new aiScene();
+
+    // copy metadata
+    if (nullptr != src->mMetaData) {
+        dest->mMetaData = new aiMetadata(*src->mMetaData);
+    }
+
+    // share all component arrays, the pointer arrays themselves are owned by
+    // the destination scene so steps can resize them after MakeUnique()
+    dest->mNumAnimations = src->mNumAnimations;
+    SharePtrArray(dest->mAnimations, src->mAnimations, dest->mNumAnimations);
+
+    dest->mNumTextures = src->mNumTextures;
+    SharePtrArray(dest->mTextures, src->mTextures, dest->mNumTextures);
+
+    dest->mNumMaterials = src->mNumMaterials;
+    SharePtrArray(dest->mMaterials, src->mMaterials, dest->mNumMaterials);
+
+    dest->mNumLights = src->mNumLights;
+    SharePtrArray(dest->mLights, src->mLights, dest->mNumLights);
+
+    dest->mNumCameras = src->mNumCameras;
+    SharePtrArray(dest->mCameras, src->mCameras, dest->mNumCameras);
+
+    dest->mNumMeshes = src->mNumMeshes;
+    SharePtrArray(dest->mMeshes, src->mMeshes, dest->mNumMeshes);
+
+    // the node graph is cheap and modified by many steps, so copy it right away
+    Copy(&dest->mRootNode, src->mRootNode);
+
+    dest->mFlags = src->mFlags;
+
+    ScenePrivateData *priv = ScenePriv(dest);
+    priv->mSharedComponents = SceneComponent_All;
+    priv->mPPStepsApplied = ScenePriv(src) ? ScenePriv(src)->mPPStepsApplied : 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SceneCombiner::MakeUnique(aiScene *scene, unsigned int components) {
+    if (nullptr == scene || nullptr == scene->mPrivate) {
+        return;
+    }
+
+    ScenePrivateData *priv = ScenePriv(scene);
+    const unsigned int todo = priv->mSharedComponents & components;
+    if (!todo) {
+        return;
+    }
+
+    if (todo & SceneComponent_Meshes) {
+        UnsharePtrArray(scene->mMeshes, scene->mNumMeshes);
+    }
+    if (todo & SceneComponent_Materials) {
+        UnsharePtrArray(scene->mMaterials, scene->mNumMaterials);
+    }
+    if (todo & SceneComponent_Animations) {
+        UnsharePtrArray(scene->mAnimations, scene->mNumAnimations);
+    }
+    if (todo & SceneComponent_Textures) {
+        UnsharePtrArray(scene->mTextures, scene->mNumTextures);
+    }
+    if (todo & SceneComponent_Lights) {
+        UnsharePtrArray(scene->mLights, scene->mNumLights);
+    }
+    if (todo & SceneComponent_Cameras) {
+        UnsharePtrArray(scene->mCameras, scene->mNumCameras);
+    }
+    priv->mSharedComponents &= ~todo;
+}
+
 // ------------------------------------------------------------------------------------------------
 void SceneCombiner::Copy(aiMesh **_dest, const aiMesh *src) {
     if (nullptr == _dest || nullptr == src) {
@@ -72,13 +72,19 @@ struct ScenePrivateData {
     // serve informative purposes.
 	//aiCopyScene()Ӧc++ APIƵģΪtrueζûѾ޸ģmPPStepsAppliedmOrigImporterǰȫģֻṩϢĿġ
     bool mIsCopy;
+
+    // Combination of SceneComponent flags for the component arrays
+    // whose elements are shared with another scene (see
+    // SceneCombiner::ShareScene()). They are not deleted with the scene.
+    unsigned int mSharedComponents;
 };
 
 inline
 ScenePrivateData::ScenePrivateData() AI_NO_EXCEPT  //캯
 : mOrigImporter( nullptr )
 , mPPStepsApplied( 0 )
-, mIsCopy( false ) {
+, mIsCopy( false )
+, mSharedComponents( 0 ) {
     // empty
 }
 
@@ -0,0 +1,121 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Implementation of the hash grid to quickly find vertices close to a given position */
+
+#include <assimp/SpatialHash.h>
+#include <assimp/ai_assert.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace Assimp;
+
+// ------------------------------------------------------------------------------------------------
+SpatialHash::SpatialHash() :
+        mRadius(0), mInvCellSize(0), mBucketMask(0) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+SpatialHash::SpatialHash(const aiVector3D *pPositions, unsigned int pNumPositions,
+        unsigned int pElementOffset, ai_real pRadius) :
+        mRadius(0), mInvCellSize(0), mBucketMask(0) {
+    Fill(pPositions, pNumPositions, pElementOffset, pRadius);
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHash::Fill(const aiVector3D *pPositions, unsigned int pNumPositions,
+        unsigned int pElementOffset, ai_real pRadius) {
+    mEntries.clear();
+    mBucketStart.clear();
+    mRadius = pRadius;
+
+    // A zero radius would give infinitely small cells. Use a tiny cell instead, the distance
+    // check in ForEachPosition() still only accepts positions strictly inside the radius.
+    const ai_real cellSize = std::max(pRadius, std::numeric_limits<ai_real>::min() * 16);
+    mInvCellSize = ai_real(1.0) / cellSize;
+    if (0 == pNumPositions) {
+        return;
+    }
+
+    // power of two bucket count, roughly one bucket per position
+    unsigned int numBuckets = 1;
+    while (numBuckets < pNumPositions && numBuckets < (1u << 30)) {
+        numBuckets <<= 1;
+    }
+    mBucketMask = numBuckets - 1;
+
+    // counting sort of the positions by bucket, yields a compact CSR layout
+    std::vector<unsigned int> buckets(pNumPositions);
+    mBucketStart.assign(numBuckets + 1, 0);
+    mEntries.resize(pNumPositions);
+    const char *data = reinterpret_cast<const char *>(pPositions);
+    for (unsigned int a = 0; a < pNumPositions; ++a) {
+        const aiVector3D &vec = *reinterpret_cast<const aiVector3D *>(data + a * static_cast<size_t>(pElementOffset));
+        int64_t cell[3];
+        ComputeCell(vec, cell);
+        buckets[a] = ComputeBucket(cell[0], cell[1], cell[2]);
+        ++mBucketStart[buckets[a] + 1];
+    }
+    for (unsigned int b = 0; b < numBuckets; ++b) {
+        mBucketStart[b + 1] += mBucketStart[b];
+    }
+
+    std::vector<unsigned int> cursor(mBucketStart.begin(), mBucketStart.end() - 1);
+    for (unsigned int a = 0; a < pNumPositions; ++a) {
+        const aiVector3D &vec = *reinterpret_cast<const aiVector3D *>(data + a * static_cast<size_t>(pElementOffset));
+        Entry &entry = mEntries[cursor[buckets[a]]++];
+        entry.mPosition = vec;
+        entry.mIndex = a;
+        ComputeCell(vec, entry.mCell);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+void SpatialHash::FindPositions(const aiVector3D &pPosition, std::vector<unsigned int> &poResults) const {
+    poResults.clear();
+    ForEachPosition(pPosition, [&poResults](unsigned int index) {
+        poResults.push_back(index);
+    });
+}
@@ -46,12 +46,12 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/Vertex.h>
 #include <assimp/ai_assert.h>
 
+#include "Common/ParallelFor.h"
 #include "PostProcessing/ProcessHelper.h"
 
 #include <stdio.h>
 
 using namespace Assimp;
-void mydummy() {}
 
 #ifdef _MSC_VER
 #pragma warning(disable : 4709)
@@ -63,6 +63,11 @@ void mydummy() {}
 // ------------------------------------------------------------------------------------------------
 class CatmullClarkSubdivider : public Subdivider {
 public:
+    explicit CatmullClarkSubdivider(int numThreads) :
+            mNumThreads(numThreads) {
+        // empty
+    }
+
     void Subdivide(aiMesh *mesh, aiMesh *&out, unsigned int num, bool discard_input);
     void Subdivide(aiMesh **smesh, size_t nmesh,
             aiMesh **out, unsigned int num, bool discard_input);
@@ -71,44 +76,99 @@ public:
     /** Intermediate description of an edge between two corners of a polygon*/
     // ---------------------------------------------------------------------------
     struct Edge {
-        Edge() :
-                ref(0) {}
         Vertex edge_point, midpoint;
+    };
+
+    // ---------------------------------------------------------------------------
+    /** Topology of an edge: the faces using it and the corner of its first face
+     *  it starts at. Only the first two faces contribute to the edge point. */
+    // ---------------------------------------------------------------------------
+    struct EdgeInfo {
         unsigned int ref;
+        unsigned int face[2];
+        unsigned int corner;
     };
 
     typedef std::vector<unsigned int> UIntVector;
-    typedef std::map<uint64_t, Edge> EdgeMap;
 
     // ---------------------------------------------------------------------------
-    // Hashing function to derive an index into an #EdgeMap from two given
-    // 'unsigned int' vertex coordinates (!!distinct coordinates - same
-    // vertex position == same index!!).
-    // NOTE - this leads to rare hash collisions if a) sizeof(unsigned int)>4
-    // and (id[0]>2^32-1 or id[0]>2^32-1).
-    // MAKE_EDGE_HASH() uses temporaries, so INIT_EDGE_HASH() needs to be put
-    // at the head of every function which is about to use MAKE_EDGE_HASH().
-    // Reason is that the hash is that hash construction needs to hold the
-    // invariant id0<id1 to identify an edge - else two hashes would refer
-    // to the same edge.
+    /** Open addressing hash table mapping an edge between two distinct vertices
+     *  (same vertex position == same index) to a continuous edge index. The key
+     *  holds the smaller index in its upper half so both directions of an edge
+     *  refer to the same entry. */
     // ---------------------------------------------------------------------------
-#define MAKE_EDGE_HASH(id0, id1) (eh_tmp0__ = id0, eh_tmp1__ = id1, \
-        (eh_tmp0__ < eh_tmp1__ ? std::swap(eh_tmp0__, eh_tmp1__) : mydummy()), (uint64_t)eh_tmp0__ ^ ((uint64_t)eh_tmp1__ << 32u))
+    class EdgeTable {
+    public:
+        void Reset(size_t maxEdges) {
+            size_t capacity = 16;
+            while (capacity < maxEdges * 2) {
+                capacity <<= 1;
+            }
+            mKeys.assign(capacity, EmptyKey());
+            mValues.resize(capacity);
+            mMask = capacity - 1;
+        }
 
-#define INIT_EDGE_HASH_TEMPORARIES() \
-    unsigned int eh_tmp0__, eh_tmp1__;
+        // Returns the index of the edge, it is set to 'next' if the edge is new
+        unsigned int Insert(unsigned int id0, unsigned int id1, unsigned int next) {
+            const uint64_t key = id0 < id1 ? ((uint64_t)id0 << 32u) | id1 : ((uint64_t)id1 << 32u) | id0;
+            size_t slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32u) & mMask;
+            while (mKeys[slot] != key) {
+                if (mKeys[slot] == EmptyKey()) {
+                    mKeys[slot] = key;
+                    mValues[slot] = next;
+                    return next;
+                }
+                slot = (slot + 1) & mMask;
+            }
+            return mValues[slot];
+        }
+
+    private:
+        static uint64_t EmptyKey() {
+            return ~(uint64_t)0;
+        }
+
+        std::vector<uint64_t> mKeys;
+        UIntVector mValues;
+        size_t mMask = 0;
+    };
+
+    // ---------------------------------------------------------------------------
+    /** Buffers of one subdivision step. They are kept for all levels, so the
+     *  storage of a level is reused by the next one. Faces, corners and
+     *  vertices of all meshes are indexed continuously. */
+    // ---------------------------------------------------------------------------
+    struct Workspace {
+        std::vector<std::pair<unsigned int, unsigned int>> moffsets;
+        UIntVector maptbl, faceMesh, cornerOfs, cornerFace, cornerEdge;
+        std::vector<Vertex> centroids, points;
+        EdgeTable table;
+        std::vector<EdgeInfo> edgeInfo;
+        std::vector<Edge> edges;
+        UIntVector adjOfs, adjCorners;
+        UIntVector nextMaptbl;
+        unsigned int numUnique = 0;
+    };
 
 private:
     void InternSubdivide(const aiMesh *const *smesh,
             size_t nmesh, aiMesh **out, unsigned int num);
+    void SubdivideLevel(const aiMesh *const *smesh, size_t nmesh, aiMesh **out,
+            Workspace &ws, bool firstLevel, bool needMapping);
+
+    // Vertex arithmetic is expensive, a few thousand items already pay for a thread
+    static const size_t MinItemsPerThread = 1024;
+
+    int mNumThreads;
 };
 
 // ------------------------------------------------------------------------------------------------
 // Construct a subdivider of a specific type
-Subdivider *Subdivider::Create(Algorithm algo) {
+Subdivider *Subdivider::Create(Algorithm algo, int numThreads) {
     switch (algo) {
     case CATMULL_CLARKE:
-        return new CatmullClarkSubdivider();
+        return new CatmullClarkSubdivider(numThreads);
     };
 
     ai_assert(false);
@@ -209,16 +269,14 @@ void CatmullClarkSubdivider::Subdivide(
     }
 }
 
+
 // ------------------------------------------------------------------------------------------------
 // Note - this is an implementation of the standard (recursive) Cm-Cl algorithm without further
 // optimizations (except we're using some nice LUTs). A description of the algorithm can be found
 // here: http://en.wikipedia.org/wiki/Catmull-Clark_subdivision_surface
 //
-// The code is mostly O(n), however parts are O(nlogn) which is therefore the algorithm's
-// expected total runtime complexity. The implementation is able to work in-place on the same
-// mesh arrays. Calling #InternSubdivide() directly is not encouraged. The code can operate
-// in-place unless 'smesh' and 'out' are equal (no strange overlaps or reorderings).
-// Previous data is replaced/deleted then.
+// The levels are computed one after another, each level replaces the previous intermediate
+// meshes. Calling #InternSubdivide() directly is not encouraged.
 // ------------------------------------------------------------------------------------------------
 void CatmullClarkSubdivider::InternSubdivide(
         const aiMesh *const *smesh,
@@ -228,354 +286,343 @@ void CatmullClarkSubdivider::InternSubdivide(
     ai_assert(nullptr != smesh);
     ai_assert(nullptr != out);
 
-    INIT_EDGE_HASH_TEMPORARIES();
+    Workspace ws;
+    std::vector<aiMesh *> prev;
+    for (unsigned int level = 0; level < num; ++level) {
+        const bool last = level + 1 == num;
+        SubdivideLevel(level ? &prev.front() : smesh, nmesh, out, ws, 0 == level, !last);
 
-    // no subdivision requested or end of recursive refinement
-    if (!num) {
-        return;
+        // the input of this level was an intermediate result
+        for (aiMesh *mesh : prev) {
+            delete mesh;
+        }
+        prev.clear();
+        if (!last) {
+            prev.assign(out, out + nmesh);
+        }
     }
+}
 
-    UIntVector maptbl;
-    SpatialSort spatial;
+// ------------------------------------------------------------------------------------------------
+// One level of refinement. The code is O(n) except for the spatial sort of the first level,
+// which is O(nlogn). Face, edge and vertex points are computed in parallel, only building
+// the edge table and the adjacency is sequential.
+// ------------------------------------------------------------------------------------------------
+void CatmullClarkSubdivider::SubdivideLevel(
+        const aiMesh *const *smesh,
+        size_t nmesh,
+        aiMesh **out,
+        Workspace &ws,
+        bool firstLevel,
+        bool needMapping) {
+    const unsigned int numThreads = GetNumWorkerThreads(mNumThreads);
 
     // ---------------------------------------------------------------------
-    // 0. Offset table to index all meshes continuously, generate a spatially
-    // sorted representation of all vertices in all meshes.
+    // 0. Offset tables to index all faces, corners and vertices of all meshes
+    // continuously. On the first level, vertices at the same position are
+    // mapped to the same index using a spatially sorted representation of
+    // all vertices. The next levels get the mapping from their previous one.
     // ---------------------------------------------------------------------
-    typedef std::pair<unsigned int, unsigned int> IntPair;
-    std::vector<IntPair> moffsets(nmesh);
+    ws.moffsets.resize(nmesh);
     unsigned int totfaces = 0, totvert = 0;
     for (size_t t = 0; t < nmesh; ++t) {
-        const aiMesh *mesh = smesh[t];
-
-        spatial.Append(mesh->mVertices, mesh->mNumVertices, sizeof(aiVector3D), false);
-        moffsets[t] = IntPair(totfaces, totvert);
+        ws.moffsets[t] = std::make_pair(totfaces, totvert);
+        totfaces += smesh[t]->mNumFaces;
+        totvert += smesh[t]->mNumVertices;
+    }
 
-        totfaces += mesh->mNumFaces;
-        totvert += mesh->mNumVertices;
+    ws.faceMesh.resize(totfaces);
+    ws.cornerOfs.resize(totfaces + 1);
+    unsigned int nfacesout = 0;
+    for (size_t t = 0, n = 0; t < nmesh; ++t) {
+        const aiMesh *mesh = smesh[t];
+        for (unsigned int i = 0; i < mesh->mNumFaces; ++i, ++n) {
+            ws.faceMesh[n] = static_cast<unsigned int>(t);
+            ws.cornerOfs[n] = nfacesout;
+            nfacesout += mesh->mFaces[i].mNumIndices;
+        }
     }
+    ws.cornerOfs[totfaces] = nfacesout;
 
-    spatial.Finalize();
-    const unsigned int num_unique = spatial.GenerateMappingTable(maptbl, ComputePositionEpsilon(smesh, nmesh));
+    if (firstLevel) {
+        SpatialSort spatial;
+        for (size_t t = 0; t < nmesh; ++t) {
+            spatial.Append(smesh[t]->mVertices, smesh[t]->mNumVertices, sizeof(aiVector3D), false);
+        }
+        spatial.Finalize();
+        ws.numUnique = spatial.GenerateMappingTable(ws.maptbl, ComputePositionEpsilon(smesh, nmesh));
+    }
+    ai_assert(ws.maptbl.size() == totvert);
 
-#define FLATTEN_VERTEX_IDX(mesh_idx, vert_idx) (moffsets[mesh_idx].second + vert_idx)
-#define FLATTEN_FACE_IDX(mesh_idx, face_idx) (moffsets[mesh_idx].first + face_idx)
+    const auto faceOf = [smesh, &ws](unsigned int f) -> const aiFace & {
+        const unsigned int t = ws.faceMesh[f];
+        return smesh[t]->mFaces[f - ws.moffsets[t].first];
+    };
+    const auto uniqueOf = [&ws](unsigned int f, unsigned int idx) {
+        return ws.maptbl[ws.moffsets[ws.faceMesh[f]].second + idx];
+    };
 
     // ---------------------------------------------------------------------
     // 1. Compute the centroid point for all faces
     // ---------------------------------------------------------------------
-    std::vector<Vertex> centroids(totfaces);
-    unsigned int nfacesout = 0;
-    for (size_t t = 0, n = 0; t < nmesh; ++t) {
-        const aiMesh *mesh = smesh[t];
-        for (unsigned int i = 0; i < mesh->mNumFaces; ++i, ++n) {
-            const aiFace &face = mesh->mFaces[i];
-            Vertex &c = centroids[n];
+    ws.centroids.assign(totfaces, Vertex());
+    ws.cornerFace.resize(nfacesout);
+    ParallelFor(totfaces, numThreads, MinItemsPerThread, [smesh, &ws, &faceOf](size_t begin, size_t end) {
+        for (size_t n = begin; n < end; ++n) {
+            const unsigned int f = static_cast<unsigned int>(n);
+            const aiMesh *mesh = smesh[ws.faceMesh[f]];
+            const aiFace &face = faceOf(f);
+            Vertex &c = ws.centroids[f];
 
             for (unsigned int a = 0; a < face.mNumIndices; ++a) {
                 c += Vertex(mesh, face.mIndices[a]);
+                ws.cornerFace[ws.cornerOfs[f] + a] = f;
             }
 
             c /= static_cast<float>(face.mNumIndices);
-            nfacesout += face.mNumIndices;
         }
-    }
+    });
 
-    {
-        // we want edges to go away before the recursive calls so begin a new scope
-        EdgeMap edges;
+    // ---------------------------------------------------------------------
+    // 2. Number the edges in the order of their first use. Every edge
+    // exists twice if there is a neighboring face.
+    // ---------------------------------------------------------------------
+    ws.table.Reset(nfacesout);
+    ws.edgeInfo.clear();
+    ws.cornerEdge.resize(nfacesout);
+    for (unsigned int f = 0; f < totfaces; ++f) {
+        const aiFace &face = faceOf(f);
+        for (unsigned int p = 0; p < face.mNumIndices; ++p) {
+            const unsigned int e = ws.table.Insert(uniqueOf(f, face.mIndices[p]),
+                    uniqueOf(f, face.mIndices[p == face.mNumIndices - 1 ? 0 : p + 1]),
+                    static_cast<unsigned int>(ws.edgeInfo.size()));
+            if (e == ws.edgeInfo.size()) {
+                EdgeInfo info;
+                info.ref = 0;
+                info.face[0] = info.face[1] = f;
+                info.corner = p;
+                ws.edgeInfo.push_back(info);
+            }
 
-        // ---------------------------------------------------------------------
-        // 2. Set each edge point to be the average of all neighbouring
-        // face points and original points. Every edge exists twice
-        // if there is a neighboring face.
-        // ---------------------------------------------------------------------
-        for (size_t t = 0; t < nmesh; ++t) {
-            const aiMesh *mesh = smesh[t];
-
-            for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
-                const aiFace &face = mesh->mFaces[i];
-
-                for (unsigned int p = 0; p < face.mNumIndices; ++p) {
-                    const unsigned int id[] = {
-                        face.mIndices[p],
-                        face.mIndices[p == face.mNumIndices - 1 ? 0 : p + 1]
-                    };
-                    const unsigned int mp[] = {
-                        maptbl[FLATTEN_VERTEX_IDX(t, id[0])],
-                        maptbl[FLATTEN_VERTEX_IDX(t, id[1])]
-                    };
-
-                    Edge &e = edges[MAKE_EDGE_HASH(mp[0], mp[1])];
-                    e.ref++;
-                    if (e.ref <= 2) {
-                        if (e.ref == 1) { // original points (end points) - add only once
-                            e.edge_point = e.midpoint = Vertex(mesh, id[0]) + Vertex(mesh, id[1]);
-                            e.midpoint *= 0.5f;
-                        }
-                        e.edge_point += centroids[FLATTEN_FACE_IDX(t, i)];
-                    }
-                }
+            EdgeInfo &info = ws.edgeInfo[e];
+            if (++info.ref == 2) {
+                info.face[1] = f;
             }
+            ws.cornerEdge[ws.cornerOfs[f] + p] = e;
         }
+    }
 
-        // ---------------------------------------------------------------------
-        // 3. Normalize edge points
-        // ---------------------------------------------------------------------
-        {
-            unsigned int bad_cnt = 0;
-            for (EdgeMap::iterator it = edges.begin(); it != edges.end(); ++it) {
-                if ((*it).second.ref < 2) {
-                    ai_assert((*it).second.ref);
-                    ++bad_cnt;
-                }
-                (*it).second.edge_point *= 1.f / ((*it).second.ref + 2.f);
+    // ---------------------------------------------------------------------
+    // 3. Set each edge point to be the average of the two neighbouring
+    // face points and original points.
+    // ---------------------------------------------------------------------
+    const unsigned int numEdges = static_cast<unsigned int>(ws.edgeInfo.size());
+    ws.edges.resize(numEdges);
+    ParallelFor(numEdges, numThreads, MinItemsPerThread, [smesh, &ws, &faceOf](size_t begin, size_t end) {
+        for (size_t n = begin; n < end; ++n) {
+            const EdgeInfo &info = ws.edgeInfo[n];
+            const aiMesh *mesh = smesh[ws.faceMesh[info.face[0]]];
+            const aiFace &face = faceOf(info.face[0]);
+            Edge &e = ws.edges[n];
+
+            // original points (end points)
+            e.edge_point = e.midpoint = Vertex(mesh, face.mIndices[info.corner]) +
+                                        Vertex(mesh, face.mIndices[info.corner == face.mNumIndices - 1 ? 0 : info.corner + 1]);
+            e.midpoint *= 0.5f;
+
+            e.edge_point += ws.centroids[info.face[0]];
+            if (info.ref >= 2) {
+                e.edge_point += ws.centroids[info.face[1]];
             }
-
-            if (bad_cnt) {
-                // Report the number of bad edges. bad edges are referenced by less than two
-                // faces in the mesh. They occur at outer model boundaries in non-closed
-                // shapes.
-                ASSIMP_LOG_VERBOSE_DEBUG_F("Catmull-Clark Subdivider: got ", bad_cnt, " bad edges touching only one face (totally ",
-                        static_cast<unsigned int>(edges.size()), " edges). ");
+            e.edge_point *= 1.f / (info.ref + 2.f);
+        }
+    });
+
+    if (!DefaultLogger::isNullLogger()) {
+        // Report the number of bad edges. bad edges are referenced by less than two
+        // faces in the mesh. They occur at outer model boundaries in non-closed
+        // shapes.
+        unsigned int bad_cnt = 0;
+        for (const EdgeInfo &info : ws.edgeInfo) {
+            if (info.ref < 2) {
+                ++bad_cnt;
             }
         }
+        if (bad_cnt) {
+            ASSIMP_LOG_VERBOSE_DEBUG_F("Catmull-Clark Subdivider: got ", bad_cnt, " bad edges touching only one face (totally ",
+                    numEdges, " edges). ");
+        }
+    }
 
-        // ---------------------------------------------------------------------
-        // 4. Compute a vertex-face adjacency table. We can't reuse the code
-        // from VertexTriangleAdjacency because we need the table for multiple
-        // meshes and out vertex indices need to be mapped to distinct values
-        // first.
-        // ---------------------------------------------------------------------
-        UIntVector faceadjac(nfacesout), cntadjfac(maptbl.size(), 0), ofsadjvec(maptbl.size() + 1, 0);
-        {
-            for (size_t t = 0; t < nmesh; ++t) {
-                const aiMesh *const minp = smesh[t];
-                for (unsigned int i = 0; i < minp->mNumFaces; ++i) {
-
-                    const aiFace &f = minp->mFaces[i];
-                    for (unsigned int n = 0; n < f.mNumIndices; ++n) {
-                        ++cntadjfac[maptbl[FLATTEN_VERTEX_IDX(t, f.mIndices[n])]];
-                    }
-                }
-            }
-            unsigned int cur = 0;
-            for (size_t i = 0; i < cntadjfac.size(); ++i) {
-                ofsadjvec[i + 1] = cur;
-                cur += cntadjfac[i];
+    // ---------------------------------------------------------------------
+    // 4. Compute a vertex-corner adjacency table (CSR layout). We can't reuse
+    // the code from VertexTriangleAdjacency because we need the table for
+    // multiple meshes and out vertex indices need to be mapped to distinct
+    // values first.
+    // ---------------------------------------------------------------------
+    ws.adjOfs.assign(ws.numUnique + 1, 0);
+    for (unsigned int f = 0; f < totfaces; ++f) {
+        const aiFace &face = faceOf(f);
+        for (unsigned int a = 0; a < face.mNumIndices; ++a) {
+            ++ws.adjOfs[uniqueOf(f, face.mIndices[a]) + 1];
+        }
+    }
+    for (unsigned int u = 1; u <= ws.numUnique; ++u) {
+        ws.adjOfs[u] += ws.adjOfs[u - 1];
+    }
+    ws.adjCorners.resize(nfacesout);
+    for (unsigned int f = 0; f < totfaces; ++f) {
+        const aiFace &face = faceOf(f);
+        for (unsigned int a = 0; a < face.mNumIndices; ++a) {
+            ws.adjCorners[ws.adjOfs[uniqueOf(f, face.mIndices[a])]++] = ws.cornerOfs[f] + a;
+        }
+    }
+    // filling moved each offset to the start of the next vertex, shift back
+    for (unsigned int u = ws.numUnique; u > 1; --u) {
+        ws.adjOfs[u - 1] = ws.adjOfs[u - 2];
+    }
+    ws.adjOfs[0] = 0;
+
+    // ---------------------------------------------------------------------
+    // 5. Move the original points. For an original point P with distinct
+    // index i:
+    // F := 0
+    // R := 0
+    // n := 0
+    // for each face f containing i
+    //    F := F+ centroid of f
+    //    R := R+ midpoint of edge of f from i to i+1
+    //    n := n+1
+    //
+    // (F+2R+(n-3)P)/n
+    //
+    // Both edges of each face are added to R. This way, we can be sure that
+    // we add *all* adjacent edges to R. In a closed shape, every edge is
+    // added twice - so we simply leave out the factor 2.f.
+    // ---------------------------------------------------------------------
+    ws.points.resize(ws.numUnique);
+    ParallelFor(ws.numUnique, numThreads, MinItemsPerThread, [smesh, &ws, &faceOf](size_t begin, size_t end) {
+        for (size_t u = begin; u < end; ++u) {
+            const unsigned int *adj = &ws.adjCorners.front() + ws.adjOfs[u];
+            const unsigned int cnt = ws.adjOfs[u + 1] - ws.adjOfs[u];
+            if (!cnt) {
+                continue;
             }
-            for (size_t t = 0; t < nmesh; ++t) {
-                const aiMesh *const minp = smesh[t];
-                for (unsigned int i = 0; i < minp->mNumFaces; ++i) {
 
-                    const aiFace &f = minp->mFaces[i];
-                    for (unsigned int n = 0; n < f.mNumIndices; ++n) {
-                        faceadjac[ofsadjvec[1 + maptbl[FLATTEN_VERTEX_IDX(t, f.mIndices[n])]]++] = FLATTEN_FACE_IDX(t, i);
-                    }
-                }
+            const unsigned int f0 = ws.cornerFace[adj[0]];
+            const Vertex org(smesh[ws.faceMesh[f0]], faceOf(f0).mIndices[adj[0] - ws.cornerOfs[f0]]);
+            if (cnt < 3) {
+                ws.points[u] = org;
+                continue;
             }
 
-            // check the other way round for consistency
-#ifdef ASSIMP_BUILD_DEBUG
-
-            for (size_t t = 0; t < ofsadjvec.size() - 1; ++t) {
-                for (unsigned int m = 0; m < cntadjfac[t]; ++m) {
-                    const unsigned int fidx = faceadjac[ofsadjvec[t] + m];
-                    ai_assert(fidx < totfaces);
-                    for (size_t n = 1; n < nmesh; ++n) {
-
-                        if (moffsets[n].first > fidx) {
-                            const aiMesh *msh = smesh[--n];
-                            const aiFace &f = msh->mFaces[fidx - moffsets[n].first];
-
-                            bool haveit = false;
-                            for (unsigned int i = 0; i < f.mNumIndices; ++i) {
-                                if (maptbl[FLATTEN_VERTEX_IDX(n, f.mIndices[i])] == (unsigned int)t) {
-                                    haveit = true;
-                                    break;
-                                }
-                            }
-                            ai_assert(haveit);
-                            if (!haveit) {
-                                ASSIMP_LOG_VERBOSE_DEBUG("Catmull-Clark Subdivider: Index not used");
-                            }
-                            break;
-                        }
-                    }
-                }
+            Vertex F, R;
+            for (unsigned int o = 0; o < cnt; ++o) {
+                const unsigned int c = adj[o];
+                const unsigned int f = ws.cornerFace[c];
+                const unsigned int prev = c == ws.cornerOfs[f] ? ws.cornerOfs[f + 1] - 1 : c - 1;
+
+                F += ws.centroids[f];
+                R += ws.edges[ws.cornerEdge[prev]].midpoint + ws.edges[ws.cornerEdge[c]].midpoint;
             }
 
-#endif
+            const float div = static_cast<float>(cnt), divsq = 1.f / (div * div);
+            ws.points[u] = org * ((div - 3.f) / div) + R * divsq + F * divsq;
         }
+    });
 
-#define GET_ADJACENT_FACES_AND_CNT(vidx, fstartout, numout) \
-    fstartout = &faceadjac[ofsadjvec[vidx]], numout = cntadjfac[vidx]
-
-        typedef std::pair<bool, Vertex> TouchedOVertex;
-        std::vector<TouchedOVertex> new_points(num_unique, TouchedOVertex(false, Vertex()));
-        // ---------------------------------------------------------------------
-        // 5. Spawn a quad from each face point to the corresponding edge points
-        // the original points being the fourth quad points.
-        // ---------------------------------------------------------------------
-        for (size_t t = 0; t < nmesh; ++t) {
-            const aiMesh *const minp = smesh[t];
-            aiMesh *const mout = out[t] = new aiMesh();
+    // ---------------------------------------------------------------------
+    // 6. Spawn a quad from each face point to the corresponding edge points
+    // the original points being the fourth quad points.
+    // ---------------------------------------------------------------------
+    for (size_t t = 0; t < nmesh; ++t) {
+        const aiMesh *const minp = smesh[t];
+        aiMesh *const mout = out[t] = new aiMesh();
 
-            for (unsigned int a = 0; a < minp->mNumFaces; ++a) {
-                mout->mNumFaces += minp->mFaces[a].mNumIndices;
-            }
+        for (unsigned int a = 0; a < minp->mNumFaces; ++a) {
+            mout->mNumFaces += minp->mFaces[a].mNumIndices;
+        }
 
-            // We need random access to the old face buffer, so reuse is not possible.
-            mout->mFaces = new aiFace[mout->mNumFaces];
+        // We need random access to the old face buffer, so reuse is not possible.
+        mout->mFaces = new aiFace[mout->mNumFaces];
 
-            mout->mNumVertices = mout->mNumFaces * 4;
-            mout->mVertices = new aiVector3D[mout->mNumVertices];
+        mout->mNumVertices = mout->mNumFaces * 4;
+        mout->mVertices = new aiVector3D[mout->mNumVertices];
 
-            // quads only, keep material index
-            mout->mPrimitiveTypes = aiPrimitiveType_POLYGON;
-            mout->mMaterialIndex = minp->mMaterialIndex;
+        // quads only, keep material index
+        mout->mPrimitiveTypes = aiPrimitiveType_POLYGON;
+        mout->mMaterialIndex = minp->mMaterialIndex;
 
-            if (minp->HasNormals()) {
-                mout->mNormals = new aiVector3D[mout->mNumVertices];
-            }
+        if (minp->HasNormals()) {
+            mout->mNormals = new aiVector3D[mout->mNumVertices];
+        }
 
-            if (minp->HasTangentsAndBitangents()) {
-                mout->mTangents = new aiVector3D[mout->mNumVertices];
-                mout->mBitangents = new aiVector3D[mout->mNumVertices];
-            }
+        if (minp->HasTangentsAndBitangents()) {
+            mout->mTangents = new aiVector3D[mout->mNumVertices];
+            mout->mBitangents = new aiVector3D[mout->mNumVertices];
+        }
 
-            for (unsigned int i = 0; minp->HasTextureCoords(i); ++i) {
-                mout->mTextureCoords[i] = new aiVector3D[mout->mNumVertices];
-                mout->mNumUVComponents[i] = minp->mNumUVComponents[i];
-            }
+        for (unsigned int i = 0; minp->HasTextureCoords(i); ++i) {
+            mout->mTextureCoords[i] = new aiVector3D[mout->mNumVertices];
+            mout->mNumUVComponents[i] = minp->mNumUVComponents[i];
+        }
 
-            for (unsigned int i = 0; minp->HasVertexColors(i); ++i) {
-                mout->mColors[i] = new aiColor4D[mout->mNumVertices];
-            }
+        for (unsigned int i = 0; minp->HasVertexColors(i); ++i) {
+            mout->mColors[i] = new aiColor4D[mout->mNumVertices];
+        }
+    }
 
-            mout->mNumVertices = mout->mNumFaces << 2u;
-            for (unsigned int i = 0, v = 0, n = 0; i < minp->mNumFaces; ++i) {
-
-                const aiFace &face = minp->mFaces[i];
-                for (unsigned int a = 0; a < face.mNumIndices; ++a) {
-
-                    // Get a clean new face.
-                    aiFace &faceOut = mout->mFaces[n++];
-                    faceOut.mIndices = new unsigned int[faceOut.mNumIndices = 4];
-
-                    // Spawn a new quadrilateral (ccw winding) for this original point between:
-                    // a) face centroid
-                    centroids[FLATTEN_FACE_IDX(t, i)].SortBack(mout, faceOut.mIndices[0] = v++);
-
-                    // b) adjacent edge on the left, seen from the centroid
-                    const Edge &e0 = edges[MAKE_EDGE_HASH(maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[a])],
-                            maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[a == face.mNumIndices - 1 ? 0 : a + 1])])]; // fixme: replace with mod face.mNumIndices?
-
-                    // c) adjacent edge on the right, seen from the centroid
-                    const Edge &e1 = edges[MAKE_EDGE_HASH(maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[a])],
-                            maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[!a ? face.mNumIndices - 1 : a - 1])])]; // fixme: replace with mod face.mNumIndices?
-
-                    e0.edge_point.SortBack(mout, faceOut.mIndices[3] = v++);
-                    e1.edge_point.SortBack(mout, faceOut.mIndices[1] = v++);
-
-                    // d= original point P with distinct index i
-                    // F := 0
-                    // R := 0
-                    // n := 0
-                    // for each face f containing i
-                    //    F := F+ centroid of f
-                    //    R := R+ midpoint of edge of f from i to i+1
-                    //    n := n+1
-                    //
-                    // (F+2R+(n-3)P)/n
-                    const unsigned int org = maptbl[FLATTEN_VERTEX_IDX(t, face.mIndices[a])];
-                    TouchedOVertex &ov = new_points[org];
-
-                    if (!ov.first) {
-                        ov.first = true;
-
-                        const unsigned int *adj;
-                        unsigned int cnt;
-                        GET_ADJACENT_FACES_AND_CNT(org, adj, cnt);
-
-                        if (cnt < 3) {
-                            ov.second = Vertex(minp, face.mIndices[a]);
-                        } else {
-
-                            Vertex F, R;
-                            for (unsigned int o = 0; o < cnt; ++o) {
-                                ai_assert(adj[o] < totfaces);
-                                F += centroids[adj[o]];
-
-                                // adj[0] is a global face index - search the face in the mesh list
-                                const aiMesh *mp = nullptr;
-                                size_t nidx;
-
-                                if (adj[o] < moffsets[0].first) {
-                                    mp = smesh[nidx = 0];
-                                } else {
-                                    for (nidx = 1; nidx <= nmesh; ++nidx) {
-                                        if (nidx == nmesh || moffsets[nidx].first > adj[o]) {
-                                            mp = smesh[--nidx];
-                                            break;
-                                        }
-                                    }
-                                }
-
-                                ai_assert(adj[o] - moffsets[nidx].first < mp->mNumFaces);
-                                const aiFace &f = mp->mFaces[adj[o] - moffsets[nidx].first];
-                                bool haveit = false;
-
-                                // find our original point in the face
-                                for (unsigned int m = 0; m < f.mNumIndices; ++m) {
-                                    if (maptbl[FLATTEN_VERTEX_IDX(nidx, f.mIndices[m])] == org) {
-
-                                        // add *both* edges. this way, we can be sure that we add
-                                        // *all* adjacent edges to R. In a closed shape, every
-                                        // edge is added twice - so we simply leave out the
-                                        // factor 2.f in the amove formula and get the right
-                                        // result.
-
-                                        const Edge &c0 = edges[MAKE_EDGE_HASH(org, maptbl[FLATTEN_VERTEX_IDX(
-                                                                                           nidx, f.mIndices[!m ? f.mNumIndices - 1 : m - 1])])];
-                                        // fixme: replace with mod face.mNumIndices?
-
-                                        const Edge &c1 = edges[MAKE_EDGE_HASH(org, maptbl[FLATTEN_VERTEX_IDX(
-                                                                                           nidx, f.mIndices[m == f.mNumIndices - 1 ? 0 : m + 1])])];
-                                        // fixme: replace with mod face.mNumIndices?
-                                        R += c0.midpoint + c1.midpoint;
-
-                                        haveit = true;
-                                        break;
-                                    }
-                                }
-
-                                // this invariant *must* hold if the vertex-to-face adjacency table is valid
-                                ai_assert(haveit);
-                                if (!haveit) {
-                                    ASSIMP_LOG_WARN("OBJ: no name for material library specified.");
-                                }
-                            }
-
-                            const float div = static_cast<float>(cnt), divsq = 1.f / (div * div);
-                            ov.second = Vertex(minp, face.mIndices[a]) * ((div - 3.f) / div) + R * divsq + F * divsq;
+    // The output vertices are spawned by faces, edges and distinct original
+    // points, which gives the mapping table of the next level for free.
+    if (needMapping) {
+        ws.nextMaptbl.resize(static_cast<size_t>(nfacesout) * 4);
+    }
+    ParallelFor(totfaces, numThreads, MinItemsPerThread,
+            [out, &ws, &faceOf, &uniqueOf, totfaces, numEdges, needMapping](size_t begin, size_t end) {
+                for (size_t n = begin; n < end; ++n) {
+                    const unsigned int f = static_cast<unsigned int>(n);
+                    const unsigned int t = ws.faceMesh[f];
+                    aiMesh *const mout = out[t];
+                    const aiFace &face = faceOf(f);
+                    const unsigned int first = ws.cornerOfs[f];
+                    const unsigned int meshFirst = ws.cornerOfs[ws.moffsets[t].first];
+
+                    for (unsigned int a = 0; a < face.mNumIndices; ++a) {
+                        const unsigned int c = first + a;
+                        const unsigned int prev = a ? c - 1 : first + face.mNumIndices - 1;
+                        const unsigned int v = (c - meshFirst) * 4;
+                        const unsigned int org = uniqueOf(f, face.mIndices[a]);
+
+                        // Get a clean new face.
+                        aiFace &faceOut = mout->mFaces[c - meshFirst];
+                        faceOut.mIndices = new unsigned int[faceOut.mNumIndices = 4];
+
+                        // Spawn a new quadrilateral (ccw winding) for this original point between:
+                        // a) face centroid
+                        ws.centroids[f].SortBack(mout, faceOut.mIndices[0] = v);
+
+                        // b) adjacent edge on the left, seen from the centroid
+                        ws.edges[ws.cornerEdge[c]].edge_point.SortBack(mout, faceOut.mIndices[3] = v + 1);
+
+                        // c) adjacent edge on the right, seen from the centroid
+                        ws.edges[ws.cornerEdge[prev]].edge_point.SortBack(mout, faceOut.mIndices[1] = v + 2);
+
+                        // d) the moved original point
+                        ws.points[org].SortBack(mout, faceOut.mIndices[2] = v + 3);
+
+                        if (needMapping) {
+                            unsigned int *map = &ws.nextMaptbl[static_cast<size_t>(c) * 4];
+                            map[0] = f;
+                            map[1] = totfaces + ws.cornerEdge[c];
+                            map[2] = totfaces + ws.cornerEdge[prev];
+                            map[3] = totfaces + numEdges + org;
                         }
                     }
-                    ov.second.SortBack(mout, faceOut.mIndices[2] = v++);
                 }
-            }
-        }
-    } // end of scope for edges, freeing its memory
+            });
 
-    // ---------------------------------------------------------------------
-    // 7. Apply the next subdivision step.
-    // ---------------------------------------------------------------------
-    if (num != 1) {
-        std::vector<aiMesh *> tmp(nmesh);
-        InternSubdivide(out, nmesh, &tmp.front(), num - 1);
-        for (size_t i = 0; i < nmesh; ++i) {
-            delete out[i];
-            out[i] = tmp[i];
-        }
+    if (needMapping) {
+        ws.maptbl.swap(ws.nextMaptbl);
+        ws.numUnique = totfaces + numEdges + ws.numUnique;
     }
 }
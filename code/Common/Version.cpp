@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Actually just a dummy, used by the compiler to build the pre-compiled header.
 
 #include "ScenePrivate.h"
+#include <assimp/SceneCombiner.h>
 #include <assimp/scene.h>
 #include <assimp/version.h>
 
@@ -145,37 +146,42 @@ ASSIMP_API aiScene::~aiScene() {
     // delete all sub-objects recursively
     delete mRootNode;
 
+    // Components shared with another scene (see SceneCombiner::ShareScene())
+    // belong to that scene, only the pointer arrays are ours.
+    const Assimp::ScenePrivateData *priv = static_cast<Assimp::ScenePrivateData *>(mPrivate);
+    const unsigned int shared = priv ? priv->mSharedComponents : 0;
+
     // To make sure we won't crash if the data is invalid it's
     // much better to check whether both mNumXXX and mXXX are
     // valid instead of relying on just one of them.
-    if (mNumMeshes && mMeshes)
+    if (mNumMeshes && mMeshes && !(shared & Assimp::SceneComponent_Meshes))
         for (unsigned int a = 0; a < mNumMeshes; a++)
             delete mMeshes[a];
     delete[] mMeshes;
 
-    if (mNumMaterials && mMaterials) {
+    if (mNumMaterials && mMaterials && !(shared & Assimp::SceneComponent_Materials)) {
         for (unsigned int a = 0; a < mNumMaterials; ++a) {
             delete mMaterials[a];
         }
     }
     delete[] mMaterials;
 
-    if (mNumAnimations && mAnimations)
+    if (mNumAnimations && mAnimations && !(shared & Assimp::SceneComponent_Animations))
         for (unsigned int a = 0; a < mNumAnimations; a++)
             delete mAnimations[a];
     delete[] mAnimations;
 
-    if (mNumTextures && mTextures)
+    if (mNumTextures && mTextures && !(shared & Assimp::SceneComponent_Textures))
         for (unsigned int a = 0; a < mNumTextures; a++)
             delete mTextures[a];
     delete[] mTextures;
 
-    if (mNumLights && mLights)
+    if (mNumLights && mLights && !(shared & Assimp::SceneComponent_Lights))
         for (unsigned int a = 0; a < mNumLights; a++)
             delete mLights[a];
     delete[] mLights;
 
-    if (mNumCameras && mCameras)
+    if (mNumCameras && mCameras && !(shared & Assimp::SceneComponent_Cameras))
         for (unsigned int a = 0; a < mNumCameras; a++)
             delete mCameras[a];
     delete[] mCameras;
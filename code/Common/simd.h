@@ -50,4 +50,8 @@ namespace Assimp {
 /// @return true, if SSE2 is supported. false if SSE2 is not supported.
 bool ASSIMP_API CPUSupportsSSE2();
 
+/// @brief  Checks if the CPU and the OS support AVX2 and FMA instructions
+/// @return true, if AVX2 and FMA can be used.
+bool ASSIMP_API CPUSupportsAVX2();
+
 } // Namespace Assimp
@@ -48,15 +48,59 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "CalcTangentsProcess.h"
 #include "ProcessHelper.h"
+#include "Common/ParallelFor.h"
 #include <assimp/TinyFormatter.h>
 #include <assimp/qnan.h>
 
+#include <unordered_map>
+
 using namespace Assimp;
 
+namespace {
+
+// ------------------------------------------------------------------------------------------------
+// A triangle of the MikkTSpace triangulation along with its texture space basis
+struct MikkTriangle {
+    unsigned int mVertices[3];
+    aiVector3D mOs, mOt;
+    bool mOrientPreserving;
+    bool mDegenerate;
+};
+
+// ------------------------------------------------------------------------------------------------
+// Vertices are only merged by MikkTSpace if position, normal and uv are identical
+struct MikkWeldKey {
+    ai_real mValues[8];
+
+    bool operator==(const MikkWeldKey &other) const {
+        for (unsigned int i = 0; i < 8; ++i) {
+            if (mValues[i] != other.mValues[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+struct MikkWeldKeyHash {
+    size_t operator()(const MikkWeldKey &key) const {
+        size_t h = 0;
+        for (unsigned int i = 0; i < 8; ++i) {
+            // adding zero turns -0 into +0, they compare equal and must hash equal
+            h = h * 31 + std::hash<ai_real>()(key.mValues[i] + ai_real(0.0));
+        }
+        return h;
+    }
+};
+
+static const unsigned int NoCorner = ~0u;
+
+} // namespace
+
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 CalcTangentsProcess::CalcTangentsProcess() :
-        configMaxAngle(AI_DEG_TO_RAD(45.f)), configSourceUV(0) {
+        configMaxAngle(AI_DEG_TO_RAD(45.f)), configSourceUV(0), configMikkTSpace(false), configNumThreads(-1) {
     // nothing to do here
 }
 
@@ -83,6 +127,8 @@ void CalcTangentsProcess::SetupProperties(const Importer *pImp) {
     configMaxAngle = AI_DEG_TO_RAD(configMaxAngle);
 
     configSourceUV = pImp->GetPropertyInteger(AI_CONFIG_PP_CT_TEXTURE_CHANNEL_INDEX, 0);
+    configMikkTSpace = pImp->GetPropertyBool(AI_CONFIG_PP_CT_MIKKTSPACE, false);
+    configNumThreads = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -93,8 +139,28 @@ void CalcTangentsProcess::Execute(aiScene *pScene) {
     ASSIMP_LOG_DEBUG("CalcTangentsProcess begin");
 
     bool bHas = false;
-    for (unsigned int a = 0; a < pScene->mNumMeshes; a++) {
-        if (ProcessMesh(pScene->mMeshes[a], a)) bHas = true;
+    if (configMikkTSpace) {
+        // validate (and log) up front, the meshes themselves are processed in parallel
+        std::vector<aiMesh *> meshes;
+        for (unsigned int a = 0; a < pScene->mNumMeshes; a++) {
+            if (CheckMesh(pScene->mMeshes[a])) meshes.push_back(pScene->mMeshes[a]);
+        }
+
+        // split the threads between the meshes, big single meshes use them all
+        const unsigned int numThreads = GetNumWorkerThreads(configNumThreads);
+        const unsigned int perMesh = std::max(1u, numThreads / static_cast<unsigned int>(std::max<size_t>(meshes.size(), 1)));
+        ParallelFor(meshes.size(), numThreads, 1, [this, &meshes, perMesh](size_t begin, size_t end) {
+            for (size_t a = begin; a < end; ++a) {
+                checkpoint.CheckCancelled();
+                ProcessMeshMikkTSpace(meshes[a], perMesh);
+            }
+        });
+        bHas = !meshes.empty();
+    } else {
+        for (unsigned int a = 0; a < pScene->mNumMeshes; a++) {
+            checkpoint.Check();
+            if (ProcessMesh(pScene->mMeshes[a], a)) bHas = true;
+        }
     }
 
     if (bHas) {
@@ -105,8 +171,8 @@ void CalcTangentsProcess::Execute(aiScene *pScene) {
 }
 
 // ------------------------------------------------------------------------------------------------
-// Calculates tangents and bi-tangents for the given mesh
-bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshIndex) {
+// Checks whether tangents can and need to be computed for the given mesh
+bool CalcTangentsProcess::CheckMesh(const aiMesh *pMesh) const {
     // we assume that the mesh is still in the verbose vertex format where each face has its own set
     // of vertices and no vertices are shared between faces. Sadly I don't know any quick test to
     // assert() it here.
@@ -132,6 +198,19 @@ bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshIndex) {
         ASSIMP_LOG_ERROR((Formatter::format("Failed to compute tangents; need UV data in channel"), configSourceUV));
         return false;
     }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Calculates tangents and bi-tangents for the given mesh
+bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshIndex) {
+    if (!CheckMesh(pMesh)) {
+        return false;
+    }
+    if (configMikkTSpace) {
+        ProcessMeshMikkTSpace(pMesh, GetNumWorkerThreads(configNumThreads));
+        return true;
+    }
 
     const float angleEpsilon = 0.9999f;
 
@@ -301,3 +380,177 @@ bool CalcTangentsProcess::ProcessMesh(aiMesh *pMesh, unsigned int meshIndex) {
     }
     return true;
 }
+
+// ------------------------------------------------------------------------------------------------
+// Calculates tangents and bi-tangents following the MikkTSpace conventions: quads are split
+// along their shorter diagonal, only vertices with identical position, normal and uv are
+// merged, faces with mirrored uv mapping are never merged with the others, and the
+// contribution of each face is weighted by its corner angle.
+void CalcTangentsProcess::ProcessMeshMikkTSpace(aiMesh *pMesh, unsigned int numThreads) const {
+    const aiVector3D *meshPos = pMesh->mVertices;
+    const aiVector3D *meshNorm = pMesh->mNormals;
+    const aiVector3D *meshTex = pMesh->mTextureCoords[configSourceUV];
+    const unsigned int numVertices = pMesh->mNumVertices;
+    const ai_real qnan = get_qnan();
+
+    pMesh->mTangents = new aiVector3D[numVertices];
+    pMesh->mBitangents = new aiVector3D[numVertices];
+    aiVector3D *meshTang = pMesh->mTangents;
+    aiVector3D *meshBitang = pMesh->mBitangents;
+    std::fill(meshTang, meshTang + numVertices, aiVector3D(qnan));
+    std::fill(meshBitang, meshBitang + numVertices, aiVector3D(qnan));
+
+    // triangulate the faces the way MikkTSpace does
+    std::vector<MikkTriangle> triangles;
+    triangles.reserve(pMesh->mNumFaces);
+    for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+        const aiFace &face = pMesh->mFaces[a];
+        const unsigned int *idx = face.mIndices;
+        MikkTriangle tri = {};
+        if (face.mNumIndices == 3) {
+            std::copy(idx, idx + 3, tri.mVertices);
+            triangles.push_back(tri);
+        } else if (face.mNumIndices == 4) {
+            // split along the shorter diagonal in uv space, fall back to positions
+            const aiVector2D t02(meshTex[idx[2]].x - meshTex[idx[0]].x, meshTex[idx[2]].y - meshTex[idx[0]].y);
+            const aiVector2D t13(meshTex[idx[3]].x - meshTex[idx[1]].x, meshTex[idx[3]].y - meshTex[idx[1]].y);
+            const ai_real uv02 = t02.SquareLength(), uv13 = t13.SquareLength();
+            bool diag02;
+            if (uv02 != uv13) {
+                diag02 = uv02 < uv13;
+            } else {
+                diag02 = (meshPos[idx[2]] - meshPos[idx[0]]).SquareLength() < (meshPos[idx[3]] - meshPos[idx[1]]).SquareLength();
+            }
+            const unsigned int split[2][2][3] = { { { 0, 1, 3 }, { 1, 2, 3 } }, { { 0, 1, 2 }, { 0, 2, 3 } } };
+            for (unsigned int t = 0; t < 2; ++t) {
+                for (unsigned int i = 0; i < 3; ++i) {
+                    tri.mVertices[i] = idx[split[diag02 ? 1 : 0][t][i]];
+                }
+                triangles.push_back(tri);
+            }
+        } else if (face.mNumIndices > 4) {
+            for (unsigned int i = 1; i + 1 < face.mNumIndices; ++i) {
+                tri.mVertices[0] = idx[0];
+                tri.mVertices[1] = idx[i];
+                tri.mVertices[2] = idx[i + 1];
+                triangles.push_back(tri);
+            }
+        }
+    }
+
+    // texture space basis of each triangle, scaled by -1 for mirrored uv mapping
+    ParallelFor(triangles.size(), numThreads, 4096, [&triangles, meshPos, meshTex](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+            MikkTriangle &tri = triangles[t];
+            const unsigned int p0 = tri.mVertices[0], p1 = tri.mVertices[1], p2 = tri.mVertices[2];
+            const aiVector3D d1 = meshPos[p1] - meshPos[p0], d2 = meshPos[p2] - meshPos[p0];
+            const ai_real t21x = meshTex[p1].x - meshTex[p0].x, t21y = meshTex[p1].y - meshTex[p0].y;
+            const ai_real t31x = meshTex[p2].x - meshTex[p0].x, t31y = meshTex[p2].y - meshTex[p0].y;
+            const ai_real signedArea = t21x * t31y - t21y * t31x;
+
+            tri.mOrientPreserving = signedArea > 0;
+            tri.mDegenerate = signedArea == 0;
+            if (!tri.mDegenerate) {
+                const ai_real sign = tri.mOrientPreserving ? ai_real(1.0) : ai_real(-1.0);
+                tri.mOs = (d1 * t31y - d2 * t21y).NormalizeSafe() * sign;
+                tri.mOt = (d2 * t21x - d1 * t31x).NormalizeSafe() * sign;
+            }
+        }
+    });
+
+    // merge identical vertices
+    std::vector<unsigned int> weld(numVertices);
+    {
+        std::unordered_map<MikkWeldKey, unsigned int, MikkWeldKeyHash> welded;
+        welded.reserve(numVertices);
+        for (unsigned int v = 0; v < numVertices; ++v) {
+            const MikkWeldKey key = { { meshPos[v].x, meshPos[v].y, meshPos[v].z,
+                    meshNorm[v].x, meshNorm[v].y, meshNorm[v].z,
+                    meshTex[v].x, meshTex[v].y } };
+            weld[v] = welded.emplace(key, v).first->second;
+        }
+    }
+
+    // Each welded vertex has up to two tangent spaces, one per uv orientation. Triangles
+    // with a degenerate uv mapping join whichever one exists, preferring the preserving one.
+    std::vector<unsigned char> slotUsed(numVertices * size_t(2), 0);
+    for (const MikkTriangle &tri : triangles) {
+        if (!tri.mDegenerate) {
+            for (unsigned int i = 0; i < 3; ++i) {
+                slotUsed[weld[tri.mVertices[i]] * size_t(2) + (tri.mOrientPreserving ? 1 : 0)] = 1;
+            }
+        }
+    }
+    std::vector<unsigned int> cornerSlot(triangles.size() * 3);
+    std::vector<unsigned int> slotStart(numVertices * size_t(2) + 1, 0);
+    std::vector<unsigned int> vertexCorner(numVertices, NoCorner);
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        const MikkTriangle &tri = triangles[t];
+        for (unsigned int i = 0; i < 3; ++i) {
+            const unsigned int v = tri.mVertices[i];
+            bool orient = tri.mOrientPreserving;
+            if (tri.mDegenerate) {
+                orient = slotUsed[weld[v] * size_t(2) + 1] != 0 || slotUsed[weld[v] * size_t(2)] == 0;
+            }
+            const unsigned int slot = weld[v] * 2 + (orient ? 1 : 0);
+            cornerSlot[t * 3 + i] = slot;
+            ++slotStart[slot + 1];
+            if (vertexCorner[v] == NoCorner) {
+                vertexCorner[v] = static_cast<unsigned int>(t * 3 + i);
+            }
+        }
+    }
+
+    // compact list of the corners contributing to each tangent space
+    for (size_t s = 1; s < slotStart.size(); ++s) {
+        slotStart[s] += slotStart[s - 1];
+    }
+    std::vector<unsigned int> slotCorners(cornerSlot.size());
+    {
+        std::vector<unsigned int> cursor(slotStart.begin(), slotStart.end() - 1);
+        for (size_t c = 0; c < cornerSlot.size(); ++c) {
+            slotCorners[cursor[cornerSlot[c]]++] = static_cast<unsigned int>(c);
+        }
+    }
+
+    // angle weighted mean of the projected triangle tangents, one tangent space per thread at a time
+    std::vector<aiVector3D> slotTangent(numVertices * size_t(2));
+    ParallelFor(slotTangent.size(), numThreads, 4096,
+            [&triangles, &slotStart, &slotCorners, &slotTangent, meshPos, meshNorm](size_t begin, size_t end) {
+                for (size_t s = begin; s < end; ++s) {
+                    aiVector3D sum;
+                    for (unsigned int c = slotStart[s]; c < slotStart[s + 1]; ++c) {
+                        const MikkTriangle &tri = triangles[slotCorners[c] / 3];
+                        const unsigned int i = slotCorners[c] % 3;
+                        const unsigned int v = tri.mVertices[i];
+                        const aiVector3D &n = meshNorm[v];
+
+                        aiVector3D os = tri.mOs - n * (n * tri.mOs);
+                        os.NormalizeSafe();
+
+                        aiVector3D e1 = meshPos[tri.mVertices[(i + 2) % 3]] - meshPos[v];
+                        aiVector3D e2 = meshPos[tri.mVertices[(i + 1) % 3]] - meshPos[v];
+                        e1 = e1 - n * (n * e1);
+                        e2 = e2 - n * (n * e2);
+                        const ai_real cosAngle = e1.NormalizeSafe() * e2.NormalizeSafe();
+                        sum += os * std::acos(std::max(ai_real(-1.0), std::min(ai_real(1.0), cosAngle)));
+                    }
+                    slotTangent[s] = sum.NormalizeSafe();
+                }
+            });
+
+    // bitangent = sign * (normal x tangent), the sign encodes the uv orientation
+    ParallelFor(numVertices, numThreads, 4096,
+            [&vertexCorner, &cornerSlot, &slotTangent, meshNorm, meshTang, meshBitang](size_t begin, size_t end) {
+                for (size_t v = begin; v < end; ++v) {
+                    if (vertexCorner[v] == NoCorner) {
+                        // point, line or unreferenced: the tangent is undefined and stays qnan
+                        continue;
+                    }
+                    const unsigned int slot = cornerSlot[vertexCorner[v]];
+                    const ai_real sign = (slot & 1) ? ai_real(1.0) : ai_real(-1.0);
+                    meshTang[v] = slotTangent[slot];
+                    meshBitang[v] = (meshNorm[v] ^ meshTang[v]) * sign;
+                }
+            });
+}
@@ -59,7 +59,7 @@ namespace Assimp
  * because the joining of vertices also considers tangents and bitangents for
  * uniqueness.
  */
-class ASSIMP_API_WINONLY CalcTangentsProcess : public BaseProcess
+class ASSIMP_API CalcTangentsProcess : public BaseProcess
 {
 public:
 
@@ -76,6 +76,12 @@ public:
     */
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    /** The step only modifies the meshes. */
+    unsigned int GetModifiedSceneComponents() const {
+        return SceneComponent_Meshes;
+    }
+
     // -------------------------------------------------------------------
     /** Called prior to ExecuteOnScene().
     * The function is a request to the process to update its configuration
@@ -90,7 +96,17 @@ public:
         configMaxAngle =f;
     }
 
-protected:
+    // setter for configMikkTSpace
+    inline void SetMikkTSpace(bool b)
+    {
+        configMikkTSpace = b;
+    }
+
+    // setter for configNumThreads
+    inline void SetNumThreads(int n)
+    {
+        configNumThreads = n;
+    }
 
     // -------------------------------------------------------------------
     /** Calculates tangents and bitangents for a specific mesh.
@@ -105,11 +121,31 @@ protected:
     */
     void Execute( aiScene* pScene);
 
+protected:
+    // -------------------------------------------------------------------
+    /** Checks whether tangents can and need to be computed for a mesh.
+    * Logs the reason if the mesh is not suitable.
+    * @param pMesh The mesh to check.
+    */
+    bool CheckMesh( const aiMesh* pMesh) const;
+
+    // -------------------------------------------------------------------
+    /** Calculates MikkTSpace compatible tangents and bitangents for a
+    * specific mesh. The mesh must have passed CheckMesh().
+    * @param pMesh The mesh to process.
+    * @param numThreads Number of worker threads to use.
+    */
+    void ProcessMeshMikkTSpace( aiMesh* pMesh, unsigned int numThreads) const;
+
 private:
 
     /** Configuration option: maximum smoothing angle, in radians*/
     float configMaxAngle;
     unsigned int configSourceUV;
+    /** Configuration option: use MikkTSpace conventions */
+    bool configMikkTSpace;
+    /** Configuration option: AI_CONFIG_GLOB_MULTITHREADING */
+    int configNumThreads;
 };
 
 } // end of namespace Assimp
@@ -0,0 +1,345 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Implementation of the post-processing step to resample node
+ *        animation channels and to drop redundant keys.
+ */
+
+#ifndef ASSIMP_BUILD_NO_COMPRESSANIMATIONS_PROCESS
+
+#include "PostProcessing/CompressAnimationsProcess.h"
+#include "PostProcessing/ProcessHelper.h"
+#include "Common/ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace Assimp {
+
+namespace {
+
+// Animations without a time base are played at this rate by most viewers
+const double DefaultTicksPerSecond = 25.0;
+
+// ------------------------------------------------------------------------------------------------
+ai_real KeyDistance(const aiVector3D &a, const aiVector3D &b) {
+    return (a - b).Length();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Angle of the rotation between two unit quaternions, q and -q are the same rotation.
+// Derived from the chord length, acos() of the dot product is too inaccurate for small angles.
+ai_real KeyDistance(const aiQuaternion &a, const aiQuaternion &b) {
+    const ai_real sign = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w < 0 ? ai_real(-1.0) : ai_real(1.0);
+    const ai_real dx = a.x - sign * b.x, dy = a.y - sign * b.y, dz = a.z - sign * b.z, dw = a.w - sign * b.w;
+    const ai_real chord = std::sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
+    return ai_real(4.0) * std::asin(std::min(chord * ai_real(0.5), ai_real(1.0)));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Interpolates between two keys of a track, keys sharing a time form a step
+template <typename KeyType>
+void InterpolateKeys(typename KeyType::elem_type &out, const KeyType &a, const KeyType &b, double time) {
+    const double span = b.mTime - a.mTime;
+    if (span <= 0.0) {
+        out = b.mValue;
+        return;
+    }
+    Interpolator<KeyType> ipl;
+    ipl(out, a, b, static_cast<ai_real>((time - a.mTime) / span));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Evaluates a track at the given time, the ends of the track are held
+template <typename KeyType>
+typename KeyType::elem_type SampleTrack(const KeyType *keys, unsigned int numKeys, double time) {
+    if (time <= keys[0].mTime) {
+        return keys[0].mValue;
+    }
+    if (time >= keys[numKeys - 1].mTime) {
+        return keys[numKeys - 1].mValue;
+    }
+    const KeyType *next = std::upper_bound(keys, keys + numKeys, time,
+            [](double t, const KeyType &key) { return t < key.mTime; });
+    typename KeyType::elem_type out;
+    InterpolateKeys(out, *(next - 1), *next, time);
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename KeyType>
+bool IsSortedByTime(const KeyType *keys, unsigned int numKeys) {
+    for (unsigned int i = 1; i < numKeys; ++i) {
+        if (keys[i].mTime < keys[i - 1].mTime) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Samples a track at a fixed interval, the first and the last key keep their times
+template <typename KeyType>
+std::vector<KeyType> ResampleTrack(const KeyType *keys, unsigned int numKeys, double interval) {
+    const double start = keys[0].mTime, end = keys[numKeys - 1].mTime;
+    std::vector<KeyType> out;
+    out.reserve(static_cast<size_t>((end - start) / interval) + 2);
+    for (size_t i = 0;; ++i) {
+        const double time = start + static_cast<double>(i) * interval;
+        if (time >= end - interval * 1e-3) {
+            break;
+        }
+        out.push_back(KeyType(time, SampleTrack(keys, numKeys, time)));
+    }
+    out.push_back(keys[numKeys - 1]);
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Greedily extends each segment as long as interpolating its end points reproduces
+// all keys in between within maxError.
+template <typename KeyType>
+std::vector<KeyType> ReduceTrack(const std::vector<KeyType> &keys, ai_real maxError) {
+    std::vector<KeyType> out;
+    if (keys.empty()) {
+        return out;
+    }
+
+    // A constant track needs a single key
+    bool constant = true;
+    for (size_t i = 1; i < keys.size() && constant; ++i) {
+        constant = KeyDistance(keys[i].mValue, keys[0].mValue) <= maxError;
+    }
+    if (constant) {
+        out.push_back(keys[0]);
+        return out;
+    }
+
+    out.push_back(keys[0]);
+    size_t anchor = 0;
+    for (size_t end = 2; end < keys.size(); ++end) {
+        typename KeyType::elem_type value;
+        for (size_t k = anchor + 1; k < end; ++k) {
+            InterpolateKeys(value, keys[anchor], keys[end], keys[k].mTime);
+            if (KeyDistance(value, keys[k].mValue) > maxError) {
+                anchor = end - 1;
+                out.push_back(keys[anchor]);
+                break;
+            }
+        }
+    }
+    out.push_back(keys.back());
+    return out;
+}
+
+// ------------------------------------------------------------------------------------------------
+void QuantizeRotations(std::vector<aiQuatKey> &keys, unsigned int bits) {
+    const ai_real scale = static_cast<ai_real>((1u << (bits - 1)) - 1);
+    for (aiQuatKey &key : keys) {
+        aiQuaternion &q = key.mValue;
+        q.Normalize();
+        q.x = std::round(q.x * scale) / scale;
+        q.y = std::round(q.y * scale) / scale;
+        q.z = std::round(q.z * scale) / scale;
+        q.w = std::round(q.w * scale) / scale;
+        q.Normalize();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Returns the largest deviation of the new track from the original keys
+template <typename KeyType>
+ai_real MeasureError(const KeyType *original, unsigned int numOriginal, const std::vector<KeyType> &keys) {
+    ai_real maxError = 0;
+    for (unsigned int i = 0; i < numOriginal; ++i) {
+        const typename KeyType::elem_type value = SampleTrack(keys.data(), static_cast<unsigned int>(keys.size()), original[i].mTime);
+        maxError = std::max(maxError, KeyDistance(value, original[i].mValue));
+    }
+    return maxError;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename KeyType>
+void ReplaceTrack(KeyType *&keys, unsigned int &numKeys, const std::vector<KeyType> &newKeys) {
+    delete[] keys;
+    numKeys = static_cast<unsigned int>(newKeys.size());
+    keys = new KeyType[numKeys];
+    std::copy(newKeys.begin(), newKeys.end(), keys);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Resamples, reduces and optionally quantizes a single track. Returns the error
+// of the new track, tracks which are empty or not sorted by time are left alone.
+template <typename KeyType>
+ai_real CompressTrack(KeyType *&keys, unsigned int &numKeys, double interval, ai_real maxError,
+        unsigned int quantizeBits, void (*quantize)(std::vector<KeyType> &, unsigned int)) {
+    if (!numKeys || !IsSortedByTime(keys, numKeys)) {
+        return 0;
+    }
+
+    std::vector<KeyType> track = interval > 0.0 && numKeys > 1 ?
+            ResampleTrack(keys, numKeys, interval) :
+            std::vector<KeyType>(keys, keys + numKeys);
+    track = ReduceTrack(track, maxError);
+    if (quantizeBits && quantize) {
+        quantize(track, quantizeBits);
+    }
+
+    const ai_real error = MeasureError(keys, numKeys, track);
+    ReplaceTrack(keys, numKeys, track);
+    return error;
+}
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+CompressAnimationsProcess::Statistics::Statistics() :
+        mKeysIn(0),
+        mKeysOut(0),
+        mMaxPositionError(0),
+        mMaxRotationError(0),
+        mMaxScalingError(0) {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+ai_real CompressAnimationsProcess::Statistics::GetRatio() const {
+    return mKeysIn ? static_cast<ai_real>(mKeysOut) / static_cast<ai_real>(mKeysIn) : ai_real(1.0);
+}
+
+// ------------------------------------------------------------------------------------------------
+CompressAnimationsProcess::CompressAnimationsProcess() :
+        BaseProcess(),
+        mResampleRate(0),
+        mPositionError(ai_real(1e-4)),
+        mRotationError(AI_DEG_TO_RAD(ai_real(0.01))),
+        mScalingError(ai_real(1e-4)),
+        mQuantizeBits(0),
+        mNumThreads(-1),
+        mStatistics() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+CompressAnimationsProcess::~CompressAnimationsProcess() {
+    // empty
+}
+
+// ------------------------------------------------------------------------------------------------
+bool CompressAnimationsProcess::IsActive(unsigned int /*pFlags*/) const {
+    return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+void CompressAnimationsProcess::SetupProperties(const Importer *pImp) {
+    mResampleRate = std::max(pImp->GetPropertyFloat(AI_CONFIG_PP_CA_RESAMPLE_RATE, 0.f), ai_real(0.0));
+    SetErrorBounds(pImp->GetPropertyFloat(AI_CONFIG_PP_CA_POSITION_ERROR, 1e-4f),
+            AI_DEG_TO_RAD(pImp->GetPropertyFloat(AI_CONFIG_PP_CA_ROTATION_ERROR, 0.01f)),
+            pImp->GetPropertyFloat(AI_CONFIG_PP_CA_SCALING_ERROR, 1e-4f));
+    const int bits = pImp->GetPropertyInteger(AI_CONFIG_PP_CA_QUANTIZE_ROTATIONS, 0);
+    mQuantizeBits = bits > 0 ? static_cast<unsigned int>(std::min(std::max(bits, 2), 24)) : 0;
+    mNumThreads = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1);
+}
+
+// ------------------------------------------------------------------------------------------------
+void CompressAnimationsProcess::SetErrorBounds(ai_real position, ai_real rotation, ai_real scaling) {
+    mPositionError = std::max(position, ai_real(0.0));
+    mRotationError = std::max(rotation, ai_real(0.0));
+    mScalingError = std::max(scaling, ai_real(0.0));
+}
+
+// ------------------------------------------------------------------------------------------------
+void CompressAnimationsProcess::ProcessChannel(aiNodeAnim *channel, double ticksPerSecond, Statistics &stats) const {
+    const double interval = mResampleRate > 0 ? (ticksPerSecond > 0.0 ? ticksPerSecond : DefaultTicksPerSecond) / mResampleRate : 0.0;
+
+    stats.mKeysIn += channel->mNumPositionKeys + channel->mNumRotationKeys + channel->mNumScalingKeys;
+    stats.mMaxPositionError = std::max(stats.mMaxPositionError,
+            CompressTrack<aiVectorKey>(channel->mPositionKeys, channel->mNumPositionKeys, interval, mPositionError, 0, nullptr));
+    stats.mMaxRotationError = std::max(stats.mMaxRotationError,
+            CompressTrack<aiQuatKey>(channel->mRotationKeys, channel->mNumRotationKeys, interval, mRotationError, mQuantizeBits, &QuantizeRotations));
+    stats.mMaxScalingError = std::max(stats.mMaxScalingError,
+            CompressTrack<aiVectorKey>(channel->mScalingKeys, channel->mNumScalingKeys, interval, mScalingError, 0, nullptr));
+    stats.mKeysOut += channel->mNumPositionKeys + channel->mNumRotationKeys + channel->mNumScalingKeys;
+}
+
+// ------------------------------------------------------------------------------------------------
+void CompressAnimationsProcess::Execute(aiScene *pScene) {
+    ASSIMP_LOG_DEBUG("CompressAnimationsProcess begin");
+    mStatistics = Statistics();
+
+    std::vector<std::pair<aiNodeAnim *, double>> channels;
+    for (unsigned int a = 0; a < pScene->mNumAnimations; ++a) {
+        const aiAnimation *anim = pScene->mAnimations[a];
+        for (unsigned int c = 0; c < anim->mNumChannels; ++c) {
+            channels.push_back(std::make_pair(anim->mChannels[c], anim->mTicksPerSecond));
+        }
+    }
+
+    // Channels are independent of each other
+    std::vector<Statistics> results(channels.size());
+    ParallelFor(channels.size(), GetNumWorkerThreads(mNumThreads), 1, [this, &channels, &results](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            ProcessChannel(channels[i].first, channels[i].second, results[i]);
+        }
+    });
+
+    for (const Statistics &stats : results) {
+        mStatistics.mKeysIn += stats.mKeysIn;
+        mStatistics.mKeysOut += stats.mKeysOut;
+        mStatistics.mMaxPositionError = std::max(mStatistics.mMaxPositionError, stats.mMaxPositionError);
+        mStatistics.mMaxRotationError = std::max(mStatistics.mMaxRotationError, stats.mMaxRotationError);
+        mStatistics.mMaxScalingError = std::max(mStatistics.mMaxScalingError, stats.mMaxScalingError);
+    }
+
+    if (mStatistics.mKeysIn) {
+        ASSIMP_LOG_INFO_F("CompressAnimationsProcess finished. Kept ", mStatistics.mKeysOut, " of ",
+                mStatistics.mKeysIn, " keys (", mStatistics.GetRatio() * 100, "%), max. error: position ",
+                mStatistics.mMaxPositionError, ", rotation ", AI_RAD_TO_DEG(mStatistics.mMaxRotationError),
+                " deg, scaling ", mStatistics.mMaxScalingError);
+    } else {
+        ASSIMP_LOG_DEBUG("CompressAnimationsProcess finished. There are no animation keys");
+    }
+}
+
+} // namespace Assimp
+
+#endif // !! ASSIMP_BUILD_NO_COMPRESSANIMATIONS_PROCESS
@@ -0,0 +1,130 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file Defines a post-processing step to resample node animation
+ *        channels and to drop the keys that interpolation reproduces.
+ */
+
+#pragma once
+
+#ifndef AI_COMPRESSANIMATIONSPROCESS_H_INC
+#define AI_COMPRESSANIMATIONSPROCESS_H_INC
+
+#ifndef ASSIMP_BUILD_NO_COMPRESSANIMATIONS_PROCESS
+
+#include "Common/BaseProcess.h"
+
+#include <assimp/anim.h>
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** Post-processing step to shrink node animation channels.
+ *
+ *  Importers usually emit keys exactly as the file stores them, the FBX
+ *  importer even bakes a key for every time any of the curves of a node
+ *  has one. This step optionally resamples each channel to a fixed rate,
+ *  then removes all keys which linear (positions, scalings) respectively
+ *  spherical linear (rotations) interpolation between the remaining keys
+ *  reproduces within the configured error bounds. Rotation keys can be
+ *  quantized in addition.
+ *
+ *  There is no free aiProcess_XXX flag for this step, it is enabled with
+ *  #AI_CONFIG_PP_CA_ENABLE and executed by the Importer after all other
+ *  steps. */
+class ASSIMP_API CompressAnimationsProcess : public BaseProcess {
+public:
+    /// Key counts and errors of a single Execute() call.
+    struct Statistics {
+        size_t mKeysIn;
+        size_t mKeysOut;
+        ai_real mMaxPositionError;
+        ai_real mMaxRotationError; ///< in radians
+        ai_real mMaxScalingError;
+
+        Statistics();
+        /// Fraction of the input keys which remain, 1 if there were none.
+        ai_real GetRatio() const;
+    };
+
+    /// The class constructor.
+    CompressAnimationsProcess();
+    /// The class destructor.
+    ~CompressAnimationsProcess();
+    /// Always returns false, see #AI_CONFIG_PP_CA_ENABLE.
+    bool IsActive(unsigned int pFlags) const override;
+    /// Reads the resampling rate, error bounds and quantization settings.
+    void SetupProperties(const Importer *pImp) override;
+    /// The execution callback.
+    void Execute(aiScene *pScene) override;
+
+    /// Resampling rate in keys per second, 0 to keep the key times.
+    void SetResampleRate(ai_real rate) { mResampleRate = rate; }
+    /// Error bounds, the rotation error is given in radians.
+    void SetErrorBounds(ai_real position, ai_real rotation, ai_real scaling);
+    /// Bits per quaternion component, 0 to keep full precision.
+    void SetRotationQuantization(unsigned int bits) { mQuantizeBits = bits; }
+
+    /// Returns the statistics of the last Execute() call.
+    const Statistics &GetStatistics() const { return mStatistics; }
+
+    // -------------------------------------------------------------------
+    /** Compresses a single channel.
+     *  @param channel The channel to process.
+     *  @param ticksPerSecond Time base of the owning animation.
+     *  @param stats Receives the key counts and errors of the channel. */
+    void ProcessChannel(aiNodeAnim *channel, double ticksPerSecond, Statistics &stats) const;
+
+private:
+    ai_real mResampleRate;
+    ai_real mPositionError;
+    ai_real mRotationError;
+    ai_real mScalingError;
+    unsigned int mQuantizeBits;
+    int mNumThreads;
+    Statistics mStatistics;
+};
+
+} // Namespace Assimp
+
+#endif // #ifndef ASSIMP_BUILD_NO_COMPRESSANIMATIONS_PROCESS
+
+#endif // AI_COMPRESSANIMATIONSPROCESS_H_INC
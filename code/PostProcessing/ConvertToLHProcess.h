@@ -134,6 +134,12 @@ public:
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    /** The step only modifies the meshes. */
+    unsigned int GetModifiedSceneComponents() const {
+        return SceneComponent_Meshes;
+    }
+
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
 
@@ -159,6 +165,12 @@ public:
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    /** The step modifies the meshes and the texture transforms of the materials. */
+    unsigned int GetModifiedSceneComponents() const {
+        return SceneComponent_Meshes | SceneComponent_Materials;
+    }
+
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
 
@@ -66,6 +66,12 @@ public:
     */
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    /** The step only modifies the meshes. */
+    unsigned int GetModifiedSceneComponents() const {
+        return SceneComponent_Meshes;
+    }
+
     // -------------------------------------------------------------------
     /** Executes the post processing step on the given imported data.
     * At the moment a process is not supposed to fail.
@@ -43,13 +43,16 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "PostProcessing/GenBoundingBoxesProcess.h"
 
+#include <assimp/Importer.hpp>
+#include <assimp/SceneAnalysis.h>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
 namespace Assimp {
 
 GenBoundingBoxesProcess::GenBoundingBoxesProcess()
-: BaseProcess() {
+: BaseProcess()
+, mNumThreads(-1) {
 
 }
 
@@ -61,35 +64,8 @@ bool GenBoundingBoxesProcess::IsActive(unsigned int pFlags) const {
     return 0 != ( pFlags & aiProcess_GenBoundingBoxes );
 }
 
-void checkMesh(aiMesh* mesh, aiVector3D& min, aiVector3D& max) {
-    ai_assert(nullptr != mesh);
-
-    if (0 == mesh->mNumVertices) {
-        return;
-    }
-
-    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-        const aiVector3D &pos = mesh->mVertices[i];
-        if (pos.x < min.x) {
-            min.x = pos.x;
-        }
-        if (pos.y < min.y) {
-            min.y = pos.y;
-        }
-        if (pos.z < min.z) {
-            min.z = pos.z;
-        }
-
-        if (pos.x > max.x) {
-            max.x = pos.x;
-        }
-        if (pos.y > max.y) {
-            max.y = pos.y;
-        }
-        if (pos.z > max.z) {
-            max.z = pos.z;
-        }
-    }
+void GenBoundingBoxesProcess::SetupProperties(const Importer *pImp) {
+    mNumThreads = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1);
 }
 
 void GenBoundingBoxesProcess::Execute(aiScene* pScene) {
@@ -97,16 +73,16 @@ void GenBoundingBoxesProcess::Execute(aiScene* pScene) {
         return;
     }
 
+    // Only the mesh space boxes are needed here, skip the node boxes
+    SceneStatistics stats;
+    AnalyzeScene(pScene, stats, mNumThreads, false);
     for (unsigned int i = 0; i < pScene->mNumMeshes; ++i) {
         aiMesh* mesh = pScene->mMeshes[i];
         if (nullptr == mesh) {
             continue;
         }
 
-        aiVector3D min(999999, 999999, 999999), max(-999999, -999999, -999999);
-        checkMesh(mesh, min, max);
-        mesh->mAABB.mMin = min;
-        mesh->mAABB.mMax = max;
+        mesh->mAABB = stats.mMeshes[i].mAABB;
     }
 }
 
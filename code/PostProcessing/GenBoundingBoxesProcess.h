@@ -65,8 +65,17 @@ public:
     ~GenBoundingBoxesProcess();
     /// Will return true, if aiProcess_GenBoundingBoxes is defined.
     bool IsActive(unsigned int pFlags) const override;
+    /// The step only modifies the meshes.
+    unsigned int GetModifiedSceneComponents() const override {
+        return SceneComponent_Meshes;
+    }
+    /// Reads the number of threads to use.
+    void SetupProperties(const Importer *pImp) override;
     /// The execution callback.
     void Execute(aiScene* pScene) override;
+
+private:
+    int mNumThreads;
 };
 
 } // Namespace Assimp
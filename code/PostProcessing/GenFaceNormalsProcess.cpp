@@ -84,6 +84,7 @@ void GenFaceNormalsProcess::Execute(aiScene *pScene) {
 
     bool bHas = false;
     for (unsigned int a = 0; a < pScene->mNumMeshes; a++) {
+        checkpoint.Check();
         if (this->GenMeshFaceNormals(pScene->mMeshes[a])) {
             bHas = true;
         }
@@ -48,7 +48,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "GenVertexNormalsProcess.h"
 #include "ProcessHelper.h"
+#include "Common/ParallelFor.h"
 #include <assimp/Exceptional.h>
+#include <assimp/SpatialHash.h>
 #include <assimp/qnan.h>
 
 using namespace Assimp;
@@ -56,7 +58,9 @@ using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 GenVertexNormalsProcess::GenVertexNormalsProcess() :
-        configMaxAngle(AI_DEG_TO_RAD(175.f)) {
+        configMaxAngle(AI_DEG_TO_RAD(175.f)),
+        configAngleWeighted(false),
+        configNumThreads(-1) {
     // empty
 }
 
@@ -79,6 +83,8 @@ void GenVertexNormalsProcess::SetupProperties(const Importer *pImp) {
     // Get the current value of the AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE property
     configMaxAngle = pImp->GetPropertyFloat(AI_CONFIG_PP_GSN_MAX_SMOOTHING_ANGLE, (ai_real)175.0);
     configMaxAngle = AI_DEG_TO_RAD(std::max(std::min(configMaxAngle, (ai_real)175.0), (ai_real)0.0));
+    configAngleWeighted = pImp->GetPropertyBool(AI_CONFIG_PP_GSN_ANGLE_WEIGHTED, false);
+    configNumThreads = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -92,6 +98,7 @@ void GenVertexNormalsProcess::Execute(aiScene *pScene) {
 
     bool bHas = false;
     for (unsigned int a = 0; a < pScene->mNumMeshes; ++a) {
+        checkpoint.Check();
         if (GenMeshVertexNormals(pScene->mMeshes[a], a))
             bHas = true;
     }
@@ -109,9 +116,10 @@ void GenVertexNormalsProcess::Execute(aiScene *pScene) {
 // Executes the post processing step on the given imported data.
 bool GenVertexNormalsProcess::GenMeshVertexNormals(aiMesh *pMesh, unsigned int meshIndex) {
     if (nullptr != pMesh->mNormals) {
-        if (force_)
+        if (force_) {
             delete[] pMesh->mNormals;
-        else
+            pMesh->mNormals = nullptr;
+        } else
             return false;
     }
 
@@ -123,108 +131,158 @@ bool GenVertexNormalsProcess::GenMeshVertexNormals(aiMesh *pMesh, unsigned int m
         return false;
     }
 
-    // Allocate the array to hold the output normals
-    const float qnan = std::numeric_limits<ai_real>::quiet_NaN();
-    pMesh->mNormals = new aiVector3D[pMesh->mNumVertices];
+    const unsigned int numThreads = GetNumWorkerThreads(configNumThreads);
+    const ai_real qnan = get_qnan();
 
-    // Compute per-face normals but store them per-vertex
-    for (unsigned int a = 0; a < pMesh->mNumFaces; a++) {
-        const aiFace &face = pMesh->mFaces[a];
-        if (face.mNumIndices < 3) {
-            // either a point or a line -> no normal vector
-            for (unsigned int i = 0; i < face.mNumIndices; ++i) {
-                pMesh->mNormals[face.mIndices[i]] = aiVector3D(qnan);
+    // Compute per-face normals. Points and lines get no normal vector.
+    std::vector<aiVector3D> faceNormals(pMesh->mNumFaces);
+    ParallelFor(pMesh->mNumFaces, numThreads, MinItemsPerThread, [pMesh, &faceNormals, qnan](size_t begin, size_t end) {
+        for (size_t a = begin; a < end; ++a) {
+            const aiFace &face = pMesh->mFaces[a];
+            if (face.mNumIndices < 3) {
+                faceNormals[a] = aiVector3D(qnan);
+                continue;
             }
 
-            continue;
+            const aiVector3D *pV1 = &pMesh->mVertices[face.mIndices[0]];
+            const aiVector3D *pV2 = &pMesh->mVertices[face.mIndices[1]];
+            const aiVector3D *pV3 = &pMesh->mVertices[face.mIndices[face.mNumIndices - 1]];
+            faceNormals[a] = ((*pV2 - *pV1) ^ (*pV3 - *pV1)).NormalizeSafe();
         }
-
-        const aiVector3D *pV1 = &pMesh->mVertices[face.mIndices[0]];
-        const aiVector3D *pV2 = &pMesh->mVertices[face.mIndices[1]];
-        const aiVector3D *pV3 = &pMesh->mVertices[face.mIndices[face.mNumIndices - 1]];
-        const aiVector3D vNor = ((*pV2 - *pV1) ^ (*pV3 - *pV1)).NormalizeSafe();
-
+    });
+
+    // Gather the normals of all faces referencing a vertex. In the usual
+    // verbose format each vertex belongs to a single face; meshes with shared
+    // vertices get the (optionally angle-weighted) mean of their faces.
+    // The per-vertex face lists cover every corner of quads and polygons.
+    std::vector<unsigned int> faceOffsets(pMesh->mNumVertices + 1, 0);
+    for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+        const aiFace &face = pMesh->mFaces[a];
         for (unsigned int i = 0; i < face.mNumIndices; ++i) {
-            pMesh->mNormals[face.mIndices[i]] = vNor;
+            ++faceOffsets[face.mIndices[i] + 1];
+        }
+    }
+    for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
+        faceOffsets[i + 1] += faceOffsets[i];
+    }
+    std::vector<unsigned int> vertexFaces(faceOffsets[pMesh->mNumVertices]);
+    {
+        std::vector<unsigned int> cursor(faceOffsets.begin(), faceOffsets.end() - 1);
+        for (unsigned int a = 0; a < pMesh->mNumFaces; ++a) {
+            const aiFace &face = pMesh->mFaces[a];
+            for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+                vertexFaces[cursor[face.mIndices[i]]++] = a;
+            }
         }
     }
 
-    // Set up a SpatialSort to quickly find all vertices close to a given position
-    // check whether we can reuse the SpatialSort of a previous step.
-    SpatialSort *vertexFinder = nullptr;
-    SpatialSort _vertexFinder;
-    ai_real posEpsilon = ai_real(1e-5);
+    // With angle weighting each vertex also keeps the unnormalized sum of its
+    // face normals scaled by the corner angles. Vertices at the same position
+    // are merged with these sums, so a corner's weight survives the merge.
+    std::vector<aiVector3D> vertexNormals(pMesh->mNumVertices);
+    std::vector<aiVector3D> weightedSums;
+    const bool weightByAngle = configAngleWeighted;
+    if (weightByAngle) {
+        weightedSums.resize(pMesh->mNumVertices);
+    }
+    ParallelFor(pMesh->mNumVertices, numThreads, MinItemsPerThread,
+            [pMesh, &faceOffsets, &vertexFaces, &faceNormals, &vertexNormals, &weightedSums, weightByAngle, qnan](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    const unsigned int vertex = static_cast<unsigned int>(i);
+
+                    aiVector3D sum;
+                    bool valid = false;
+                    for (unsigned int f = faceOffsets[i]; f < faceOffsets[i + 1]; ++f) {
+                        const aiVector3D &n = faceNormals[vertexFaces[f]];
+                        if (is_qnan(n.x)) {
+                            continue;
+                        }
+                        valid = true;
+                        sum += weightByAngle ? n * ComputeCornerAngle(pMesh, pMesh->mFaces[vertexFaces[f]], vertex) : n;
+                    }
+                    if (weightByAngle) {
+                        weightedSums[i] = sum;
+                    }
+                    vertexNormals[i] = valid ? sum.NormalizeSafe() : aiVector3D(qnan);
+                }
+            });
+    const std::vector<aiVector3D> &contributions = weightByAngle ? weightedSums : vertexNormals;
+
+    // Find vertices at the same position with a hash grid. Reuse the epsilon of
+    // a previous step if there is one so all steps agree on what 'same' means.
+    ai_real posEpsilon = 0;
+    bool haveEpsilon = false;
     if (shared) {
         std::vector<std::pair<SpatialSort, ai_real>> *avf;
         shared->GetProperty(AI_SPP_SPATIAL_SORT, avf);
         if (avf) {
-            std::pair<SpatialSort, ai_real> &blubb = avf->operator[](meshIndex);
-            vertexFinder = &blubb.first;
-            posEpsilon = blubb.second;
+            posEpsilon = avf->operator[](meshIndex).second;
+            haveEpsilon = true;
         }
     }
-    if (!vertexFinder) {
-        _vertexFinder.Fill(pMesh->mVertices, pMesh->mNumVertices, sizeof(aiVector3D));
-        vertexFinder = &_vertexFinder;
+    if (!haveEpsilon) {
         posEpsilon = ComputePositionEpsilon(pMesh);
     }
-    std::vector<unsigned int> verticesFound;
-    aiVector3D *pcNew = new aiVector3D[pMesh->mNumVertices];
+    const SpatialHash vertexFinder(pMesh->mVertices, pMesh->mNumVertices, sizeof(aiVector3D), posEpsilon);
 
+    aiVector3D *pcNew = new aiVector3D[pMesh->mNumVertices];
     if (configMaxAngle >= AI_DEG_TO_RAD(175.f)) {
         // There is no angle limit. Thus all vertices with positions close
-        // to each other will receive the same vertex normal. This allows us
-        // to optimize the whole algorithm a little bit ...
-        std::vector<bool> abHad(pMesh->mNumVertices, false);
-        for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
-            if (abHad[i]) {
-                continue;
-            }
-
-            // Get all vertices that share this one ...
-            vertexFinder->FindPositions(pMesh->mVertices[i], posEpsilon, verticesFound);
-
-            aiVector3D pcNor;
-            for (unsigned int a = 0; a < verticesFound.size(); ++a) {
-                const aiVector3D &v = pMesh->mNormals[verticesFound[a]];
-                if (is_not_qnan(v.x)) pcNor += v;
-            }
-            pcNor.NormalizeSafe();
-
-            // Write the smoothed normal back to all affected normals
-            for (unsigned int a = 0; a < verticesFound.size(); ++a) {
-                unsigned int vidx = verticesFound[a];
-                pcNew[vidx] = pcNor;
-                abHad[vidx] = true;
-            }
-        }
+        // to each other will receive the same vertex normal.
+        ParallelFor(pMesh->mNumVertices, numThreads, MinItemsPerThread,
+                [pMesh, &vertexFinder, &vertexNormals, &contributions, pcNew](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        aiVector3D pcNor;
+                        vertexFinder.ForEachPosition(pMesh->mVertices[i], [&pcNor, &vertexNormals, &contributions](unsigned int idx) {
+                            const aiVector3D &v = vertexNormals[idx];
+                            if (is_not_qnan(v.x)) pcNor += contributions[idx];
+                        });
+                        pcNew[i] = pcNor.NormalizeSafe();
+                    }
+                });
     }
     // Slower code path if a smooth angle is set. There are many ways to achieve
     // the effect, this one is the most straightforward one.
     else {
         const ai_real fLimit = std::cos(configMaxAngle);
-        for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
-            // Get all vertices that share this one ...
-            vertexFinder->FindPositions(pMesh->mVertices[i], posEpsilon, verticesFound);
-
-            aiVector3D vr = pMesh->mNormals[i];
-
-            aiVector3D pcNor;
-            for (unsigned int a = 0; a < verticesFound.size(); ++a) {
-                aiVector3D v = pMesh->mNormals[verticesFound[a]];
-
-                // Check whether the angle between the two normals is not too large.
-                // Skip the angle check on our own normal to avoid false negatives
-                // (v*v is not guaranteed to be 1.0 for all unit vectors v)
-                if (is_not_qnan(v.x) && (verticesFound[a] == i || (v * vr >= fLimit)))
-                    pcNor += v;
-            }
-            pcNew[i] = pcNor.NormalizeSafe();
-        }
+        ParallelFor(pMesh->mNumVertices, numThreads, MinItemsPerThread,
+                [pMesh, &vertexFinder, &vertexNormals, &contributions, pcNew, fLimit](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i) {
+                        const aiVector3D &vr = vertexNormals[i];
+
+                        aiVector3D pcNor;
+                        vertexFinder.ForEachPosition(pMesh->mVertices[i], [&](unsigned int idx) {
+                            const aiVector3D &v = vertexNormals[idx];
+
+                            // Check whether the angle between the two normals is not too large.
+                            // Skip the angle check on our own normal to avoid false negatives
+                            // (v*v is not guaranteed to be 1.0 for all unit vectors v)
+                            if (is_not_qnan(v.x) && (idx == i || (v * vr >= fLimit)))
+                                pcNor += contributions[idx];
+                        });
+                        pcNew[i] = pcNor.NormalizeSafe();
+                    }
+                });
     }
 
-    delete[] pMesh->mNormals;
     pMesh->mNormals = pcNew;
 
     return true;
 }
+
+// ------------------------------------------------------------------------------------------------
+// Returns the interior angle of a face at one of its vertices.
+ai_real GenVertexNormalsProcess::ComputeCornerAngle(const aiMesh *pMesh, const aiFace &face, unsigned int vertex) {
+    for (unsigned int i = 0; i < face.mNumIndices; ++i) {
+        if (face.mIndices[i] != vertex) {
+            continue;
+        }
+
+        const aiVector3D &center = pMesh->mVertices[vertex];
+        aiVector3D a = pMesh->mVertices[face.mIndices[(i + 1) % face.mNumIndices]] - center;
+        aiVector3D b = pMesh->mVertices[face.mIndices[(i + face.mNumIndices - 1) % face.mNumIndices]] - center;
+        const ai_real d = a.NormalizeSafe() * b.NormalizeSafe();
+        return std::acos(std::max(ai_real(-1.0), std::min(ai_real(1.0), d)));
+    }
+    return ai_real(0.0);
+}
@@ -72,6 +72,12 @@ public:
     */
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    /** The step only modifies the meshes. */
+    unsigned int GetModifiedSceneComponents() const {
+        return SceneComponent_Meshes;
+    }
+
     // -------------------------------------------------------------------
     /** Called prior to ExecuteOnScene().
     * The function is a request to the process to update its configuration
@@ -92,6 +98,16 @@ public:
         configMaxAngle =f;
     }
 
+    // setter for configAngleWeighted
+    inline void SetAngleWeighted(bool b) {
+        configAngleWeighted = b;
+    }
+
+    // setter for configNumThreads
+    inline void SetNumThreads(int n) {
+        configNumThreads = n;
+    }
+
     // -------------------------------------------------------------------
     /** Computes normals for a specific mesh
     *  @param pcMesh Mesh
@@ -101,8 +117,18 @@ public:
     bool GenMeshVertexNormals (aiMesh* pcMesh, unsigned int meshIndex);
 
 private:
+    /** Interior angle of a face at one of its vertices, in radians */
+    static ai_real ComputeCornerAngle(const aiMesh *pMesh, const aiFace &face, unsigned int vertex);
+
+    /** Meshes smaller than this are not worth a worker thread */
+    static const size_t MinItemsPerThread = 16384;
+
     /** Configuration option: maximum smoothing angle, in radians*/
     ai_real configMaxAngle;
+    /** Configuration option: weight face normals by their corner angle */
+    bool configAngleWeighted;
+    /** Configuration option: AI_CONFIG_GLOB_MULTITHREADING */
+    int configNumThreads;
     mutable bool force_ = false;
 };
 
@@ -100,6 +100,7 @@ void ImproveCacheLocalityProcess::Execute( aiScene* pScene) {
     float out = 0.f;
     unsigned int numf = 0, numm = 0;
     for( unsigned int a = 0; a < pScene->mNumMeshes; ++a ){
+        checkpoint.Check();
         const float res = ProcessMesh( pScene->mMeshes[a],a);
         if (res) {
             numf += pScene->mMeshes[a]->mNumFaces;
@@ -92,8 +92,10 @@ void JoinVerticesProcess::Execute( aiScene* pScene)
 
     // execute the step
     int iNumVertices = 0;
-    for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
+    for( unsigned int a = 0; a < pScene->mNumMeshes; a++) {
+        checkpoint.Check();
         iNumVertices += ProcessMesh( pScene->mMeshes[a],a);
+    }
 
     // if logging is active, print detailed statistics
     if (!DefaultLogger::isNullLogger()) {
@@ -81,6 +81,7 @@ void LimitBoneWeightsProcess::Execute( aiScene* pScene)
     ASSIMP_LOG_DEBUG("LimitBoneWeightsProcess begin");
 
     for (unsigned int m = 0; m < pScene->mNumMeshes; ++m) {
+        checkpoint.Check();
         ProcessMesh(pScene->mMeshes[m]);
     }
 
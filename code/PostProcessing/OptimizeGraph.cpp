@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "OptimizeGraph.h"
 #include "ProcessHelper.h"
 #include "ConvertToLHProcess.h"
+#include "Common/BatchMath.h"
 #include <assimp/Exceptional.h>
 #include <assimp/SceneCombiner.h>
 #include <stdio.h>
@@ -201,17 +202,14 @@ void OptimizeGraphProcess::CollectNewChildren(aiNode *nd, std::list<aiNode *> &n
 
                         // Update positions, normals and tangents
 						const aiMatrix3x3 IT = aiMatrix3x3(join_node->mTransformation).Inverse().Transpose();
-						for (unsigned int a = 0; a < mesh->mNumVertices; ++a) {
+						BatchMath::TransformPositions(mesh->mVertices, mesh->mVertices, mesh->mNumVertices, join_node->mTransformation);
 
-							mesh->mVertices[a] *= join_node->mTransformation;
+						if (mesh->HasNormals())
+							BatchMath::TransformDirections(mesh->mNormals, mesh->mNormals, mesh->mNumVertices, IT, false);
 
-							if (mesh->HasNormals())
-								mesh->mNormals[a] *= IT;
-
-							if (mesh->HasTangentsAndBitangents()) {
-								mesh->mTangents[a] *= IT;
-								mesh->mBitangents[a] *= IT;
-							}
+						if (mesh->HasTangentsAndBitangents()) {
+							BatchMath::TransformDirections(mesh->mTangents, mesh->mTangents, mesh->mNumVertices, IT, false);
+							BatchMath::TransformDirections(mesh->mBitangents, mesh->mBitangents, mesh->mNumVertices, IT, false);
 						}
 					}
 					delete join_node; // bye, node
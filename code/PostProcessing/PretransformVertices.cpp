@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PretransformVertices.h"
 #include "ConvertToLHProcess.h"
 #include "ProcessHelper.h"
+#include "Common/BatchMath.h"
 #include <assimp/Exceptional.h>
 #include <assimp/SceneCombiner.h>
 
@@ -182,9 +183,8 @@ void PretransformVertices::CollectData(const aiScene *pcScene, const aiNode *pcN
 				}
 			} else {
 				// copy positions, transform them to worldspace
-				for (unsigned int n = 0; n < pcMesh->mNumVertices; ++n) {
-					pcMeshOut->mVertices[aiCurrent[AI_PTVS_VERTEX] + n] = pcNode->mTransformation * pcMesh->mVertices[n];
-				}
+				BatchMath::TransformPositions(pcMeshOut->mVertices + aiCurrent[AI_PTVS_VERTEX],
+						pcMesh->mVertices, pcMesh->mNumVertices, pcNode->mTransformation);
 				aiMatrix4x4 mWorldIT = pcNode->mTransformation;
 				mWorldIT.Inverse().Transpose();
 
@@ -193,17 +193,15 @@ void PretransformVertices::CollectData(const aiScene *pcScene, const aiNode *pcN
 
 				if (iVFormat & 0x2) {
 					// copy normals, transform them to worldspace
-					for (unsigned int n = 0; n < pcMesh->mNumVertices; ++n) {
-						pcMeshOut->mNormals[aiCurrent[AI_PTVS_VERTEX] + n] =
-								(m * pcMesh->mNormals[n]).Normalize();
-					}
+					BatchMath::TransformDirections(pcMeshOut->mNormals + aiCurrent[AI_PTVS_VERTEX],
+							pcMesh->mNormals, pcMesh->mNumVertices, m, true);
 				}
 				if (iVFormat & 0x4) {
 					// copy tangents and bitangents, transform them to worldspace
-					for (unsigned int n = 0; n < pcMesh->mNumVertices; ++n) {
-						pcMeshOut->mTangents[aiCurrent[AI_PTVS_VERTEX] + n] = (m * pcMesh->mTangents[n]).Normalize();
-						pcMeshOut->mBitangents[aiCurrent[AI_PTVS_VERTEX] + n] = (m * pcMesh->mBitangents[n]).Normalize();
-					}
+					BatchMath::TransformDirections(pcMeshOut->mTangents + aiCurrent[AI_PTVS_VERTEX],
+							pcMesh->mTangents, pcMesh->mNumVertices, m, true);
+					BatchMath::TransformDirections(pcMeshOut->mBitangents + aiCurrent[AI_PTVS_VERTEX],
+							pcMesh->mBitangents, pcMesh->mNumVertices, m, true);
 				}
 			}
 			unsigned int p = 0;
@@ -298,8 +296,27 @@ void PretransformVertices::ComputeAbsoluteTransform(aiNode *pcNode) {
 		pcNode->mTransformation = pcNode->mParent->mTransformation * pcNode->mTransformation;
 	}
 
-	for (unsigned int i = 0; i < pcNode->mNumChildren; ++i) {
-		ComputeAbsoluteTransform(pcNode->mChildren[i]);
+	// Walk the hierarchy level by level, so the matrices of a whole level
+	// are multiplied in one batch and deep hierarchies don't recurse
+	std::vector<aiNode *> level(pcNode->mChildren, pcNode->mChildren + pcNode->mNumChildren), next;
+	std::vector<aiMatrix4x4> parents, locals;
+	while (!level.empty()) {
+		parents.resize(level.size());
+		locals.resize(level.size());
+		for (size_t i = 0; i < level.size(); ++i) {
+			// Nodes without parent link keep their local transformation
+			parents[i] = level[i]->mParent ? level[i]->mParent->mTransformation : aiMatrix4x4();
+			locals[i] = level[i]->mTransformation;
+		}
+		BatchMath::MultiplyMatrices(locals.data(), parents.data(), locals.data(), locals.size());
+
+		next.clear();
+		for (size_t i = 0; i < level.size(); ++i) {
+			aiNode *nd = level[i];
+			nd->mTransformation = locals[i];
+			next.insert(next.end(), nd->mChildren, nd->mChildren + nd->mNumChildren);
+		}
+		level.swap(next);
 	}
 }
 
@@ -317,9 +334,7 @@ void PretransformVertices::ApplyTransform(aiMesh *mesh, const aiMatrix4x4 &mat)
 
 		// Update positions
 		if (mesh->HasPositions()) {
-			for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-				mesh->mVertices[i] = mat * mesh->mVertices[i];
-			}
+			BatchMath::TransformPositions(mesh->mVertices, mesh->mVertices, mesh->mNumVertices, mat);
 		}
 
 		// Update normals and tangents
@@ -327,15 +342,11 @@ void PretransformVertices::ApplyTransform(aiMesh *mesh, const aiMatrix4x4 &mat)
 			const aiMatrix3x3 m = aiMatrix3x3(mat).Inverse().Transpose();
 
 			if (mesh->HasNormals()) {
-				for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-					mesh->mNormals[i] = (m * mesh->mNormals[i]).Normalize();
-				}
+				BatchMath::TransformDirections(mesh->mNormals, mesh->mNormals, mesh->mNumVertices, m, true);
 			}
 			if (mesh->HasTangentsAndBitangents()) {
-				for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
-					mesh->mTangents[i] = (m * mesh->mTangents[i]).Normalize();
-					mesh->mBitangents[i] = (m * mesh->mBitangents[i]).Normalize();
-				}
+				BatchMath::TransformDirections(mesh->mTangents, mesh->mTangents, mesh->mNumVertices, m, true);
+				BatchMath::TransformDirections(mesh->mBitangents, mesh->mBitangents, mesh->mNumVertices, m, true);
 			}
 		}
 	}
@@ -497,12 +508,17 @@ void PretransformVertices::Execute(aiScene *pScene) {
 				unsigned int iVertices = 0;
 				unsigned int iFaces = 0;
 				CountVerticesAndFaces(pScene, pScene->mRootNode, i, *j, &iFaces, &iVertices);
-				if (0 != iFaces && 0 != iVertices) {
+				if (0 != iVertices) {
 					apcOutMeshes.push_back(new aiMesh());
 					aiMesh *pcMesh = apcOutMeshes.back();
 					pcMesh->mNumFaces = iFaces;
 					pcMesh->mNumVertices = iVertices;
-					pcMesh->mFaces = new aiFace[iFaces];
+					if (0 != iFaces) {
+						pcMesh->mFaces = new aiFace[iFaces];
+					} else {
+						// point clouds merge into a point cloud again
+						pcMesh->mPrimitiveTypes = aiPrimitiveType_POINT;
+					}
 					pcMesh->mVertices = new aiVector3D[iVertices];
 					pcMesh->mMaterialIndex = i;
 					if ((*j) & 0x2) pcMesh->mNormals = new aiVector3D[iVertices];
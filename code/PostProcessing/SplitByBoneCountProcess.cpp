@@ -46,13 +46,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // internal headers of the post-processing framework
 #include "SplitByBoneCountProcess.h"
+#include "Common/ParallelFor.h"
 #include <assimp/postprocess.h>
 #include <assimp/DefaultLogger.hpp>
 
+#include <algorithm>
 #include <limits>
 #include <assimp/TinyFormatter.h>
 #include <assimp/Exceptional.h>
-#include <set>
+#include <unordered_map>
 
 using namespace Assimp;
 using namespace Assimp::Formatter;
@@ -63,6 +65,7 @@ SplitByBoneCountProcess::SplitByBoneCountProcess()
 {
     // set default, might be overridden by importer config
     mMaxBoneCount = AI_SBBC_DEFAULT_MAX_BONES;
+    mNumThreads = -1;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -84,6 +87,7 @@ bool SplitByBoneCountProcess::IsActive( unsigned int pFlags) const
 void SplitByBoneCountProcess::SetupProperties(const Importer* pImp)
 {
     mMaxBoneCount = pImp->GetPropertyInteger(AI_CONFIG_PP_SBBC_MAX_BONES,AI_SBBC_DEFAULT_MAX_BONES);
+    mNumThreads = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -107,28 +111,60 @@ void SplitByBoneCountProcess::Execute( aiScene* pScene)
         return;
     }
 
-    // we need to do something. Let's go.
+    // we need to do something. Let's go. Meshes are partitioned independently of each other,
+    // then all submeshes of all meshes are created.
+    const unsigned int numThreads = GetNumWorkerThreads( mNumThreads);
+    std::vector<Partition> partitions( pScene->mNumMeshes);
+    ParallelFor( pScene->mNumMeshes, numThreads, 1, [this, pScene, &partitions]( size_t begin, size_t end)
+    {
+        for( size_t a = begin; a < end; ++a)
+        {
+            checkpoint.CheckCancelled();
+            if( pScene->mMeshes[a]->mNumBones > mMaxBoneCount )
+            {
+                PartitionMesh( pScene->mMeshes[a], partitions[a]);
+            }
+        }
+    });
+
+    std::vector<std::pair<unsigned int, unsigned int> > jobs;
+    for( unsigned int a = 0; a < pScene->mNumMeshes; ++a)
+    {
+        for( unsigned int b = 0; b < partitions[a].GetNumSubMeshes(); ++b)
+        {
+            jobs.push_back( std::make_pair( a, b));
+        }
+    }
+    std::vector<aiMesh*> subMeshes( jobs.size(), nullptr);
+    ParallelFor( jobs.size(), numThreads, 1, [this, pScene, &partitions, &jobs, &subMeshes]( size_t begin, size_t end)
+    {
+        for( size_t j = begin; j < end; ++j)
+        {
+            const unsigned int a = jobs[j].first;
+            subMeshes[j] = CreateSubMesh( pScene->mMeshes[a], partitions[a], jobs[j].second);
+        }
+    });
+
     mSubMeshIndices.clear();
     mSubMeshIndices.resize( pScene->mNumMeshes);
 
     // build a new array of meshes for the scene
     std::vector<aiMesh*> meshes;
+    std::vector<aiMesh*>::const_iterator nextSubMesh = subMeshes.begin();
 
     for( unsigned int a = 0; a < pScene->mNumMeshes; ++a)
     {
         aiMesh* srcMesh = pScene->mMeshes[a];
-
-        std::vector<aiMesh*> newMeshes;
-        SplitMesh( pScene->mMeshes[a], newMeshes);
+        const unsigned int numSubMeshes = partitions[a].GetNumSubMeshes();
 
         // mesh was split
-        if( !newMeshes.empty() )
+        if( numSubMeshes > 0 )
         {
             // store new meshes and indices of the new meshes
-            for( unsigned int b = 0; b < newMeshes.size(); ++b)
+            for( unsigned int b = 0; b < numSubMeshes; ++b)
             {
                 mSubMeshIndices[a].push_back( static_cast<unsigned int>(meshes.size()));
-                meshes.push_back( newMeshes[b]);
+                meshes.push_back( *nextSubMesh++);
             }
 
             // and destroy the source mesh. It should be completely contained inside the new submeshes
@@ -155,300 +191,499 @@ void SplitByBoneCountProcess::Execute( aiScene* pScene)
 }
 
 // ------------------------------------------------------------------------------------------------
-// Splits the given mesh by bone count.
-void SplitByBoneCountProcess::SplitMesh( const aiMesh* pMesh, std::vector<aiMesh*>& poNewMeshes) const
+// Prefix sum turning per-item counts stored at ofs[i+1] into CSR offsets.
+static void MakeOffsets( std::vector<unsigned int>& ofs)
 {
-    // skip if not necessary
-    if( pMesh->mNumBones <= mMaxBoneCount )
+    for( size_t a = 1; a < ofs.size(); ++a)
     {
-        return;
+        ofs[a] += ofs[a - 1];
     }
+}
 
-    // necessary optimisation: build a list of all affecting bones for each vertex
-    // TODO: (thom) maybe add a custom allocator here to avoid allocating tens of thousands of small arrays
-    typedef std::pair<unsigned int, float> BoneWeight;
-    std::vector< std::vector<BoneWeight> > vertexBones( pMesh->mNumVertices);
-    for( unsigned int a = 0; a < pMesh->mNumBones; ++a)
+// ------------------------------------------------------------------------------------------------
+// Distributes the faces of the given mesh to submeshes.
+//
+// Faces with the same set of bones (palette) are grouped first, skinned meshes usually have
+// far fewer distinct palettes than faces. Grouping palettes into submeshes is a bin packing
+// problem on sets. Each submesh is seeded with the largest palette left, then the palette
+// adding the fewest new bones is added until none fits anymore. The number of new bones of
+// each palette is updated incrementally through a bone to palette index whenever a bone is
+// added to the submesh, only palettes sharing bones with the submesh need to be looked at.
+void SplitByBoneCountProcess::PartitionMesh( const aiMesh* pMesh, Partition& poPartition) const
+{
+    const unsigned int numVertices = pMesh->mNumVertices;
+    const unsigned int numBones = pMesh->mNumBones;
+    const unsigned int unassigned = std::numeric_limits<unsigned int>::max();
+
+    // build a list of all affecting bones for each vertex, ordered by bone index
+    std::vector<unsigned int>& weightOfs = poPartition.mWeightOfs;
+    weightOfs.assign( numVertices + 1, 0);
+    for( unsigned int a = 0; a < numBones; ++a)
     {
         const aiBone* bone = pMesh->mBones[a];
         for( unsigned int b = 0; b < bone->mNumWeights; ++b)
         {
-          if (bone->mWeights[b].mWeight > 0.0f)
-          {
-            int vertexId = bone->mWeights[b].mVertexId;
-            vertexBones[vertexId].push_back( BoneWeight( a, bone->mWeights[b].mWeight));
-            if (vertexBones[vertexId].size() > mMaxBoneCount)
+            if( bone->mWeights[b].mWeight > 0.0f )
             {
-              throw DeadlyImportError("SplitByBoneCountProcess: Single face requires more bones than specified max bone count!");
+                ++weightOfs[bone->mWeights[b].mVertexId + 1];
             }
-          }
         }
     }
+    for( unsigned int a = 0; a < numVertices; ++a)
+    {
+        if( weightOfs[a + 1] > mMaxBoneCount )
+        {
+            throw DeadlyImportError("SplitByBoneCountProcess: Single face requires more bones than specified max bone count!");
+        }
+    }
+    MakeOffsets( weightOfs);
 
-    unsigned int numFacesHandled = 0;
-    std::vector<bool> isFaceHandled( pMesh->mNumFaces, false);
-    while( numFacesHandled < pMesh->mNumFaces )
-    {
-        // which bones are used in the current submesh
-        unsigned int numBones = 0;
-        std::vector<bool> isBoneUsed( pMesh->mNumBones, false);
-        // indices of the faces which are going to go into this submesh
-        std::vector<unsigned int> subMeshFaces;
-        subMeshFaces.reserve( pMesh->mNumFaces);
-        // accumulated vertex count of all the faces in this submesh
-        unsigned int numSubMeshVertices = 0;
-
-        // add faces to the new submesh as long as all bones affecting the faces' vertices fit in the limit
-        for( unsigned int a = 0; a < pMesh->mNumFaces; ++a)
+    poPartition.mWeightBones.resize( weightOfs[numVertices]);
+    poPartition.mWeightValues.resize( weightOfs[numVertices]);
+    {
+        std::vector<unsigned int> cursor( weightOfs.begin(), weightOfs.end() - 1);
+        for( unsigned int a = 0; a < numBones; ++a)
         {
-            // skip if the face is already stored in a submesh
-            if( isFaceHandled[a] )
-            {
-                continue;
-            }
-            // a small local set of new bones for the current face. State of all used bones for that face
-            // can only be updated AFTER the face is completely analysed. Thanks to imre for the fix.
-            std::set<unsigned int> newBonesAtCurrentFace;
-          
-            const aiFace& face = pMesh->mFaces[a];
-            // check every vertex if its bones would still fit into the current submesh
-            for( unsigned int b = 0; b < face.mNumIndices; ++b )
+            const aiBone* bone = pMesh->mBones[a];
+            for( unsigned int b = 0; b < bone->mNumWeights; ++b)
             {
-              const std::vector<BoneWeight>& vb = vertexBones[face.mIndices[b]];
-              for( unsigned int c = 0; c < vb.size(); ++c)
-              {
-                unsigned int boneIndex = vb[c].first;
-                if( !isBoneUsed[boneIndex] )
+                if( bone->mWeights[b].mWeight > 0.0f )
                 {
-                  newBonesAtCurrentFace.insert(boneIndex);
-                }   
-              }
-            }
-
-            // leave out the face if the new bones required for this face don't fit the bone count limit anymore
-            if( numBones + newBonesAtCurrentFace.size() > mMaxBoneCount )
-            {
-                continue;
-            }
-
-            // mark all new bones as necessary
-            for (std::set<unsigned int>::iterator it = newBonesAtCurrentFace.begin(); it != newBonesAtCurrentFace.end(); ++it)
-            {
-              if (!isBoneUsed[*it])
-              {
-                isBoneUsed[*it] = true;
-                numBones++;
-              }
+                    const unsigned int entry = cursor[bone->mWeights[b].mVertexId]++;
+                    poPartition.mWeightBones[entry] = a;
+                    poPartition.mWeightValues[entry] = bone->mWeights[b].mWeight;
+                }
             }
-
-            // store the face index and the vertex count
-            subMeshFaces.push_back( a);
-            numSubMeshVertices += face.mNumIndices;
-
-            // remember that this face is handled
-            isFaceHandled[a] = true;
-            numFacesHandled++;
         }
+    }
 
-        // create a new mesh to hold this subset of the source mesh
-        aiMesh* newMesh = new aiMesh;
-        if( pMesh->mName.length > 0 )
+    // group the faces by their palette, identical palettes are found by their hash
+    std::vector<unsigned int> paletteOfs( 1, 0), paletteBones, paletteFaces, nextInBucket;
+    std::vector<unsigned int> faceGroup( pMesh->mNumFaces);
+    std::unordered_map<uint64_t, unsigned int> buckets;
+    std::vector<unsigned int> faceBones;
+    for( unsigned int a = 0; a < pMesh->mNumFaces; ++a)
+    {
+        const aiFace& face = pMesh->mFaces[a];
+        faceBones.clear();
+        for( unsigned int b = 0; b < face.mNumIndices; ++b)
         {
-            newMesh->mName.Set( format() << pMesh->mName.data << "_sub" << poNewMeshes.size());
+            const unsigned int v = face.mIndices[b];
+            faceBones.insert( faceBones.end(), poPartition.mWeightBones.begin() + weightOfs[v],
+                    poPartition.mWeightBones.begin() + weightOfs[v + 1]);
         }
-        newMesh->mMaterialIndex = pMesh->mMaterialIndex;
-        newMesh->mPrimitiveTypes = pMesh->mPrimitiveTypes;
-        poNewMeshes.push_back( newMesh);
-
-        // create all the arrays for this mesh if the old mesh contained them
-        newMesh->mNumVertices = numSubMeshVertices;
-        newMesh->mNumFaces = static_cast<unsigned int>(subMeshFaces.size());
-        newMesh->mVertices = new aiVector3D[newMesh->mNumVertices];
-        if( pMesh->HasNormals() )
+        std::sort( faceBones.begin(), faceBones.end());
+        faceBones.erase( std::unique( faceBones.begin(), faceBones.end()), faceBones.end());
+        if( faceBones.size() > mMaxBoneCount )
         {
-            newMesh->mNormals = new aiVector3D[newMesh->mNumVertices];
+            throw DeadlyImportError("SplitByBoneCountProcess: Single face requires more bones than specified max bone count!");
         }
-        if( pMesh->HasTangentsAndBitangents() )
+
+        uint64_t hash = 14695981039346656037ull;
+        for( unsigned int bone : faceBones)
         {
-            newMesh->mTangents = new aiVector3D[newMesh->mNumVertices];
-            newMesh->mBitangents = new aiVector3D[newMesh->mNumVertices];
+            hash = (hash ^ bone) * 1099511628211ull;
         }
-        for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a )
+
+        const std::pair<std::unordered_map<uint64_t, unsigned int>::iterator, bool> bucket =
+                buckets.insert( std::make_pair( hash, unassigned));
+        unsigned int group = bucket.first->second;
+        while( group != unassigned )
         {
-            if( pMesh->HasTextureCoords( a) )
+            if( paletteOfs[group + 1] - paletteOfs[group] == faceBones.size() &&
+                    std::equal( faceBones.begin(), faceBones.end(), paletteBones.begin() + paletteOfs[group]) )
             {
-                newMesh->mTextureCoords[a] = new aiVector3D[newMesh->mNumVertices];
+                break;
             }
-            newMesh->mNumUVComponents[a] = pMesh->mNumUVComponents[a];
+            group = nextInBucket[group];
+        }
+        if( group == unassigned )
+        {
+            group = static_cast<unsigned int>(paletteFaces.size());
+            nextInBucket.push_back( bucket.first->second);
+            bucket.first->second = group;
+            paletteBones.insert( paletteBones.end(), faceBones.begin(), faceBones.end());
+            paletteOfs.push_back( static_cast<unsigned int>(paletteBones.size()));
+            paletteFaces.push_back( 0);
         }
-        for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a )
+        ++paletteFaces[group];
+        faceGroup[a] = group;
+    }
+    const unsigned int numPalettes = static_cast<unsigned int>(paletteFaces.size());
+
+    // palettes using a bone
+    std::vector<unsigned int> boneOfs( numBones + 1, 0), bonePalettes( paletteBones.size());
+    for( unsigned int bone : paletteBones)
+    {
+        ++boneOfs[bone + 1];
+    }
+    MakeOffsets( boneOfs);
+    {
+        std::vector<unsigned int> cursor( boneOfs.begin(), boneOfs.end() - 1);
+        for( unsigned int a = 0; a < numPalettes; ++a)
         {
-            if( pMesh->HasVertexColors( a) )
+            for( unsigned int b = paletteOfs[a]; b < paletteOfs[a + 1]; ++b)
             {
-                newMesh->mColors[a] = new aiColor4D[newMesh->mNumVertices];
+                bonePalettes[cursor[paletteBones[b]]++] = a;
             }
         }
+    }
 
-        // and copy over the data, generating faces with linear indices along the way
-        newMesh->mFaces = new aiFace[subMeshFaces.size()];
-        unsigned int nvi = 0; // next vertex index
-        std::vector<unsigned int> previousVertexIndices( numSubMeshVertices, std::numeric_limits<unsigned int>::max()); // per new vertex: its index in the source mesh
-        for( unsigned int a = 0; a < subMeshFaces.size(); ++a )
+    // largest palettes are the hardest to place, they seed the submeshes
+    std::vector<unsigned int> order( numPalettes);
+    for( unsigned int a = 0; a < numPalettes; ++a)
+    {
+        order[a] = a;
+    }
+    std::sort( order.begin(), order.end(), [&paletteOfs, &paletteFaces]( unsigned int x, unsigned int y)
+    {
+        const unsigned int sx = paletteOfs[x + 1] - paletteOfs[x], sy = paletteOfs[y + 1] - paletteOfs[y];
+        if( sx != sy )
         {
-            const aiFace& srcFace = pMesh->mFaces[subMeshFaces[a]];
-            aiFace& dstFace = newMesh->mFaces[a];
-            dstFace.mNumIndices = srcFace.mNumIndices;
-            dstFace.mIndices = new unsigned int[dstFace.mNumIndices];
+            return sx > sy;
+        }
+        return paletteFaces[x] != paletteFaces[y] ? paletteFaces[x] > paletteFaces[y] : x < y;
+    });
+
+    std::vector<unsigned int> paletteSubMesh( numPalettes, unassigned);
+    std::vector<unsigned int> newBones( numPalettes);
+    for( unsigned int a = 0; a < numPalettes; ++a)
+    {
+        newBones[a] = paletteOfs[a + 1] - paletteOfs[a];
+    }
+    std::vector<char> isCandidate( numPalettes, 0);
+    std::vector<unsigned int> candidates;
+    std::vector<uint64_t> isBoneUsed( (numBones + 63) / 64);
+
+    poPartition.mBoneOfs.assign( 1, 0);
+    poPartition.mBones.clear();
+    unsigned int numSubMeshes = 0, numAssigned = 0;
+    size_t nextSeed = 0;
+    while( numAssigned < numPalettes )
+    {
+        std::fill( isBoneUsed.begin(), isBoneUsed.end(), 0);
+        const size_t firstBone = poPartition.mBones.size();
+        unsigned int numUsedBones = 0;
 
-            // accumulate linearly all the vertices of the source face
-            for( unsigned int b = 0; b < dstFace.mNumIndices; ++b )
+        const auto addPalette = [&]( unsigned int palette)
+        {
+            paletteSubMesh[palette] = numSubMeshes;
+            ++numAssigned;
+            for( unsigned int b = paletteOfs[palette]; b < paletteOfs[palette + 1]; ++b)
             {
-                unsigned int srcIndex = srcFace.mIndices[b];
-                dstFace.mIndices[b] = nvi;
-                previousVertexIndices[nvi] = srcIndex;
+                const unsigned int bone = paletteBones[b];
+                uint64_t& word = isBoneUsed[bone >> 6];
+                const uint64_t bit = uint64_t(1) << (bone & 63);
+                if( word & bit )
+                {
+                    continue;
+                }
+                word |= bit;
+                ++numUsedBones;
+                poPartition.mBones.push_back( bone);
+                for( unsigned int c = boneOfs[bone]; c < boneOfs[bone + 1]; ++c)
+                {
+                    const unsigned int other = bonePalettes[c];
+                    if( paletteSubMesh[other] != unassigned )
+                    {
+                        continue;
+                    }
+                    --newBones[other];
+                    if( !isCandidate[other] )
+                    {
+                        isCandidate[other] = 1;
+                        candidates.push_back( other);
+                    }
+                }
+            }
+        };
+
+        while( paletteSubMesh[order[nextSeed]] != unassigned )
+        {
+            ++nextSeed;
+        }
+        addPalette( order[nextSeed]);
 
-                newMesh->mVertices[nvi] = pMesh->mVertices[srcIndex];
-                if( pMesh->HasNormals() )
+        while( true )
+        {
+            // palette adding the fewest bones, then the one sharing the most bones
+            unsigned int best = unassigned;
+            size_t numCandidates = 0;
+            for( size_t c = 0; c < candidates.size(); ++c)
+            {
+                const unsigned int palette = candidates[c];
+                if( paletteSubMesh[palette] != unassigned )
                 {
-                    newMesh->mNormals[nvi] = pMesh->mNormals[srcIndex];
+                    continue;
                 }
-                if( pMesh->HasTangentsAndBitangents() )
+                candidates[numCandidates++] = palette;
+                if( numUsedBones + newBones[palette] > mMaxBoneCount )
                 {
-                    newMesh->mTangents[nvi] = pMesh->mTangents[srcIndex];
-                    newMesh->mBitangents[nvi] = pMesh->mBitangents[srcIndex];
+                    continue;
                 }
-                for( unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c )
+                if( best == unassigned || newBones[palette] < newBones[best] ||
+                        (newBones[palette] == newBones[best] && paletteOfs[palette + 1] - paletteOfs[palette] > paletteOfs[best + 1] - paletteOfs[best]) ||
+                        (newBones[palette] == newBones[best] && paletteOfs[palette + 1] - paletteOfs[palette] == paletteOfs[best + 1] - paletteOfs[best] && palette < best) )
                 {
-                    if( pMesh->HasTextureCoords( c) )
-                    {
-                        newMesh->mTextureCoords[c][nvi] = pMesh->mTextureCoords[c][srcIndex];
-                    }
+                    best = palette;
                 }
-                for( unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c )
+            }
+            candidates.resize( numCandidates);
+
+            // nothing related fits anymore, fill up with the largest unrelated palette that fits
+            if( best == unassigned )
+            {
+                for( size_t o = nextSeed; o < numPalettes; ++o)
                 {
-                    if( pMesh->HasVertexColors( c) )
+                    const unsigned int palette = order[o];
+                    if( paletteSubMesh[palette] == unassigned && !isCandidate[palette] &&
+                            numUsedBones + newBones[palette] <= mMaxBoneCount )
                     {
-                        newMesh->mColors[c][nvi] = pMesh->mColors[c][srcIndex];
+                        best = palette;
+                        break;
                     }
                 }
-
-                nvi++;
             }
+            if( best == unassigned )
+            {
+                break;
+            }
+            addPalette( best);
         }
 
-        ai_assert( nvi == numSubMeshVertices );
+        // the counts of the remaining palettes refer to this submesh, reset them
+        for( unsigned int palette : candidates)
+        {
+            isCandidate[palette] = 0;
+            newBones[palette] = paletteOfs[palette + 1] - paletteOfs[palette];
+        }
+        candidates.clear();
 
-        // Create the bones for the new submesh: first create the bone array
-        newMesh->mNumBones = 0;
-        newMesh->mBones = new aiBone*[numBones];
+        std::sort( poPartition.mBones.begin() + firstBone, poPartition.mBones.end());
+        poPartition.mBoneOfs.push_back( static_cast<unsigned int>(poPartition.mBones.size()));
+        ++numSubMeshes;
+    }
 
-        std::vector<unsigned int> mappedBoneIndex( pMesh->mNumBones, std::numeric_limits<unsigned int>::max());
-        for( unsigned int a = 0; a < pMesh->mNumBones; ++a )
-        {
-            if( !isBoneUsed[a] )
-            {
-                continue;
-            }
+    // faces of the submeshes, in their original order
+    std::vector<unsigned int>& faceOfs = poPartition.mFaceOfs;
+    faceOfs.assign( numSubMeshes + 1, 0);
+    for( unsigned int a = 0; a < pMesh->mNumFaces; ++a)
+    {
+        ++faceOfs[paletteSubMesh[faceGroup[a]] + 1];
+    }
+    MakeOffsets( faceOfs);
+    poPartition.mFaces.resize( pMesh->mNumFaces);
+    std::vector<unsigned int> cursor( faceOfs.begin(), faceOfs.end() - 1);
+    for( unsigned int a = 0; a < pMesh->mNumFaces; ++a)
+    {
+        poPartition.mFaces[cursor[paletteSubMesh[faceGroup[a]]]++] = a;
+    }
 
-            // create the new bone
-            const aiBone* srcBone = pMesh->mBones[a];
-            aiBone* dstBone = new aiBone;
-            mappedBoneIndex[a] = newMesh->mNumBones;
-            newMesh->mBones[newMesh->mNumBones++] = dstBone;
-            dstBone->mName = srcBone->mName;
-            dstBone->mOffsetMatrix = srcBone->mOffsetMatrix;
-            dstBone->mNumWeights = 0;
+    if( numSubMeshes == 0 )
+    {
+        faceOfs.clear();
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+// Creates a submesh of the given mesh.
+aiMesh* SplitByBoneCountProcess::CreateSubMesh( const aiMesh* pMesh, const Partition& pPartition, unsigned int pSubMesh) const
+{
+    const unsigned int* subMeshFaces = pPartition.mFaces.data() + pPartition.mFaceOfs[pSubMesh];
+    const unsigned int numFaces = pPartition.mFaceOfs[pSubMesh + 1] - pPartition.mFaceOfs[pSubMesh];
+    const unsigned int* subMeshBones = pPartition.mBones.data() + pPartition.mBoneOfs[pSubMesh];
+    const unsigned int numBones = pPartition.mBoneOfs[pSubMesh + 1] - pPartition.mBoneOfs[pSubMesh];
+    const std::vector<unsigned int>& weightOfs = pPartition.mWeightOfs;
+
+    // accumulated vertex count of all the faces in this submesh
+    unsigned int numSubMeshVertices = 0;
+    for( unsigned int a = 0; a < numFaces; ++a)
+    {
+        numSubMeshVertices += pMesh->mFaces[subMeshFaces[a]].mNumIndices;
+    }
+
+    // create a new mesh to hold this subset of the source mesh
+    aiMesh* newMesh = new aiMesh;
+    if( pMesh->mName.length > 0 )
+    {
+        newMesh->mName.Set( format() << pMesh->mName.data << "_sub" << pSubMesh);
+    }
+    newMesh->mMaterialIndex = pMesh->mMaterialIndex;
+    newMesh->mPrimitiveTypes = pMesh->mPrimitiveTypes;
+
+    // create all the arrays for this mesh if the old mesh contained them
+    newMesh->mNumVertices = numSubMeshVertices;
+    newMesh->mNumFaces = numFaces;
+    newMesh->mVertices = new aiVector3D[newMesh->mNumVertices];
+    if( pMesh->HasNormals() )
+    {
+        newMesh->mNormals = new aiVector3D[newMesh->mNumVertices];
+    }
+    if( pMesh->HasTangentsAndBitangents() )
+    {
+        newMesh->mTangents = new aiVector3D[newMesh->mNumVertices];
+        newMesh->mBitangents = new aiVector3D[newMesh->mNumVertices];
+    }
+    for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++a )
+    {
+        if( pMesh->HasTextureCoords( a) )
+        {
+            newMesh->mTextureCoords[a] = new aiVector3D[newMesh->mNumVertices];
+        }
+        newMesh->mNumUVComponents[a] = pMesh->mNumUVComponents[a];
+    }
+    for( unsigned int a = 0; a < AI_MAX_NUMBER_OF_COLOR_SETS; ++a )
+    {
+        if( pMesh->HasVertexColors( a) )
+        {
+            newMesh->mColors[a] = new aiColor4D[newMesh->mNumVertices];
         }
+    }
 
-        ai_assert( newMesh->mNumBones == numBones );
+    // and copy over the data, generating faces with linear indices along the way
+    newMesh->mFaces = new aiFace[numFaces];
+    unsigned int nvi = 0; // next vertex index
+    std::vector<unsigned int> previousVertexIndices( numSubMeshVertices, std::numeric_limits<unsigned int>::max()); // per new vertex: its index in the source mesh
+    for( unsigned int a = 0; a < numFaces; ++a )
+    {
+        const aiFace& srcFace = pMesh->mFaces[subMeshFaces[a]];
+        aiFace& dstFace = newMesh->mFaces[a];
+        dstFace.mNumIndices = srcFace.mNumIndices;
+        dstFace.mIndices = new unsigned int[dstFace.mNumIndices];
 
-        // iterate over all new vertices and count which bones affected its old vertex in the source mesh
-        for( unsigned int a = 0; a < numSubMeshVertices; ++a )
+        // accumulate linearly all the vertices of the source face
+        for( unsigned int b = 0; b < dstFace.mNumIndices; ++b )
         {
-            unsigned int oldIndex = previousVertexIndices[a];
-            const std::vector<BoneWeight>& bonesOnThisVertex = vertexBones[oldIndex];
+            unsigned int srcIndex = srcFace.mIndices[b];
+            dstFace.mIndices[b] = nvi;
+            previousVertexIndices[nvi] = srcIndex;
 
-            for( unsigned int b = 0; b < bonesOnThisVertex.size(); ++b )
+            newMesh->mVertices[nvi] = pMesh->mVertices[srcIndex];
+            if( pMesh->HasNormals() )
+            {
+                newMesh->mNormals[nvi] = pMesh->mNormals[srcIndex];
+            }
+            if( pMesh->HasTangentsAndBitangents() )
+            {
+                newMesh->mTangents[nvi] = pMesh->mTangents[srcIndex];
+                newMesh->mBitangents[nvi] = pMesh->mBitangents[srcIndex];
+            }
+            for( unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c )
+            {
+                if( pMesh->HasTextureCoords( c) )
+                {
+                    newMesh->mTextureCoords[c][nvi] = pMesh->mTextureCoords[c][srcIndex];
+                }
+            }
+            for( unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c )
             {
-                unsigned int newBoneIndex = mappedBoneIndex[ bonesOnThisVertex[b].first ];
-                if( newBoneIndex != std::numeric_limits<unsigned int>::max() )
+                if( pMesh->HasVertexColors( c) )
                 {
-                    newMesh->mBones[newBoneIndex]->mNumWeights++;
+                    newMesh->mColors[c][nvi] = pMesh->mColors[c][srcIndex];
                 }
             }
+
+            nvi++;
         }
+    }
+
+    ai_assert( nvi == numSubMeshVertices );
+
+    // Create the bones for the new submesh: first create the bone array
+    newMesh->mNumBones = numBones;
+    newMesh->mBones = new aiBone*[numBones];
 
-        // allocate all bone weight arrays accordingly
-        for( unsigned int a = 0; a < newMesh->mNumBones; ++a )
+    std::vector<unsigned int> mappedBoneIndex( pMesh->mNumBones, std::numeric_limits<unsigned int>::max());
+    for( unsigned int a = 0; a < numBones; ++a )
+    {
+        // create the new bone
+        const aiBone* srcBone = pMesh->mBones[subMeshBones[a]];
+        aiBone* dstBone = new aiBone;
+        mappedBoneIndex[subMeshBones[a]] = a;
+        newMesh->mBones[a] = dstBone;
+        dstBone->mName = srcBone->mName;
+        dstBone->mOffsetMatrix = srcBone->mOffsetMatrix;
+        dstBone->mNumWeights = 0;
+    }
+
+    // iterate over all new vertices and count which bones affected its old vertex in the source mesh
+    for( unsigned int a = 0; a < numSubMeshVertices; ++a )
+    {
+        const unsigned int oldIndex = previousVertexIndices[a];
+        for( unsigned int b = weightOfs[oldIndex]; b < weightOfs[oldIndex + 1]; ++b )
         {
-            aiBone* bone = newMesh->mBones[a];
-            ai_assert( bone->mNumWeights > 0 );
-            bone->mWeights = new aiVertexWeight[bone->mNumWeights];
-            bone->mNumWeights = 0; // for counting up in the next step
+            const unsigned int newBoneIndex = mappedBoneIndex[pPartition.mWeightBones[b]];
+            ai_assert( newBoneIndex != std::numeric_limits<unsigned int>::max() );
+            newMesh->mBones[newBoneIndex]->mNumWeights++;
         }
+    }
 
-        // now copy all the bone vertex weights for all the vertices which made it into the new submesh
-        for( unsigned int a = 0; a < numSubMeshVertices; ++a)
+    // allocate all bone weight arrays accordingly
+    for( unsigned int a = 0; a < newMesh->mNumBones; ++a )
+    {
+        aiBone* bone = newMesh->mBones[a];
+        ai_assert( bone->mNumWeights > 0 );
+        bone->mWeights = new aiVertexWeight[bone->mNumWeights];
+        bone->mNumWeights = 0; // for counting up in the next step
+    }
+
+    // now copy all the bone vertex weights for all the vertices which made it into the new submesh.
+    // All of the bones affecting them are present in the new submesh, or else the faces they
+    // comprise wouldn't be present
+    for( unsigned int a = 0; a < numSubMeshVertices; ++a)
+    {
+        const unsigned int previousIndex = previousVertexIndices[a];
+        for( unsigned int b = weightOfs[previousIndex]; b < weightOfs[previousIndex + 1]; ++b)
         {
-            // find the source vertex for it in the source mesh
-            unsigned int previousIndex = previousVertexIndices[a];
-            // these bones were affecting it
-            const std::vector<BoneWeight>& bonesOnThisVertex = vertexBones[previousIndex];
-            // all of the bones affecting it should be present in the new submesh, or else
-            // the face it comprises shouldn't be present
-            for( unsigned int b = 0; b < bonesOnThisVertex.size(); ++b)
-            {
-                unsigned int newBoneIndex = mappedBoneIndex[ bonesOnThisVertex[b].first ];
-                ai_assert( newBoneIndex != std::numeric_limits<unsigned int>::max() );
-                aiVertexWeight* dstWeight = newMesh->mBones[newBoneIndex]->mWeights + newMesh->mBones[newBoneIndex]->mNumWeights;
-                newMesh->mBones[newBoneIndex]->mNumWeights++;
+            aiBone* bone = newMesh->mBones[mappedBoneIndex[pPartition.mWeightBones[b]]];
+            aiVertexWeight* dstWeight = bone->mWeights + bone->mNumWeights;
+            bone->mNumWeights++;
 
-                dstWeight->mVertexId = a;
-                dstWeight->mWeight = bonesOnThisVertex[b].second;
-            }
+            dstWeight->mVertexId = a;
+            dstWeight->mWeight = pPartition.mWeightValues[b];
         }
+    }
 
-        // ... and copy all the morph targets for all the vertices which made it into the new submesh
-        if (pMesh->mNumAnimMeshes > 0) {
-            newMesh->mNumAnimMeshes = pMesh->mNumAnimMeshes;
-            newMesh->mAnimMeshes = new aiAnimMesh*[newMesh->mNumAnimMeshes];
+    // ... and copy all the morph targets for all the vertices which made it into the new submesh
+    if (pMesh->mNumAnimMeshes > 0) {
+        newMesh->mNumAnimMeshes = pMesh->mNumAnimMeshes;
+        newMesh->mAnimMeshes = new aiAnimMesh*[newMesh->mNumAnimMeshes];
+        
+        for (unsigned int morphIdx = 0; morphIdx < newMesh->mNumAnimMeshes; ++morphIdx) {
+            aiAnimMesh* origTarget = pMesh->mAnimMeshes[morphIdx];
+            aiAnimMesh* newTarget = new aiAnimMesh;
+            newTarget->mName = origTarget->mName;
+            newTarget->mWeight = origTarget->mWeight;
+            newTarget->mNumVertices = numSubMeshVertices;
+            newTarget->mVertices = new aiVector3D[numSubMeshVertices];
+            newMesh->mAnimMeshes[morphIdx] = newTarget;
             
-            for (unsigned int morphIdx = 0; morphIdx < newMesh->mNumAnimMeshes; ++morphIdx) {
-                aiAnimMesh* origTarget = pMesh->mAnimMeshes[morphIdx];
-                aiAnimMesh* newTarget = new aiAnimMesh;
-                newTarget->mName = origTarget->mName;
-                newTarget->mWeight = origTarget->mWeight;
-                newTarget->mNumVertices = numSubMeshVertices;
-                newTarget->mVertices = new aiVector3D[numSubMeshVertices];
-                newMesh->mAnimMeshes[morphIdx] = newTarget;
-                
-                if (origTarget->HasNormals()) {
-                    newTarget->mNormals = new aiVector3D[numSubMeshVertices];
-                }
-                
-                if (origTarget->HasTangentsAndBitangents()) {
-                    newTarget->mTangents = new aiVector3D[numSubMeshVertices];
-                    newTarget->mBitangents = new aiVector3D[numSubMeshVertices];
+            if (origTarget->HasNormals()) {
+                newTarget->mNormals = new aiVector3D[numSubMeshVertices];
+            }
+            
+            if (origTarget->HasTangentsAndBitangents()) {
+                newTarget->mTangents = new aiVector3D[numSubMeshVertices];
+                newTarget->mBitangents = new aiVector3D[numSubMeshVertices];
+            }
+            
+            for( unsigned int vi = 0; vi < numSubMeshVertices; ++vi) {
+                // find the source vertex for it in the source mesh
+                unsigned int previousIndex = previousVertexIndices[vi];
+                newTarget->mVertices[vi] = origTarget->mVertices[previousIndex];
+
+                if (newTarget->HasNormals()) {
+                    newTarget->mNormals[vi] = origTarget->mNormals[previousIndex];
                 }
-                
-                for( unsigned int vi = 0; vi < numSubMeshVertices; ++vi) {
-                    // find the source vertex for it in the source mesh
-                    unsigned int previousIndex = previousVertexIndices[vi];
-                    newTarget->mVertices[vi] = origTarget->mVertices[previousIndex];
-
-                    if (newTarget->HasNormals()) {
-                        newTarget->mNormals[vi] = origTarget->mNormals[previousIndex];
-                    }
-                    if (newTarget->HasTangentsAndBitangents()) {
-                        newTarget->mTangents[vi] = origTarget->mTangents[previousIndex];
-                        newTarget->mBitangents[vi] = origTarget->mBitangents[previousIndex];
-                    }
+                if (newTarget->HasTangentsAndBitangents()) {
+                    newTarget->mTangents[vi] = origTarget->mTangents[previousIndex];
+                    newTarget->mBitangents[vi] = origTarget->mBitangents[previousIndex];
                 }
             }
         }
-
-        // I have the strange feeling that this will break apart at some point in time...
     }
+
+    return newMesh;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -61,7 +61,7 @@ namespace Assimp
  * Applied BEFORE the JoinVertices-Step occurs.
  * Returns NON-UNIQUE vertices, splits by bone count.
 */
-class SplitByBoneCountProcess : public BaseProcess
+class ASSIMP_API SplitByBoneCountProcess : public BaseProcess
 {
 public:
 
@@ -90,10 +90,37 @@ protected:
     */
     void Execute( aiScene* pScene);
 
-    /// Splits the given mesh by bone count.
-    /// @param pMesh the Mesh to split. Is not changed at all, but might be superfluous in case it was split.
-    /// @param poNewMeshes Array of submeshes created in the process. Empty if splitting was not necessary.
-    void SplitMesh( const aiMesh* pMesh, std::vector<aiMesh*>& poNewMeshes) const;
+    /// Submeshes of a mesh and the bone weights of its vertices. Lists are stored
+    /// in CSR layout: the entries of item i are [ofs[i], ofs[i+1]).
+    struct Partition
+    {
+        /// Per vertex: bone indices and weights affecting it, ordered by bone index
+        std::vector<unsigned int> mWeightOfs;
+        std::vector<unsigned int> mWeightBones;
+        std::vector<float> mWeightValues;
+        /// Per submesh: indices of its faces in ascending order
+        std::vector<unsigned int> mFaceOfs;
+        std::vector<unsigned int> mFaces;
+        /// Per submesh: indices of the bones it uses in ascending order
+        std::vector<unsigned int> mBoneOfs;
+        std::vector<unsigned int> mBones;
+
+        unsigned int GetNumSubMeshes() const {
+            return mFaceOfs.empty() ? 0 : static_cast<unsigned int>(mFaceOfs.size() - 1);
+        }
+    };
+
+    /// Distributes the faces of the given mesh to as few submeshes as possible, each
+    /// of them using at most mMaxBoneCount bones.
+    /// @param pMesh the Mesh to split.
+    /// @param poPartition Receives the submeshes. Has no submeshes if the mesh has no faces.
+    void PartitionMesh( const aiMesh* pMesh, Partition& poPartition) const;
+
+    /// Creates a submesh of the given mesh.
+    /// @param pMesh the Mesh which was split. Is not changed at all.
+    /// @param pPartition Partition of the mesh created by PartitionMesh().
+    /// @param pSubMesh Index of the submesh to create.
+    aiMesh* CreateSubMesh( const aiMesh* pMesh, const Partition& pPartition, unsigned int pSubMesh) const;
 
     /// Recursively updates the node's mesh list to account for the changed mesh list
     void UpdateNode( aiNode* pNode) const;
@@ -102,6 +129,9 @@ public:
     /// Max bone count. Splitting occurs if a mesh has more than that number of bones.
     size_t mMaxBoneCount;
 
+    /// Number of threads to use, see #AI_CONFIG_GLOB_MULTITHREADING.
+    int mNumThreads;
+
     /// Per mesh index: Array of indices of the new submeshes.
     std::vector< std::vector<unsigned int> > mSubMeshIndices;
 };
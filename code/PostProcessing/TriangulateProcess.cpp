@@ -106,6 +106,7 @@ void TriangulateProcess::Execute( aiScene* pScene)
     bool bHas = false;
     for( unsigned int a = 0; a < pScene->mNumMeshes; a++)
     {
+        checkpoint.Check();
         if (pScene->mMeshes[ a ]) {
             if ( TriangulateMesh( pScene->mMeshes[ a ] ) ) {
                 bHas = true;
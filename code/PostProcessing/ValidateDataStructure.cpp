@@ -49,8 +49,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // internal headers
 #include "ValidateDataStructure.h"
 #include "ProcessHelper.h"
+#include "Common/ParallelFor.h"
 #include <assimp/BaseImporter.h>
+#include <assimp/Hash.h>
 #include <assimp/fast_atof.h>
+#include <exception>
 #include <memory>
 
 // CRT headers
@@ -61,7 +64,11 @@ using namespace Assimp;
 // ------------------------------------------------------------------------------------------------
 // Constructor to be privately used by Importer
 ValidateDSProcess::ValidateDSProcess() :
-        mScene() {}
+        mScene(),
+        mNumThreads(-1),
+        mNodeNames(),
+        mHasNodeNames(false),
+        mNodeMeshes() {}
 
 // ------------------------------------------------------------------------------------------------
 // Destructor, private as well
@@ -72,8 +79,18 @@ ValidateDSProcess::~ValidateDSProcess() {}
 bool ValidateDSProcess::IsActive(unsigned int pFlags) const {
     return (pFlags & aiProcess_ValidateDataStructure) != 0;
 }
+
+// ------------------------------------------------------------------------------------------------
+void ValidateDSProcess::SetupProperties(const Importer *pImp) {
+    mNumThreads = pImp->GetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, -1);
+}
+
+// ------------------------------------------------------------------------------------------------
+size_t ValidateDSProcess::NameHash::operator()(const aiString *name) const {
+    return SuperFastHash(name->data, name->length);
+}
 // ------------------------------------------------------------------------------------------------
-AI_WONT_RETURN void ValidateDSProcess::ReportError(const char *msg, ...) {
+AI_WONT_RETURN void ValidateDSProcess::ReportError(const char *msg, ...) const {
     ai_assert(nullptr != msg);
 
     va_list args;
@@ -103,12 +120,27 @@ void ValidateDSProcess::ReportWarning(const char *msg, ...) {
 }
 
 // ------------------------------------------------------------------------------------------------
-inline int HasNameMatch(const aiString &in, aiNode *node) {
-    int result = (node->mName == in ? 1 : 0);
+void ValidateDSProcess::CollectWarning(std::vector<std::string> &warnings, const char *msg, ...) {
+    ai_assert(nullptr != msg);
+
+    va_list args;
+    va_start(args, msg);
+
+    char szBuffer[3000];
+    const int iLen = vsprintf(szBuffer, msg, args);
+    ai_assert(iLen > 0);
+
+    va_end(args);
+    warnings.push_back("Validation warning: " + std::string(szBuffer, iLen));
+}
+
+// ------------------------------------------------------------------------------------------------
+// Counts how often each name occurs in the node graph.
+static void CountNodeNames(const aiNode *node, ValidateDSProcess::NameMap &names) {
+    ++names[&node->mName];
     for (unsigned int i = 0; i < node->mNumChildren; ++i) {
-        result += HasNameMatch(in, node->mChildren[i]);
+        CountNodeNames(node->mChildren[i], names);
     }
-    return result;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -136,6 +168,8 @@ inline void ValidateDSProcess::DoValidationEx(T **parray, unsigned int size,
         const char *firstName, const char *secondName) {
     // validate all entries
     if (size) {
+        NameMap names;
+        names.reserve(size);
         if (!parray) {
             ReportError("aiScene::%s is nullptr (aiScene::%s is %i)",
                     firstName, secondName, size);
@@ -148,12 +182,11 @@ inline void ValidateDSProcess::DoValidationEx(T **parray, unsigned int size,
             Validate(parray[i]);
 
             // check whether there are duplicate names
-            for (unsigned int a = i + 1; a < size; ++a) {
-                if (parray[i]->mName == parray[a]->mName) {
-                    ReportError("aiScene::%s[%u] has the same name as "
-                                "aiScene::%s[%u]",
-                            firstName, i, secondName, a);
-                }
+            const auto inserted = names.insert(NameMap::value_type(&parray[i]->mName, i));
+            if (!inserted.second) {
+                ReportError("aiScene::%s[%u] has the same name as "
+                            "aiScene::%s[%u]",
+                        firstName, inserted.first->second, secondName, i);
             }
         }
     }
@@ -166,8 +199,14 @@ inline void ValidateDSProcess::DoValidationWithNameCheck(T **array, unsigned int
     // validate all entries
     DoValidationEx(array, size, firstName, secondName);
 
+    // look the names up in one pass over the node graph
+    if (!mHasNodeNames) {
+        CountNodeNames(mScene->mRootNode, mNodeNames);
+        mHasNodeNames = true;
+    }
     for (unsigned int i = 0; i < size; ++i) {
-        int res = HasNameMatch(array[i]->mName, mScene->mRootNode);
+        const NameMap::const_iterator it = mNodeNames.find(&array[i]->mName);
+        const unsigned int res = mNodeNames.end() == it ? 0 : it->second;
         if (0 == res) {
             const std::string name = static_cast<char *>(array[i]->mName.data);
             ReportError("aiScene::%s[%i] has no corresponding node in the scene graph (%s)",
@@ -184,14 +223,17 @@ inline void ValidateDSProcess::DoValidationWithNameCheck(T **array, unsigned int
 // Executes the post processing step on the given imported data.
 void ValidateDSProcess::Execute(aiScene *pScene) {
     mScene = pScene;
+    mNodeNames.clear();
+    mHasNodeNames = false;
     ASSIMP_LOG_DEBUG("ValidateDataStructureProcess begin");
 
     // validate the node graph of the scene
+    mNodeMeshes.assign(pScene->mNumMeshes, false);
     Validate(pScene->mRootNode);
 
     // validate all meshes
     if (pScene->mNumMeshes) {
-        DoValidation(pScene->mMeshes, pScene->mNumMeshes, "mMeshes", "mNumMeshes");
+        ValidateMeshes();
     } else if (!(mScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE)) {
         ReportError("aiScene::mNumMeshes is 0. At least one mesh must be there");
     } else if (pScene->mMeshes) {
@@ -245,9 +287,52 @@ void ValidateDSProcess::Execute(aiScene *pScene) {
     }
 
     //  if (!has)ReportError("The aiScene data structure is empty");
+    mNodeNames.clear();
     ASSIMP_LOG_DEBUG("ValidateDataStructureProcess end");
 }
 
+// ------------------------------------------------------------------------------------------------
+void ValidateDSProcess::ValidateMeshes() {
+    const unsigned int numMeshes = mScene->mNumMeshes;
+    if (!mScene->mMeshes) {
+        ReportError("aiScene::mMeshes is nullptr (aiScene::mNumMeshes is %i)", numMeshes);
+    }
+    size_t numFaces = 0;
+    for (unsigned int i = 0; i < numMeshes; ++i) {
+        if (!mScene->mMeshes[i]) {
+            ReportError("aiScene::mMeshes[%i] is nullptr (aiScene::mNumMeshes is %i)", i, numMeshes);
+        }
+        numFaces += mScene->mMeshes[i]->mNumFaces;
+    }
+
+    // Each thread validates a range of meshes with its own scratch buffers. Warnings
+    // and errors are kept per mesh and reported in mesh order afterwards, so the
+    // result is the same as for a serial validation.
+    const unsigned int numThreads = numFaces >= MinFacesPerThread ? GetNumWorkerThreads(mNumThreads) : 1;
+    std::vector<std::vector<std::string>> warnings(numMeshes);
+    std::vector<std::exception_ptr> errors(numMeshes);
+    ParallelFor(numMeshes, numThreads, 1, [this, &warnings, &errors](size_t begin, size_t end) {
+        MeshScratch scratch;
+        for (size_t i = begin; i < end; ++i) {
+            try {
+                Validate(mScene->mMeshes[i], scratch, warnings[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+                return;
+            }
+        }
+    });
+
+    for (unsigned int i = 0; i < numMeshes; ++i) {
+        for (const std::string &warning : warnings[i]) {
+            ASSIMP_LOG_WARN(warning);
+        }
+        if (errors[i]) {
+            std::rethrow_exception(errors[i]);
+        }
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 void ValidateDSProcess::Validate(const aiLight *pLight) {
     if (pLight->mType == aiLightSource_UNDEFINED)
@@ -279,7 +364,7 @@ void ValidateDSProcess::Validate(const aiCamera *pCamera) {
 }
 
 // ------------------------------------------------------------------------------------------------
-void ValidateDSProcess::Validate(const aiMesh *pMesh) {
+void ValidateDSProcess::Validate(const aiMesh *pMesh, MeshScratch &scratch, std::vector<std::string> &warnings) const {
     // validate the material index of the mesh
     if (mScene->mNumMaterials && pMesh->mMaterialIndex >= mScene->mNumMaterials) {
         ReportError("aiMesh::mMaterialIndex is invalid (value: %i maximum: %i)",
@@ -348,15 +433,15 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
         ReportError("If there are tangents, bitangent vectors must be present as well");
     }
 
-    // faces, too
-    if (!pMesh->mNumFaces || (!pMesh->mFaces && !mScene->mFlags)) {
+    // faces, too - except for point clouds, their vertices are the points
+    if (!pMesh->IsPointCloud() && (!pMesh->mNumFaces || (!pMesh->mFaces && !mScene->mFlags))) {
         ReportError("Mesh %s contains no faces", pMesh->mName.C_Str());
     }
 
     // now check whether the face indexing layout is correct:
     // unique vertices, pseudo-indexed.
-    std::vector<bool> abRefList;
-    abRefList.resize(pMesh->mNumVertices, false);
+    std::vector<bool> &abRefList = scratch.referenced;
+    abRefList.assign(pMesh->mNumVertices, false);
     for (unsigned int i = 0; i < pMesh->mNumFaces; ++i) {
         aiFace &face = pMesh->mFaces[i];
         if (face.mNumIndices > AI_MAX_FACE_INDICES) {
@@ -382,12 +467,14 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
 
     // check whether there are vertices that aren't referenced by a face
     bool b = false;
+    if (pMesh->IsPointCloud()) {
+        abRefList.assign(pMesh->mNumVertices, true);
+    }
     for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
         if (!abRefList[i]) b = true;
     }
-    abRefList.clear();
     if (b) {
-        ReportWarning("There are unreferenced vertices");
+        CollectWarning(warnings, "There are unreferenced vertices");
     }
 
     // texture channel 2 may not be set if channel 1 is zero ...
@@ -423,42 +510,34 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
             ReportError("aiMesh::mBones is nullptr (aiMesh::mNumBones is %i)",
                     pMesh->mNumBones);
         }
-        std::unique_ptr<float[]> afSum(nullptr);
-        if (pMesh->mNumVertices) {
-            afSum.reset(new float[pMesh->mNumVertices]);
-            for (unsigned int i = 0; i < pMesh->mNumVertices; ++i)
-                afSum[i] = 0.0f;
-        }
+        std::vector<float> &afSum = scratch.weightSums;
+        afSum.assign(pMesh->mNumVertices, 0.0f);
 
         // check whether there are duplicate bone names
+        NameMap &boneNames = scratch.boneNames;
+        boneNames.clear();
         for (unsigned int i = 0; i < pMesh->mNumBones; ++i) {
             const aiBone *bone = pMesh->mBones[i];
-            if (bone->mNumWeights > AI_MAX_BONE_WEIGHTS) {
-                ReportError("Bone %u has too many weights: %u, but the limit is %u", i, bone->mNumWeights, AI_MAX_BONE_WEIGHTS);
-            }
-
-            if (!pMesh->mBones[i]) {
+            if (!bone) {
                 ReportError("aiMesh::mBones[%i] is nullptr (aiMesh::mNumBones is %i)",
                         i, pMesh->mNumBones);
             }
-            Validate(pMesh, pMesh->mBones[i], afSum.get());
+            if (bone->mNumWeights > AI_MAX_BONE_WEIGHTS) {
+                ReportError("Bone %u has too many weights: %u, but the limit is %u", i, bone->mNumWeights, AI_MAX_BONE_WEIGHTS);
+            }
+            Validate(pMesh, bone, afSum.data(), warnings);
 
-            for (unsigned int a = i + 1; a < pMesh->mNumBones; ++a) {
-                if (pMesh->mBones[i]->mName == pMesh->mBones[a]->mName) {
-                    const char *name = "unknown";
-                    if (nullptr != pMesh->mBones[i]->mName.C_Str()) {
-                        name = pMesh->mBones[i]->mName.C_Str();
-                    }
-                    ReportError("aiMesh::mBones[%i], name = \"%s\" has the same name as "
-                                "aiMesh::mBones[%i]",
-                            i, name, a);
-                }
+            const auto inserted = boneNames.insert(NameMap::value_type(&bone->mName, i));
+            if (!inserted.second) {
+                ReportError("aiMesh::mBones[%i], name = \"%s\" has the same name as "
+                            "aiMesh::mBones[%i]",
+                        inserted.first->second, bone->mName.C_Str(), i);
             }
         }
         // check whether all bone weights for a vertex sum to 1.0 ...
         for (unsigned int i = 0; i < pMesh->mNumVertices; ++i) {
             if (afSum[i] && (afSum[i] <= 0.94 || afSum[i] >= 1.05)) {
-                ReportWarning("aiMesh::mVertices[%i]: bone weight sum != 1.0 (sum is %f)", i, afSum[i]);
+                CollectWarning(warnings, "aiMesh::mVertices[%i]: bone weight sum != 1.0 (sum is %f)", i, afSum[i]);
             }
         }
     } else if (pMesh->mBones) {
@@ -467,7 +546,7 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh) {
 }
 
 // ------------------------------------------------------------------------------------------------
-void ValidateDSProcess::Validate(const aiMesh *pMesh, const aiBone *pBone, float *afSum) {
+void ValidateDSProcess::Validate(const aiMesh *pMesh, const aiBone *pBone, float *afSum, std::vector<std::string> &warnings) const {
     this->Validate(&pBone->mName);
 
     if (!pBone->mNumWeights) {
@@ -479,7 +558,7 @@ void ValidateDSProcess::Validate(const aiMesh *pMesh, const aiBone *pBone, float
         if (pBone->mWeights[i].mVertexId >= pMesh->mNumVertices) {
             ReportError("aiBone::mWeights[%i].mVertexId is out of range", i);
         } else if (!pBone->mWeights[i].mWeight || pBone->mWeights[i].mWeight > 1.0f) {
-            ReportWarning("aiBone::mWeights[%i].mWeight has an invalid value", i);
+            CollectWarning(warnings, "aiBone::mWeights[%i].mWeight has an invalid value", i);
         }
         afSum[pBone->mWeights[i].mVertexId] += pBone->mWeights[i].mWeight;
     }
@@ -895,8 +974,7 @@ void ValidateDSProcess::Validate(const aiNode *pNode) {
             ReportError("aiNode::mMeshes is nullptr for node %s (aiNode::mNumMeshes is %i)",
                     nodeName, pNode->mNumMeshes);
         }
-        std::vector<bool> abHadMesh;
-        abHadMesh.resize(mScene->mNumMeshes, false);
+        std::vector<bool> &abHadMesh = mNodeMeshes;
         for (unsigned int i = 0; i < pNode->mNumMeshes; ++i) {
             if (pNode->mMeshes[i] >= mScene->mNumMeshes) {
                 ReportError("aiNode::mMeshes[%i] is out of range for node %s (maximum is %i)",
@@ -908,6 +986,10 @@ void ValidateDSProcess::Validate(const aiNode *pNode) {
             }
             abHadMesh[pNode->mMeshes[i]] = true;
         }
+        // only reset what this node marked, the buffer is shared by all nodes
+        for (unsigned int i = 0; i < pNode->mNumMeshes; ++i) {
+            abHadMesh[pNode->mMeshes[i]] = false;
+        }
     }
     if (pNode->mNumChildren) {
         if (!pNode->mChildren) {
@@ -921,7 +1003,7 @@ void ValidateDSProcess::Validate(const aiNode *pNode) {
 }
 
 // ------------------------------------------------------------------------------------------------
-void ValidateDSProcess::Validate(const aiString *pString) {
+void ValidateDSProcess::Validate(const aiString *pString) const {
     if (pString->length > MAXLEN) {
         ReportError("aiString::length is too large (%u, maximum is %lu)",
                 pString->length, MAXLEN);
@@ -51,6 +51,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Common/BaseProcess.h"
 
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 struct aiBone;
 struct aiMesh;
 struct aiAnimation;
@@ -69,7 +73,7 @@ namespace Assimp    {
 /** Validates the whole ASSIMP scene data structure for correctness.
  *  ImportErrorException is thrown of the scene is corrupt.*/
 // --------------------------------------------------------------------------------------
-class ValidateDSProcess : public BaseProcess
+class ASSIMP_API ValidateDSProcess : public BaseProcess
 {
 public:
 
@@ -80,16 +84,45 @@ public:
     // -------------------------------------------------------------------
     bool IsActive( unsigned int pFlags) const;
 
+    // -------------------------------------------------------------------
+    /** The step only reads the scene. */
+    unsigned int GetModifiedSceneComponents() const {
+        return 0;
+    }
+
+    // -------------------------------------------------------------------
+    void SetupProperties(const Importer* pImp);
+
     // -------------------------------------------------------------------
     void Execute( aiScene* pScene);
 
+    /// Scenes with fewer faces are validated on the calling thread.
+    static const size_t MinFacesPerThread = 16384;
+
+    /// Hashes aiStrings by their contents, used to find duplicate names.
+    struct NameHash {
+        size_t operator()(const aiString* name) const;
+    };
+    struct NameEqual {
+        bool operator()(const aiString* a, const aiString* b) const {
+            return *a == *b;
+        }
+    };
+    typedef std::unordered_map<const aiString*, unsigned int, NameHash, NameEqual> NameMap;
+
 protected:
+    /// Buffers reused for all meshes validated by one thread.
+    struct MeshScratch {
+        std::vector<bool> referenced;
+        std::vector<float> weightSums;
+        NameMap boneNames;
+    };
 
     // -------------------------------------------------------------------
     /** Report a validation error. This will throw an exception,
      *  control won't return.
      * @param msg Format string for sprintf().*/
-    AI_WONT_RETURN void ReportError(const char* msg,...) AI_WONT_RETURN_SUFFIX;
+    AI_WONT_RETURN void ReportError(const char* msg,...) const AI_WONT_RETURN_SUFFIX;
 
 
     // -------------------------------------------------------------------
@@ -98,17 +131,33 @@ protected:
      * @param msg Format string for sprintf().*/
     void ReportWarning(const char* msg,...);
 
+    // -------------------------------------------------------------------
+    /** Collect a validation warning to be logged later, for checks
+     *  running on worker threads.
+     * @param warnings Receives the message
+     * @param msg Format string for sprintf().*/
+    static void CollectWarning(std::vector<std::string>& warnings, const char* msg,...);
 
     // -------------------------------------------------------------------
-    /** Validates a mesh
-     * @param pMesh Input mesh*/
-    void Validate( const aiMesh* pMesh);
+    /** Validates all meshes of the scene, in parallel for large scenes.*/
+    void ValidateMeshes();
+
+
+    // -------------------------------------------------------------------
+    /** Validates a mesh. Safe to call for several meshes at once.
+     * @param pMesh Input mesh
+     * @param scratch Buffers of the calling thread
+     * @param warnings Receives the warnings*/
+    void Validate( const aiMesh* pMesh, MeshScratch& scratch,
+        std::vector<std::string>& warnings) const;
 
     // -------------------------------------------------------------------
     /** Validates a bone
      * @param pMesh Input mesh
-     * @param pBone Input bone*/
-    void Validate( const aiMesh* pMesh,const aiBone* pBone,float* afSum);
+     * @param pBone Input bone
+     * @param warnings Receives the warnings*/
+    void Validate( const aiMesh* pMesh,const aiBone* pBone,float* afSum,
+        std::vector<std::string>& warnings) const;
 
     // -------------------------------------------------------------------
     /** Validates an animation
@@ -166,7 +215,7 @@ protected:
     // -------------------------------------------------------------------
     /** Validates a string
      * @param pString Input string*/
-    void Validate( const aiString* pString);
+    void Validate( const aiString* pString) const;
 
 private:
 
@@ -187,6 +236,14 @@ private:
         const char* firstName, const char* secondName);
 
     aiScene* mScene;
+    int mNumThreads;
+
+    /// Number of occurrences of each node name, built on demand.
+    NameMap mNodeNames;
+    bool mHasNodeNames;
+
+    /// Meshes referenced by the node being validated.
+    std::vector<bool> mNodeMeshes;
 };
 
 
@@ -53,6 +53,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/ai_assert.h>
 #include <assimp/types.h>
+#include <assimp/Cancellation.h>
 #include <assimp/ProgressHandler.hpp>
 #include <map>
 #include <set>
@@ -162,6 +163,17 @@ public:
         return m_Exception;
     }
 
+    // -------------------------------------------------------------------
+    /** Returns the source keys of the meshes of the last import.
+     * A key identifies a mesh by the id and the content of the source
+     * object it was converted from, 0 means unknown. The list is either
+     * empty or has one entry per mesh of the imported scene.
+     * @return Keys used by incremental re-imports.
+     */
+    const std::vector<uint64_t> &GetMeshKeys() const {
+        return m_meshKeys;
+    }
+
     // -------------------------------------------------------------------
     /** Called prior to ReadFile().
      * The function is a request to the importer to update its configuration
@@ -429,6 +441,10 @@ protected:
     std::exception_ptr m_Exception;
     /// Currently set progress handler.
     ProgressHandler *m_progress;
+    /// Cancellation point for the current import, see #ImportCheckpoint.
+    ImportCheckpoint m_checkpoint;
+    /// Source keys of the imported meshes, see #GetMeshKeys.
+    std::vector<uint64_t> m_meshKeys;
 };
 
 } // end of namespace Assimp
@@ -49,6 +49,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/cexport.h>
 #include <stdint.h>
+#include <algorithm>
+#include <cstring>
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/IOStream.hpp>
 #include <assimp/IOSystem.hpp>
@@ -63,12 +65,14 @@ class BlobIOSystem;
 // --------------------------------------------------------------------------------------------
 class BlobIOStream : public IOStream {
 public:
-    BlobIOStream(BlobIOSystem *creator, const std::string &file, size_t initial = 4096) :
-            buffer(),
+    BlobIOStream(BlobIOSystem *creator, const std::string &file, size_t initial = 4096,
+            const aiExportBlobAllocator *allocator = nullptr) :
+            chunks(),
             cur_size(),
             file_size(),
             cursor(),
             initial(initial),
+            allocator(allocator),
             file(file),
             creator(creator) {
         // empty
@@ -81,9 +85,29 @@ public:
     aiExportDataBlob *GetBlob() {
         aiExportDataBlob *blob = new aiExportDataBlob();
         blob->size = file_size;
-        blob->data = buffer;
-
-        buffer = nullptr;
+        blob->allocator = allocator;
+
+        if (chunks.size() == 1) {
+            // the common case if the size hint was right, hand over as is
+            blob->data = chunks[0].data;
+        } else if (!chunks.empty()) {
+            // join the chunks, each byte is copied exactly once
+            uint8_t *data = Allocate(file_size);
+            if (data) {
+                for (const Chunk &chunk : chunks) {
+                    if (chunk.offset < file_size) {
+                        memcpy(data + chunk.offset, chunk.data, std::min(chunk.size, file_size - chunk.offset));
+                    }
+                }
+            } else {
+                ASSIMP_LOG_ERROR_F("BlobIOStream: failed to allocate ", file_size, " bytes for ", file);
+                blob->size = 0;
+            }
+            blob->data = data;
+            ReleaseChunks();
+        }
+        chunks.clear();
+        cur_size = 0;
 
         return blob;
     }
@@ -100,12 +124,29 @@ public:
             size_t pSize,
             size_t pCount) {
         pSize *= pCount;
-        if (cursor + pSize > cur_size) {
-            Grow(cursor + pSize);
+        if (!pSize) {
+            return pCount;
+        }
+        if (cursor + pSize > cur_size && !Grow(cursor + pSize)) {
+            return 0;
         }
 
-        memcpy(buffer + cursor, pvBuffer, pSize);
-        cursor += pSize;
+        // find the chunk containing the cursor, usually the last one
+        size_t c = chunks.size() - 1;
+        while (chunks[c].offset > cursor) {
+            --c;
+        }
+
+        const uint8_t *src = static_cast<const uint8_t *>(pvBuffer);
+        for (size_t remaining = pSize; remaining;) {
+            const Chunk &chunk = chunks[c++];
+            const size_t at = cursor - chunk.offset;
+            const size_t n = std::min(remaining, chunk.size - at);
+            memcpy(chunk.data + at, src, n);
+            src += n;
+            cursor += n;
+            remaining -= n;
+        }
 
         file_size = std::max(file_size, cursor);
         return pCount;
@@ -131,8 +172,8 @@ public:
             return AI_FAILURE;
         }
 
-        if (cursor > file_size) {
-            Grow(cursor);
+        if (cursor > cur_size && !Grow(cursor)) {
+            return AI_FAILURE;
         }
 
         file_size = std::max(cursor, file_size);
@@ -156,29 +197,56 @@ public:
 
 private:
     // -------------------------------------------------------------------
-    void Grow(size_t need = 0) {
-        // 1.5 and phi are very heap-friendly growth factors (the first
-        // allows for frequent re-use of heap blocks, the second
-        // forms a fibonacci sequence with similar characteristics -
-        // since this heavily depends on the heap implementation
-        // and other factors as well, i'll just go with 1.5 since
-        // it is quicker to compute).
-        size_t new_size = std::max(initial, std::max(need, cur_size + (cur_size >> 1)));
-
-        const uint8_t *const old = buffer;
-        buffer = new uint8_t[new_size];
-
-        if (old) {
-            memcpy(buffer, old, cur_size);
-            delete[] old;
+    bool Grow(size_t need) {
+        // Append a chunk instead of reallocating, so nothing written so
+        // far is copied again. Doubling the total capacity keeps the
+        // number of chunks logarithmic in the file size.
+        const size_t size = std::max(initial, std::max(need - cur_size, cur_size));
+        uint8_t *data = Allocate(size);
+        if (!data) {
+            ASSIMP_LOG_ERROR_F("BlobIOStream: failed to allocate ", size, " bytes for ", file);
+            return false;
         }
 
-        cur_size = new_size;
+        Chunk chunk;
+        chunk.data = data;
+        chunk.offset = cur_size;
+        chunk.size = size;
+        chunks.push_back(chunk);
+
+        cur_size += size;
+        return true;
+    }
+
+    // -------------------------------------------------------------------
+    uint8_t *Allocate(size_t size) const {
+        if (allocator) {
+            return static_cast<uint8_t *>(allocator->allocate(size, allocator->user));
+        }
+        return new uint8_t[size];
+    }
+
+    // -------------------------------------------------------------------
+    void ReleaseChunks() {
+        for (const Chunk &chunk : chunks) {
+            if (allocator) {
+                allocator->release(chunk.data, allocator->user);
+            } else {
+                delete[] chunk.data;
+            }
+        }
+        chunks.clear();
     }
 
 private:
-    uint8_t *buffer;
+    struct Chunk {
+        uint8_t *data;
+        size_t offset, size;
+    };
+
+    std::vector<Chunk> chunks;
     size_t cur_size, file_size, cursor, initial;
+    const aiExportBlobAllocator *const allocator;
 
     const std::string file;
     BlobIOSystem *const creator;
@@ -195,7 +263,12 @@ class BlobIOSystem : public IOSystem {
     typedef std::pair<std::string, aiExportDataBlob *> BlobEntry;
 
 public:
-    BlobIOSystem() {
+    /** @param allocator Memory source for the blobs, nullptr for the heap.
+     *  @param sizeHint Expected size of the master file, 0 for the default. */
+    explicit BlobIOSystem(const aiExportBlobAllocator *allocator = nullptr, size_t sizeHint = 0) :
+            allocator(allocator),
+            sizeHint(sizeHint) {
+        // empty
     }
 
     virtual ~BlobIOSystem() {
@@ -265,7 +338,9 @@ public:
         }
 
         created.insert(std::string(pFile));
-        return new BlobIOStream(this, std::string(pFile));
+
+        const bool master = !strcmp(pFile, AI_BLOBIO_MAGIC);
+        return new BlobIOStream(this, std::string(pFile), master && sizeHint ? sizeHint : 4096, allocator);
     }
 
     // -------------------------------------------------------------------
@@ -285,12 +360,14 @@ private:
 private:
     std::set<std::string> created;
     std::vector<BlobEntry> blobs;
+    const aiExportBlobAllocator *const allocator;
+    const size_t sizeHint;
 };
 
 // --------------------------------------------------------------------------------------------
 BlobIOStream ::~BlobIOStream() {
     creator->OnDestruct(file, this);
-    delete[] buffer;
+    ReleaseChunks();
 }
 
 } // namespace Assimp
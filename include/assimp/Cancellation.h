@@ -0,0 +1,202 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  Cancellation.h
+ *  @brief Cooperative cancellation of running imports.
+ */
+#pragma once
+#ifndef AI_CANCELLATION_H_INC
+#define AI_CANCELLATION_H_INC
+
+#ifdef __GNUC__
+#pragma GCC system_header
+#endif
+
+#include <assimp/Exceptional.h>
+#include <assimp/ProgressHandler.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** @brief Flag to cancel a running import from any thread.
+ *
+ *  Hand it to #Importer::SetCancellationToken() before the import and call
+ *  Cancel() from any thread, e.g. a request timeout. The importer stops at
+ *  its next checkpoint and ReadFile() returns nullptr. The flag is not reset
+ *  by the importer, use one token per request. */
+class CancellationToken {
+public:
+    CancellationToken() AI_NO_EXCEPT :
+            mCancelled(false) {
+        // empty
+    }
+
+    /// Requests the import to stop, safe to call from any thread.
+    void Cancel() {
+        mCancelled.store(true, std::memory_order_relaxed);
+    }
+
+    /// Returns true once Cancel() has been called.
+    bool IsCancelled() const {
+        return mCancelled.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<bool> mCancelled;
+};
+
+// ---------------------------------------------------------------------------
+/** FOR IMPORTER PLUGINS ONLY: Thrown by #ImportCheckpoint once the import
+ *  was cancelled. Loaders which catch DeadlyImportError to skip broken
+ *  elements must rethrow this one. */
+class ImportCancelledError : public DeadlyImportError {
+public:
+    ImportCancelledError() :
+            DeadlyImportError("Import cancelled") {
+        // empty
+    }
+};
+
+// ---------------------------------------------------------------------------
+/** FOR IMPORTER PLUGINS ONLY: Cancellation point for long-running loops of
+ *  loaders and post-processing steps.
+ *
+ *  Check() reads an atomic flag and counts calls, so it can be called once
+ *  per element. Every few hundred calls, and at most once per PollInterval,
+ *  the progress handler is asked as well - if its Update() returns false the
+ *  import is cancelled too. The object itself is not thread-safe, worker
+ *  threads must use CheckCancelled() which never calls the handler. */
+class ImportCheckpoint {
+public:
+    /// Minimum time between two calls to the progress handler, in ms
+    enum { PollInterval = 5 };
+
+    ImportCheckpoint() AI_NO_EXCEPT :
+            mProgress(nullptr),
+            mToken(nullptr),
+            mAborted(false),
+            mCalls(0),
+            mLastPoll() {
+        // empty
+    }
+
+    ImportCheckpoint(ProgressHandler *progress, const CancellationToken *token) AI_NO_EXCEPT :
+            mProgress(progress),
+            mToken(token),
+            mAborted(false),
+            mCalls(0),
+            mLastPoll() {
+        // empty
+    }
+
+    // -------------------------------------------------------------------
+    /** Throws #ImportCancelledError if the import was cancelled. */
+    void Check() {
+        CheckCancelled();
+        if (mProgress && !(++mCalls & 0xff)) {
+            Poll(-1.f);
+        }
+    }
+
+    // -------------------------------------------------------------------
+    /** Same as Check(), also reports the progress of the file reading
+     *  phase to the handler, like ProgressHandler::UpdateFileRead(). */
+    void Check(size_t done, size_t total) {
+        CheckCancelled();
+        if (mProgress && !(++mCalls & 0xff)) {
+            Poll(total ? 0.5f * static_cast<float>(done) / static_cast<float>(total) : 0.5f);
+        }
+    }
+
+    // -------------------------------------------------------------------
+    /** For coarse loops, e.g. once per chunk of a file: same as
+     *  Check(done, total) but does not skip calls to the handler. */
+    void CheckProgress(size_t done, size_t total) {
+        CheckCancelled();
+        if (mProgress) {
+            Poll(total ? 0.5f * static_cast<float>(done) / static_cast<float>(total) : 0.5f);
+        }
+    }
+
+    // -------------------------------------------------------------------
+    /** Throws #ImportCancelledError if the import was cancelled, without
+     *  asking the progress handler. Safe to call from worker threads. */
+    void CheckCancelled() const {
+        if (IsCancelled()) {
+            throw ImportCancelledError();
+        }
+    }
+
+    // -------------------------------------------------------------------
+    /** Returns true if the import was cancelled, never throws. */
+    bool IsCancelled() const {
+        return mAborted || (mToken && mToken->IsCancelled());
+    }
+
+private:
+    void Poll(float percentage) {
+        const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now - mLastPoll < std::chrono::milliseconds(PollInterval)) {
+            return;
+        }
+        mLastPoll = now;
+        if (!mProgress->Update(percentage)) {
+            mAborted = true;
+            throw ImportCancelledError();
+        }
+    }
+
+    ProgressHandler *mProgress;
+    const CancellationToken *mToken;
+    bool mAborted;
+    unsigned int mCalls;
+    std::chrono::steady_clock::time_point mLastPoll;
+};
+
+} // namespace Assimp
+
+#endif // AI_CANCELLATION_H_INC
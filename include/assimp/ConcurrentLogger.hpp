@@ -0,0 +1,160 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+/** @file ConcurrentLogger.hpp
+ *  @brief Logger implementation for many importers running on many threads.
+ */
+
+#ifndef INCLUDED_AI_CONCURRENTLOGGER
+#define INCLUDED_AI_CONCURRENTLOGGER
+
+#include "DefaultLogger.hpp"
+
+#include <atomic>
+#include <vector>
+
+namespace Assimp {
+
+class IOSystem;
+
+// ------------------------------------------------------------------------------------
+/** @brief CPP-API: Logger for concurrent imports.
+ *
+ *  The #DefaultLogger formats every message into a shared buffer and writes
+ *  it to the attached streams on the calling thread. When many #Importer
+ *  instances are running on many threads this serializes all of them on the
+ *  logger. The ConcurrentLogger instead formats each message into a
+ *  thread-local buffer and pushes it onto a lock-free queue. Whichever thread
+ *  finds the queue idle drains it to the attached #LogStream's, all other
+ *  threads return immediately.
+ *
+ *  Messages are tagged with a small per-thread id and - if set - with the
+ *  owner of the current #ScopedContext. The #Importer opens such a context
+ *  for the duration of ReadFile() and ApplyPostProcessing(), so every
+ *  message can be attributed to the importer instance which emitted it.
+ *
+ *  Install it via #create() or DefaultLogger::set(new ConcurrentLogger()).
+ *  The relative order of messages is kept per thread. */
+class ASSIMP_API ConcurrentLogger : public Logger {
+public:
+    // ----------------------------------------------------------------------
+    /** @brief Tags all messages logged by the current thread with an owner.
+     *
+     *  Contexts can be nested, the previous one is restored when the
+     *  scope is left. */
+    class ASSIMP_API ScopedContext {
+    public:
+        explicit ScopedContext(const void *owner);
+        ~ScopedContext();
+
+        ScopedContext(const ScopedContext &) = delete;
+        ScopedContext &operator=(const ScopedContext &) = delete;
+
+    private:
+        const void *mPrevious;
+    };
+
+    // ----------------------------------------------------------------------
+    /** @brief Creates a concurrent logger and installs it as default logger.
+     *  @see DefaultLogger::create() for the meaning of the parameters.
+     *  @return The new logger instance, owned by #DefaultLogger. */
+    static Logger *create(const char *name = ASSIMP_DEFAULT_LOG_NAME,
+            LogSeverity severity = NORMAL,
+            unsigned int defStreams = aiDefaultLogStream_DEBUGGER | aiDefaultLogStream_FILE,
+            IOSystem *io = nullptr);
+
+    // ----------------------------------------------------------------------
+    /** @brief Returns the owner of the innermost #ScopedContext of the
+     *  calling thread, nullptr if there is none. */
+    static const void *getContext();
+
+    // ----------------------------------------------------------------------
+    /** @brief Construction with a given log severity. */
+    explicit ConcurrentLogger(LogSeverity severity = NORMAL);
+
+    // ----------------------------------------------------------------------
+    /** @brief Destructor, writes all pending messages and deletes the
+     *  attached streams. */
+    ~ConcurrentLogger() override;
+
+    // ----------------------------------------------------------------------
+    /** @copydoc Logger::attachStream   */
+    bool attachStream(LogStream *pStream, unsigned int severity) override;
+
+    // ----------------------------------------------------------------------
+    /** @copydoc Logger::detachStream */
+    bool detachStream(LogStream *pStream, unsigned int severity) override;
+
+    // ----------------------------------------------------------------------
+    /** @brief Writes all queued messages to the streams.
+     *
+     *  Blocks until the queue has been drained, either by this thread or
+     *  by another one. */
+    void flush();
+
+protected:
+    void OnDebug(const char *message) override;
+    void OnVerboseDebug(const char *message) override;
+    void OnInfo(const char *message) override;
+    void OnWarn(const char *message) override;
+    void OnError(const char *message) override;
+
+private:
+    struct Message;
+    struct StreamInfo {
+        unsigned int mSeverity;
+        LogStream *mStream;
+    };
+
+    void Enqueue(const char *prefix, const char *message, ErrorSeverity severity);
+    void TryDrain();
+    void WriteQueued();
+    void LockStreams();
+    void UnlockStreams();
+
+    std::atomic<Message *> mHead;
+    std::atomic<bool> mDraining;
+    std::vector<StreamInfo> mStreams;
+};
+
+} // Namespace Assimp
+
+#endif // !! INCLUDED_AI_CONCURRENTLOGGER
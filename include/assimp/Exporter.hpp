@@ -260,6 +260,25 @@ public:
      * following methods is called: #Export, #ExportToBlob, #FreeBlob */
     const char *GetErrorString() const; //ش
 
+    // -------------------------------------------------------------------
+    /** Set the memory source for the data of the blobs produced by
+     *  #ExportToBlob.
+     *
+     *  @param allocator Allocator to be used or nullptr to go back to
+     *    the default heap. It is not owned by the Exporter and must
+     *    outlive all blobs produced with it. */
+    void SetBlobAllocator(const aiExportBlobAllocator *allocator);
+
+    // -------------------------------------------------------------------
+    /** Set the expected size of the primary blob produced by
+     *  #ExportToBlob.
+     *
+     *  The blob is written in chunks which are joined once at the end.
+     *  If the output fits the hinted size, the first chunk becomes the
+     *  blob data without any copy.
+     *  @param size Expected size in bytes, 0 to use the default. */
+    void SetBlobSizeHint(size_t size);
+
     // -------------------------------------------------------------------
     /** Return the blob obtained from the last call to #ExportToBlob */
     const aiExportDataBlob *GetBlob() const;//һλص #ExportToBlobblob
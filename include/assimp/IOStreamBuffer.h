@@ -52,6 +52,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/IOStream.hpp>
 #include <assimp/ParsingUtils.h>
 
+#include <cstring>
 #include <vector>
 
 namespace Assimp {
@@ -107,6 +108,24 @@ public:
     /// @return true if successful.
     bool getNextDataLine( std::vector<T> &buffer, T continuationToken );
 
+    /// @brief  Will return the next line without copying it, if possible.
+    ///
+    /// The returned line points into the cache. Only lines crossing a block
+    /// boundary or containing the continuation token are assembled in an
+    /// internal buffer. The line stays valid until the next read call.
+    /// @param  line        Will point to the first character of the line.
+    /// @param  length      The length of the line, line[length] is always a line end.
+    /// @param  continuationToken   Lines containing this token are joined with the next one,
+    ///                     pass a line end character to disable this.
+    /// @return true if successful, false at the end of the stream.
+    bool getNextDataLineView( const T *&line, size_t &length, T continuationToken );
+
+    /// @brief  Will return the next non-empty line without copying it, if possible.
+    /// @param  line        Will point to the first character of the line.
+    /// @param  length      The length of the line, line[length] is always a line end.
+    /// @return true if successful, false at the end of the stream.
+    bool getNextLineView( const T *&line, size_t &length );
+
     /// @brief  Will read the next line ascii or binary end line char.
     /// @param  buffer      The buffer for the next line.
     /// @return true if successful.
@@ -126,6 +145,7 @@ private:
     std::vector<T> m_cache;
     size_t m_cachePos;
     size_t m_filePos;
+    std::vector<T> m_lineBuffer;
 };
 
 template<class T>
@@ -137,7 +157,8 @@ IOStreamBuffer<T>::IOStreamBuffer( size_t cache )
 , m_numBlocks( 0 )
 , m_blockIdx( 0 )
 , m_cachePos( 0 )
-, m_filePos( 0 ) {
+, m_filePos( 0 )
+, m_lineBuffer() {
     m_cache.resize( cache );
     std::fill( m_cache.begin(), m_cache.end(), '\n' );
 }
@@ -244,56 +265,122 @@ size_t IOStreamBuffer<T>::getFilePos() const {
     return m_filePos;
 }
 
+// ---------------------------------------------------------------------------
+/// @brief  Returns the first line end or continuation token in [begin, end), or end.
+template<class T>
+AI_FORCE_INLINE
+const T *findLineEnd( const T *begin, const T *end, T continuationToken ) {
+    for ( ; begin != end; ++begin ) {
+        if ( continuationToken == *begin || IsLineEnd( *begin ) ) {
+            break;
+        }
+    }
+    return begin;
+}
+
+static AI_FORCE_INLINE
+const char *findLineEnd( const char *begin, const char *end, char continuationToken ) {
+    // memchr is vectorized by the C library. Almost every line ends with '\n', the
+    // other line ends and the token are checked within that (short) range only.
+    const char *newLine = static_cast<const char *>( ::memchr( begin, '\n', end - begin ) );
+    if ( nullptr == newLine ) {
+        newLine = end;
+    }
+    for ( ; begin != newLine; ++begin ) {
+        const char c = *begin;
+        if ( continuationToken == c || '\r' == c || '\0' == c || '\f' == c ) {
+            break;
+        }
+    }
+    return begin;
+}
+
 template<class T>
 AI_FORCE_INLINE
 bool IOStreamBuffer<T>::getNextDataLine( std::vector<T> &buffer, T continuationToken ) {
-    buffer.resize( m_cacheSize );
+    const T *line = nullptr;
+    size_t length = 0;
+    if ( !getNextDataLineView( line, length, continuationToken ) ) {
+        return false;
+    }
+
+    buffer.assign( line, line + length );
+    buffer.push_back( '\n' );
+
+    return true;
+}
+
+template<class T>
+AI_FORCE_INLINE
+bool IOStreamBuffer<T>::getNextDataLineView( const T *&line, size_t &length, T continuationToken ) {
     if ( m_cachePos >= m_cacheSize || 0 == m_filePos ) {
         if ( !readNextBlock() ) {
             return false;
         }
     }
 
-    bool continuationFound( false );
-    size_t i = 0;
-    for( ;; ) {
-        if ( continuationToken == m_cache[ m_cachePos ] ) {
-            continuationFound = true;
+    // Fast path: the line is complete within the current block.
+    const T *begin = &m_cache[ m_cachePos ];
+    const T *blockEnd = &m_cache[ 0 ] + m_cacheSize;
+    const T *end = findLineEnd( begin, blockEnd, continuationToken );
+    if ( end != blockEnd && IsLineEnd( *end ) ) {
+        line = begin;
+        length = static_cast<size_t>( end - begin );
+        m_cachePos += length + 1;
+        if ( '\r' == *end && m_cachePos < m_cacheSize && '\n' == m_cache[ m_cachePos ] ) {
             ++m_cachePos;
         }
-        if ( IsLineEnd( m_cache[ m_cachePos ] ) ) {
-            if ( !continuationFound ) {
-                // the end of the data line
+        return true;
+    }
+
+    // Slow path: assemble the line, it may span several blocks.
+    m_lineBuffer.clear();
+    bool continuationFound( false );
+    for ( ;; ) {
+        if ( m_cachePos >= m_cacheSize ) {
+            if ( !readNextBlock() ) {
+                // the last line of the file has no line end
                 break;
-            } else {
-                // skip line end
-                while ( m_cache[m_cachePos] != '\n') {
-                    ++m_cachePos;
-                }
-                ++m_cachePos;
-                continuationFound = false;
             }
         }
 
-        buffer[ i ] = m_cache[ m_cachePos ];
-        ++m_cachePos;
-        ++i;
-        if (m_cachePos >= size()) {
-            break;
-        }
-        if ( m_cachePos >= m_cacheSize ) {
-            if ( !readNextBlock() ) {
-                return false;
+        const T c = m_cache[ m_cachePos++ ];
+        if ( IsLineEnd( c ) ) {
+            if ( '\r' == c && m_cachePos < m_cacheSize && '\n' == m_cache[ m_cachePos ] ) {
+                ++m_cachePos;
             }
+            if ( !continuationFound ) {
+                // the end of the data line
+                break;
+            }
+            continuationFound = false;
+        } else if ( continuationToken == c ) {
+            continuationFound = true;
+        } else {
+            m_lineBuffer.push_back( c );
         }
     }
-    
-    buffer[ i ] = '\n';
-    ++m_cachePos;
+    m_lineBuffer.push_back( '\n' );
+
+    line = &m_lineBuffer[ 0 ];
+    length = m_lineBuffer.size() - 1;
 
     return true;
 }
 
+template<class T>
+AI_FORCE_INLINE
+bool IOStreamBuffer<T>::getNextLineView( const T *&line, size_t &length ) {
+    for ( ;; ) {
+        if ( !getNextDataLineView( line, length, '\n' ) ) {
+            return false;
+        }
+        if ( 0 != length ) {
+            return true;
+        }
+    }
+}
+
 static AI_FORCE_INLINE
 bool isEndOfCache( size_t pos, size_t cacheSize ) {
     return ( pos == cacheSize );
@@ -0,0 +1,131 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+
+/** @file  ImportSettings.h
+ *  @brief Immutable configuration snapshot shared by several importers.
+ */
+#pragma once
+#ifndef AI_IMPORTSETTINGS_H_INC
+#define AI_IMPORTSETTINGS_H_INC
+
+#ifdef __GNUC__
+#pragma GCC system_header
+#endif
+
+#include <assimp/types.h>
+#include <string>
+
+namespace Assimp {
+
+class Importer;
+class ImportSettingsPimpl;
+
+// ---------------------------------------------------------------------------
+/** @brief Read-only copy of the configuration properties of an #Importer.
+ *
+ *  Configure one Importer, take a snapshot of it and hand the snapshot to
+ *  #Importer::SetSettings() of one Importer per thread. A snapshot never
+ *  changes after construction, so any number of threads may read it at the
+ *  same time without locking. Properties set on an Importer itself take
+ *  precedence over the snapshot it uses.
+ *
+ *  @code
+ *  Assimp::Importer configured;
+ *  configured.SetPropertyInteger(AI_CONFIG_PP_SLM_VERTEX_LIMIT, 1 << 16);
+ *  auto settings = std::make_shared<const Assimp::ImportSettings>(configured);
+ *
+ *  // in each worker thread
+ *  Assimp::Importer importer;
+ *  importer.SetSettings(settings);
+ *  importer.ReadFile(...);
+ *  @endcode
+ */
+class ASSIMP_API ImportSettings {
+public:
+    // -------------------------------------------------------------------
+    /** Takes a snapshot of all properties of the given importer,
+     *  including the ones of the snapshot it uses itself. */
+    explicit ImportSettings(const Importer &importer);
+
+    ~ImportSettings();
+
+    ImportSettings(const ImportSettings &) = delete;
+    ImportSettings &operator=(const ImportSettings &) = delete;
+
+    // -------------------------------------------------------------------
+    /** Get a configuration property, see #Importer::GetPropertyInteger() */
+    int GetPropertyInteger(const char *szName,
+            int iErrorReturn = 0xffffffff) const;
+
+    // -------------------------------------------------------------------
+    /** Get a boolean configuration property */
+    bool GetPropertyBool(const char *szName, bool bErrorReturn = false) const {
+        return GetPropertyInteger(szName, bErrorReturn) != 0;
+    }
+
+    // -------------------------------------------------------------------
+    /** Get a floating-point configuration property */
+    ai_real GetPropertyFloat(const char *szName,
+            ai_real fErrorReturn = 10e10) const;
+
+    // -------------------------------------------------------------------
+    /** Get a string configuration property */
+    std::string GetPropertyString(const char *szName,
+            const std::string &sErrorReturn = "") const;
+
+    // -------------------------------------------------------------------
+    /** Get a matrix configuration property */
+    aiMatrix4x4 GetPropertyMatrix(const char *szName,
+            const aiMatrix4x4 &sErrorReturn = aiMatrix4x4()) const;
+
+    // -------------------------------------------------------------------
+    /** Private, do not use. */
+    const ImportSettingsPimpl *Pimpl() const { return pimpl; }
+
+private:
+    ImportSettingsPimpl *pimpl;
+};
+
+} // namespace Assimp
+
+#endif // AI_IMPORTSETTINGS_H_INC
@@ -58,6 +58,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Public ASSIMP data structures
 #include <assimp/types.h>
+#include <memory>
 
 namespace Assimp {
 // =======================================================================
@@ -77,6 +78,8 @@ class BaseImporter;
 class BaseProcess;
 class SharedPostProcessInfo;
 class BatchLoader;
+class ImportSettings;
+class CancellationToken;
 
 // =======================================================================
 // Holy stuff, only for members of the high council of the Jedi.
@@ -295,6 +298,35 @@ public:
     aiMatrix4x4 GetPropertyMatrix(const char *szName,
             const aiMatrix4x4 &sErrorReturn = aiMatrix4x4()) const;
 
+    // -------------------------------------------------------------------
+    /** Makes the importer use a shared, read-only set of configuration
+     *  properties.
+     *
+     *  All properties set on this importer so far are dropped. Properties
+     *  set afterwards take precedence over the shared ones, the snapshot
+     *  itself is never modified. This is the way to run many importers
+     *  in parallel with one configuration, see #ImportSettings.
+     * @param settings Snapshot to be used or nullptr to use none. */
+    void SetSettings(const std::shared_ptr<const ImportSettings> &settings);
+
+    // -------------------------------------------------------------------
+    /** Returns the snapshot passed to #SetSettings, may be nullptr. */
+    const std::shared_ptr<const ImportSettings> &GetSettings() const;
+
+    // -------------------------------------------------------------------
+    /** Supplies a token to cancel imports from another thread.
+     *
+     *  The loaders and post-processing steps check it in their main
+     *  loops. Once it is cancelled, ReadFile() and ApplyPostProcessing()
+     *  return nullptr as soon as possible. A #ProgressHandler returning
+     *  false from Update() has the same effect.
+     * @param token Token to be used or nullptr to use none. */
+    void SetCancellationToken(const std::shared_ptr<CancellationToken> &token);
+
+    // -------------------------------------------------------------------
+    /** Returns the token passed to #SetCancellationToken, may be nullptr. */
+    const std::shared_ptr<CancellationToken> &GetCancellationToken() const;
+
     // -------------------------------------------------------------------
     /** Supplies a custom IO handler to the importer to use to open and
      * access files. If you need the importer to use custom IO logic to
@@ -0,0 +1,139 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** @file SceneAnalysis.h
+ *  @brief Single pass over a scene to collect bounding boxes, element counts
+ *    and memory footprints, e.g. for quota or LOD decisions.
+ */
+#pragma once
+#ifndef AI_SCENEANALYSIS_H_INC
+#define AI_SCENEANALYSIS_H_INC
+
+#ifdef __GNUC__
+#pragma GCC system_header
+#endif
+
+#include <assimp/aabb.h>
+#include <assimp/types.h>
+
+#include <cstddef>
+#include <vector>
+
+struct aiNode;
+struct aiScene;
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** Statistics of a single mesh. */
+struct ASSIMP_API MeshStatistics {
+    /// Bounding box in mesh space, mMin > mMax if there are no vertices
+    aiAABB mAABB;
+    unsigned int mNumVertices;
+    unsigned int mNumFaces;
+    /// Sum of the indices of all faces
+    unsigned int mNumIndices;
+    unsigned int mNumBones;
+    unsigned int mNumBoneWeights;
+    /// Combination of aiPrimitiveType flags
+    unsigned int mPrimitiveTypes;
+    /// Bytes held by the mesh, its vertex streams, faces and bones
+    size_t mMemory;
+
+    MeshStatistics();
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Statistics of a single node. */
+struct ASSIMP_API NodeStatistics {
+    const aiNode *mNode;
+    /// Index of the parent in SceneStatistics::mNodes, UINT_MAX for the root
+    unsigned int mParent;
+    /// The root has depth 1
+    unsigned int mDepth;
+    aiMatrix4x4 mWorldTransform;
+    /// World space bounding box of the meshes of the node and all its children,
+    /// mMin > mMax if there are none
+    aiAABB mAABB;
+
+    NodeStatistics();
+};
+
+// ------------------------------------------------------------------------------------------------
+/** Result of #AnalyzeScene(). */
+struct ASSIMP_API SceneStatistics {
+    /// One entry per aiScene::mMeshes
+    std::vector<MeshStatistics> mMeshes;
+    /// All nodes in depth-first order, parents come before their children
+    std::vector<NodeStatistics> mNodes;
+    /// World space bounding box of all mesh instances, same as the one of the root
+    aiAABB mAABB;
+    unsigned int mMaxDepth;
+    unsigned int mNumVertices;
+    unsigned int mNumFaces;
+    unsigned int mNumBones;
+    unsigned int mNumAnimChannels;
+    /// Combination of the aiPrimitiveType flags of all meshes
+    unsigned int mPrimitiveTypes;
+    /// Bytes held by all meshes
+    size_t mMeshMemory;
+
+    SceneStatistics();
+};
+
+// ------------------------------------------------------------------------------------------------
+/** @brief Collects the statistics of a scene.
+ *
+ *  The node graph is walked once, the vertex work is split into chunks
+ *  which are reduced in parallel with SIMD min/max.
+ *  @param scene The scene to analyze.
+ *  @param stats Receives the results, previous contents are replaced.
+ *  @param numThreads Thread count like #AI_CONFIG_GLOB_MULTITHREADING,
+ *    -1 uses all cores, 0 disables threading.
+ *  @param nodeBounds Set to false to skip the world space bounding boxes of
+ *    the nodes, they need to transform every vertex of every mesh instance.
+ *    mAABB of the scene and of the nodes stay empty then. */
+ASSIMP_API void AnalyzeScene(const aiScene *scene, SceneStatistics &stats, int numThreads = -1, bool nodeBounds = true);
+
+} // namespace Assimp
+
+#endif // AI_SCENEANALYSIS_H_INC
@@ -141,6 +141,21 @@ struct NodeAttachmentInfo {
  */
 #define AI_INT_MERGE_SCENE_GEN_UNIQUE_NAMES_IF_NECESSARY 0x10
 
+// ---------------------------------------------------------------------------
+/** @brief Component arrays of a scene which SceneCombiner::ShareScene()
+ *  shares between two scenes and SceneCombiner::MakeUnique() unshares.
+ */
+enum SceneComponent {
+    SceneComponent_Meshes = 0x1,
+    SceneComponent_Materials = 0x2,
+    SceneComponent_Animations = 0x4,
+    SceneComponent_Textures = 0x8,
+    SceneComponent_Lights = 0x10,
+    SceneComponent_Cameras = 0x20,
+
+    SceneComponent_All = 0x3f
+};
+
 typedef std::pair<aiBone *, unsigned int> BoneSrcIndex;
 
 // ---------------------------------------------------------------------------
@@ -343,6 +358,30 @@ public:
      */
     static void CopySceneFlat(aiScene **dest, const aiScene *source);
 
+    // -------------------------------------------------------------------
+    /** Get a copy-on-write copy of a scene
+     *
+     *  The node graph and the metadata are deep copied. The meshes,
+     *  materials, animations, textures, lights and cameras are shared
+     *  with the source scene until MakeUnique() is called for them, the
+     *  destination scene does not delete shared components. The source
+     *  scene must outlive the destination scene.
+     *  @param dest Receives a pointer to the destination scene
+     *  @param src Source scene - remains unmodified.
+     */
+    static void ShareScene(aiScene **dest, const aiScene *source);
+
+    // -------------------------------------------------------------------
+    /** Replace shared components of a scene by deep copies
+     *
+     *  Must be called before a scene obtained from ShareScene() is
+     *  modified. Components which are already owned by the scene are
+     *  left untouched.
+     *  @param scene Scene to be modified
+     *  @param components Combination of SceneComponent flags
+     */
+    static void MakeUnique(aiScene *scene, unsigned int components);
+
     // -------------------------------------------------------------------
     /** Get a deep copy of a mesh
      *
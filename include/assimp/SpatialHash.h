@@ -0,0 +1,176 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+  copyright notice, this list of conditions and the
+  following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+  copyright notice, this list of conditions and the
+  following disclaimer in the documentation and/or other
+  materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+  contributors may be used to endorse or promote products
+  derived from this software without specific prior
+  written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+/** Hash grid to find vertices close to a given location in constant time */
+#pragma once
+#ifndef AI_SPATIALHASH_H_INC
+#define AI_SPATIALHASH_H_INC
+
+#ifdef __GNUC__
+#pragma GCC system_header
+#endif
+
+#include <assimp/types.h>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace Assimp {
+
+// ------------------------------------------------------------------------------------------------
+/** Counterpart of #SpatialSort for a fixed search radius. The positions are bucketed into a
+ * uniform grid whose cells are as large as the search radius, so all positions in the radius
+ * of a query point lie in the 27 cells around it. Queries are O(1) on average, do not allocate
+ * and may be issued concurrently from several threads once the grid has been filled. */
+// ------------------------------------------------------------------------------------------------
+class ASSIMP_API SpatialHash {
+public:
+    SpatialHash();
+
+    // ------------------------------------------------------------------------------------
+    /** Constructs the grid from the given position array.
+     * @param pPositions Pointer to the first position vector of the array.
+     * @param pNumPositions Number of vectors to expect in that array.
+     * @param pElementOffset Offset in bytes from the beginning of one vector in memory
+     *   to the beginning of the next vector.
+     * @param pRadius Maximal distance from a query position a vertex may have to be found. */
+    SpatialHash(const aiVector3D *pPositions, unsigned int pNumPositions,
+            unsigned int pElementOffset, ai_real pRadius);
+
+    // ------------------------------------------------------------------------------------
+    /** Sets the input data for the grid. This replaces existing data, if any.
+     * @see SpatialHash() for the parameters. */
+    void Fill(const aiVector3D *pPositions, unsigned int pNumPositions,
+            unsigned int pElementOffset, ai_real pRadius);
+
+    // ------------------------------------------------------------------------------------
+    /** Calls callback(index) for each position closer than the radius to the given one.
+     * @param pPosition The position to look for vertices. */
+    template <typename Callback>
+    void ForEachPosition(const aiVector3D &pPosition, Callback callback) const;
+
+    // ------------------------------------------------------------------------------------
+    /** Same as #ForEachPosition() but collects the indices in a container.
+     * @param pPosition The position to look for vertices.
+     * @param poResults The container to store the indices of the found positions.
+     *   Will be emptied by the call so it may contain anything. */
+    void FindPositions(const aiVector3D &pPosition, std::vector<unsigned int> &poResults) const;
+
+    // ------------------------------------------------------------------------------------
+    /** Returns the search radius the grid has been built for. */
+    ai_real GetRadius() const {
+        return mRadius;
+    }
+
+protected:
+    /** An entry in a bucket of the grid */
+    struct Entry {
+        aiVector3D mPosition;
+        unsigned int mIndex;
+        int64_t mCell[3];
+    };
+
+    void ComputeCell(const aiVector3D &pPosition, int64_t *pCell) const;
+    unsigned int ComputeBucket(int64_t x, int64_t y, int64_t z) const;
+
+    ai_real mRadius;
+    ai_real mInvCellSize;
+    unsigned int mBucketMask;
+
+    /** Entries of bucket b are mEntries[mBucketStart[b]] ... mEntries[mBucketStart[b+1]-1] */
+    std::vector<unsigned int> mBucketStart;
+    std::vector<Entry> mEntries;
+};
+
+// ------------------------------------------------------------------------------------------------
+inline void SpatialHash::ComputeCell(const aiVector3D &pPosition, int64_t *pCell) const {
+    // clamp far away or invalid positions instead of overflowing, they still get
+    // distance-checked on query
+    static const double Limit = 4.0e18;
+    for (unsigned int i = 0; i < 3; ++i) {
+        const double c = std::floor(static_cast<double>(pPosition[i]) * mInvCellSize);
+        pCell[i] = c > -Limit && c < Limit ? static_cast<int64_t>(c) : (c > 0 ? int64_t(Limit) : -int64_t(Limit));
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+inline unsigned int SpatialHash::ComputeBucket(int64_t x, int64_t y, int64_t z) const {
+    // classic spatial hashing primes, see Teschner et al. 2003
+    const uint64_t h = (static_cast<uint64_t>(x) * 73856093u) ^
+                       (static_cast<uint64_t>(y) * 19349663u) ^
+                       (static_cast<uint64_t>(z) * 83492791u);
+    return static_cast<unsigned int>(h ^ (h >> 32)) & mBucketMask;
+}
+
+// ------------------------------------------------------------------------------------------------
+template <typename Callback>
+inline void SpatialHash::ForEachPosition(const aiVector3D &pPosition, Callback callback) const {
+    if (mEntries.empty()) {
+        return;
+    }
+
+    int64_t cell[3];
+    ComputeCell(pPosition, cell);
+    const ai_real squared = mRadius * mRadius;
+    for (int64_t x = cell[0] - 1; x <= cell[0] + 1; ++x) {
+        for (int64_t y = cell[1] - 1; y <= cell[1] + 1; ++y) {
+            for (int64_t z = cell[2] - 1; z <= cell[2] + 1; ++z) {
+                const unsigned int bucket = ComputeBucket(x, y, z);
+                for (unsigned int i = mBucketStart[bucket]; i < mBucketStart[bucket + 1]; ++i) {
+                    const Entry &entry = mEntries[i];
+
+                    // several cells may share a bucket, skip the foreign ones
+                    if (entry.mCell[0] != x || entry.mCell[1] != y || entry.mCell[2] != z) {
+                        continue;
+                    }
+                    if ((entry.mPosition - pPosition).SquareLength() < squared) {
+                        callback(entry.mIndex);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // Namespace Assimp
+
+#endif // AI_SPATIALHASH_H_INC
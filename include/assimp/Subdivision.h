@@ -73,8 +73,10 @@ public:
     /** Create a subdivider of a specific type
      *
      *  @param algo Algorithm to be used for subdivision
+     *  @param numThreads Number of threads to use, -1 for all cores
+     *    and 0 for none, like #AI_CONFIG_GLOB_MULTITHREADING.
      *  @return Subdivider instance. */
-    static Subdivider* Create (Algorithm algo);
+    static Subdivider* Create (Algorithm algo, int numThreads = -1);
 
     // ---------------------------------------------------------------
     /** Subdivide a mesh using the selected algorithm
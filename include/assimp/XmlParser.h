@@ -88,9 +88,10 @@ public:
     }
 
     void clear() {
-        mData.resize(0);
+        // the document points into the buffer, release it first
         delete mDoc;
         mDoc = nullptr;
+        mData.clear();
     }
 
     TNodeType *findNode(const std::string &name) {
@@ -115,26 +116,32 @@ public:
         return nullptr != findNode(name);
     }
 
-    bool parse(IOStream *stream) {
+    /// @brief  Parses the stream. The document is built in place in the parser's copy of the
+    ///         stream, so node names and texts point into it and no second copy is made.
+    /// @param  stream      The stream to parse.
+    /// @param  options     The pugixml parse options. Importers which do not need comments,
+    ///                     processing instructions or the doctype should pass fewer flags.
+    /// @return true if successful.
+    bool parse(IOStream *stream, unsigned int options = pugi::parse_full) {
         if (nullptr == stream) {
             ASSIMP_LOG_DEBUG("Stream is nullptr.");
             return false;
         }
 
-        bool result = false;
+        clear();
         const size_t len = stream->FileSize();
         mData.resize(len + 1);
-        memset(&mData[0], '\0', len + 1);
-        stream->Read(&mData[0], 1, len);
-        
+        const size_t readLen = len > 0 ? stream->Read(&mData[0], 1, len) : 0;
+        mData[readLen] = '\0';
+
         mDoc = new pugi::xml_document();
-        pugi::xml_parse_result parse_result = mDoc->load_string(&mData[0], pugi::parse_full);
-        if (parse_result.status == pugi::status_ok) {
+        pugi::xml_parse_result parse_result = mDoc->load_buffer_inplace(&mData[0], readLen, options);
+        if (parse_result.status != pugi::status_ok) {
             ASSIMP_LOG_DEBUG("Error while parse xml.");
-            result = true;
+            return false;
         }
 
-        return result;
+        return true;
     }
 
     pugi::xml_document *getDocument() const {
@@ -232,6 +239,19 @@ public:
         return true;
     }
 
+    /// @brief  Returns the text of a node without copying it. The text points into the parsed
+    ///         document and is valid as long as the parser is.
+    static inline bool getValueAsCString( XmlNode &node, const char *&text ) {
+        text = "";
+        if (node.empty()) {
+            return false;
+        }
+
+        text = node.text().get();
+
+        return true;
+    }
+
     static inline bool getValueAsFloat( XmlNode &node, ai_real &v ) {
         if (node.empty()) {
             return false;
@@ -0,0 +1,532 @@
+/*
+Open Asset Import Library (assimp)
+----------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the
+following conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------
+*/
+
+
+/** @file XmlStreamReader.h
+ *  @brief Event based XML reader which reads its input stream block by block.
+ */
+
+#pragma once
+#ifndef INCLUDED_AI_XML_STREAM_READER_H
+#define INCLUDED_AI_XML_STREAM_READER_H
+
+#include <assimp/Exceptional.h>
+#include <assimp/IOStream.hpp>
+#include <assimp/MemoryIOWrapper.h>
+#include <assimp/XmlParser.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace Assimp {
+
+// ---------------------------------------------------------------------------
+/** @brief  Reads an XML document as a sequence of start-element, end-element and
+ *          text events without building a document tree.
+ *
+ *  Only one block of the stream is held at a time, so importers of huge
+ *  documents can append the data of repetitive elements straight into their
+ *  output buffers. Elements which are easier to handle as a tree can be read
+ *  with readSubtree() into a small XmlParser document.
+ *
+ *  Comments, processing instructions and the doctype are skipped, CDATA sections
+ *  are reported as text, and text consisting of whitespace only is dropped. The
+ *  predefined and numeric character entities are decoded. Malformed input
+ *  raises a DeadlyImportError.
+ */
+class XmlStreamReader {
+public:
+    enum EventType {
+        Event_None,
+        Event_StartElement,
+        Event_EndElement,
+        Event_Text
+    };
+
+    /// The number of bytes read from the stream at once.
+    static const size_t BlockSize = 64 * 1024;
+
+    /// @brief  The constructor, the stream stays owned by the caller.
+    explicit XmlStreamReader(IOStream *stream) :
+            mStream(stream),
+            mBlock(BlockSize),
+            mPos(0),
+            mEnd(0),
+            mEof(nullptr == stream),
+            mEvent(Event_None),
+            mName(),
+            mText(),
+            mAttributes(),
+            mNumAttributes(0),
+            mStack(),
+            mDepth(0),
+            mPendingEnd(false),
+            mCapture(nullptr) {
+        // skip an utf-8 byte order mark
+        if (peek() == 0xef) {
+            get();
+            if (get() != '\xbb' || get() != '\xbf') {
+                throw DeadlyImportError("XML: invalid byte order mark.");
+            }
+        }
+    }
+
+    /// @brief  Reads the next event.
+    /// @return false at the end of the document.
+    bool read() {
+        if (mPendingEnd) {
+            mPendingEnd = false;
+            mEvent = Event_EndElement;
+            mDepth = mStack.size();
+            mStack.pop_back();
+            return true;
+        }
+
+        for (;;) {
+            const int c = peek();
+            if (c < 0) {
+                if (!mStack.empty()) {
+                    throw DeadlyImportError("XML: unexpected end of file, <", mStack.back(), "> is not closed.");
+                }
+                mEvent = Event_None;
+                return false;
+            }
+
+            if (c != '<') {
+                if (readText()) {
+                    return true;
+                }
+                continue;
+            }
+
+            get();
+            const int next = peek();
+            if (next == '?') {
+                skipUntil("?>");
+            } else if (next == '!') {
+                get();
+                if (peek() == '-') {
+                    expect("--");
+                    skipUntil("-->");
+                } else if (peek() == '[') {
+                    expect("[CDATA[");
+                    mText.clear();
+                    readUntil("]]>", mText);
+                    if (!mText.empty()) {
+                        mEvent = Event_Text;
+                        mDepth = mStack.size();
+                        return true;
+                    }
+                } else {
+                    skipDeclaration();
+                }
+            } else if (next == '/') {
+                get();
+                readName(mName);
+                skipSpaces();
+                expect(">");
+                if (mStack.empty() || mStack.back() != mName) {
+                    throw DeadlyImportError("XML: unexpected closing tag </", mName, ">.");
+                }
+                mEvent = Event_EndElement;
+                mDepth = mStack.size();
+                mStack.pop_back();
+                return true;
+            } else {
+                readStartTag();
+                return true;
+            }
+        }
+    }
+
+    /// @brief  Returns the type of the current event.
+    EventType getEventType() const {
+        return mEvent;
+    }
+
+    /// @brief  Returns the name of the current start or end element.
+    const std::string &getName() const {
+        return mName;
+    }
+
+    /// @brief  Returns the nesting depth of the current event, the root element has depth 1.
+    ///         The start and end event of an element report the same depth, text reports
+    ///         the depth of the element containing it.
+    size_t getDepth() const {
+        return mDepth;
+    }
+
+    /// @brief  Returns the decoded text of the current text event.
+    const std::string &getText() const {
+        return mText;
+    }
+
+    /// @brief  Returns the decoded value of an attribute of the current start element.
+    /// @return nullptr if the element has no such attribute.
+    const char *getAttribute(const char *name) const {
+        for (size_t i = 0; i < mNumAttributes; ++i) {
+            if (mAttributes[i].first == name) {
+                return mAttributes[i].second.c_str();
+            }
+        }
+        return nullptr;
+    }
+
+    /// @brief  Advances to the next direct child of an element, skipping any deeper content.
+    /// @param  parentDepth The depth of the parent element.
+    /// @return true at the start of a child, false at the end of the parent.
+    bool nextChild(size_t parentDepth) {
+        while (read()) {
+            if (mEvent == Event_StartElement && mDepth == parentDepth + 1) {
+                return true;
+            }
+            if (mEvent == Event_EndElement && mDepth == parentDepth) {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    /// @brief  Reads the text of the current start element and advances to its end.
+    ///         The text of nested elements is skipped.
+    void readElementText(std::string &text) {
+        text.clear();
+        const size_t depth = mDepth;
+        while (read()) {
+            if (mEvent == Event_Text && mDepth == depth) {
+                text += mText;
+            } else if (mEvent == Event_EndElement && mDepth == depth) {
+                return;
+            }
+        }
+    }
+
+    /// @brief  Parses the current start element and all of its content into a document and
+    ///         advances to its end, for elements which are easier to handle as a tree.
+    /// @param  parser  Receives the document.
+    /// @param  node    Receives the element in the document.
+    /// @return true if successful.
+    bool readSubtree(XmlParser &parser, XmlNode &node) {
+        std::string xml;
+        xml += '<';
+        xml += mName;
+        for (size_t i = 0; i < mNumAttributes; ++i) {
+            xml += ' ';
+            xml += mAttributes[i].first;
+            xml += "=\"";
+            appendEscaped(mAttributes[i].second, xml);
+            xml += '"';
+        }
+        if (mPendingEnd) {
+            xml += "/>";
+            read();
+        } else {
+            xml += '>';
+            const size_t depth = mDepth;
+            mCapture = &xml;
+            while (read()) {
+                if (mEvent == Event_EndElement && mDepth == depth) {
+                    break;
+                }
+            }
+            mCapture = nullptr;
+        }
+
+        MemoryIOStream stream(reinterpret_cast<const uint8_t *>(xml.c_str()), xml.size());
+        if (!parser.parse(&stream, pugi::parse_default)) {
+            return false;
+        }
+        node = parser.getRootNode().first_child();
+        return !node.empty();
+    }
+
+private:
+    bool fill() {
+        if (mEof) {
+            return false;
+        }
+        mPos = 0;
+        mEnd = mStream->Read(&mBlock[0], 1, mBlock.size());
+        if (0 == mEnd) {
+            mEof = true;
+            return false;
+        }
+        return true;
+    }
+
+    int peek() {
+        if (mPos == mEnd && !fill()) {
+            return -1;
+        }
+        return static_cast<unsigned char>(mBlock[mPos]);
+    }
+
+    char get() {
+        if (mPos == mEnd && !fill()) {
+            throw DeadlyImportError("XML: unexpected end of file.");
+        }
+        const char c = mBlock[mPos++];
+        if (nullptr != mCapture) {
+            mCapture->push_back(c);
+        }
+        return c;
+    }
+
+    static bool isSpace(int c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    static bool isNameChar(int c) {
+        return c >= 0 && !isSpace(c) && c != '>' && c != '/' && c != '=' && c != '<' && c != '"' && c != '\'';
+    }
+
+    void skipSpaces() {
+        while (isSpace(peek())) {
+            get();
+        }
+    }
+
+    void expect(const char *token) {
+        for (; *token; ++token) {
+            if (get() != *token) {
+                throw DeadlyImportError("XML: expected \"", token, "\".");
+            }
+        }
+    }
+
+    void readName(std::string &name) {
+        name.clear();
+        while (isNameChar(peek())) {
+            name += get();
+        }
+        if (name.empty()) {
+            throw DeadlyImportError("XML: expected a name.");
+        }
+    }
+
+    // Reads up to and including the terminator, the terminator is not stored.
+    void readUntil(const char *terminator, std::string &out) {
+        const size_t len = ::strlen(terminator);
+        for (;;) {
+            out += get();
+            if (out.size() >= len && out.compare(out.size() - len, len, terminator) == 0) {
+                out.resize(out.size() - len);
+                return;
+            }
+        }
+    }
+
+    void skipUntil(const char *terminator) {
+        const size_t len = ::strlen(terminator);
+        size_t matched = 0;
+        while (matched < len) {
+            const char c = get();
+            if (c == terminator[matched]) {
+                ++matched;
+            } else {
+                matched = (c == terminator[0]) ? 1 : 0;
+            }
+        }
+    }
+
+    // Skips <!DOCTYPE ...> including an internal subset in brackets.
+    void skipDeclaration() {
+        int brackets = 0;
+        for (;;) {
+            const char c = get();
+            if (c == '[') {
+                ++brackets;
+            } else if (c == ']') {
+                --brackets;
+            } else if (c == '>' && brackets <= 0) {
+                return;
+            }
+        }
+    }
+
+    // Decodes the entity after a '&'.
+    void readEntity(std::string &out) {
+        std::string entity;
+        for (char c = get(); c != ';'; c = get()) {
+            entity += c;
+            if (entity.size() > 10) {
+                throw DeadlyImportError("XML: invalid entity &", entity, ".");
+            }
+        }
+
+        if (entity == "lt") {
+            out += '<';
+        } else if (entity == "gt") {
+            out += '>';
+        } else if (entity == "amp") {
+            out += '&';
+        } else if (entity == "quot") {
+            out += '"';
+        } else if (entity == "apos") {
+            out += '\'';
+        } else if (entity.size() > 1 && entity[0] == '#') {
+            const bool hex = entity[1] == 'x';
+            const unsigned long code = std::strtoul(entity.c_str() + (hex ? 2 : 1), nullptr, hex ? 16 : 10);
+            appendUtf8(static_cast<unsigned int>(code), out);
+        } else {
+            throw DeadlyImportError("XML: unknown entity &", entity, ";.");
+        }
+    }
+
+    static void appendUtf8(unsigned int code, std::string &out) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xc0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3f));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xe0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+            out += static_cast<char>(0x80 | (code & 0x3f));
+        } else {
+            out += static_cast<char>(0xf0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+            out += static_cast<char>(0x80 | (code & 0x3f));
+        }
+    }
+
+    static void appendEscaped(const std::string &value, std::string &out) {
+        for (char c : value) {
+            switch (c) {
+            case '<': out += "&lt;"; break;
+            case '&': out += "&amp;"; break;
+            case '"': out += "&quot;"; break;
+            default: out += c; break;
+            }
+        }
+    }
+
+    // Reads character data up to the next tag, returns true if it is not only whitespace.
+    bool readText() {
+        mText.clear();
+        bool blank = true;
+        for (int c = peek(); c >= 0 && c != '<'; c = peek()) {
+            if (c == '&') {
+                get();
+                readEntity(mText);
+                blank = false;
+            } else {
+                blank = blank && isSpace(c);
+                mText += get();
+            }
+        }
+        if (blank) {
+            return false;
+        }
+        if (mStack.empty()) {
+            throw DeadlyImportError("XML: text outside of the root element.");
+        }
+        mEvent = Event_Text;
+        mDepth = mStack.size();
+        return true;
+    }
+
+    void readStartTag() {
+        readName(mName);
+        mNumAttributes = 0;
+        for (;;) {
+            skipSpaces();
+            const int c = peek();
+            if (c == '>') {
+                get();
+                break;
+            }
+            if (c == '/') {
+                get();
+                expect(">");
+                mPendingEnd = true;
+                break;
+            }
+
+            if (mNumAttributes == mAttributes.size()) {
+                mAttributes.emplace_back();
+            }
+            std::pair<std::string, std::string> &attribute = mAttributes[mNumAttributes++];
+            readName(attribute.first);
+            skipSpaces();
+            expect("=");
+            skipSpaces();
+            const char quote = get();
+            if (quote != '"' && quote != '\'') {
+                throw DeadlyImportError("XML: attribute value of <", mName, "> is not quoted.");
+            }
+            attribute.second.clear();
+            for (char v = get(); v != quote; v = get()) {
+                if (v == '&') {
+                    readEntity(attribute.second);
+                } else {
+                    attribute.second += v;
+                }
+            }
+        }
+
+        mStack.push_back(mName);
+        mEvent = Event_StartElement;
+        mDepth = mStack.size();
+    }
+
+private:
+    IOStream *mStream;
+    std::vector<char> mBlock;
+    size_t mPos;
+    size_t mEnd;
+    bool mEof;
+    EventType mEvent;
+    std::string mName;
+    std::string mText;
+    std::vector<std::pair<std::string, std::string>> mAttributes;
+    size_t mNumAttributes;
+    std::vector<std::string> mStack;
+    size_t mDepth;
+    bool mPendingEnd;
+    std::string *mCapture;
+};
+
+} // namespace Assimp
+
+#endif // INCLUDED_AI_XML_STREAM_READER_H
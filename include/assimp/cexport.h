@@ -187,6 +187,24 @@ ASSIMP_API aiReturn aiExportSceneEx(const C_STRUCT aiScene *pScene,
         C_STRUCT aiFileIO *pIO,
         unsigned int pPreprocessing);
 
+// --------------------------------------------------------------------------------
+/** Custom memory source for the data of exported blobs, see
+* Assimp::Exporter::SetBlobAllocator(). The exporter writes the primary blob into
+* memory obtained from #allocate and hands that memory to the blob without a copy
+* whenever the output fits the first allocation, so a caller-owned buffer can be
+* handed out there together with a matching size hint.
+*/
+struct aiExportBlobAllocator {
+    /** Returns at least size bytes of memory or NULL on failure. */
+    void *(*allocate)(size_t size, void *user);
+
+    /** Releases memory returned by #allocate. */
+    void (*release)(void *data, void *user);
+
+    /** Passed to both callbacks. */
+    void *user;
+};
+
 // --------------------------------------------------------------------------------
 /** Describes a blob of exported scene data. Use #aiExportSceneToBlob() to create a blob containing an
 * exported scene. The memory referred by this structure is owned by Assimp.
@@ -221,15 +239,26 @@ struct aiExportDataBlob {
     /** Pointer to the next blob in the chain or NULL if there is none. */
     C_STRUCT aiExportDataBlob *next;
 
+    /** Allocator #data was obtained from or NULL if it was allocated
+        by Assimp. The allocator must outlive the blob. */
+    const C_STRUCT aiExportBlobAllocator *allocator;
+
 #ifdef __cplusplus
     /// Default constructor
     aiExportDataBlob() {
         size = 0;
         data = next = nullptr;
+        allocator = nullptr;
     }
     /// Releases the data
     ~aiExportDataBlob() {
-        delete[] static_cast<unsigned char *>(data);
+        if (allocator) {
+            if (data) {
+                allocator->release(data, allocator->user);
+            }
+        } else {
+            delete[] static_cast<unsigned char *>(data);
+        }
         delete next;
     }
 
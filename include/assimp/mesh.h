@@ -591,6 +591,7 @@ struct aiMesh {
     /** The number of primitives (triangles, polygons, lines) in this  mesh.
     * This is also the size of the mFaces array.
     * The maximum value for this member is #AI_MAX_FACES.
+    * Is 0 for point clouds, see mFaces.
     */
     unsigned int mNumFaces;
 
@@ -673,6 +674,9 @@ struct aiMesh {
     * This array is always present in a mesh, its size is given
     * in mNumFaces. If the #AI_SCENE_FLAGS_NON_VERBOSE_FORMAT
     * is NOT set each face references an unique set of vertices.
+    * Point clouds are the exception: if mPrimitiveTypes is
+    * #aiPrimitiveType_POINT the array may be nullptr, each vertex
+    * is one point then.
     */
     C_STRUCT aiFace *mFaces;
 
@@ -799,6 +803,12 @@ struct aiMesh {
     //! are set this should always return true
     bool HasFaces() const { return mFaces != nullptr && mNumFaces > 0; }
 
+    //! Check whether the mesh is a point cloud without faces, each
+    //! vertex is one point then
+    bool IsPointCloud() const {
+        return mPrimitiveTypes == aiPrimitiveType_POINT && mNumFaces == 0 && mFaces == nullptr;
+    }
+
     //! Check whether the mesh contains normal vectors
     bool HasNormals() const { return mNormals != nullptr && mNumVertices > 0; }
 
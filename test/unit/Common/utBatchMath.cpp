@@ -0,0 +1,205 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "Common/BatchMath.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Assimp;
+
+class utBatchMath : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mBestLevel = BatchMath::SetLevel(BatchMath::Level_AVX2);
+        ::srand(42);
+    }
+
+    void TearDown() override {
+        BatchMath::SetLevel(mBestLevel);
+    }
+
+    static ai_real Random() {
+        return static_cast<ai_real>(rand()) / static_cast<ai_real>(RAND_MAX) * 2 - 1;
+    }
+
+    static aiMatrix4x4 RandomMatrix() {
+        aiMatrix4x4 m;
+        for (unsigned int r = 0; r < 4; ++r) {
+            for (unsigned int c = 0; c < 4; ++c) {
+                m[r][c] = Random() + (r == c ? 4 : 0);
+            }
+        }
+        return m;
+    }
+
+    static std::vector<aiVector3D> RandomVectors(size_t count) {
+        std::vector<aiVector3D> v(count);
+        for (aiVector3D &p : v) {
+            p = aiVector3D(Random(), Random(), Random()) * ai_real(10.0);
+        }
+        return v;
+    }
+
+    static void ExpectNear(const aiMatrix4x4 &expected, const aiMatrix4x4 &actual) {
+        for (unsigned int r = 0; r < 4; ++r) {
+            for (unsigned int c = 0; c < 4; ++c) {
+                EXPECT_NEAR(expected[r][c], actual[r][c], 1e-4);
+            }
+        }
+    }
+
+    static void ExpectNear(const aiVector3D &expected, const aiVector3D &actual) {
+        EXPECT_NEAR(expected.x, actual.x, 1e-4);
+        EXPECT_NEAR(expected.y, actual.y, 1e-4);
+        EXPECT_NEAR(expected.z, actual.z, 1e-4);
+    }
+
+    BatchMath::Level mBestLevel;
+};
+
+TEST_F(utBatchMath, multiplyMatricesTest) {
+    for (int level = BatchMath::Level_Scalar; level <= mBestLevel; ++level) {
+        BatchMath::SetLevel(static_cast<BatchMath::Level>(level));
+        std::vector<aiMatrix4x4> lhs(7), rhs(7), out(7);
+        for (size_t i = 0; i < lhs.size(); ++i) {
+            lhs[i] = RandomMatrix();
+            rhs[i] = RandomMatrix();
+        }
+
+        BatchMath::MultiplyMatrices(out.data(), lhs.data(), rhs.data(), out.size());
+        for (size_t i = 0; i < out.size(); ++i) {
+            ExpectNear(lhs[i] * rhs[i], out[i]);
+        }
+
+        // In place, with a single left operand
+        out = rhs;
+        BatchMath::MultiplyMatrices(out.data(), lhs[0], out.data(), out.size());
+        for (size_t i = 0; i < out.size(); ++i) {
+            ExpectNear(lhs[0] * rhs[i], out[i]);
+        }
+    }
+}
+
+TEST_F(utBatchMath, invertMatricesTest) {
+    for (int level = BatchMath::Level_Scalar; level <= mBestLevel; ++level) {
+        BatchMath::SetLevel(static_cast<BatchMath::Level>(level));
+        std::vector<aiMatrix4x4> in(9), out(9);
+        for (aiMatrix4x4 &m : in) {
+            m = RandomMatrix();
+        }
+        // A singular matrix inside the SIMD part of the batch
+        in[2] = aiMatrix4x4(1, 2, 3, 4, 2, 4, 6, 8, 0, 0, 1, 0, 0, 0, 0, 1);
+
+        BatchMath::InvertMatrices(out.data(), in.data(), in.size());
+        for (size_t i = 0; i < in.size(); ++i) {
+            if (i == 2) {
+                EXPECT_TRUE(std::isnan(out[i].a1));
+                EXPECT_TRUE(std::isnan(out[i].d4));
+                continue;
+            }
+            aiMatrix4x4 expected = in[i];
+            ExpectNear(expected.Inverse(), out[i]);
+        }
+    }
+}
+
+TEST_F(utBatchMath, transformVectorsTest) {
+    aiMatrix4x4 m = RandomMatrix();
+    m.d1 = m.d2 = m.d3 = 0;
+    m.d4 = 1;
+    const aiMatrix3x3 m3(m);
+    const std::vector<aiVector3D> in = RandomVectors(37);
+
+    for (int level = BatchMath::Level_Scalar; level <= mBestLevel; ++level) {
+        BatchMath::SetLevel(static_cast<BatchMath::Level>(level));
+
+        std::vector<aiVector3D> out = in;
+        BatchMath::TransformPositions(out.data(), out.data(), out.size(), m);
+        for (size_t i = 0; i < in.size(); ++i) {
+            ExpectNear(m * in[i], out[i]);
+        }
+
+        out = in;
+        BatchMath::TransformDirections(out.data(), out.data(), out.size(), m3, false);
+        for (size_t i = 0; i < in.size(); ++i) {
+            ExpectNear(m3 * in[i], out[i]);
+        }
+
+        BatchMath::TransformDirections(out.data(), in.data(), in.size(), m3, true);
+        for (size_t i = 0; i < in.size(); ++i) {
+            ExpectNear((m3 * in[i]).Normalize(), out[i]);
+        }
+    }
+}
+
+TEST_F(utBatchMath, slerpQuaternionsTest) {
+    const aiQuaternion a(aiVector3D(0, 0, 1), 0), b(aiVector3D(0, 0, 1), static_cast<ai_real>(AI_MATH_HALF_PI));
+    aiQuaternion out;
+    BatchMath::SlerpQuaternions(&out, &a, &b, ai_real(0.5), 1);
+
+    const aiQuaternion expected(aiVector3D(0, 0, 1), static_cast<ai_real>(AI_MATH_HALF_PI / 2));
+    EXPECT_NEAR(expected.w, out.w, 1e-5);
+    EXPECT_NEAR(expected.z, out.z, 1e-5);
+}
+
+TEST_F(utBatchMath, boundingBoxTest) {
+    std::vector<aiVector3D> in = RandomVectors(29);
+    in[9].y = std::numeric_limits<ai_real>::quiet_NaN();
+    in[20] = aiVector3D(100, -100, 50);
+
+    for (int level = BatchMath::Level_Scalar; level <= mBestLevel; ++level) {
+        BatchMath::SetLevel(static_cast<BatchMath::Level>(level));
+
+        aiVector3D min(1e10f, 1e10f, 1e10f), max(-1e10f, -1e10f, -1e10f);
+        BatchMath::ComputeBoundingBox(in.data(), in.size(), min, max);
+        EXPECT_EQ(100, max.x);
+        EXPECT_EQ(-100, min.y);
+        EXPECT_EQ(50, max.z);
+        EXPECT_FALSE(std::isnan(min.y));
+        EXPECT_FALSE(std::isnan(max.y));
+        for (const aiVector3D &p : in) {
+            EXPECT_LE(min.x, p.x);
+            EXPECT_GE(max.z, p.z);
+        }
+    }
+}
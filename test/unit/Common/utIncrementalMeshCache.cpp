@@ -0,0 +1,230 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+
+#include "Common/IncrementalMeshCache.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class utIncrementalMeshCache : public ::testing::Test {
+protected:
+    static aiMesh *CreateQuad(float offset) {
+        aiMesh *mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_POLYGON;
+        mesh->mNumVertices = 4;
+        mesh->mVertices = new aiVector3D[4];
+        mesh->mVertices[0] = aiVector3D(offset, 0, 0);
+        mesh->mVertices[1] = aiVector3D(offset + 1, 0, 0);
+        mesh->mVertices[2] = aiVector3D(offset + 1, 1, 0);
+        mesh->mVertices[3] = aiVector3D(offset, 1, 0);
+        mesh->mNumFaces = 1;
+        mesh->mFaces = new aiFace[1];
+        mesh->mFaces[0].mNumIndices = 4;
+        mesh->mFaces[0].mIndices = new unsigned int[4]{ 0, 1, 2, 3 };
+        return mesh;
+    }
+
+    static aiScene *CreateScene(float offset0, float offset1, float offset2) {
+        aiScene *scene = new aiScene();
+        scene->mNumMeshes = 3;
+        scene->mMeshes = new aiMesh *[3];
+        scene->mMeshes[0] = CreateQuad(offset0);
+        scene->mMeshes[1] = CreateQuad(offset1);
+        scene->mMeshes[2] = CreateQuad(offset2);
+        return scene;
+    }
+
+    // Stands in for the post processing steps: tags every mesh it sees.
+    static void Process(aiScene *scene, unsigned int pass) {
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            scene->mMeshes[i]->mName.Set("pass" + std::to_string(pass));
+        }
+    }
+};
+
+TEST_F(utIncrementalMeshCache, hashDependsOnContent) {
+    std::unique_ptr<aiMesh> a(CreateQuad(0)), b(CreateQuad(0)), c(CreateQuad(2));
+    EXPECT_EQ(IncrementalMeshCache::HashMesh(a.get()), IncrementalMeshCache::HashMesh(b.get()));
+    EXPECT_NE(IncrementalMeshCache::HashMesh(a.get()), IncrementalMeshCache::HashMesh(c.get()));
+
+    b->mFaces[0].mIndices[3] = 1;
+    EXPECT_NE(IncrementalMeshCache::HashMesh(a.get()), IncrementalMeshCache::HashMesh(b.get()));
+}
+
+TEST_F(utIncrementalMeshCache, reusesUnchangedMeshes) {
+    IncrementalMeshCache cache;
+    const unsigned int flags = aiProcess_Triangulate;
+    EXPECT_TRUE(IncrementalMeshCache::IsSupported(flags));
+    EXPECT_FALSE(IncrementalMeshCache::IsSupported(flags | aiProcess_PreTransformVertices));
+
+    std::unique_ptr<aiScene> first(CreateScene(0, 2, 4));
+    {
+        IncrementalMeshCache::Session session;
+        EXPECT_EQ(0u, cache.Detach(first.get(), flags, 0, session));
+        EXPECT_EQ(3u, first->mNumMeshes);
+        Process(first.get(), 1);
+        cache.Attach(first.get(), session);
+    }
+    EXPECT_EQ(3u, cache.GetNumCachedMeshes());
+
+    // The middle mesh changed, only this one is handed to post-processing
+    std::unique_ptr<aiScene> second(CreateScene(0, 3, 4));
+    {
+        IncrementalMeshCache::Session session;
+        EXPECT_EQ(2u, cache.Detach(second.get(), flags, 0, session));
+        ASSERT_EQ(1u, second->mNumMeshes);
+        EXPECT_FLOAT_EQ(3.f, second->mMeshes[0]->mVertices[0].x);
+        Process(second.get(), 2);
+        cache.Attach(second.get(), session);
+    }
+    ASSERT_EQ(3u, second->mNumMeshes);
+    EXPECT_STREQ("pass1", second->mMeshes[0]->mName.C_Str());
+    EXPECT_STREQ("pass2", second->mMeshes[1]->mName.C_Str());
+    EXPECT_STREQ("pass1", second->mMeshes[2]->mName.C_Str());
+    EXPECT_FLOAT_EQ(4.f, second->mMeshes[2]->mVertices[0].x);
+    EXPECT_EQ(3u, cache.GetNumCachedMeshes());
+
+    // Different flags invalidate everything
+    std::unique_ptr<aiScene> third(CreateScene(0, 3, 4));
+    IncrementalMeshCache::Session session;
+    EXPECT_EQ(0u, cache.Detach(third.get(), flags | aiProcess_GenNormals, 0, session));
+    cache.Attach(third.get(), session);
+}
+
+TEST_F(utIncrementalMeshCache, importerReimport) {
+    const unsigned int flags = aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_JoinIdenticalVertices;
+
+    Importer reference;
+    const aiScene *expected = reference.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", flags);
+    ASSERT_NE(nullptr, expected);
+
+    Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_INCREMENTAL, true);
+    for (int pass = 0; pass < 2; ++pass) {
+        const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", flags);
+        ASSERT_NE(nullptr, scene);
+        ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            const aiMesh *a = expected->mMeshes[i], *b = scene->mMeshes[i];
+            ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+            ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+            ASSERT_NE(nullptr, b->mNormals);
+            for (unsigned int v = 0; v < a->mNumVertices; ++v) {
+                EXPECT_EQ(a->mVertices[v], b->mVertices[v]);
+                EXPECT_EQ(a->mNormals[v], b->mNormals[v]);
+            }
+        }
+    }
+}
+
+TEST_F(utIncrementalMeshCache, sourceKeysReplaceContentHash) {
+    IncrementalMeshCache cache;
+    const unsigned int flags = aiProcess_Triangulate;
+    const std::vector<uint64_t> keys = { 1, 2, 0 };
+
+    std::unique_ptr<aiScene> first(CreateScene(0, 2, 4));
+    {
+        IncrementalMeshCache::Session session;
+        EXPECT_EQ(0u, cache.Detach(first.get(), flags, 0, session, &keys));
+        Process(first.get(), 1);
+        cache.Attach(first.get(), session);
+    }
+
+    // Meshes with a known key are not hashed, the last one has no key and
+    // is looked up by its content which changed
+    std::unique_ptr<aiScene> second(CreateScene(1, 3, 5));
+    {
+        IncrementalMeshCache::Session session;
+        EXPECT_EQ(2u, cache.Detach(second.get(), flags, 0, session, &keys));
+        ASSERT_EQ(1u, second->mNumMeshes);
+        EXPECT_FLOAT_EQ(5.f, second->mMeshes[0]->mVertices[0].x);
+        Process(second.get(), 2);
+        cache.Attach(second.get(), session);
+    }
+    ASSERT_EQ(3u, second->mNumMeshes);
+    EXPECT_STREQ("pass1", second->mMeshes[0]->mName.C_Str());
+    EXPECT_STREQ("pass1", second->mMeshes[1]->mName.C_Str());
+    EXPECT_STREQ("pass2", second->mMeshes[2]->mName.C_Str());
+
+    // Key lists which do not match the scene are ignored
+    const std::vector<uint64_t> wrongSize = { 1 };
+    std::unique_ptr<aiScene> third(CreateScene(1, 3, 5));
+    IncrementalMeshCache::Session session;
+    EXPECT_EQ(1u, cache.Detach(third.get(), flags, 0, session, &wrongSize));
+    cache.Attach(third.get(), session);
+}
+
+TEST_F(utIncrementalMeshCache, keyCollisionIsDetected) {
+    IncrementalMeshCache cache;
+    const unsigned int flags = aiProcess_Triangulate;
+    const std::vector<uint64_t> keys = { 1, 2, 3 };
+
+    std::unique_ptr<aiScene> first(CreateScene(0, 2, 4));
+    {
+        IncrementalMeshCache::Session session;
+        EXPECT_EQ(0u, cache.Detach(first.get(), flags, 0, session, &keys));
+        Process(first.get(), 1);
+        cache.Attach(first.get(), session);
+    }
+
+    // Same keys, but the first mesh lost a face and the second one uses
+    // another material: their cached results must not be handed out
+    std::unique_ptr<aiScene> second(CreateScene(0, 2, 4));
+    second->mMeshes[0]->mNumFaces = 0;
+    second->mMeshes[1]->mMaterialIndex = 1;
+    {
+        IncrementalMeshCache::Session session;
+        EXPECT_EQ(1u, cache.Detach(second.get(), flags, 0, session, &keys));
+        ASSERT_EQ(2u, second->mNumMeshes);
+        Process(second.get(), 2);
+        cache.Attach(second.get(), session);
+    }
+    ASSERT_EQ(3u, second->mNumMeshes);
+    EXPECT_STREQ("pass2", second->mMeshes[0]->mName.C_Str());
+    EXPECT_STREQ("pass2", second->mMeshes[1]->mName.C_Str());
+    EXPECT_STREQ("pass1", second->mMeshes[2]->mName.C_Str());
+    EXPECT_EQ(1u, second->mMeshes[1]->mMaterialIndex);
+}
@@ -0,0 +1,150 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/SceneAnalysis.h>
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class utSceneAnalysis : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // a single unit triangle, referenced by the root and by a translated
+        // child which itself has a child without meshes
+        mScene = new aiScene;
+        mScene->mNumMeshes = 1;
+        mScene->mMeshes = new aiMesh *[1];
+        aiMesh *mesh = mScene->mMeshes[0] = new aiMesh;
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = 3;
+        mesh->mVertices = new aiVector3D[3];
+        mesh->mVertices[0] = aiVector3D(0, 0, 0);
+        mesh->mVertices[1] = aiVector3D(1, 0, 0);
+        mesh->mVertices[2] = aiVector3D(0, 1, 0);
+        mesh->mNumFaces = 1;
+        mesh->mFaces = new aiFace[1];
+        mesh->mFaces[0].mNumIndices = 3;
+        mesh->mFaces[0].mIndices = new unsigned int[3]{ 0, 1, 2 };
+
+        aiNode *root = mScene->mRootNode = new aiNode("root");
+        root->mNumMeshes = 1;
+        root->mMeshes = new unsigned int[1]{ 0 };
+
+        aiNode *child = new aiNode("child");
+        child->mTransformation = aiMatrix4x4::Translation(aiVector3D(10, 0, 0), child->mTransformation);
+        child->mNumMeshes = 1;
+        child->mMeshes = new unsigned int[1]{ 0 };
+        root->addChildren(1, &child);
+
+        aiNode *leaf = new aiNode("leaf");
+        child->addChildren(1, &leaf);
+    }
+
+    void TearDown() override {
+        delete mScene;
+    }
+
+    aiScene *mScene;
+};
+
+TEST_F(utSceneAnalysis, countsTest) {
+    SceneStatistics stats;
+    AnalyzeScene(mScene, stats);
+
+    ASSERT_EQ(1u, stats.mMeshes.size());
+    EXPECT_EQ(3u, stats.mMeshes[0].mNumVertices);
+    EXPECT_EQ(1u, stats.mMeshes[0].mNumFaces);
+    EXPECT_EQ(3u, stats.mMeshes[0].mNumIndices);
+    EXPECT_LT(0u, stats.mMeshes[0].mMemory);
+    EXPECT_EQ(stats.mMeshes[0].mMemory, stats.mMeshMemory);
+
+    EXPECT_EQ(3u, stats.mNodes.size());
+    EXPECT_EQ(3u, stats.mMaxDepth);
+    EXPECT_EQ(3u, stats.mNumVertices);
+    EXPECT_EQ(1u, stats.mNumFaces);
+    EXPECT_EQ(static_cast<unsigned int>(aiPrimitiveType_TRIANGLE), stats.mPrimitiveTypes);
+}
+
+TEST_F(utSceneAnalysis, nodeOrderTest) {
+    SceneStatistics stats;
+    AnalyzeScene(mScene, stats);
+
+    ASSERT_EQ(3u, stats.mNodes.size());
+    EXPECT_EQ(mScene->mRootNode, stats.mNodes[0].mNode);
+    EXPECT_EQ(UINT_MAX, stats.mNodes[0].mParent);
+    EXPECT_EQ(1u, stats.mNodes[0].mDepth);
+    EXPECT_EQ(0u, stats.mNodes[1].mParent);
+    EXPECT_EQ(2u, stats.mNodes[1].mDepth);
+    EXPECT_EQ(1u, stats.mNodes[2].mParent);
+    EXPECT_EQ(3u, stats.mNodes[2].mDepth);
+    EXPECT_FLOAT_EQ(10.0f, stats.mNodes[2].mWorldTransform.a4);
+}
+
+TEST_F(utSceneAnalysis, boundsTest) {
+    SceneStatistics stats;
+    AnalyzeScene(mScene, stats, 0);
+
+    const aiAABB &meshBox = stats.mMeshes[0].mAABB;
+    EXPECT_EQ(aiVector3D(0, 0, 0), meshBox.mMin);
+    EXPECT_EQ(aiVector3D(1, 1, 0), meshBox.mMax);
+
+    // the translated instance
+    EXPECT_EQ(aiVector3D(10, 0, 0), stats.mNodes[1].mAABB.mMin);
+    EXPECT_EQ(aiVector3D(11, 1, 0), stats.mNodes[1].mAABB.mMax);
+
+    // no meshes below the leaf
+    EXPECT_GT(stats.mNodes[2].mAABB.mMin.x, stats.mNodes[2].mAABB.mMax.x);
+
+    // the root covers both instances
+    EXPECT_EQ(aiVector3D(0, 0, 0), stats.mNodes[0].mAABB.mMin);
+    EXPECT_EQ(aiVector3D(11, 1, 0), stats.mNodes[0].mAABB.mMax);
+    EXPECT_EQ(stats.mNodes[0].mAABB.mMin, stats.mAABB.mMin);
+    EXPECT_EQ(stats.mNodes[0].mAABB.mMax, stats.mAABB.mMax);
+}
+
+TEST_F(utSceneAnalysis, skipNodeBoundsTest) {
+    SceneStatistics stats;
+    AnalyzeScene(mScene, stats, -1, false);
+
+    EXPECT_EQ(aiVector3D(1, 1, 0), stats.mMeshes[0].mAABB.mMax);
+    EXPECT_GT(stats.mAABB.mMin.x, stats.mAABB.mMax.x);
+}
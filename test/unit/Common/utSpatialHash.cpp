@@ -0,0 +1,101 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/SpatialHash.h>
+#include <assimp/SpatialSort.h>
+
+#include <algorithm>
+
+using namespace Assimp;
+
+class utSpatialHash : public ::testing::Test {
+public:
+    std::vector<aiVector3D> vecs;
+
+protected:
+    void SetUp() override {
+        ::srand(static_cast<unsigned>(time(0)));
+        vecs.resize(1000);
+        for (size_t i = 0; i < vecs.size(); ++i) {
+            vecs[i].x = static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / 10));
+            vecs[i].y = static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / 10));
+            vecs[i].z = static_cast<float>(rand()) / (static_cast<float>(RAND_MAX / 10)) - 5.0f;
+        }
+        // a few exact duplicates
+        for (size_t i = 0; i < 10; ++i) {
+            vecs[i + 500] = vecs[i];
+        }
+    }
+};
+
+TEST_F(utSpatialHash, emptyTest) {
+    SpatialHash hash(nullptr, 0, sizeof(aiVector3D), 0.1f);
+    std::vector<unsigned int> indices;
+    hash.FindPositions(aiVector3D(0, 0, 0), indices);
+    EXPECT_TRUE(indices.empty());
+}
+
+TEST_F(utSpatialHash, findDuplicatesTest) {
+    SpatialHash hash(&vecs[0], static_cast<unsigned int>(vecs.size()), sizeof(aiVector3D), 1e-5f);
+
+    std::vector<unsigned int> indices;
+    hash.FindPositions(vecs[3], indices);
+    std::sort(indices.begin(), indices.end());
+    ASSERT_EQ(2u, indices.size());
+    EXPECT_EQ(3u, indices[0]);
+    EXPECT_EQ(503u, indices[1]);
+}
+
+TEST_F(utSpatialHash, matchesSpatialSortTest) {
+    const ai_real radius = 0.5f;
+    SpatialHash hash(&vecs[0], static_cast<unsigned int>(vecs.size()), sizeof(aiVector3D), radius);
+    SpatialSort sort(&vecs[0], static_cast<unsigned int>(vecs.size()), sizeof(aiVector3D));
+
+    std::vector<unsigned int> fromHash, fromSort;
+    for (size_t i = 0; i < vecs.size(); i += 7) {
+        hash.FindPositions(vecs[i], fromHash);
+        sort.FindPositions(vecs[i], radius, fromSort);
+        std::sort(fromHash.begin(), fromHash.end());
+        std::sort(fromSort.begin(), fromSort.end());
+        EXPECT_EQ(fromSort, fromHash);
+    }
+}
@@ -40,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/XmlParser.h>
 #include <assimp/DefaultIOStream.h>
 #include <assimp/DefaultIOSystem.h>
+#include <assimp/MemoryIOWrapper.h>
 
 using namespace Assimp;
 
@@ -86,3 +87,35 @@ TEST_F(utXmlParser, parse_xml_and_traverse_test) {
         EXPECT_FALSE(nodeName.empty());
     }
 }
+
+TEST_F(utXmlParser, parse_in_place_and_text_view_test) {
+    static const char xml[] =
+            "<?xml version=\"1.0\"?>\n"
+            "<root><!-- comment --><float_array count=\"3\"> 1.5 2 3</float_array><empty/></root>";
+    MemoryIOStream stream(reinterpret_cast<const uint8_t *>(xml), sizeof(xml) - 1);
+
+    XmlParser parser;
+    EXPECT_TRUE(parser.parse(&stream, pugi::parse_default));
+    XmlNode root = parser.getRootNode().child("root");
+    ASSERT_FALSE(root.empty());
+
+    // Without parse_comments only the elements are children
+    size_t numChildren = 0;
+    for (XmlNode child : root.children()) {
+        EXPECT_EQ(pugi::node_element, child.type());
+        ++numChildren;
+    }
+    EXPECT_EQ(2U, numChildren);
+
+    XmlNode array = root.child("float_array");
+    const char *text = nullptr;
+    EXPECT_TRUE(XmlParser::getValueAsCString(array, text));
+    EXPECT_STREQ(" 1.5 2 3", text);
+
+    XmlNode empty = root.child("empty");
+    EXPECT_TRUE(XmlParser::getValueAsCString(empty, text));
+    EXPECT_STREQ("", text);
+
+    XmlNode missing = root.child("missing");
+    EXPECT_FALSE(XmlParser::getValueAsCString(missing, text));
+}
@@ -0,0 +1,174 @@
+/*-------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+-------------------------------------------------------------------------*/
+#include "UnitTestPCH.h"
+#include "UnitTestPCH.h"
+#include <assimp/XmlStreamReader.h>
+#include <assimp/MemoryIOWrapper.h>
+
+#include <string>
+
+using namespace Assimp;
+
+class utXmlStreamReader : public ::testing::Test {
+    // empty
+};
+
+TEST_F(utXmlStreamReader, read_events_test) {
+    static const char xml[] =
+            "\xef\xbb\xbf<?xml version=\"1.0\"?>\n"
+            "<!DOCTYPE root [ <!ELEMENT root ANY> ]>\n"
+            "<root a=\"1 &amp; 2\" b='x'>\n"
+            "  <!-- comment -->\n"
+            "  <item>&lt;text&#65;&#x42;&gt;</item>\n"
+            "  <empty/>\n"
+            "  <![CDATA[<raw>]]>\n"
+            "</root>\n";
+    MemoryIOStream stream(reinterpret_cast<const uint8_t *>(xml), sizeof(xml) - 1);
+    XmlStreamReader reader(&stream);
+
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(XmlStreamReader::Event_StartElement, reader.getEventType());
+    EXPECT_EQ("root", reader.getName());
+    EXPECT_EQ(1U, reader.getDepth());
+    EXPECT_STREQ("1 & 2", reader.getAttribute("a"));
+    EXPECT_STREQ("x", reader.getAttribute("b"));
+    EXPECT_EQ(nullptr, reader.getAttribute("c"));
+
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(XmlStreamReader::Event_StartElement, reader.getEventType());
+    EXPECT_EQ("item", reader.getName());
+    EXPECT_EQ(2U, reader.getDepth());
+
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(XmlStreamReader::Event_Text, reader.getEventType());
+    EXPECT_EQ("<textAB>", reader.getText());
+
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(XmlStreamReader::Event_EndElement, reader.getEventType());
+    EXPECT_EQ("item", reader.getName());
+
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(XmlStreamReader::Event_StartElement, reader.getEventType());
+    EXPECT_EQ("empty", reader.getName());
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(XmlStreamReader::Event_EndElement, reader.getEventType());
+    EXPECT_EQ("empty", reader.getName());
+    EXPECT_EQ(2U, reader.getDepth());
+
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(XmlStreamReader::Event_Text, reader.getEventType());
+    EXPECT_EQ("<raw>", reader.getText());
+
+    ASSERT_TRUE(reader.read());
+    EXPECT_EQ(XmlStreamReader::Event_EndElement, reader.getEventType());
+    EXPECT_EQ("root", reader.getName());
+    EXPECT_EQ(1U, reader.getDepth());
+
+    EXPECT_FALSE(reader.read());
+}
+
+TEST_F(utXmlStreamReader, read_children_across_blocks_test) {
+    // Large enough to span several blocks of the reader
+    const unsigned int numVertices = 20000;
+    std::string xml = "<mesh><vertices>";
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        xml += "<vertex x=\"" + std::to_string(i) + "\"><skip><deeper/></skip></vertex>";
+    }
+    xml += "</vertices><name>box</name></mesh>";
+    ASSERT_GT(xml.size(), 2 * XmlStreamReader::BlockSize);
+
+    MemoryIOStream stream(reinterpret_cast<const uint8_t *>(xml.c_str()), xml.size());
+    XmlStreamReader reader(&stream);
+    ASSERT_TRUE(reader.read());
+    const size_t meshDepth = reader.getDepth();
+
+    unsigned int count = 0;
+    std::string name;
+    while (reader.nextChild(meshDepth)) {
+        if (reader.getName() == "vertices") {
+            const size_t depth = reader.getDepth();
+            while (reader.nextChild(depth)) {
+                ASSERT_EQ("vertex", reader.getName());
+                EXPECT_EQ(std::to_string(count), reader.getAttribute("x"));
+                ++count;
+            }
+        } else if (reader.getName() == "name") {
+            reader.readElementText(name);
+        }
+    }
+    EXPECT_EQ(numVertices, count);
+    EXPECT_EQ("box", name);
+    EXPECT_FALSE(reader.read());
+}
+
+TEST_F(utXmlStreamReader, read_subtree_test) {
+    static const char xml[] =
+            "<model><material id=\"m&amp;1\"><color r=\"1\"/>text</material><mesh/></model>";
+    MemoryIOStream stream(reinterpret_cast<const uint8_t *>(xml), sizeof(xml) - 1);
+    XmlStreamReader reader(&stream);
+    ASSERT_TRUE(reader.read());
+    ASSERT_TRUE(reader.nextChild(reader.getDepth()));
+    ASSERT_EQ("material", reader.getName());
+
+    XmlParser parser;
+    XmlNode node;
+    ASSERT_TRUE(reader.readSubtree(parser, node));
+    EXPECT_STREQ("material", node.name());
+    EXPECT_STREQ("m&1", node.attribute("id").as_string());
+    EXPECT_STREQ("1", node.child("color").attribute("r").as_string());
+    EXPECT_STREQ("text", node.text().get());
+
+    // The reader continues behind the subtree
+    ASSERT_TRUE(reader.nextChild(1));
+    EXPECT_EQ("mesh", reader.getName());
+    EXPECT_FALSE(reader.nextChild(1));
+    EXPECT_FALSE(reader.read());
+}
+
+TEST_F(utXmlStreamReader, malformed_input_test) {
+    static const char mismatched[] = "<a><b></a></b>";
+    MemoryIOStream stream(reinterpret_cast<const uint8_t *>(mismatched), sizeof(mismatched) - 1);
+    XmlStreamReader reader(&stream);
+    EXPECT_THROW(while (reader.read()) {}, DeadlyImportError);
+
+    static const char unclosed[] = "<a><b/>";
+    MemoryIOStream stream2(reinterpret_cast<const uint8_t *>(unclosed), sizeof(unclosed) - 1);
+    XmlStreamReader reader2(&stream2);
+    EXPECT_THROW(while (reader2.read()) {}, DeadlyImportError);
+}
@@ -41,6 +41,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 
 #include <assimp/Exporter.hpp>
+#include <assimp/cexport.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
 #include <assimp/ProgressHandler.hpp>
 
 using namespace Assimp;
@@ -101,3 +105,102 @@ TEST_F(ExporterTest, ExporterIdTest) {
     const aiExportFormatDesc *desc = exporter.GetExportFormatDescription(exportFormatCount);
     EXPECT_EQ(nullptr, desc) << "More exporters than claimed";
 }
+
+// The exporter shares the scene data with the caller, steps and writers must not modify it
+TEST_F(ExporterTest, ExportLeavesSourceSceneUntouchedTest) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_LT(0u, scene->mNumMeshes);
+    const aiMesh *mesh = scene->mMeshes[0];
+    ASSERT_TRUE(mesh->HasNormals());
+    ASSERT_TRUE(mesh->HasTextureCoords(0));
+    const unsigned int numVertices = mesh->mNumVertices;
+    const std::vector<aiVector3D> normals(mesh->mNormals, mesh->mNormals + numVertices);
+    const std::vector<aiVector3D> uvs(mesh->mTextureCoords[0], mesh->mTextureCoords[0] + numVertices);
+
+    Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(scene, "glb2",
+            aiProcess_FlipUVs | aiProcess_FlipWindingOrder | aiProcess_JoinIdenticalVertices);
+    ASSERT_NE(nullptr, blob);
+
+    ASSERT_EQ(mesh, scene->mMeshes[0]);
+    ASSERT_EQ(numVertices, mesh->mNumVertices);
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        EXPECT_EQ(normals[i], mesh->mNormals[i]);
+        EXPECT_EQ(uvs[i], mesh->mTextureCoords[0][i]);
+    }
+}
+
+namespace {
+
+// Hands out a caller-owned buffer for the first request, heap memory afterwards
+struct BufferAllocator {
+    std::vector<uint8_t> buffer;
+    bool bufferInUse = false;
+    unsigned int allocations = 0;
+    unsigned int releases = 0;
+};
+
+void *AllocateFromBuffer(size_t size, void *user) {
+    BufferAllocator *alloc = static_cast<BufferAllocator *>(user);
+    ++alloc->allocations;
+    if (!alloc->bufferInUse && size <= alloc->buffer.size()) {
+        alloc->bufferInUse = true;
+        return alloc->buffer.data();
+    }
+    return new uint8_t[size];
+}
+
+void ReleaseToBuffer(void *data, void *user) {
+    BufferAllocator *alloc = static_cast<BufferAllocator *>(user);
+    ++alloc->releases;
+    if (data == alloc->buffer.data()) {
+        alloc->bufferInUse = false;
+    } else {
+        delete[] static_cast<uint8_t *>(data);
+    }
+}
+
+} // namespace
+
+TEST_F(ExporterTest, ExportToBlobAllocatorTest) {
+    Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(scene, "glb2");
+    ASSERT_NE(nullptr, blob);
+    ASSERT_EQ(nullptr, blob->allocator);
+    const uint8_t *bytes = static_cast<const uint8_t *>(blob->data);
+    const std::vector<uint8_t> expected(bytes, bytes + blob->size);
+
+    BufferAllocator alloc;
+    const aiExportBlobAllocator allocator = { &AllocateFromBuffer, &ReleaseToBuffer, &alloc };
+    exporter.SetBlobAllocator(&allocator);
+
+    // a large enough size hint makes the caller's buffer the blob data
+    alloc.buffer.resize(expected.size());
+    exporter.SetBlobSizeHint(expected.size());
+    blob = exporter.ExportToBlob(scene, "glb2");
+    ASSERT_NE(nullptr, blob);
+    EXPECT_EQ(&allocator, blob->allocator);
+    EXPECT_EQ(alloc.buffer.data(), blob->data);
+    ASSERT_EQ(expected.size(), blob->size);
+    EXPECT_EQ(0, memcmp(expected.data(), blob->data, blob->size));
+
+    // a small one spreads the output over several chunks, which are joined once
+    alloc.buffer.resize(64);
+    exporter.SetBlobSizeHint(64);
+    blob = exporter.ExportToBlob(scene, "glb2");
+    ASSERT_NE(nullptr, blob);
+    EXPECT_NE(alloc.buffer.data(), blob->data);
+    ASSERT_EQ(expected.size(), blob->size);
+    EXPECT_EQ(0, memcmp(expected.data(), blob->data, blob->size));
+
+    exporter.FreeBlob();
+    EXPECT_LT(2u, alloc.allocations);
+    EXPECT_EQ(alloc.allocations, alloc.releases);
+    EXPECT_FALSE(alloc.bufferInUse);
+}
@@ -43,6 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 
 #include <assimp/postprocess.h>
+#include <assimp/scene.h>
 #include <assimp/Importer.hpp>
 
 using namespace Assimp;
@@ -65,3 +66,28 @@ TEST_F(utAMFImportExport, importAMFWithMatFromFileTest) {
     const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/AMF/test_with_mat.amf", aiProcess_ValidateDataStructure);
     EXPECT_NE(nullptr, scene);
 }
+
+TEST_F(utAMFImportExport, importAMFAllVerticesAndVolumesTest) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/AMF/test_with_mat.amf", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    // One mesh per <volume>, each with the four triangles of one half of the pyramid
+    ASSERT_EQ(2u, scene->mNumMeshes);
+    aiVector3D apex;
+    bool hasApex = false;
+    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *mesh = scene->mMeshes[i];
+        EXPECT_EQ(4u, mesh->mNumFaces);
+        for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+            if (mesh->mVertices[v].z > 0.5f) {
+                apex = mesh->mVertices[v];
+                hasApex = true;
+            }
+        }
+    }
+    ASSERT_TRUE(hasApex);
+    EXPECT_FLOAT_EQ(0.5f, apex.x);
+    EXPECT_FLOAT_EQ(0.5f, apex.y);
+    EXPECT_FLOAT_EQ(1.0f, apex.z);
+}
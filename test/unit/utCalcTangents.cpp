@@ -0,0 +1,140 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/CalcTangentsProcess.h"
+
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+namespace {
+
+// A unit quad in the xy plane facing +z, split into two triangles. With mirrored
+// set, the u coordinate runs along -x.
+aiMesh *CreateQuad(bool mirrored) {
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = 6;
+    mesh->mVertices = new aiVector3D[6];
+    mesh->mNormals = new aiVector3D[6];
+    mesh->mTextureCoords[0] = new aiVector3D[6];
+    mesh->mNumUVComponents[0] = 2;
+    const aiVector3D corners[6] = {
+        aiVector3D(0, 0, 0), aiVector3D(1, 0, 0), aiVector3D(1, 1, 0),
+        aiVector3D(0, 0, 0), aiVector3D(1, 1, 0), aiVector3D(0, 1, 0)
+    };
+    for (unsigned int i = 0; i < 6; ++i) {
+        mesh->mVertices[i] = corners[i];
+        mesh->mNormals[i] = aiVector3D(0, 0, 1);
+        mesh->mTextureCoords[0][i] = aiVector3D(mirrored ? 1 - corners[i].x : corners[i].x, corners[i].y, 0);
+    }
+    mesh->mNumFaces = 2;
+    mesh->mFaces = new aiFace[2];
+    for (unsigned int f = 0; f < 2; ++f) {
+        mesh->mFaces[f].mNumIndices = 3;
+        mesh->mFaces[f].mIndices = new unsigned int[3];
+        for (unsigned int i = 0; i < 3; ++i) {
+            mesh->mFaces[f].mIndices[i] = f * 3 + i;
+        }
+    }
+    return mesh;
+}
+
+} // namespace
+
+class utCalcTangents : public ::testing::Test {
+protected:
+    CalcTangentsProcess process;
+};
+
+TEST_F(utCalcTangents, needsNormalsTest) {
+    aiMesh *mesh = CreateQuad(false);
+    delete[] mesh->mNormals;
+    mesh->mNormals = nullptr;
+    EXPECT_FALSE(process.ProcessMesh(mesh, 0));
+    EXPECT_EQ(nullptr, mesh->mTangents);
+    delete mesh;
+}
+
+TEST_F(utCalcTangents, mikkTSpaceQuadTest) {
+    process.SetMikkTSpace(true);
+    aiMesh *mesh = CreateQuad(false);
+    EXPECT_TRUE(process.ProcessMesh(mesh, 0));
+    ASSERT_NE(nullptr, mesh->mTangents);
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        EXPECT_TRUE(mesh->mTangents[i].Equal(aiVector3D(1, 0, 0), 1e-5f));
+        EXPECT_TRUE(mesh->mBitangents[i].Equal(aiVector3D(0, 1, 0), 1e-5f));
+    }
+    delete mesh;
+}
+
+TEST_F(utCalcTangents, mikkTSpaceMirroredTest) {
+    process.SetMikkTSpace(true);
+    aiMesh *mesh = CreateQuad(true);
+    EXPECT_TRUE(process.ProcessMesh(mesh, 0));
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        // u runs along -x, v still along +y: the sign flips the bitangent
+        EXPECT_TRUE(mesh->mTangents[i].Equal(aiVector3D(-1, 0, 0), 1e-5f));
+        EXPECT_TRUE(mesh->mBitangents[i].Equal(aiVector3D(0, 1, 0), 1e-5f));
+    }
+    delete mesh;
+}
+
+TEST_F(utCalcTangents, mikkTSpaceParallelSceneTest) {
+    process.SetMikkTSpace(true);
+    process.SetNumThreads(4);
+
+    aiScene scene;
+    scene.mNumMeshes = 8;
+    scene.mMeshes = new aiMesh *[scene.mNumMeshes];
+    for (unsigned int m = 0; m < scene.mNumMeshes; ++m) {
+        scene.mMeshes[m] = CreateQuad(m % 2 == 1);
+    }
+    process.Execute(&scene);
+
+    for (unsigned int m = 0; m < scene.mNumMeshes; ++m) {
+        ASSERT_NE(nullptr, scene.mMeshes[m]->mTangents);
+        EXPECT_TRUE(scene.mMeshes[m]->mTangents[0].Equal(aiVector3D(m % 2 == 1 ? -1.0f : 1.0f, 0, 0), 1e-5f));
+    }
+}
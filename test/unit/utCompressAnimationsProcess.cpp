@@ -0,0 +1,156 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/CompressAnimationsProcess.h"
+#include <assimp/scene.h>
+
+#include <cmath>
+
+using namespace Assimp;
+
+class utCompressAnimationsProcess : public ::testing::Test {
+public:
+    utCompressAnimationsProcess() :
+            Test(), mProcess(nullptr), mChannel(nullptr), mScene(nullptr) {
+        // empty
+    }
+
+    void SetUp() override {
+        mProcess = new CompressAnimationsProcess;
+        mChannel = new aiNodeAnim();
+        mChannel->mNodeName.Set("node");
+
+        aiAnimation *anim = new aiAnimation();
+        anim->mTicksPerSecond = 1.0;
+        anim->mNumChannels = 1;
+        anim->mChannels = new aiNodeAnim *[1];
+        anim->mChannels[0] = mChannel;
+
+        mScene = new aiScene();
+        mScene->mNumAnimations = 1;
+        mScene->mAnimations = new aiAnimation *[1];
+        mScene->mAnimations[0] = anim;
+    }
+
+    void TearDown() override {
+        delete mProcess;
+        delete mScene;
+    }
+
+    // Fills the channel with numKeys keys, one per tick
+    void FillChannel(unsigned int numKeys, bool curved) {
+        mChannel->mNumPositionKeys = mChannel->mNumRotationKeys = mChannel->mNumScalingKeys = numKeys;
+        mChannel->mPositionKeys = new aiVectorKey[numKeys];
+        mChannel->mRotationKeys = new aiQuatKey[numKeys];
+        mChannel->mScalingKeys = new aiVectorKey[numKeys];
+        for (unsigned int i = 0; i < numKeys; ++i) {
+            const double time = static_cast<double>(i);
+            const ai_real x = curved ? std::sin(static_cast<ai_real>(i) * ai_real(0.1)) : static_cast<ai_real>(i);
+            mChannel->mPositionKeys[i] = aiVectorKey(time, aiVector3D(x, 2 * x, 0));
+            mChannel->mRotationKeys[i] = aiQuatKey(time, aiQuaternion(aiVector3D(0, 0, 1), static_cast<ai_real>(i) * ai_real(0.02)));
+            mChannel->mScalingKeys[i] = aiVectorKey(time, aiVector3D(1, 1, 1));
+        }
+    }
+
+protected:
+    CompressAnimationsProcess *mProcess;
+    aiNodeAnim *mChannel;
+    aiScene *mScene;
+};
+
+TEST_F(utCompressAnimationsProcess, dropLinearKeysTest) {
+    FillChannel(100, false);
+    mProcess->Execute(mScene);
+
+    EXPECT_EQ(2u, mChannel->mNumPositionKeys);
+    EXPECT_EQ(0.0, mChannel->mPositionKeys[0].mTime);
+    EXPECT_EQ(99.0, mChannel->mPositionKeys[1].mTime);
+    EXPECT_EQ(2u, mChannel->mNumRotationKeys);
+    EXPECT_EQ(1u, mChannel->mNumScalingKeys);
+
+    const CompressAnimationsProcess::Statistics &stats = mProcess->GetStatistics();
+    EXPECT_EQ(300u, stats.mKeysIn);
+    EXPECT_EQ(5u, stats.mKeysOut);
+    EXPECT_NEAR(5.0 / 300.0, stats.GetRatio(), 1e-6);
+}
+
+TEST_F(utCompressAnimationsProcess, errorBoundTest) {
+    FillChannel(100, true);
+    const ai_real bound = ai_real(1e-3);
+    mProcess->SetErrorBounds(bound, bound, bound);
+    mProcess->Execute(mScene);
+
+    EXPECT_LT(mChannel->mNumPositionKeys, 100u);
+    EXPECT_GT(mChannel->mNumPositionKeys, 2u);
+    const CompressAnimationsProcess::Statistics &stats = mProcess->GetStatistics();
+    EXPECT_LE(stats.mMaxPositionError, bound);
+    EXPECT_LE(stats.mMaxRotationError, bound);
+    EXPECT_LE(stats.mMaxScalingError, bound);
+}
+
+TEST_F(utCompressAnimationsProcess, resampleTest) {
+    FillChannel(10, true);
+    mProcess->SetResampleRate(ai_real(0.5));
+    mProcess->SetErrorBounds(0, 0, 0);
+    mProcess->Execute(mScene);
+
+    // Every second tick, the last key keeps its time
+    const double times[] = { 0.0, 2.0, 4.0, 6.0, 8.0, 9.0 };
+    ASSERT_EQ(6u, mChannel->mNumPositionKeys);
+    for (unsigned int i = 0; i < mChannel->mNumPositionKeys; ++i) {
+        EXPECT_DOUBLE_EQ(times[i], mChannel->mPositionKeys[i].mTime);
+        EXPECT_FLOAT_EQ(std::sin(static_cast<ai_real>(times[i]) * ai_real(0.1)), mChannel->mPositionKeys[i].mValue.x);
+    }
+}
+
+TEST_F(utCompressAnimationsProcess, quantizeRotationsTest) {
+    FillChannel(10, true);
+    mProcess->SetRotationQuantization(12);
+    mProcess->Execute(mScene);
+
+    for (unsigned int i = 0; i < mChannel->mNumRotationKeys; ++i) {
+        const aiQuaternion &q = mChannel->mRotationKeys[i].mValue;
+        EXPECT_NEAR(1.0, q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w, 1e-5);
+    }
+    EXPECT_GT(mProcess->GetStatistics().mMaxRotationError, 0);
+    EXPECT_LT(mProcess->GetStatistics().mMaxRotationError, ai_real(1e-2));
+}
@@ -0,0 +1,129 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+#include "UTLogStream.h"
+
+#include <assimp/ConcurrentLogger.hpp>
+
+#include <thread>
+
+using namespace Assimp;
+
+class utConcurrentLogger : public ::testing::Test {
+    // empty
+};
+
+TEST_F(utConcurrentLogger, singleThreadKeepsOrderTest) {
+    ConcurrentLogger logger(Logger::VERBOSE);
+    UTLogStream *stream = new UTLogStream;
+    EXPECT_TRUE(logger.attachStream(stream, Logger::Info | Logger::Warn));
+
+    logger.info("first");
+    logger.debug("filtered");
+    logger.warn("second");
+    logger.flush();
+
+    ASSERT_EQ(2u, stream->m_messages.size());
+    EXPECT_NE(std::string::npos, stream->m_messages[0].find("first"));
+    EXPECT_NE(std::string::npos, stream->m_messages[1].find("second"));
+}
+
+TEST_F(utConcurrentLogger, manyThreadsLoseNoMessageTest) {
+    static const unsigned int NumThreads = 8;
+    static const unsigned int NumMessages = 500;
+
+    ConcurrentLogger logger;
+    UTLogStream *stream = new UTLogStream;
+    logger.attachStream(stream, Logger::Warn);
+
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < NumThreads; ++t) {
+        threads.emplace_back([&logger]() {
+            for (unsigned int i = 0; i < NumMessages; ++i) {
+                logger.warn("message");
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    logger.flush();
+
+    EXPECT_EQ(NumThreads * NumMessages, stream->m_messages.size());
+}
+
+TEST_F(utConcurrentLogger, scopedContextTest) {
+    ConcurrentLogger logger;
+    UTLogStream *stream = new UTLogStream;
+    logger.attachStream(stream, Logger::Info);
+
+    int owner = 0;
+    EXPECT_EQ(nullptr, ConcurrentLogger::getContext());
+    {
+        ConcurrentLogger::ScopedContext context(&owner);
+        EXPECT_EQ(&owner, ConcurrentLogger::getContext());
+        logger.info("with context");
+    }
+    EXPECT_EQ(nullptr, ConcurrentLogger::getContext());
+    logger.info("without context");
+    logger.flush();
+
+    char tag[64];
+    ::snprintf(tag, sizeof(tag), "%p", static_cast<void *>(&owner));
+    ASSERT_EQ(2u, stream->m_messages.size());
+    EXPECT_NE(std::string::npos, stream->m_messages[0].find(tag));
+    EXPECT_EQ(std::string::npos, stream->m_messages[1].find(tag));
+}
+
+TEST_F(utConcurrentLogger, detachStreamTest) {
+    ConcurrentLogger logger;
+    UTLogStream stream;
+    logger.attachStream(&stream, Logger::Info);
+    logger.info("before");
+    EXPECT_TRUE(logger.detachStream(&stream, Logger::Info));
+    logger.info("after");
+    logger.flush();
+
+    ASSERT_EQ(1u, stream.m_messages.size());
+    EXPECT_FALSE(logger.detachStream(&stream, Logger::Info));
+}
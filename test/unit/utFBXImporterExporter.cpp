@@ -423,3 +423,32 @@ TEST_F(utFBXImporterExporter, importMaxPbrMaterialsSpecularGloss) {
     ASSERT_EQ(mat->Get("$raw.3dsMax|main|emit_color", aiTextureType_NONE, 0, emitColor), aiReturn_SUCCESS);
     EXPECT_EQ(emitColor, aiColor4D(1, 0, 1, 1));
 }
+
+TEST_F(utFBXImporterExporter, importParallelMeshConversion) {
+    for (const char *file : { ASSIMP_TEST_MODELS_DIR "/FBX/spider.fbx", ASSIMP_TEST_MODELS_DIR "/FBX/huesitos.fbx" }) {
+        Assimp::Importer serial, parallel;
+        serial.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, 0);
+        parallel.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, 4);
+        const aiScene *expected = serial.ReadFile(file, aiProcess_ValidateDataStructure);
+        const aiScene *scene = parallel.ReadFile(file, aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, expected);
+        ASSERT_NE(nullptr, scene);
+
+        ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+        for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+            const aiMesh *a = expected->mMeshes[i], *b = scene->mMeshes[i];
+            EXPECT_EQ(a->mName, b->mName);
+            EXPECT_EQ(a->mMaterialIndex, b->mMaterialIndex);
+            ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+            ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+            for (unsigned int v = 0; v < a->mNumVertices; ++v) {
+                EXPECT_EQ(a->mVertices[v], b->mVertices[v]);
+            }
+            ASSERT_EQ(a->mNumBones, b->mNumBones);
+            for (unsigned int j = 0; j < a->mNumBones; ++j) {
+                EXPECT_EQ(a->mBones[j]->mName, b->mBones[j]->mName);
+                EXPECT_EQ(a->mBones[j]->mNumWeights, b->mBones[j]->mNumWeights);
+            }
+        }
+    }
+}
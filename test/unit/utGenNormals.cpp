@@ -84,3 +84,161 @@ TEST_F(GenNormalsTest, testSimpleTriangle) {
     piProcess->GenMeshVertexNormals(pcMesh, 0);
     EXPECT_TRUE(pcMesh->mNormals != NULL);
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testSharedVertices) {
+    // two triangles forming a roof, sharing the ridge vertices 0 and 1
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = 4;
+    mesh->mVertices = new aiVector3D[4];
+    mesh->mVertices[0] = aiVector3D(0.0f, 1.0f, 0.0f);
+    mesh->mVertices[1] = aiVector3D(0.0f, 1.0f, 1.0f);
+    mesh->mVertices[2] = aiVector3D(1.0f, 0.0f, 0.0f);
+    mesh->mVertices[3] = aiVector3D(-1.0f, 0.0f, 0.0f);
+    mesh->mNumFaces = 2;
+    mesh->mFaces = new aiFace[2];
+    const unsigned int indices[2][3] = { { 0, 1, 2 }, { 1, 0, 3 } };
+    for (unsigned int f = 0; f < 2; ++f) {
+        mesh->mFaces[f].mNumIndices = 3;
+        mesh->mFaces[f].mIndices = new unsigned int[3];
+        std::copy(indices[f], indices[f] + 3, mesh->mFaces[f].mIndices);
+    }
+
+    EXPECT_TRUE(piProcess->GenMeshVertexNormals(mesh, 0));
+    ASSERT_NE(nullptr, mesh->mNormals);
+
+    // the ridge gets the mean of both faces, pointing straight up
+    EXPECT_NEAR(0.0f, mesh->mNormals[0].x, 1e-5f);
+    EXPECT_NEAR(1.0f, std::fabs(mesh->mNormals[0].y), 1e-5f);
+    EXPECT_NEAR(0.0f, mesh->mNormals[0].z, 1e-5f);
+    EXPECT_NEAR(mesh->mNormals[0].y, mesh->mNormals[1].y, 1e-5f);
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testQuadAndPolygonCorners) {
+    // a quad and a pentagon in the z = 0 plane, every corner needs the face normal
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_POLYGON;
+    mesh->mNumVertices = 9;
+    mesh->mVertices = new aiVector3D[9];
+    mesh->mVertices[0] = aiVector3D(0.0f, 0.0f, 0.0f);
+    mesh->mVertices[1] = aiVector3D(1.0f, 0.0f, 0.0f);
+    mesh->mVertices[2] = aiVector3D(1.0f, 1.0f, 0.0f);
+    mesh->mVertices[3] = aiVector3D(0.0f, 1.0f, 0.0f);
+    mesh->mVertices[4] = aiVector3D(5.0f, 0.0f, 0.0f);
+    mesh->mVertices[5] = aiVector3D(6.0f, 0.0f, 0.0f);
+    mesh->mVertices[6] = aiVector3D(6.5f, 1.0f, 0.0f);
+    mesh->mVertices[7] = aiVector3D(5.5f, 2.0f, 0.0f);
+    mesh->mVertices[8] = aiVector3D(4.5f, 1.0f, 0.0f);
+    mesh->mNumFaces = 2;
+    mesh->mFaces = new aiFace[2];
+    mesh->mFaces[0].mNumIndices = 4;
+    mesh->mFaces[0].mIndices = new unsigned int[4]{ 0, 1, 2, 3 };
+    mesh->mFaces[1].mNumIndices = 5;
+    mesh->mFaces[1].mIndices = new unsigned int[5]{ 4, 5, 6, 7, 8 };
+
+    EXPECT_TRUE(piProcess->GenMeshVertexNormals(mesh, 0));
+    ASSERT_NE(nullptr, mesh->mNormals);
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        EXPECT_NEAR(0.0f, mesh->mNormals[i].x, 1e-5f);
+        EXPECT_NEAR(0.0f, mesh->mNormals[i].y, 1e-5f);
+        EXPECT_NEAR(1.0f, mesh->mNormals[i].z, 1e-5f);
+    }
+    delete mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testAngleWeightedCorners) {
+    // two unconnected triangles meeting at the origin: a 90 degree corner facing +z
+    // and a narrow corner of about 5.7 degrees facing +y
+    aiMesh *meshes[2];
+    for (aiMesh *&mesh : meshes) {
+        mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = 6;
+        mesh->mVertices = new aiVector3D[6];
+        mesh->mVertices[0] = aiVector3D(0.0f, 0.0f, 0.0f);
+        mesh->mVertices[1] = aiVector3D(1.0f, 0.0f, 0.0f);
+        mesh->mVertices[2] = aiVector3D(0.0f, 1.0f, 0.0f);
+        mesh->mVertices[3] = aiVector3D(0.0f, 0.0f, 0.0f);
+        mesh->mVertices[4] = aiVector3D(0.0f, 0.0f, 1.0f);
+        mesh->mVertices[5] = aiVector3D(0.1f, 0.0f, 1.0f);
+        mesh->mNumFaces = 2;
+        mesh->mFaces = new aiFace[2];
+        mesh->mFaces[0].mNumIndices = 3;
+        mesh->mFaces[0].mIndices = new unsigned int[3]{ 0, 1, 2 };
+        mesh->mFaces[1].mNumIndices = 3;
+        mesh->mFaces[1].mIndices = new unsigned int[3]{ 3, 4, 5 };
+    }
+
+    piProcess->SetAngleWeighted(false);
+    EXPECT_TRUE(piProcess->GenMeshVertexNormals(meshes[0], 0));
+    piProcess->SetAngleWeighted(true);
+    EXPECT_TRUE(piProcess->GenMeshVertexNormals(meshes[1], 0));
+
+    // plain mean of both face normals
+    const aiVector3D &plain = meshes[0]->mNormals[0];
+    EXPECT_NEAR(0.0f, plain.x, 1e-4f);
+    EXPECT_NEAR(0.70711f, plain.y, 1e-4f);
+    EXPECT_NEAR(0.70711f, plain.z, 1e-4f);
+
+    // the wide corner dominates: (0, atan(0.1), pi / 2) normalized
+    for (unsigned int i : { 0u, 3u }) {
+        const aiVector3D &weighted = meshes[1]->mNormals[i];
+        EXPECT_NEAR(0.0f, weighted.x, 1e-4f);
+        EXPECT_NEAR(0.06332f, weighted.y, 1e-4f);
+        EXPECT_NEAR(0.99799f, weighted.z, 1e-4f);
+    }
+    delete meshes[0];
+    delete meshes[1];
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(GenNormalsTest, testParallelMatchesSerial) {
+    // a bumpy grid, large enough to be split across threads
+    const unsigned int size = 200;
+    aiMesh *meshes[2];
+    for (aiMesh *&mesh : meshes) {
+        mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumFaces = (size - 1) * (size - 1) * 2;
+        mesh->mNumVertices = mesh->mNumFaces * 3;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        unsigned int v = 0, f = 0;
+        for (unsigned int y = 0; y + 1 < size; ++y) {
+            for (unsigned int x = 0; x + 1 < size; ++x) {
+                const aiVector3D p[4] = {
+                    aiVector3D(ai_real(x), ai_real(y), std::sin(ai_real(x * y))),
+                    aiVector3D(ai_real(x + 1), ai_real(y), std::sin(ai_real((x + 1) * y))),
+                    aiVector3D(ai_real(x + 1), ai_real(y + 1), std::sin(ai_real((x + 1) * (y + 1)))),
+                    aiVector3D(ai_real(x), ai_real(y + 1), std::sin(ai_real(x * (y + 1))))
+                };
+                const unsigned int tris[2][3] = { { 0, 1, 2 }, { 0, 2, 3 } };
+                for (const auto &tri : tris) {
+                    aiFace &face = mesh->mFaces[f++];
+                    face.mNumIndices = 3;
+                    face.mIndices = new unsigned int[3];
+                    for (unsigned int i = 0; i < 3; ++i) {
+                        mesh->mVertices[v] = p[tri[i]];
+                        face.mIndices[i] = v++;
+                    }
+                }
+            }
+        }
+    }
+
+    piProcess->SetMaxSmoothAngle(AI_DEG_TO_RAD(60.f));
+    piProcess->SetNumThreads(0);
+    EXPECT_TRUE(piProcess->GenMeshVertexNormals(meshes[0], 0));
+    piProcess->SetNumThreads(4);
+    EXPECT_TRUE(piProcess->GenMeshVertexNormals(meshes[1], 0));
+
+    for (unsigned int i = 0; i < meshes[0]->mNumVertices; ++i) {
+        EXPECT_EQ(meshes[0]->mNormals[i], meshes[1]->mNormals[i]);
+    }
+    delete meshes[0];
+    delete meshes[1];
+}
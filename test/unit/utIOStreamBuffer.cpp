@@ -144,3 +144,35 @@ TEST_F( IOStreamBufferTest, accessBlockIndexTest ) {
 
 }
 
+
+TEST_F( IOStreamBufferTest, lineViewTest ) {
+    const char lines[] = "first line\r\nsecond \\\n  continued\nthird line crossing the block\nlast";
+
+    char fname[]={ "lineviewtest.XXXXXX" };
+    auto* fs = MakeTmpFile(fname);
+    ASSERT_NE(nullptr, fs);
+    EXPECT_EQ( sizeof(lines) - 1, std::fwrite( lines, 1, sizeof(lines) - 1, fs ) );
+    std::fclose(fs);
+    fs = std::fopen(fname, "rb");
+    ASSERT_NE(nullptr, fs);
+    {
+        TestDefaultIOStream myStream( fs, fname );
+        IOStreamBuffer<char> myBuffer( 32 );
+        EXPECT_TRUE( myBuffer.open( &myStream ) );
+
+        std::vector<std::string> result;
+        const char *line = nullptr;
+        size_t length = 0;
+        while ( myBuffer.getNextDataLineView( line, length, '\\' ) ) {
+            EXPECT_TRUE( IsLineEnd( line[ length ] ) );
+            result.emplace_back( line, length );
+        }
+        ASSERT_EQ( 4u, result.size() );
+        EXPECT_EQ( "first line", result[ 0 ] );
+        EXPECT_EQ( "second   continued", result[ 1 ] );
+        EXPECT_EQ( "third line crossing the block", result[ 2 ] );
+        EXPECT_EQ( "last", result[ 3 ] );
+        EXPECT_TRUE( myBuffer.close() );
+    }
+    remove(fname);
+}
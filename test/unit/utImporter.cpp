@@ -44,9 +44,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "../../include/assimp/scene.h"
 #include "TestIOSystem.h"
 #include <assimp/BaseImporter.h>
+#include <assimp/Cancellation.h>
 #include <assimp/DefaultIOSystem.h>
+#include <assimp/ImportSettings.h>
 #include <assimp/Importer.hpp>
 
+#include <thread>
+
 using namespace ::std;
 using namespace ::Assimp;
 
@@ -381,3 +385,141 @@ TEST_F(ImporterTest, unexpectedException)
         EXPECT_TRUE(false);
     }
 }
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, importSettingsSnapshot) {
+    pImp->SetPropertyInteger("test.int", 42);
+    pImp->SetPropertyString("test.string", "shared");
+    auto settings = std::make_shared<const ImportSettings>(*pImp);
+
+    // the snapshot does not follow the importer it was taken from
+    pImp->SetPropertyInteger("test.int", 7);
+    EXPECT_EQ(42, settings->GetPropertyInteger("test.int"));
+    EXPECT_EQ("shared", settings->GetPropertyString("test.string"));
+    EXPECT_EQ(-1, settings->GetPropertyInteger("test.missing", -1));
+
+    Importer importer;
+    importer.SetPropertyInteger("test.dropped", 1);
+    importer.SetSettings(settings);
+    EXPECT_EQ(settings, importer.GetSettings());
+    EXPECT_EQ(0, importer.GetPropertyInteger("test.dropped", 0));
+    EXPECT_EQ(42, importer.GetPropertyInteger("test.int"));
+
+    // local properties take precedence, the snapshot stays as it is
+    importer.SetPropertyInteger("test.int", 3);
+    EXPECT_EQ(3, importer.GetPropertyInteger("test.int"));
+    EXPECT_EQ("shared", importer.GetPropertyString("test.string"));
+    EXPECT_EQ(42, settings->GetPropertyInteger("test.int"));
+
+    // snapshots of an importer include its shared settings
+    ImportSettings nested(importer);
+    EXPECT_EQ(3, nested.GetPropertyInteger("test.int"));
+    EXPECT_EQ("shared", nested.GetPropertyString("test.string"));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, importSettingsSharedByThreads) {
+    pImp->SetPropertyInteger(AI_CONFIG_PP_RVC_FLAGS, aiComponent_NORMALS);
+    auto settings = std::make_shared<const ImportSettings>(*pImp);
+
+    const unsigned int numThreads = 4;
+    std::vector<int> results(numThreads, 0);
+    std::vector<std::thread> threads;
+    for (unsigned int i = 0; i < numThreads; ++i) {
+        threads.emplace_back([settings, &results, i]() {
+            Importer importer;
+            importer.SetSettings(settings);
+            const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/BoxTextured-glTF/BoxTextured.gltf",
+                    aiProcess_RemoveComponent | aiProcess_ValidateDataStructure);
+            if (nullptr != scene && scene->mNumMeshes > 0) {
+                results[i] = scene->mMeshes[0]->HasNormals() ? 1 : 2;
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    for (int result : results) {
+        EXPECT_EQ(2, result);
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, cancelledTokenStopsImport) {
+    auto token = std::make_shared<CancellationToken>();
+    pImp->SetCancellationToken(token);
+    EXPECT_EQ(token, pImp->GetCancellationToken());
+
+    // not cancelled yet, the token must not change anything
+    EXPECT_NE(nullptr, pImp->ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate));
+
+    token->Cancel();
+    EXPECT_EQ(nullptr, pImp->ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/spider.obj", aiProcess_Triangulate));
+    EXPECT_NE(std::string::npos, std::string(pImp->GetErrorString()).find("cancelled"));
+    EXPECT_EQ(nullptr, pImp->ReadFile(ASSIMP_TEST_MODELS_DIR "/FBX/box.fbx", 0));
+}
+
+namespace {
+
+class AbortingProgressHandler : public ProgressHandler {
+public:
+    AbortingProgressHandler() :
+            mCalls(0) {
+        // empty
+    }
+
+    bool Update(float) override {
+        ++mCalls;
+        return false;
+    }
+
+    unsigned int mCalls;
+};
+
+} // namespace
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, progressHandlerAbortsImport) {
+    std::string obj;
+    for (unsigned int i = 0; i < 20000; ++i) {
+        obj += "v 0 0 0\nv 1 0 0\nv 0 1 0\nf -3 -2 -1\n";
+    }
+
+    AbortingProgressHandler *handler = new AbortingProgressHandler;
+    pImp->SetProgressHandler(handler);
+    EXPECT_EQ(nullptr, pImp->ReadFileFromMemory(obj.c_str(), obj.size(), 0, "obj"));
+    EXPECT_LT(0u, handler->mCalls);
+    EXPECT_NE(std::string::npos, std::string(pImp->GetErrorString()).find("cancelled"));
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ImporterTest, progressHandlerAbortsColladaParsing) {
+    std::string values;
+    for (unsigned int i = 0; i < 30000; ++i) {
+        values += "0 1 2 ";
+    }
+    const std::string dae =
+            "<?xml version=\"1.0\"?>\n"
+            "<COLLADA xmlns=\"http://www.collada.org/2005/11/COLLADASchema\" version=\"1.4.1\">\n"
+            "<library_geometries><geometry id=\"g\"><mesh>\n"
+            "<source id=\"p\"><float_array id=\"pa\" count=\"90000\">" + values + "</float_array>\n"
+            "<technique_common><accessor source=\"#pa\" count=\"30000\" stride=\"3\">"
+            "<param name=\"X\" type=\"float\"/><param name=\"Y\" type=\"float\"/><param name=\"Z\" type=\"float\"/>"
+            "</accessor></technique_common></source>\n"
+            "<vertices id=\"v\"><input semantic=\"POSITION\" source=\"#p\"/></vertices>\n"
+            "<triangles count=\"1\"><input semantic=\"VERTEX\" source=\"#v\" offset=\"0\"/><p>0 1 2</p></triangles>\n"
+            "</mesh></geometry></library_geometries>\n"
+            "<library_visual_scenes><visual_scene id=\"s\"><node id=\"n\"><instance_geometry url=\"#g\"/></node></visual_scene></library_visual_scenes>\n"
+            "<scene><instance_visual_scene url=\"#s\"/></scene>\n"
+            "</COLLADA>\n";
+
+    // the file itself is fine
+    EXPECT_NE(nullptr, pImp->ReadFileFromMemory(dae.c_str(), dae.size(), 0, "dae"));
+
+    AbortingProgressHandler *handler = new AbortingProgressHandler;
+    pImp->SetProgressHandler(handler);
+    EXPECT_EQ(nullptr, pImp->ReadFileFromMemory(dae.c_str(), dae.size(), 0, "dae"));
+    EXPECT_LT(0u, handler->mCalls);
+    EXPECT_NE(std::string::npos, std::string(pImp->GetErrorString()).find("cancelled"));
+}
@@ -42,6 +42,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractImportExportBase.h"
 #include "SceneDiffer.h"
 #include "UnitTestPCH.h"
+
+#include "AssetLib/Obj/ObjFileParser.h"
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <assimp/Exporter.hpp>
@@ -297,9 +299,12 @@ TEST_F(utObjImportExport, issue1453_segfault) {
             "v  1.0  1.0  0.0\n"
             "v  1.0  1.0  1.0\nB";
 
+    // A file with vertices only is a valid point cloud
     Assimp::Importer myimporter;
     const aiScene *scene = myimporter.ReadFileFromMemory(curObjModel, strlen(curObjModel), aiProcess_ValidateDataStructure);
-    EXPECT_EQ(nullptr, scene);
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(8u, scene->mMeshes[0]->mNumVertices);
+    EXPECT_TRUE(scene->mMeshes[0]->IsPointCloud());
 }
 
 TEST_F(utObjImportExport, relative_indices_Test) {
@@ -438,6 +443,61 @@ TEST_F(utObjImportExport, import_point_cloud) {
     ASSERT_NE(nullptr, scene);
 }
 
+TEST_F(utObjImportExport, import_point_statements_as_point_cloud) {
+    static const char *ObjModel =
+            "o cloud\n"
+            "v 0 0 0\n"
+            "v 1 0 0\n"
+            "v 0 1 0\n"
+            "p 1 2\n"
+            "p 3\n";
+
+    Assimp::Importer myimporter;
+    const aiScene *scene = myimporter.ReadFileFromMemory(ObjModel, strlen(ObjModel), aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(1u, scene->mNumMeshes);
+    const aiMesh *mesh = scene->mMeshes[0];
+    EXPECT_TRUE(mesh->IsPointCloud());
+    ASSERT_EQ(3u, mesh->mNumVertices);
+    EXPECT_EQ(aiVector3D(0, 1, 0), mesh->mVertices[2]);
+}
+
+#ifndef ASSIMP_BUILD_NO_EXPORT
+
+TEST_F(utObjImportExport, export_point_cloud_round_trip) {
+    static const char *ObjModel =
+            "o cloud\n"
+            "v 0 0 0\n"
+            "v 1 0 0\n"
+            "v 0 1 0\n"
+            "v 0 0 1\n"
+            "v 1 1 1\n"
+            "p 1 2 3\n"
+            "p 4 5\n";
+
+    Assimp::Importer myimporter;
+    const aiScene *scene = myimporter.ReadFileFromMemory(ObjModel, strlen(ObjModel), aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_TRUE(scene->mMeshes[0]->IsPointCloud());
+
+    ::Assimp::Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(scene, "obj");
+    ASSERT_NE(nullptr, blob);
+
+    Assimp::Importer reimporter;
+    const aiScene *sceneReImport = reimporter.ReadFileFromMemory(blob->data, blob->size, aiProcess_ValidateDataStructure, "obj");
+    ASSERT_NE(nullptr, sceneReImport);
+    ASSERT_EQ(1u, sceneReImport->mNumMeshes);
+    const aiMesh *mesh = sceneReImport->mMeshes[0];
+    EXPECT_TRUE(mesh->IsPointCloud());
+    ASSERT_EQ(5u, mesh->mNumVertices);
+    for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+        EXPECT_EQ(scene->mMeshes[0]->mVertices[i], mesh->mVertices[i]);
+    }
+}
+
+#endif // ASSIMP_BUILD_NO_EXPORT
+
 TEST_F(utObjImportExport, import_without_linend) {
     Assimp::Importer myImporter;
     const aiScene *scene = myImporter.ReadFile(ASSIMP_TEST_MODELS_DIR "/OBJ/box_without_lineending.obj", 0);
@@ -477,3 +537,87 @@ TEST_F(utObjImportExport, import_with_line_continuations) {
     EXPECT_NEAR(vertices[2].y, 0.5f, threshold);
     EXPECT_NEAR(vertices[2].z, -0.5f, threshold);
 }
+
+TEST_F(utObjImportExport, mixed_normals_and_uvs_per_face) {
+    static const char *curObjModel =
+            "v 0 0 0\n"
+            "v 1 0 0\n"
+            "v 1 1 0\n"
+            "v 0 1 0\n"
+            "vt 0 0\n"
+            "vt 1 0\n"
+            "vt 1 1\n"
+            "vn 0 0 1\n"
+            "f 1 2 3\n"
+            "f 1/1/1 3/3/1 4/2/1\n"
+            "l 1 2 3\n";
+
+    Assimp::Importer myImporter;
+    const aiScene *scene = myImporter.ReadFileFromMemory(curObjModel, strlen(curObjModel), 0);
+    ASSERT_NE(nullptr, scene);
+
+    ASSERT_EQ(scene->mNumMeshes, 1U);
+    const aiMesh *mesh = scene->mMeshes[0];
+    EXPECT_EQ(mesh->mNumFaces, 4U);
+    ASSERT_NE(nullptr, mesh->mNormals);
+    ASSERT_NE(nullptr, mesh->mTextureCoords[0]);
+
+    // The second triangle carries normals and uvs, the first one does not.
+    EXPECT_EQ(mesh->mNormals[3], aiVector3D(0, 0, 1));
+    EXPECT_EQ(mesh->mNormals[5], aiVector3D(0, 0, 1));
+    EXPECT_EQ(mesh->mTextureCoords[0][4], aiVector3D(1, 1, 0));
+    EXPECT_EQ(mesh->mTextureCoords[0][5], aiVector3D(1, 0, 0));
+    EXPECT_EQ(mesh->mVertices[5], aiVector3D(0, 1, 0));
+}
+
+TEST_F(utObjImportExport, chunked_parsing_matches_streamed_parsing) {
+    // Large enough to be split into several chunks
+    std::string objModel;
+    for (unsigned int i = 0; objModel.size() < 4 * ObjFileParser::MinChunkSize; ++i) {
+        if (i % 500 == 0) {
+            objModel += "o part" + std::to_string(i) + "\n";
+            objModel += "usemtl mat" + std::to_string(i % 3) + "\n";
+        }
+        objModel += "# quad " + std::to_string(i) + "\n";
+        objModel += "v " + std::to_string(i) + " 0 0\nv " + std::to_string(i) + " 1 0\nv \\\n " + std::to_string(i) + " 1 1\nv 0 0 " + std::to_string(i) + "\n";
+        objModel += "vt 0 0\nvt 1 0\nvt 1 1\nvn 0 0 1\n";
+        if (i % 2) {
+            objModel += "f -4/-3/-1 -3/-2/-1 -2/-1/-1 -1/-1/-1\n";
+        } else {
+            objModel += "f " + std::to_string(4 * i + 1) + "//" + std::to_string(i + 1) + " " + std::to_string(4 * i + 2) + "//" + std::to_string(i + 1) + " " + std::to_string(4 * i + 3) + "//" + std::to_string(i + 1) + "\n";
+            objModel += "l -1 -2 -3\n";
+        }
+    }
+
+    Assimp::Importer streamed;
+    streamed.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, 0);
+    const aiScene *expected = streamed.ReadFileFromMemory(objModel.data(), objModel.size(), 0);
+    ASSERT_NE(nullptr, expected);
+
+    Assimp::Importer chunked;
+    chunked.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, 4);
+    const aiScene *scene = chunked.ReadFileFromMemory(objModel.data(), objModel.size(), 0);
+    ASSERT_NE(nullptr, scene);
+
+    ASSERT_EQ(expected->mNumMeshes, scene->mNumMeshes);
+    ASSERT_EQ(expected->mNumMaterials, scene->mNumMaterials);
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh *a = expected->mMeshes[m];
+        const aiMesh *b = scene->mMeshes[m];
+        ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+        ASSERT_EQ(a->mNumFaces, b->mNumFaces);
+        EXPECT_EQ(a->mMaterialIndex, b->mMaterialIndex);
+        EXPECT_EQ(a->mPrimitiveTypes, b->mPrimitiveTypes);
+        ASSERT_EQ(a->HasNormals(), b->HasNormals());
+        ASSERT_EQ(a->HasTextureCoords(0), b->HasTextureCoords(0));
+        for (unsigned int v = 0; v < a->mNumVertices; ++v) {
+            ASSERT_EQ(a->mVertices[v], b->mVertices[v]);
+            if (a->HasNormals()) {
+                ASSERT_EQ(a->mNormals[v], b->mNormals[v]);
+            }
+            if (a->HasTextureCoords(0)) {
+                ASSERT_EQ(a->mTextureCoords[0][v], b->mTextureCoords[0][v]);
+            }
+        }
+    }
+}
@@ -45,6 +45,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <assimp/scene.h>
 #include <assimp/Exporter.hpp>
 #include <assimp/Importer.hpp>
+#include <assimp/config.h>
 
 using namespace ::Assimp;
 
@@ -144,17 +145,40 @@ TEST_F(utPLYImportExport, vertexColorTest) {
 TEST_F(utPLYImportExport, pointcloudTest) {
     Assimp::Importer importer;
 
-    //Could not use aiProcess_ValidateDataStructure since it's missing faces.
-    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/PLY/issue623.ply", 0);
-    EXPECT_NE(nullptr, scene);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/PLY/issue623.ply", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
 
     EXPECT_EQ(1u, scene->mNumMeshes);
     EXPECT_NE(nullptr, scene->mMeshes[0]);
     EXPECT_EQ(24u, scene->mMeshes[0]->mNumVertices);
     EXPECT_EQ(aiPrimitiveType::aiPrimitiveType_POINT, scene->mMeshes[0]->mPrimitiveTypes);
     EXPECT_EQ(0u, scene->mMeshes[0]->mNumFaces);
+    EXPECT_TRUE(scene->mMeshes[0]->IsPointCloud());
 }
 
+#ifndef ASSIMP_BUILD_NO_EXPORT
+
+// A point cloud is written without a face element and reads back as a point cloud
+TEST_F(utPLYImportExport, exportPointCloudTest) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/PLY/issue623.ply", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    Assimp::Exporter exporter;
+    const aiExportDataBlob *blob = exporter.ExportToBlob(scene, "ply");
+    ASSERT_NE(nullptr, blob);
+    const std::string data(static_cast<const char *>(blob->data), blob->size);
+    EXPECT_EQ(std::string::npos, data.find("element face"));
+
+    Assimp::Importer reimporter;
+    scene = reimporter.ReadFileFromMemory(blob->data, blob->size, aiProcess_ValidateDataStructure, "ply");
+    ASSERT_NE(nullptr, scene);
+    EXPECT_EQ(24u, scene->mMeshes[0]->mNumVertices);
+    EXPECT_TRUE(scene->mMeshes[0]->IsPointCloud());
+}
+
+#endif // ASSIMP_BUILD_NO_EXPORT
+
 static const char *test_file =
         "ply\n"
         "format ascii 1.0\n"
@@ -180,3 +204,115 @@ TEST_F(utPLYImportExport, parseErrorTest) {
     const aiScene *scene = importer.ReadFileFromMemory(test_file, strlen(test_file), 0);
     EXPECT_NE(nullptr, scene);
 }
+
+// Binary vertex records are decoded without element instances, check mixed types and byte order
+TEST_F(utPLYImportExport, binaryVertexRecordsTest) {
+    std::string file =
+            "ply\n"
+            "format binary_big_endian 1.0\n"
+            "element vertex 2\n"
+            "property double x\n"
+            "property float y\n"
+            "property short z\n"
+            "property uchar red\n"
+            "property ushort green\n"
+            "property int extra\n"
+            "property float nz\n"
+            "element face 1\n"
+            "property list uchar int vertex_indices\n"
+            "end_header\n";
+    auto appendBE = [&file](const void *value, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            file.push_back(static_cast<const char *>(value)[size - 1 - i]);
+        }
+    };
+    for (int i = 0; i < 2; ++i) {
+        const double x = 1.5 + i;
+        const float y = -2.0f * i;
+        const int16_t z = static_cast<int16_t>(-300 + i);
+        const uint8_t red = 255;
+        const uint16_t green = 0;
+        const int32_t extra = 12345;
+        const float nz = 1.0f;
+        appendBE(&x, sizeof(x));
+        appendBE(&y, sizeof(y));
+        appendBE(&z, sizeof(z));
+        appendBE(&red, sizeof(red));
+        appendBE(&green, sizeof(green));
+        appendBE(&extra, sizeof(extra));
+        appendBE(&nz, sizeof(nz));
+    }
+    const uint8_t numIndices = 3;
+    appendBE(&numIndices, sizeof(numIndices));
+    for (int32_t i : { 0, 1, 1 }) {
+        appendBE(&i, sizeof(i));
+    }
+
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFileFromMemory(file.data(), file.size(), 0, "ply");
+    ASSERT_NE(nullptr, scene);
+    const aiMesh *mesh = scene->mMeshes[0];
+    ASSERT_EQ(2u, mesh->mNumVertices);
+    ASSERT_EQ(1u, mesh->mNumFaces);
+    EXPECT_EQ(1u, mesh->mFaces[0].mIndices[2]);
+    ASSERT_TRUE(mesh->HasNormals());
+    ASSERT_TRUE(mesh->HasVertexColors(0));
+    EXPECT_FALSE(mesh->HasTextureCoords(0));
+    for (unsigned int i = 0; i < 2; ++i) {
+        EXPECT_EQ(aiVector3D(1.5f + i, -2.0f * i, -300.0f + i), mesh->mVertices[i]);
+        EXPECT_EQ(aiVector3D(0, 0, 1), mesh->mNormals[i]);
+        EXPECT_EQ(aiColor4D(1, 0, 0, 1), mesh->mColors[0][i]);
+    }
+}
+
+// Records of 15 bytes straddle the 1 MiB blocks the file is streamed in, and
+// the vertex list is long enough to be decoded by several threads
+TEST_F(utPLYImportExport, binaryRecordsAcrossBlocksTest) {
+    const unsigned int numVertices = 150000;
+    const unsigned int numFaces = numVertices / 3;
+    std::string file =
+            "ply\n"
+            "format binary_little_endian 1.0\n"
+            "element vertex " + std::to_string(numVertices) + "\n"
+            "property float x\n"
+            "property float y\n"
+            "property float z\n"
+            "property uchar red\n"
+            "property uchar green\n"
+            "property uchar blue\n"
+            "element face " + std::to_string(numFaces) + "\n"
+            "property list uchar int vertex_indices\n"
+            "end_header\n";
+    auto append = [&file](const void *value, size_t size) {
+        file.append(static_cast<const char *>(value), size);
+    };
+    for (unsigned int i = 0; i < numVertices; ++i) {
+        const float position[3] = { static_cast<float>(i), -0.5f * i, static_cast<float>(i % 7) };
+        const uint8_t color[3] = { static_cast<uint8_t>(i), 0, 255 };
+        append(position, sizeof(position));
+        append(color, sizeof(color));
+    }
+    for (int32_t f = 0; f < static_cast<int32_t>(numFaces); ++f) {
+        const uint8_t numIndices = 3;
+        const int32_t indices[3] = { 3 * f, 3 * f + 1, 3 * f + 2 };
+        append(&numIndices, sizeof(numIndices));
+        append(indices, sizeof(indices));
+    }
+    ASSERT_GT(file.size(), 2u * 1024u * 1024u);
+
+    for (int numThreads : { 1, 4 }) {
+        Assimp::Importer importer;
+        importer.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, numThreads);
+        const aiScene *scene = importer.ReadFileFromMemory(file.data(), file.size(), 0, "ply");
+        ASSERT_NE(nullptr, scene);
+        const aiMesh *mesh = scene->mMeshes[0];
+        ASSERT_EQ(numVertices, mesh->mNumVertices);
+        ASSERT_EQ(numFaces, mesh->mNumFaces);
+        ASSERT_TRUE(mesh->HasVertexColors(0));
+        for (unsigned int i = 0; i < numVertices; ++i) {
+            ASSERT_EQ(aiVector3D(static_cast<float>(i), -0.5f * i, static_cast<float>(i % 7)), mesh->mVertices[i]) << i;
+            ASSERT_EQ(aiColor4D((i % 256) / 255.0f, 0, 1, 1), mesh->mColors[0][i]) << i;
+        }
+        EXPECT_EQ(numVertices - 1, mesh->mFaces[numFaces - 1].mIndices[2]);
+    }
+}
@@ -99,8 +99,68 @@ TEST_F(utSTLImporterExporter, test_with_empty_solid) {
     EXPECT_EQ(nullptr, scene2);
 }
 
+TEST_F(utSTLImporterExporter, test_binary_weld_vertices) {
+    Assimp::Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_STL_WELD_VERTICES, true);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+    ASSERT_EQ(1u, scene->mNumMeshes);
+
+    const aiMesh *mesh = scene->mMeshes[0];
+    EXPECT_LT(mesh->mNumVertices, mesh->mNumFaces * 3);
+    ASSERT_NE(nullptr, mesh->mNormals);
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        ASSERT_EQ(3u, mesh->mFaces[i].mNumIndices);
+        for (unsigned int j = 0; j < 3; ++j) {
+            ASSERT_LT(mesh->mFaces[i].mIndices[j], mesh->mNumVertices);
+        }
+    }
+
+    // JoinIdenticalVertices compares the facet normals as well and can only keep more
+    Assimp::Importer plain;
+    const aiScene *unwelded = plain.ReadFile(ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", aiProcess_JoinIdenticalVertices);
+    ASSERT_NE(nullptr, unwelded);
+    EXPECT_EQ(mesh->mNumFaces, unwelded->mMeshes[0]->mNumFaces);
+    EXPECT_GE(unwelded->mMeshes[0]->mNumVertices, mesh->mNumVertices);
+}
+
+TEST_F(utSTLImporterExporter, test_binary_recompute_normals) {
+    Assimp::Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_STL_RECOMPUTE_NORMALS, true);
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    const aiMesh *mesh = scene->mMeshes[0];
+    for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
+        const aiVector3D *v = mesh->mVertices + i * 3;
+        aiVector3D expected = (v[1] - v[0]) ^ (v[2] - v[0]);
+        expected.NormalizeSafe();
+        EXPECT_NEAR(0.0, (mesh->mNormals[i * 3] - expected).Length(), 1e-5);
+    }
+}
+
 #ifndef ASSIMP_BUILD_NO_EXPORT
 
+TEST_F(utSTLImporterExporter, exporterBinaryTest) {
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/STL/Spider_binary.stl", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene);
+
+    Assimp::Exporter mAiExporter;
+    ASSERT_EQ(aiReturn_SUCCESS, mAiExporter.Export(scene, "stlb", "spiderExportBinary.stl"));
+
+    Assimp::Importer importer2;
+    const aiScene *scene2 = importer2.ReadFile("spiderExportBinary.stl", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, scene2);
+
+    const aiMesh *a = scene->mMeshes[0];
+    const aiMesh *b = scene2->mMeshes[0];
+    ASSERT_EQ(a->mNumVertices, b->mNumVertices);
+    for (unsigned int i = 0; i < a->mNumVertices; ++i) {
+        EXPECT_EQ(a->mVertices[i], b->mVertices[i]);
+    }
+}
+
 TEST_F(utSTLImporterExporter, exporterTest) {
     Assimp::Importer importer;
     const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/STL/Spider_ascii.stl", aiProcess_ValidateDataStructure);
@@ -41,6 +41,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "UnitTestPCH.h"
 #include <assimp/SceneCombiner.h>
 #include <assimp/mesh.h>
+#include <assimp/material.h>
+#include <assimp/scene.h>
 #include <memory>
 
 using namespace ::Assimp;
@@ -75,3 +77,37 @@ TEST_F(utSceneCombiner, CopySceneWithNullptr_AI_NO_EXCEPTion) {
     EXPECT_NO_THROW(SceneCombiner::CopyScene(nullptr, nullptr));
     EXPECT_NO_THROW(SceneCombiner::CopySceneFlat(nullptr, nullptr));
 }
+
+TEST_F(utSceneCombiner, ShareScene_MakeUnique_Test) {
+    std::unique_ptr<aiScene> source(new aiScene);
+    source->mRootNode = new aiNode("root");
+    source->mNumMeshes = 1;
+    source->mMeshes = new aiMesh *[1];
+    source->mMeshes[0] = new aiMesh;
+    source->mMeshes[0]->mNumVertices = 1;
+    source->mMeshes[0]->mVertices = new aiVector3D[1];
+    source->mMeshes[0]->mVertices[0] = aiVector3D(1, 2, 3);
+    source->mNumMaterials = 1;
+    source->mMaterials = new aiMaterial *[1];
+    source->mMaterials[0] = new aiMaterial;
+
+    aiScene *ptr = nullptr;
+    SceneCombiner::ShareScene(&ptr, source.get());
+    std::unique_ptr<aiScene> shared(ptr);
+    ASSERT_NE(nullptr, shared.get());
+    EXPECT_NE(source->mRootNode, shared->mRootNode);
+    EXPECT_EQ(source->mMeshes[0], shared->mMeshes[0]);
+    EXPECT_EQ(source->mMaterials[0], shared->mMaterials[0]);
+
+    SceneCombiner::MakeUnique(shared.get(), SceneComponent_Meshes);
+    EXPECT_NE(source->mMeshes[0], shared->mMeshes[0]);
+    EXPECT_EQ(source->mMaterials[0], shared->mMaterials[0]);
+
+    shared->mMeshes[0]->mVertices[0] = aiVector3D();
+    EXPECT_EQ(aiVector3D(1, 2, 3), source->mMeshes[0]->mVertices[0]);
+
+    // the shared material must survive the copy
+    shared.reset();
+    EXPECT_EQ(1U, source->mMeshes[0]->mNumVertices);
+    EXPECT_EQ(0U, source->mMaterials[0]->mNumProperties);
+}
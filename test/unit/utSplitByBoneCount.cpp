@@ -0,0 +1,180 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include "PostProcessing/SplitByBoneCountProcess.h"
+#include <assimp/scene.h>
+
+using namespace Assimp;
+
+class SplitByBoneCountTest : public ::testing::Test {
+public:
+    virtual void SetUp();
+    virtual void TearDown();
+
+protected:
+    // Creates a scene with one mesh. Face f is a triangle with its own vertices,
+    // all of them weighted to the bones of palettes[f].
+    aiScene *CreateScene(const std::vector<std::vector<unsigned int>> &palettes, unsigned int numBones);
+
+    SplitByBoneCountProcess *piProcess;
+};
+
+// ------------------------------------------------------------------------------------------------
+void SplitByBoneCountTest::SetUp() {
+    piProcess = new SplitByBoneCountProcess();
+    piProcess->mMaxBoneCount = 4;
+}
+
+// ------------------------------------------------------------------------------------------------
+void SplitByBoneCountTest::TearDown() {
+    delete piProcess;
+}
+
+// ------------------------------------------------------------------------------------------------
+aiScene *SplitByBoneCountTest::CreateScene(const std::vector<std::vector<unsigned int>> &palettes, unsigned int numBones) {
+    aiMesh *mesh = new aiMesh();
+    mesh->mName.Set("skin");
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumFaces = static_cast<unsigned int>(palettes.size());
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    mesh->mNumVertices = mesh->mNumFaces * 3;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+
+    std::vector<std::vector<aiVertexWeight>> weights(numBones);
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+        aiFace &face = mesh->mFaces[f];
+        face.mNumIndices = 3;
+        face.mIndices = new unsigned int[3];
+        for (unsigned int i = 0; i < 3; ++i) {
+            const unsigned int v = f * 3 + i;
+            face.mIndices[i] = v;
+            mesh->mVertices[v] = aiVector3D(static_cast<ai_real>(f), static_cast<ai_real>(i), 0);
+            for (unsigned int bone : palettes[f]) {
+                weights[bone].push_back(aiVertexWeight(v, 1.0f / palettes[f].size()));
+            }
+        }
+    }
+
+    mesh->mNumBones = numBones;
+    mesh->mBones = new aiBone *[numBones];
+    for (unsigned int b = 0; b < numBones; ++b) {
+        aiBone *bone = new aiBone();
+        bone->mName.Set("bone" + std::to_string(b));
+        bone->mNumWeights = static_cast<unsigned int>(weights[b].size());
+        bone->mWeights = new aiVertexWeight[bone->mNumWeights];
+        std::copy(weights[b].begin(), weights[b].end(), bone->mWeights);
+        mesh->mBones[b] = bone;
+    }
+
+    aiScene *scene = new aiScene();
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh *[1];
+    scene->mMeshes[0] = mesh;
+    scene->mRootNode = new aiNode();
+    scene->mRootNode->mNumMeshes = 1;
+    scene->mRootNode->mMeshes = new unsigned int[1];
+    scene->mRootNode->mMeshes[0] = 0;
+    return scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitByBoneCountTest, testPalettesArePacked) {
+    // Filling the first submesh with faces in order would put A and B into it and
+    // need a third submesh. C contains A and D contains B, two submeshes suffice.
+    const std::vector<unsigned int> A = { 0, 1 }, B = { 2, 3 }, C = { 0, 1, 4, 5 }, D = { 2, 3, 6, 7 };
+    aiScene *scene = CreateScene({ A, B, C, D, A, B }, 8);
+    static_cast<BaseProcess *>(piProcess)->Execute(scene);
+
+    ASSERT_EQ(2U, scene->mNumMeshes);
+    ASSERT_EQ(2U, scene->mRootNode->mNumMeshes);
+
+    unsigned int numFaces = 0;
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh *mesh = scene->mMeshes[m];
+        EXPECT_LE(mesh->mNumBones, 4U);
+        numFaces += mesh->mNumFaces;
+
+        // every vertex keeps all of its weights
+        std::vector<float> sum(mesh->mNumVertices, 0.0f);
+        for (unsigned int b = 0; b < mesh->mNumBones; ++b) {
+            for (unsigned int w = 0; w < mesh->mBones[b]->mNumWeights; ++w) {
+                sum[mesh->mBones[b]->mWeights[w].mVertexId] += mesh->mBones[b]->mWeights[w].mWeight;
+            }
+        }
+        for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+            EXPECT_NEAR(1.0f, sum[v], 1e-5f);
+        }
+    }
+    EXPECT_EQ(6U, numFaces);
+
+    delete scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitByBoneCountTest, testSmallMeshIsKept) {
+    aiScene *scene = CreateScene({ { 0, 1 }, { 2, 3 } }, 4);
+    aiMesh *mesh = scene->mMeshes[0];
+    static_cast<BaseProcess *>(piProcess)->Execute(scene);
+
+    ASSERT_EQ(1U, scene->mNumMeshes);
+    EXPECT_EQ(mesh, scene->mMeshes[0]);
+
+    delete scene;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SplitByBoneCountTest, testFaceWithTooManyBones) {
+    // No vertex exceeds the limit, but the second face needs bones 2 to 6
+    aiScene *scene = CreateScene({ { 0, 1 }, { 2, 3 } }, 7);
+    aiMesh *mesh = scene->mMeshes[0];
+    const unsigned int extra[3][2] = { { 4, 4 }, { 5, 5 }, { 6, 5 } }; // bone, vertex
+    for (const auto &e : extra) {
+        aiBone *bone = mesh->mBones[e[0]];
+        delete[] bone->mWeights;
+        bone->mNumWeights = 1;
+        bone->mWeights = new aiVertexWeight[1];
+        bone->mWeights[0] = aiVertexWeight(e[1], 0.5f);
+    }
+    EXPECT_THROW(static_cast<BaseProcess *>(piProcess)->Execute(scene), DeadlyImportError);
+
+    delete scene;
+}
@@ -0,0 +1,174 @@
+/*
+---------------------------------------------------------------------------
+Open Asset Import Library (assimp)
+---------------------------------------------------------------------------
+
+Copyright (c) 2006-2020, assimp team
+
+All rights reserved.
+
+Redistribution and use of this software in source and binary forms,
+with or without modification, are permitted provided that the following
+conditions are met:
+
+* Redistributions of source code must retain the above
+copyright notice, this list of conditions and the
+following disclaimer.
+
+* Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the
+following disclaimer in the documentation and/or other
+materials provided with the distribution.
+
+* Neither the name of the assimp team, nor the names of its
+contributors may be used to endorse or promote products
+derived from this software without specific prior
+written permission of the assimp team.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+---------------------------------------------------------------------------
+*/
+#include "UnitTestPCH.h"
+
+#include <assimp/Subdivision.h>
+#include <assimp/mesh.h>
+
+#include <cmath>
+#include <memory>
+
+using namespace Assimp;
+
+class SubdivisionTest : public ::testing::Test {
+protected:
+    // Verbose cube with an edge length of two around the origin, quads only.
+    // The faces from 'first' to 'last' (excluding) are put into the mesh.
+    static aiMesh *createCube(unsigned int first = 0, unsigned int last = 6) {
+        static const float corners[8][3] = {
+            { -1, -1, -1 }, { 1, -1, -1 }, { 1, 1, -1 }, { -1, 1, -1 },
+            { -1, -1, 1 }, { 1, -1, 1 }, { 1, 1, 1 }, { -1, 1, 1 }
+        };
+        static const unsigned int faces[6][4] = {
+            { 0, 3, 2, 1 }, { 4, 5, 6, 7 }, { 0, 1, 5, 4 },
+            { 1, 2, 6, 5 }, { 2, 3, 7, 6 }, { 3, 0, 4, 7 }
+        };
+
+        aiMesh *mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_POLYGON;
+        mesh->mNumFaces = last - first;
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        mesh->mNumVertices = mesh->mNumFaces * 4;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        for (unsigned int i = 0, v = 0; i < mesh->mNumFaces; ++i) {
+            aiFace &face = mesh->mFaces[i];
+            face.mIndices = new unsigned int[face.mNumIndices = 4];
+            for (unsigned int a = 0; a < 4; ++a, ++v) {
+                const float *c = corners[faces[first + i][a]];
+                mesh->mVertices[v] = aiVector3D(c[0], c[1], c[2]);
+                face.mIndices[a] = v;
+            }
+        }
+        return mesh;
+    }
+
+    // Verbose, bumpy grid of size x size quads. Large enough for every
+    // pass of the subdivider to be split across several threads.
+    static aiMesh *createGrid(unsigned int size) {
+        aiMesh *mesh = new aiMesh();
+        mesh->mPrimitiveTypes = aiPrimitiveType_POLYGON;
+        mesh->mNumFaces = size * size;
+        mesh->mFaces = new aiFace[mesh->mNumFaces];
+        mesh->mNumVertices = mesh->mNumFaces * 4;
+        mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+        static const unsigned int offsets[4][2] = { { 0, 0 }, { 1, 0 }, { 1, 1 }, { 0, 1 } };
+        for (unsigned int y = 0, f = 0, v = 0; y < size; ++y) {
+            for (unsigned int x = 0; x < size; ++x, ++f) {
+                aiFace &face = mesh->mFaces[f];
+                face.mIndices = new unsigned int[face.mNumIndices = 4];
+                for (unsigned int a = 0; a < 4; ++a, ++v) {
+                    const unsigned int px = x + offsets[a][0], py = y + offsets[a][1];
+                    mesh->mVertices[v] = aiVector3D(ai_real(px), ai_real(py), std::sin(ai_real(px * py)));
+                    face.mIndices[a] = v;
+                }
+            }
+        }
+        return mesh;
+    }
+
+    static std::unique_ptr<aiMesh> subdivide(aiMesh *mesh, unsigned int num, int numThreads) {
+        std::unique_ptr<Subdivider> div(Subdivider::Create(Subdivider::CATMULL_CLARKE, numThreads));
+        aiMesh *out = nullptr;
+        div->Subdivide(mesh, out, num, true);
+        return std::unique_ptr<aiMesh>(out);
+    }
+};
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SubdivisionTest, cubeCornersAreMoved) {
+    std::unique_ptr<aiMesh> out = subdivide(createCube(), 1, 1);
+    ASSERT_NE(nullptr, out);
+    EXPECT_EQ(24u, out->mNumFaces);
+    EXPECT_EQ(96u, out->mNumVertices);
+
+    // (F + 2R + (n - 3)P) / n for a corner touching three faces
+    unsigned int numCorners = 0;
+    for (unsigned int i = 0; i < out->mNumVertices; ++i) {
+        const aiVector3D &v = out->mVertices[i];
+        if (v.x > 0.5f && v.y > 0.5f && v.z > 0.5f) {
+            EXPECT_NEAR(5.f / 9.f, v.x, 1e-5f);
+            EXPECT_NEAR(5.f / 9.f, v.y, 1e-5f);
+            EXPECT_NEAR(5.f / 9.f, v.z, 1e-5f);
+            ++numCorners;
+        }
+    }
+    EXPECT_EQ(3u, numCorners);
+
+    out = subdivide(createCube(), 3, 1);
+    EXPECT_EQ(24u * 16u, out->mNumFaces);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SubdivisionTest, threadCountDoesNotChangeResult) {
+    // 64 x 64 quads give each of four threads 1024+ faces, edges and vertices
+    std::unique_ptr<aiMesh> serial = subdivide(createGrid(64), 2, 0);
+    std::unique_ptr<aiMesh> parallel = subdivide(createGrid(64), 2, 4);
+    ASSERT_EQ(serial->mNumVertices, parallel->mNumVertices);
+    ASSERT_EQ(serial->mNumFaces, parallel->mNumFaces);
+    for (unsigned int i = 0; i < serial->mNumVertices; ++i) {
+        EXPECT_EQ(serial->mVertices[i], parallel->mVertices[i]);
+    }
+    for (unsigned int i = 0; i < serial->mNumFaces; ++i) {
+        for (unsigned int a = 0; a < 4; ++a) {
+            EXPECT_EQ(serial->mFaces[i].mIndices[a], parallel->mFaces[i].mIndices[a]);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(SubdivisionTest, meshesAreSmoothedTogether) {
+    std::unique_ptr<aiMesh> whole = subdivide(createCube(), 2, -1);
+
+    aiMesh *parts[2] = { createCube(0, 3), createCube(3, 6) };
+    aiMesh *out[2] = { nullptr, nullptr };
+    std::unique_ptr<Subdivider> div(Subdivider::Create(Subdivider::CATMULL_CLARKE));
+    div->Subdivide(parts, 2, out, 2, true);
+    std::unique_ptr<aiMesh> first(out[0]), second(out[1]);
+
+    ASSERT_EQ(whole->mNumVertices, first->mNumVertices + second->mNumVertices);
+    for (unsigned int i = 0; i < whole->mNumVertices; ++i) {
+        const aiMesh *part = i < first->mNumVertices ? first.get() : second.get();
+        const aiVector3D &v = part->mVertices[i < first->mNumVertices ? i : i - first->mNumVertices];
+        EXPECT_NEAR(whole->mVertices[i].x, v.x, 1e-5f);
+        EXPECT_NEAR(whole->mVertices[i].y, v.y, 1e-5f);
+        EXPECT_NEAR(whole->mVertices[i].z, v.z, 1e-5f);
+    }
+}
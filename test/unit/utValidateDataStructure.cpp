@@ -44,7 +44,11 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <assimp/mesh.h>
 #include <assimp/scene.h>
-#include <ValidateDataStructure.h>
+#include <assimp/Exceptional.h>
+#include <assimp/Importer.hpp>
+#include "PostProcessing/ValidateDataStructure.h"
+
+#include <string>
 
 using namespace std;
 using namespace Assimp;
@@ -90,6 +94,110 @@ void ValidateDataStructureTest::TearDown()
 
 
 
+// ------------------------------------------------------------------------------------------------
+static aiMesh *CreateTriangleMesh(unsigned int numFaces) {
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = numFaces * 3;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    mesh->mNumFaces = numFaces;
+    mesh->mFaces = new aiFace[numFaces];
+    for (unsigned int i = 0; i < numFaces; ++i) {
+        aiFace &face = mesh->mFaces[i];
+        face.mNumIndices = 3;
+        face.mIndices = new unsigned int[3];
+        for (unsigned int a = 0; a < 3; ++a) {
+            face.mIndices[a] = i * 3 + a;
+            mesh->mVertices[i * 3 + a] = aiVector3D(static_cast<ai_real>(i), static_cast<ai_real>(a), 0);
+        }
+    }
+    return mesh;
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDataStructureTest, testDuplicateCameraNames) {
+    scene->mFlags |= AI_SCENE_FLAGS_INCOMPLETE;
+    scene->mRootNode->mNumChildren = 2;
+    scene->mRootNode->mChildren = new aiNode *[2];
+    for (unsigned int i = 0; i < 2; ++i) {
+        aiNode *node = new aiNode(i ? "camera1" : "camera0");
+        node->mParent = scene->mRootNode;
+        scene->mRootNode->mChildren[i] = node;
+    }
+
+    scene->mNumCameras = 2;
+    scene->mCameras = new aiCamera *[2];
+    scene->mCameras[0] = new aiCamera();
+    scene->mCameras[0]->mName.Set("camera0");
+    scene->mCameras[1] = new aiCamera();
+    scene->mCameras[1]->mName.Set("camera1");
+    EXPECT_NO_THROW(vds->Execute(scene));
+
+    // two cameras with the same name
+    scene->mCameras[1]->mName.Set("camera0");
+    EXPECT_THROW(vds->Execute(scene), DeadlyImportError);
+
+    // a camera without a node
+    scene->mCameras[1]->mName.Set("camera2");
+    EXPECT_THROW(vds->Execute(scene), DeadlyImportError);
+
+    // two nodes with the name of a camera
+    scene->mCameras[1]->mName.Set("camera1");
+    scene->mRootNode->mChildren[1]->mName.Set("camera0");
+    EXPECT_THROW(vds->Execute(scene), DeadlyImportError);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDataStructureTest, testDuplicateBoneNames) {
+    aiMesh *mesh = CreateTriangleMesh(1);
+    mesh->mNumBones = 2;
+    mesh->mBones = new aiBone *[2];
+    for (unsigned int i = 0; i < 2; ++i) {
+        mesh->mBones[i] = new aiBone();
+        mesh->mBones[i]->mName.Set(i ? "bone1" : "bone0");
+    }
+    scene->mNumMeshes = 1;
+    scene->mMeshes = new aiMesh *[1];
+    scene->mMeshes[0] = mesh;
+    EXPECT_NO_THROW(vds->Execute(scene));
+
+    mesh->mBones[1]->mName.Set("bone0");
+    EXPECT_THROW(vds->Execute(scene), DeadlyImportError);
+}
+
+// ------------------------------------------------------------------------------------------------
+TEST_F(ValidateDataStructureTest, testParallelMeshValidationReportsFirstError) {
+    // enough faces to validate the meshes on several threads
+    const unsigned int numMeshes = 64;
+    const unsigned int facesPerMesh = 512;
+    scene->mNumMeshes = numMeshes;
+    scene->mMeshes = new aiMesh *[numMeshes];
+    scene->mRootNode->mNumMeshes = numMeshes;
+    scene->mRootNode->mMeshes = new unsigned int[numMeshes];
+    for (unsigned int i = 0; i < numMeshes; ++i) {
+        scene->mMeshes[i] = CreateTriangleMesh(facesPerMesh);
+        scene->mRootNode->mMeshes[i] = i;
+    }
+    ASSERT_GE(numMeshes * facesPerMesh, ValidateDSProcess::MinFacesPerThread);
+
+    Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_GLOB_MULTITHREADING, 4);
+    vds->SetupProperties(&importer);
+    EXPECT_NO_THROW(vds->Execute(scene));
+
+    // the error of the mesh with the lower index wins, whichever thread finds it first
+    scene->mMeshes[20]->mFaces[7].mIndices[1] = facesPerMesh * 3;
+    scene->mMeshes[50]->mNumVertices = 0;
+    std::string message;
+    try {
+        vds->Execute(scene);
+    } catch (const DeadlyImportError &e) {
+        message = e.what();
+    }
+    EXPECT_NE(std::string::npos, message.find("aiMesh::mFaces[7]::mIndices[1] is out of range"));
+}
+
+
 // ------------------------------------------------------------------------------------------------
 //Template
 //TEST_F(ScenePreprocessorTest, test)
@@ -195,5 +303,3 @@ void ValidateDataStructureTest::TearDown()
 //965: ReportError("aiString::length is too large (%i, maximum is %lu)",
 //974: ReportError("aiString::data is invalid: the terminal zero is at a wrong offset");
 //979: ReportError("aiString::data is invalid. There is no terminal character");
-}
-
@@ -40,8 +40,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "AbstractImportExportBase.h"
 #include "UnitTestPCH.h"
+#include "AssetLib/glTF2/glTF2MeshoptCodec.h"
 
 #include <assimp/commonMetaData.h>
+#include <assimp/config.h>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <assimp/Exporter.hpp>
@@ -138,10 +140,7 @@ TEST_F(utglTF2ImportExport, importglTF2PrimitiveModePointsWithoutIndices) {
     const aiScene *scene = importer.ReadFile(ASSIMP_TEST_MODELS_DIR "/glTF2/glTF-Asset-Generator/Mesh_PrimitiveMode/Mesh_PrimitiveMode_00.gltf", aiProcess_ValidateDataStructure);
     EXPECT_NE(nullptr, scene);
     EXPECT_EQ(scene->mMeshes[0]->mNumVertices, 1024u);
-    for (unsigned int i = 0; i < scene->mMeshes[0]->mNumFaces; ++i) {
-        EXPECT_EQ(scene->mMeshes[0]->mFaces[i].mNumIndices, 1u);
-        EXPECT_EQ(scene->mMeshes[0]->mFaces[i].mIndices[0], i);
-    }
+    EXPECT_TRUE(scene->mMeshes[0]->IsPointCloud());
 }
 
 TEST_F(utglTF2ImportExport, importglTF2PrimitiveModeLinesWithoutIndices) {
@@ -463,6 +462,227 @@ TEST_F(utglTF2ImportExport, export_normalized_normals) {
     }
 }
 
+TEST_F(utglTF2ImportExport, export_many_identical_names) {
+    // one triangle instanced by many nodes and meshes sharing the same name
+    const unsigned int count = 200;
+    aiScene scene;
+    scene.mNumMaterials = 1;
+    scene.mMaterials = new aiMaterial *[1];
+    scene.mMaterials[0] = new aiMaterial();
+    scene.mNumMeshes = count;
+    scene.mMeshes = new aiMesh *[count];
+    scene.mRootNode = new aiNode("root");
+    std::vector<aiNode *> children(count);
+    for (unsigned int i = 0; i < count; ++i) {
+        aiMesh *mesh = scene.mMeshes[i] = new aiMesh();
+        mesh->mName = "part";
+        mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+        mesh->mNumVertices = 3;
+        mesh->mVertices = new aiVector3D[3];
+        mesh->mVertices[0] = aiVector3D(ai_real(i), 0, 0);
+        mesh->mVertices[1] = aiVector3D(ai_real(i + 1), 0, 0);
+        mesh->mVertices[2] = aiVector3D(ai_real(i), 1, 0);
+        mesh->mNumFaces = 1;
+        mesh->mFaces = new aiFace[1];
+        mesh->mFaces[0].mNumIndices = 3;
+        mesh->mFaces[0].mIndices = new unsigned int[3]{ 0, 1, 2 };
+
+        children[i] = new aiNode("part");
+        children[i]->mNumMeshes = 1;
+        children[i]->mMeshes = new unsigned int[1]{ i };
+    }
+    scene.mRootNode->addChildren(count, children.data());
+
+    Assimp::Exporter exporter;
+    ASSERT_EQ(aiReturn_SUCCESS, exporter.Export(&scene, "glb2", "identicalNames_out.glb"));
+
+    Assimp::Importer importer;
+    const aiScene *result = importer.ReadFile("identicalNames_out.glb", aiProcess_ValidateDataStructure);
+    ASSERT_NE(nullptr, result);
+    ASSERT_EQ(count, result->mNumMeshes);
+    ASSERT_EQ(count, result->mRootNode->mNumChildren);
+    for (unsigned int i = 0; i < count; ++i) {
+        const aiMesh *mesh = result->mMeshes[i];
+        ASSERT_EQ(3u, mesh->mNumVertices);
+        EXPECT_EQ(scene.mMeshes[i]->mVertices[1], mesh->mVertices[1]);
+    }
+}
+
+namespace {
+
+// A size x size grid of vertices in the xy plane with normals and uvs
+aiMesh *CreateGridMesh(const aiVector3D &origin, ai_real spacing, unsigned int size) {
+    aiMesh *mesh = new aiMesh();
+    mesh->mPrimitiveTypes = aiPrimitiveType_TRIANGLE;
+    mesh->mNumVertices = size * size;
+    mesh->mVertices = new aiVector3D[mesh->mNumVertices];
+    mesh->mNormals = new aiVector3D[mesh->mNumVertices];
+    mesh->mTextureCoords[0] = new aiVector3D[mesh->mNumVertices];
+    mesh->mNumUVComponents[0] = 2;
+    for (unsigned int y = 0; y < size; ++y) {
+        for (unsigned int x = 0; x < size; ++x) {
+            const unsigned int i = y * size + x;
+            mesh->mVertices[i] = origin + aiVector3D(x * spacing, y * spacing, ai_real((x * y) % 7) * spacing * ai_real(0.1));
+            mesh->mNormals[i] = aiVector3D(ai_real(x % 3) - 1, ai_real(y % 5) - 2, 4).Normalize();
+            mesh->mTextureCoords[0][i] = aiVector3D(ai_real(x) / (size - 1), ai_real(y) / (size - 1), 0);
+        }
+    }
+
+    mesh->mNumFaces = 2 * (size - 1) * (size - 1);
+    mesh->mFaces = new aiFace[mesh->mNumFaces];
+    unsigned int f = 0;
+    for (unsigned int y = 0; y + 1 < size; ++y) {
+        for (unsigned int x = 0; x + 1 < size; ++x) {
+            const unsigned int i = y * size + x;
+            mesh->mFaces[f].mNumIndices = 3;
+            mesh->mFaces[f++].mIndices = new unsigned int[3]{ i, i + 1, i + size };
+            mesh->mFaces[f].mNumIndices = 3;
+            mesh->mFaces[f++].mIndices = new unsigned int[3]{ i + 1, i + size + 1, i + size };
+        }
+    }
+    return mesh;
+}
+
+aiNode *CreateMeshNode(const char *name, const aiMatrix4x4 &transform, std::vector<unsigned int> meshes) {
+    aiNode *node = new aiNode(name);
+    node->mTransformation = transform;
+    node->mNumMeshes = static_cast<unsigned int>(meshes.size());
+    node->mMeshes = new unsigned int[meshes.size()];
+    std::copy(meshes.begin(), meshes.end(), node->mMeshes);
+    return node;
+}
+
+// World transform of the (first) node referencing each mesh
+void CollectMeshTransforms(const aiNode *node, const aiMatrix4x4 &parent, std::vector<aiMatrix4x4> &transforms) {
+    const aiMatrix4x4 world = parent * node->mTransformation;
+    for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
+        transforms[node->mMeshes[i]] = world;
+    }
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) {
+        CollectMeshTransforms(node->mChildren[i], world, transforms);
+    }
+}
+
+} // namespace
+
+TEST_F(utglTF2ImportExport, meshopt_codec_roundtrip) {
+    // smooth data compresses well, noise exercises the 8 bit groups
+    const size_t count = 1000, stride = 16;
+    std::vector<uint8_t> vertices(count * stride);
+    uint32_t state = 12345;
+    for (size_t i = 0; i < count; ++i) {
+        const float smooth[2] = { float(i) * 0.25f, std::sin(float(i) * 0.01f) };
+        memcpy(&vertices[i * stride], smooth, sizeof(smooth));
+        for (size_t k = sizeof(smooth); k < stride; ++k) {
+            state = state * 1664525u + 1013904223u;
+            vertices[i * stride + k] = uint8_t(state >> 24);
+        }
+    }
+
+    std::vector<uint8_t> encoded;
+    glTF2::Meshopt::EncodeVertexBuffer(encoded, vertices.data(), count, stride);
+    std::vector<uint8_t> decoded(count * stride);
+    ASSERT_TRUE(glTF2::Meshopt::DecodeVertexBuffer(decoded.data(), count, stride, encoded.data(), encoded.size()));
+    EXPECT_EQ(vertices, decoded);
+
+    // truncated streams are rejected
+    EXPECT_FALSE(glTF2::Meshopt::DecodeVertexBuffer(decoded.data(), count, stride, encoded.data(), encoded.size() / 2));
+
+    std::vector<uint32_t> indices(3000);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = uint32_t((i / 3 + i % 3 * 7) % 60000);
+    }
+    std::vector<uint8_t> encodedIndices;
+    glTF2::Meshopt::EncodeIndexSequence(encodedIndices, indices.data(), indices.size());
+
+    std::vector<uint32_t> decoded32(indices.size());
+    ASSERT_TRUE(glTF2::Meshopt::DecodeIndexSequence(reinterpret_cast<uint8_t *>(decoded32.data()), indices.size(), 4, encodedIndices.data(), encodedIndices.size()));
+    EXPECT_EQ(indices, decoded32);
+
+    std::vector<uint16_t> decoded16(indices.size());
+    ASSERT_TRUE(glTF2::Meshopt::DecodeIndexSequence(reinterpret_cast<uint8_t *>(decoded16.data()), indices.size(), 2, encodedIndices.data(), encodedIndices.size()));
+    for (size_t i = 0; i < indices.size(); ++i) {
+        ASSERT_EQ(indices[i], decoded16[i]);
+    }
+}
+
+TEST_F(utglTF2ImportExport, export_quantized_meshopt) {
+    aiScene scene;
+    scene.mNumMaterials = 1;
+    scene.mMaterials = new aiMaterial *[1];
+    scene.mMaterials[0] = new aiMaterial();
+    scene.mNumMeshes = 5;
+    scene.mMeshes = new aiMesh *[5];
+    scene.mMeshes[0] = CreateGridMesh(aiVector3D(-50, 10, 3), ai_real(2.5), 40);
+    scene.mMeshes[1] = CreateGridMesh(aiVector3D(0, 0, 0), ai_real(0.01), 12);
+    scene.mMeshes[2] = CreateGridMesh(aiVector3D(1000, -2000, 5), ai_real(10), 20);
+    scene.mMeshes[3] = CreateGridMesh(aiVector3D(1, 2, 3), ai_real(0.5), 16);
+    scene.mMeshes[4] = CreateGridMesh(aiVector3D(-30, -40, 7), ai_real(1), 300);
+
+    aiMatrix4x4 translation, rotation;
+    aiMatrix4x4::Translation(aiVector3D(10, -5, 2), translation);
+    aiMatrix4x4::RotationZ(ai_real(0.5), rotation);
+
+    // a leaf node, a node with a child and a node with two meshes sharing one grid
+    scene.mRootNode = new aiNode("root");
+    aiNode *withChild = CreateMeshNode("withChild", rotation, { 1 });
+    aiNode *children[] = { CreateMeshNode("child", translation, { 2 }) };
+    withChild->addChildren(1, children);
+    aiNode *nodes[] = { CreateMeshNode("leaf", translation * rotation, { 0 }), withChild, CreateMeshNode("twoMeshes", aiMatrix4x4(), { 3, 4 }) };
+    scene.mRootNode->addChildren(3, nodes);
+
+    std::vector<aiMatrix4x4> expectedTransforms(scene.mNumMeshes);
+    CollectMeshTransforms(scene.mRootNode, aiMatrix4x4(), expectedTransforms);
+
+    Assimp::ExportProperties properties;
+    properties.SetPropertyBool(AI_CONFIG_EXPORT_GLTF_QUANTIZE, true);
+    properties.SetPropertyBool(AI_CONFIG_EXPORT_GLTF_MESHOPT_COMPRESSION, true);
+
+    Assimp::Exporter exporter;
+    ASSERT_EQ(aiReturn_SUCCESS, exporter.Export(&scene, "glb2", ASSIMP_TEST_MODELS_DIR "/glTF2/quantized_out.glb", 0, &properties));
+    ASSERT_EQ(aiReturn_SUCCESS, exporter.Export(&scene, "gltf2", ASSIMP_TEST_MODELS_DIR "/glTF2/quantized_out.gltf", 0, &properties));
+
+    for (const char *file : { ASSIMP_TEST_MODELS_DIR "/glTF2/quantized_out.glb", ASSIMP_TEST_MODELS_DIR "/glTF2/quantized_out.gltf" }) {
+        Assimp::Importer importer;
+        const aiScene *result = importer.ReadFile(file, aiProcess_ValidateDataStructure);
+        ASSERT_NE(nullptr, result) << file;
+        ASSERT_EQ(scene.mNumMeshes, result->mNumMeshes);
+
+        std::vector<aiMatrix4x4> transforms(result->mNumMeshes);
+        CollectMeshTransforms(result->mRootNode, aiMatrix4x4(), transforms);
+
+        // the importer orders the meshes by node traversal, the vertex counts are unique
+        for (unsigned int e = 0; e < scene.mNumMeshes; ++e) {
+            const aiMesh *expected = scene.mMeshes[e];
+            unsigned int m = 0;
+            while (m < result->mNumMeshes && result->mMeshes[m]->mNumVertices != expected->mNumVertices) {
+                ++m;
+            }
+            ASSERT_LT(m, result->mNumMeshes) << file << " mesh " << e;
+            const aiMesh *mesh = result->mMeshes[m];
+            ASSERT_EQ(expected->mNumFaces, mesh->mNumFaces);
+            ASSERT_TRUE(mesh->HasNormals());
+            ASSERT_TRUE(mesh->HasTextureCoords(0));
+
+            // 16 bit positions on a grid spanning at most a few thousand units
+            for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
+                const aiVector3D a = expectedTransforms[e] * expected->mVertices[i];
+                const aiVector3D b = transforms[m] * mesh->mVertices[i];
+                ASSERT_NEAR(0, (a - b).Length(), 0.05) << file << " mesh " << m << " vertex " << i;
+                EXPECT_NEAR(1, expected->mNormals[i] * mesh->mNormals[i], 1e-2);
+                EXPECT_NEAR(expected->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].x, 1e-4);
+                EXPECT_NEAR(expected->mTextureCoords[0][i].y, mesh->mTextureCoords[0][i].y, 1e-4);
+            }
+            for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+                ASSERT_EQ(3u, mesh->mFaces[f].mNumIndices);
+                for (unsigned int k = 0; k < 3; ++k) {
+                    ASSERT_EQ(expected->mFaces[f].mIndices[k], mesh->mFaces[f].mIndices[k]);
+                }
+            }
+        }
+    }
+}
+
 #endif // ASSIMP_BUILD_NO_EXPORT
 
 TEST_F(utglTF2ImportExport, sceneMetadata) {
@@ -574,3 +794,67 @@ TEST_F(utglTF2ImportExport, allIndicesOutOfRange) {
     std::string error = importer.GetErrorString();
     ASSERT_NE(error.find("Mesh \"Mesh\" has no faces"), std::string::npos);
 }
+
+static std::string CreateTwoTriangleAsset(const char *bufferData) {
+    return std::string(R"({
+        "asset": { "version": "2.0" },
+        "scene": 0,
+        "scenes": [ { "nodes": [ 0, 1 ] } ],
+        "nodes": [ { "mesh": 0 }, { "mesh": 1 } ],
+        "meshes": [
+            { "name": "first", "primitives": [ { "attributes": { "POSITION": 0 } } ] },
+            { "name": "second", "primitives": [ { "attributes": { "POSITION": 1 } } ] }
+        ],
+        "accessors": [
+            { "bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3" },
+            { "bufferView": 1, "componentType": 5126, "count": 3, "type": "VEC3" }
+        ],
+        "bufferViews": [
+            { "buffer": 0, "byteOffset": 0, "byteLength": 36 },
+            { "buffer": 0, "byteOffset": 36, "byteLength": 36 }
+        ],
+        "buffers": [ { "byteLength": 72, "uri": "data:application/octet-stream;base64,)") +
+           bufferData + R"(" } ]
+    })";
+}
+
+TEST_F(utglTF2ImportExport, incrementalReimportConvertsChangedPrimitivesOnly) {
+    // The x coordinate of the second vertex of the second mesh is 3 and 4
+    const std::string original = CreateTwoTriangleAsset(
+            "AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAAAAQAAAAAAAAAAAAABAQAAAAAAAAAAAAAAAQAAAgD8AAAAA");
+    const std::string modified = CreateTwoTriangleAsset(
+            "AAAAAAAAAAAAAAAAAACAPwAAAAAAAAAAAAAAAAAAgD8AAAAAAAAAQAAAAAAAAAAAAACAQAAAAAAAAAAAAAAAQAAAgD8AAAAA");
+
+    struct LogObserver : Assimp::LogStream {
+        std::vector<std::string> m_reused;
+        void write(const char *message) override {
+            if (std::strstr(message, "converted meshes")) {
+                m_reused.push_back(message);
+            }
+        }
+    };
+    LogObserver logObserver;
+    DefaultLogger::get()->attachStream(&logObserver);
+
+    Assimp::Importer importer;
+    importer.SetPropertyBool(AI_CONFIG_IMPORT_INCREMENTAL, true);
+    const unsigned int flags = aiProcess_GenNormals | aiProcess_ValidateDataStructure;
+    const std::string *inputs[] = { &original, &modified, &modified };
+    for (const std::string *input : inputs) {
+        const aiScene *scene = importer.ReadFileFromMemory(input->data(), input->size(), flags, "gltf");
+        ASSERT_NE(nullptr, scene);
+        ASSERT_EQ(2u, scene->mNumMeshes);
+        EXPECT_STREQ("first", scene->mMeshes[0]->mName.C_Str());
+        EXPECT_STREQ("second", scene->mMeshes[1]->mName.C_Str());
+        EXPECT_FLOAT_EQ(1.f, scene->mMeshes[0]->mVertices[1].x);
+        EXPECT_FLOAT_EQ(input == &original ? 3.f : 4.f, scene->mMeshes[1]->mVertices[1].x);
+        ASSERT_NE(nullptr, scene->mMeshes[1]->mNormals);
+        EXPECT_FLOAT_EQ(1.f, scene->mMeshes[1]->mNormals[0].z);
+    }
+    DefaultLogger::get()->detachStream(&logObserver);
+
+    ASSERT_EQ(3u, logObserver.m_reused.size());
+    EXPECT_NE(std::string::npos, logObserver.m_reused[0].find("Reused 0 of 2"));
+    EXPECT_NE(std::string::npos, logObserver.m_reused[1].find("Reused 1 of 2"));
+    EXPECT_NE(std::string::npos, logObserver.m_reused[2].find("Reused 2 of 2"));
+}
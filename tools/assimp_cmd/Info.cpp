@@ -46,6 +46,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Main.h"
 
+#include <assimp/SceneAnalysis.h>
+
 #include <cstdio>
 #include <iostream>
 #include <string>
@@ -73,130 +75,20 @@ const char *TREE_STOP = TREE_STOP_UTF8;
 const char *TREE_CONTINUE = TREE_CONTINUE_UTF8;
 
 // -----------------------------------------------------------------------------------
-unsigned int CountNodes(const aiNode* root)
-{
-	unsigned int i = 0;
-	for (unsigned int a = 0; a < root->mNumChildren; ++a ) {
-		i += CountNodes(root->mChildren[a]);
-	}
-	return 1+i;
-}
-
-// -----------------------------------------------------------------------------------
-unsigned int GetMaxDepth(const aiNode* root)
-{
-	unsigned int cnt = 0;
-	for (unsigned int i = 0; i < root->mNumChildren; ++i ) {
-		cnt = std::max(cnt,GetMaxDepth(root->mChildren[i]));
-	}
-	return cnt+1;
-}
-
-// -----------------------------------------------------------------------------------
-unsigned int CountVertices(const aiScene* scene)
+std::string FindPTypes(unsigned int pt)
 {
-	unsigned int cnt = 0;
-	for(unsigned int i = 0; i < scene->mNumMeshes; ++i) {
-		cnt += scene->mMeshes[i]->mNumVertices;
-	}
-	return cnt;
-}
-
-// -----------------------------------------------------------------------------------
-unsigned int CountFaces(const aiScene* scene)
-{
-	unsigned int cnt = 0;
-	for(unsigned int i = 0; i < scene->mNumMeshes; ++i) {
-		cnt += scene->mMeshes[i]->mNumFaces;
+	bool haveit[4] = {0};
+	if (pt & aiPrimitiveType_POINT) {
+		haveit[0]=true;
 	}
-	return cnt;
-}
-
-// -----------------------------------------------------------------------------------
-unsigned int CountBones(const aiScene* scene)
-{
-	unsigned int cnt = 0;
-	for(unsigned int i = 0; i < scene->mNumMeshes; ++i) {
-		cnt += scene->mMeshes[i]->mNumBones;
+	if (pt & aiPrimitiveType_LINE) {
+		haveit[1]=true;
 	}
-	return cnt;
-}
-
-// -----------------------------------------------------------------------------------
-unsigned int CountAnimChannels(const aiScene* scene)
-{
-	unsigned int cnt = 0;
-	for(unsigned int i = 0; i < scene->mNumAnimations; ++i) {
-		cnt += scene->mAnimations[i]->mNumChannels;
+	if (pt & aiPrimitiveType_TRIANGLE) {
+		haveit[2]=true;
 	}
-	return cnt;
-}
-
-// -----------------------------------------------------------------------------------
-unsigned int GetAvgFacePerMesh(const aiScene* scene) {
-	return (scene->mNumMeshes != 0) ? static_cast<unsigned int>(CountFaces(scene)/scene->mNumMeshes) : 0;
-}
-
-// -----------------------------------------------------------------------------------
-unsigned int GetAvgVertsPerMesh(const aiScene* scene) {
-	return (scene->mNumMeshes != 0) ? static_cast<unsigned int>(CountVertices(scene)/scene->mNumMeshes) : 0;
-}
-
-// -----------------------------------------------------------------------------------
-void FindSpecialPoints(const aiScene* scene,const aiNode* root,aiVector3D special_points[3],const aiMatrix4x4& mat=aiMatrix4x4())
-{
-	// XXX that could be greatly simplified by using code from code/ProcessHelper.h
-	// XXX I just don't want to include it here.
-	const aiMatrix4x4 trafo = root->mTransformation*mat;
-	for(unsigned int i = 0; i < root->mNumMeshes; ++i) {
-		const aiMesh* mesh = scene->mMeshes[root->mMeshes[i]];
-
-		for(unsigned int a = 0; a < mesh->mNumVertices; ++a) {
-			aiVector3D v = trafo*mesh->mVertices[a];
-
-			special_points[0].x = std::min(special_points[0].x,v.x);
-			special_points[0].y = std::min(special_points[0].y,v.y);
-			special_points[0].z = std::min(special_points[0].z,v.z);
-
-			special_points[1].x = std::max(special_points[1].x,v.x);
-			special_points[1].y = std::max(special_points[1].y,v.y);
-			special_points[1].z = std::max(special_points[1].z,v.z);
-		}
-	}
-
-	for(unsigned int i = 0; i < root->mNumChildren; ++i) {
-		FindSpecialPoints(scene,root->mChildren[i],special_points,trafo);
-	}
-}
-
-// -----------------------------------------------------------------------------------
-void FindSpecialPoints(const aiScene* scene,aiVector3D special_points[3])
-{
-	special_points[0] = aiVector3D(1e10,1e10,1e10);
-	special_points[1] = aiVector3D(-1e10,-1e10,-1e10);
-
-	FindSpecialPoints(scene,scene->mRootNode,special_points);
-	special_points[2] = (special_points[0]+special_points[1])*(ai_real)0.5;
-}
-
-// -----------------------------------------------------------------------------------
-std::string FindPTypes(const aiScene* scene)
-{
-	bool haveit[4] = {0};
-	for(unsigned int i = 0; i < scene->mNumMeshes; ++i) {
-		const unsigned int pt = scene->mMeshes[i]->mPrimitiveTypes;
-		if (pt & aiPrimitiveType_POINT) {
-			haveit[0]=true;
-		}
-		if (pt & aiPrimitiveType_LINE) {
-			haveit[1]=true;
-		}
-		if (pt & aiPrimitiveType_TRIANGLE) {
-			haveit[2]=true;
-		}
-		if (pt & aiPrimitiveType_POLYGON) {
-			haveit[3]=true;
-		}
+	if (pt & aiPrimitiveType_POLYGON) {
+		haveit[3]=true;
 	}
 	return (haveit[0]?std::string("points"):"")+(haveit[1]?"lines":"")+
 		(haveit[2]?"triangles":"")+(haveit[3]?"n-polygons":"");
@@ -363,28 +255,31 @@ int Assimp_Info (const char* const* params, unsigned int num) {
 
 		;
 
-	aiVector3D special_points[3];
-	FindSpecialPoints(scene,special_points);
+	// one pass over the scene for all counts and bounds
+	SceneStatistics stats;
+	AnalyzeScene(scene, stats);
+	const aiVector3D center = (stats.mAABB.mMin + stats.mAABB.mMax) * (ai_real)0.5;
+	const unsigned int numMeshes = std::max(scene->mNumMeshes, 1u);
 	printf(format_string,
 		mem.total,
-		CountNodes(scene->mRootNode),
-		GetMaxDepth(scene->mRootNode),
+		static_cast<unsigned int>(stats.mNodes.size()),
+		stats.mMaxDepth,
 		scene->mNumMeshes,
 		scene->mNumAnimations,
 		scene->mNumTextures,
 		scene->mNumMaterials,
 		scene->mNumCameras,
 		scene->mNumLights,
-		CountVertices(scene),
-		CountFaces(scene),
-		CountBones(scene),
-		CountAnimChannels(scene),
-		FindPTypes(scene).c_str(),
-		GetAvgFacePerMesh(scene),
-		GetAvgVertsPerMesh(scene),
-		special_points[0][0],special_points[0][1],special_points[0][2],
-		special_points[1][0],special_points[1][1],special_points[1][2],
-		special_points[2][0],special_points[2][1],special_points[2][2]
+		stats.mNumVertices,
+		stats.mNumFaces,
+		stats.mNumBones,
+		stats.mNumAnimChannels,
+		FindPTypes(stats.mPrimitiveTypes).c_str(),
+		stats.mNumFaces / numMeshes,
+		stats.mNumVertices / numMeshes,
+		stats.mAABB.mMin.x,stats.mAABB.mMin.y,stats.mAABB.mMin.z,
+		stats.mAABB.mMax.x,stats.mAABB.mMax.y,stats.mAABB.mMax.z,
+		center.x,center.y,center.z
 		)
 	;
 
@@ -396,7 +291,7 @@ int Assimp_Info (const char* const* params, unsigned int num) {
 
 	// meshes
 	if (scene->mNumMeshes) {
-		printf("\nMeshes:  (name) [vertices / bones / faces | primitive_types]\n");
+		printf("\nMeshes:  (name) [vertices / bones / faces | primitive_types | memory]\n");
 	}
 	for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
 		const aiMesh* mesh = scene->mMeshes[i];
@@ -412,7 +307,7 @@ int Assimp_Info (const char* const* params, unsigned int num) {
 		if (ptypes & aiPrimitiveType_LINE) { printf(" line"); }
 		if (ptypes & aiPrimitiveType_TRIANGLE) { printf(" triangle"); }
 		if (ptypes & aiPrimitiveType_POLYGON) { printf(" polygon"); }
-		printf("]\n");
+		printf(" | %llu B]\n", static_cast<unsigned long long>(stats.mMeshes[i].mMemory));
 	}
 
 	// materials